@@ -0,0 +1,29 @@
+{
+    "Source" : "./GltfPointCloud_DepthPass.azsl",
+
+    "DepthStencilState" : { 
+        "Depth" : { "Enable" : true, "CompareFunc" : "GreaterEqual" }
+    },
+
+    "RasterState" :
+    {
+        "CullMode" : "None"
+    },
+
+    "ProgramSettings" : 
+    {
+        "EntryPoints":
+        [
+            {
+                "name": "DepthPassVS",
+                "type" : "Vertex"
+            },
+            {
+                "name": "DepthPassPS",
+                "type": "Fragment"
+            }
+        ] 
+    },
+
+    "DrawList" : "depth"
+}
@@ -0,0 +1,34 @@
+{
+    "Source" : "./GltfPointCloud_ForwardPass.azsl",
+
+    "DepthStencilState" :
+    {
+        "Depth" :
+        {
+            "Enable" : true,
+            "CompareFunc" : "GreaterEqual"
+        }
+    },
+
+    "RasterState" :
+    {
+        "CullMode" : "None"
+    },
+
+    "ProgramSettings":
+    {
+      "EntryPoints":
+      [
+        {
+          "name": "PointCloud_ForwardPassVS",
+          "type": "Vertex"
+        },
+        {
+          "name": "PointCloud_ForwardPassPS",
+          "type": "Fragment"
+        }
+      ]
+    },
+
+    "DrawList" : "forward"
+}
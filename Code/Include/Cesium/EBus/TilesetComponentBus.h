@@ -38,6 +38,13 @@ namespace Cesium
         bool m_forbidHole;
     };
 
+    enum class TangentGenerationMode
+    {
+        MikkTSpace,
+        FastPerTriangle,
+        FastAccumulated
+    };
+
     struct TilesetRenderConfiguration final
     {
         AZ_RTTI(TilesetRenderConfiguration, "{141F2DE1-CEEB-4ACD-BCCA-2F7F6CEF60B6}");
@@ -47,10 +54,43 @@ namespace Cesium
 
         TilesetRenderConfiguration()
             : m_generateMissingNormalAsSmooth{ true }
+            , m_pointCloudPointBudget{ 8 * 1024 * 1024 }
+            , m_pointCloudPointSize{ 2.0f }
+            , m_pointCloudAttenuation{ true }
+            , m_pointCloudGeometricErrorScale{ 1.0f }
+            , m_pointCloudMaximumAttenuation{ 8.0f }
+            , m_optimizeVertexCache{ false }
+            , m_vertexCacheOptimizationMinimumTriangleCount{ 256 }
+            , m_tangentGenerationMode{ TangentGenerationMode::MikkTSpace }
+            , m_compressTextures{ false }
+            , m_generateMipmaps{ true }
+            , m_shareTextures{ true }
+            , m_poolRasterOverlayTiles{ true }
+            , m_compositeRasterOverlays{ false }
+            , m_streamTexturesByScreenCoverage{ true }
+            , m_releaseDecodedImages{ false }
         {
         }
 
         bool m_generateMissingNormalAsSmooth;
+        std::uint64_t m_pointCloudPointBudget;
+        float m_pointCloudPointSize;
+        bool m_pointCloudAttenuation;
+        float m_pointCloudGeometricErrorScale;
+        float m_pointCloudMaximumAttenuation;
+        bool m_optimizeVertexCache;
+        std::uint32_t m_vertexCacheOptimizationMinimumTriangleCount;
+        TangentGenerationMode m_tangentGenerationMode;
+        bool m_compressTextures;
+        bool m_generateMipmaps;
+        bool m_shareTextures;
+        bool m_poolRasterOverlayTiles;
+        bool m_compositeRasterOverlays;
+        bool m_streamTexturesByScreenCoverage;
+
+        // frees the decoded images of a tile once its textures are uploaded. Raster overlays can't be added to the tileset then,
+        // since cesium-native upsamples the tiles they drape over from the images of their parent
+        bool m_releaseDecodedImages;
     };
 
     struct TilesetLocalFileSource final
@@ -10,15 +10,70 @@
 #include <Cesium/Math/Cartographic.h>
 #include <Cesium/Math/GeospatialHelper.h>
 #include <Cesium/Math/MathReflect.h>
+#include <AzCore/Console/IConsole.h>
 #include <AzCore/Serialization/SerializeContext.h>
 #include <AzCore/Serialization/EditContext.h>
 #include <AzCore/Serialization/EditContextConstants.inl>
 #include <AzCore/std/smart_ptr/make_shared.h>
 #include <AzCore/std/smart_ptr/shared_ptr.h>
 #include <Cesium3DTilesSelection/registerAllTileContentTypes.h>
+#include <cinttypes>
 
 namespace Cesium
 {
+    static void cesium_DumpHttpStatistics([[maybe_unused]] const AZ::ConsoleCommandContainer& arguments)
+    {
+        std::vector<HttpHostStatistics> hosts;
+        CesiumSystemRequestBus::BroadcastResult(hosts, &CesiumSystemRequestBus::Events::GetHttpHostStatistics);
+        if (hosts.empty())
+        {
+            AZ_Printf("Cesium", "No http requests have been sent yet\n");
+            return;
+        }
+
+        for (const HttpHostStatistics& host : hosts)
+        {
+            AZ_Printf(
+                "Cesium",
+                "%s: %" PRIu64 " requests, %" PRIu64 " retried, %" PRIu32 " active (peak %" PRIu32 "), %" PRIu64 " bytes received, %" PRIu64
+                " bytes decoded\n",
+                host.m_host.c_str(), host.m_requestCount, host.m_retryCount, host.m_activeRequestCount, host.m_peakActiveRequestCount,
+                host.m_bytesReceived, host.m_bytesDecoded);
+            AZ_Printf(
+                "Cesium", "    ttfb: mean %.1f ms, p50 <= %" PRIu32 " ms, p95 <= %" PRIu32 " ms\n", host.m_timeToFirstByte.GetMeanMs(),
+                host.m_timeToFirstByte.GetPercentileMs(0.5), host.m_timeToFirstByte.GetPercentileMs(0.95));
+            AZ_Printf(
+                "Cesium", "    total: mean %.1f ms, p50 <= %" PRIu32 " ms, p95 <= %" PRIu32 " ms\n", host.m_totalTime.GetMeanMs(),
+                host.m_totalTime.GetPercentileMs(0.5), host.m_totalTime.GetPercentileMs(0.95));
+            for (const auto& responseCodeCount : host.m_responseCodeCounts)
+            {
+                AZ_Printf("Cesium", "    status %d: %" PRIu64 "\n", responseCodeCount.first, responseCodeCount.second);
+            }
+        }
+    }
+
+    AZ_CONSOLEFREEFUNC(
+        cesium_DumpHttpStatistics, AZ::ConsoleFunctorFlags::Null, "Prints the request counts, latencies and status codes per http host");
+
+    static void cesium_DumpVertexCacheStatistics([[maybe_unused]] const AZ::ConsoleCommandContainer& arguments)
+    {
+        VertexCacheStatistics statistics;
+        CesiumSystemRequestBus::BroadcastResult(statistics, &CesiumSystemRequestBus::Events::GetVertexCacheStatistics);
+        if (statistics.m_primitiveCount == 0)
+        {
+            AZ_Printf("Cesium", "No vertex cache has been optimized yet\n");
+            return;
+        }
+
+        AZ_Printf(
+            "Cesium", "Optimized vertex cache of %" PRIu64 " primitives, %" PRIu64 " triangles. ACMR: %.3f -> %.3f\n",
+            statistics.m_primitiveCount, statistics.m_triangleCount, statistics.GetMeanACMRBefore(), statistics.GetMeanACMRAfter());
+    }
+
+    AZ_CONSOLEFREEFUNC(
+        cesium_DumpVertexCacheStatistics, AZ::ConsoleFunctorFlags::Null,
+        "Prints the mean ACMR of the loaded primitives before and after their vertex cache is optimized");
+
     void CesiumSystemComponent::Reflect(AZ::ReflectContext* context)
     {
         MathSerialization::Reflect(context);
@@ -113,6 +168,17 @@ namespace Cesium
 
     void CesiumSystemComponent::OnTick([[maybe_unused]] float deltaTime, [[maybe_unused]] AZ::ScriptTimePoint time)
     {
+        m_cesiumSystem->Tick();
+    }
+
+    std::vector<HttpHostStatistics> CesiumSystemComponent::GetHttpHostStatistics()
+    {
+        return m_cesiumSystem->GetHttpHostStatistics();
+    }
+
+    VertexCacheStatistics CesiumSystemComponent::GetVertexCacheStatistics()
+    {
+        return m_cesiumSystem->GetVertexCacheTelemetry().GetStatistics();
     }
 
 } // namespace Cesium
@@ -41,6 +41,10 @@ namespace Cesium
 
         void OnTick(float deltaTime, AZ::ScriptTimePoint time) override;
 
+        std::vector<HttpHostStatistics> GetHttpHostStatistics() override;
+
+        VertexCacheStatistics GetVertexCacheStatistics() override;
+
     private:
         AZStd::unique_ptr<CesiumSystem> m_cesiumSystem;
     };
@@ -1,13 +1,15 @@
 #include "Cesium/Components/DynamicUiImageComponent.h"
+#include "Cesium/Gltf/GltfLoadScratchArena.h"
+#include "Cesium/Gltf/StreamingImageBuilder.h"
 #include "Cesium/Systems/CesiumSystem.h"
 #include <LyShine/ILyShine.h>
 #include <LyShine/IDraw2d.h>
 #include <LyShine/Bus/UiTransformBus.h>
 #include <Atom/RPI.Public/ViewportContext.h>
 #include <Atom/RPI.Public/ViewportContextBus.h>
-#include <Atom/RPI.Public/Image/ImageSystemInterface.h>
-#include <Atom/RPI.Public/Image/StreamingImagePool.h>
+#include <Atom/RPI.Reflect/Image/StreamingImageAsset.h>
 #include <AzCore/std/string/string_view.h>
+#include <AzCore/std/algorithm.h>
 #include <AzCore/StringFunc/StringFunc.h>
 
 // Window 10 wingdi.h header defines OPAQUE macro which mess up with CesiumGltf::Material::AlphaMode::OPAQUE.
@@ -18,7 +20,7 @@
 #undef OPAQUE
 #endif
 
-#include <CesiumGltfReader/GltfReader.h>
+#include <CesiumGltf/ImageCesium.h>
 
 #ifdef AZ_COMPILER_MSVC
 #pragma pop_macro("OPAQUE")
@@ -60,56 +62,94 @@ namespace Cesium
 
     void DynamicUiImageComponent::LoadImageUrl(const AZStd::string& url)
     {
-        if (AZ::StringFunc::StartsWith(url, "data") && AZ::StringFunc::Contains(url, "base64"))
+        // the image is only ever drawn scaled down to fit the max size, so there is no need to decode more than that
+        ImageDecodeOption decodeOption;
+        decodeOption.m_targetSize = AZStd::max(m_maxSize.m_width, m_maxSize.m_height);
+        AZStd::string key = AZStd::string::format("%u:%s", decodeOption.m_targetSize, url.c_str());
+
+        AZ::EntityId selfEntityId = GetEntityId();
+        bool needsLoad = CesiumInterface::Get()->GetUiImageCache().Request(
+            key,
+            [selfEntityId](const UiImage& uiImage)
+            {
+                AZ::Data::Instance<AZ::RPI::StreamingImage> image = uiImage.m_imageAsset
+                    ? AZ::RPI::StreamingImage::FindOrCreate(uiImage.m_imageAsset)
+                    : AZ::Data::Instance<AZ::RPI::StreamingImage>();
+                if (image)
+                {
+                    DynamicUiImageRequestBus::Event(selfEntityId, &DynamicUiImageRequestBus::Events::SetImage, image, uiImage.m_size);
+                }
+            });
+        if (!needsLoad)
         {
-            AZStd::string_view urlView = url;
-            auto separator = urlView.find_first_of(",");
-            auto base64View = url.substr(separator + 1);
+            return;
+        }
 
-            AZStd::vector<AZ::u8> decodeOutput;
-            AZ::StringFunc::Base64::Decode(decodeOutput, base64View.data(), base64View.size());
+        // decoding and creating the asset happen on worker threads. The main thread only creates the image from the finished asset
+        auto onImageLoaded = [key](UiImage&& uiImage)
+        {
+            CesiumInterface::Get()->GetUiImageCache().Complete(key, uiImage);
+        };
 
-            CesiumGltfReader::GltfReader gltfReader;
-            auto imageResult = gltfReader.readImage(
-                gsl::span<const std::byte>(reinterpret_cast<const std::byte*>(decodeOutput.data()), decodeOutput.size()));
-            if (imageResult.image)
-            {
-                auto pool = AZ::RPI::ImageSystemInterface::Get()->GetStreamingPool();
-                auto size = AZ::RHI::Size(imageResult.image->width, imageResult.image->height, 1);
-                auto image = AZ::RPI::StreamingImage::CreateFromCpuData(
-                    *pool, AZ::RHI::ImageDimension::Image2D, size, AZ::RHI::Format::R8G8B8A8_UNORM, imageResult.image->pixelData.data(),
-                    imageResult.image->pixelData.size());
-                SetImage(image, size);
-            }
+        if (AZ::StringFunc::StartsWith(url, "data") && AZ::StringFunc::Contains(url, "base64"))
+        {
+            m_asyncSystem
+                .runInWorkerThread(
+                    [url, decodeOption]()
+                    {
+                        AZStd::string_view urlView = url;
+                        auto separator = urlView.find_first_of(",");
+                        auto base64View = urlView.substr(separator + 1);
 
+                        AZStd::vector<AZ::u8> decodeOutput;
+                        AZ::StringFunc::Base64::Decode(decodeOutput, base64View.data(), base64View.size());
+                        return CreateImageAsset(
+                            gsl::span<const std::byte>(reinterpret_cast<const std::byte*>(decodeOutput.data()), decodeOutput.size()),
+                            decodeOption);
+                    })
+                .thenInMainThread(std::move(onImageLoaded));
             return;
         }
 
-        AZ::EntityId selfEntityId = GetEntityId();
         auto& httpManager = CesiumInterface::Get()->GetIOManager(Cesium::IOKind::Http);
         Cesium::IORequestParameter requestParameter{ url, "" };
-        auto future =
-            httpManager.GetFileContentAsync(m_asyncSystem, requestParameter)
-                .thenInMainThread(
-                    [selfEntityId](IOContent&& content)
-                    {
-                        if (content.empty())
-                        {
-                            return;
-                        }
-
-                        CesiumGltfReader::GltfReader gltfReader;
-                        auto imageResult = gltfReader.readImage(content);
-                        if (imageResult.image)
-                        {
-                            auto pool = AZ::RPI::ImageSystemInterface::Get()->GetStreamingPool();
-                            auto size = AZ::RHI::Size(imageResult.image->width, imageResult.image->height, 1);
-                            auto image = AZ::RPI::StreamingImage::CreateFromCpuData(
-                                *pool, AZ::RHI::ImageDimension::Image2D, size, AZ::RHI::Format::R8G8B8A8_UNORM,
-                                imageResult.image->pixelData.data(), imageResult.image->pixelData.size());
-                            DynamicUiImageRequestBus::Event(selfEntityId, &DynamicUiImageRequestBus::Events::SetImage, image, size);
-                        }
-                    });
+        httpManager.GetFileContentAsync(m_asyncSystem, requestParameter)
+            .thenInWorkerThread(
+                [decodeOption](IOContent&& content)
+                {
+                    return CreateImageAsset(gsl::span<const std::byte>(content.data(), content.size()), decodeOption);
+                })
+            .thenInMainThread(std::move(onImageLoaded));
+    }
+
+    UiImage DynamicUiImageComponent::CreateImageAsset(gsl::span<const std::byte> data, const ImageDecodeOption& option)
+    {
+        CesiumGltf::ImageCesium decodedImage;
+        if (data.empty() || !CesiumInterface::Get()->GetImageDecoderRegistry().Decode(data, option, decodedImage))
+        {
+            return UiImage{};
+        }
+
+        // the registry passes GPU compressed and high bit depth images through as they are, which the UI doesn't draw
+        if (decodedImage.compressedPixelFormat != CesiumGltf::GpuCompressedPixelFormat::NONE || decodedImage.channels != 4 ||
+            decodedImage.bytesPerChannel != 1)
+        {
+            return UiImage{};
+        }
+
+        std::uint32_t width = static_cast<std::uint32_t>(decodedImage.width);
+        std::uint32_t height = static_cast<std::uint32_t>(decodedImage.height);
+
+        // the worker may be in the middle of loading a tile, so the image gets an arena of its own that is released on return
+        GltfLoadScratchArena scratchArena;
+        AZ::Data::Asset<AZ::RPI::StreamingImageAsset> imageAsset =
+            StreamingImageBuilder::Create(decodedImage.pixelData.data(), width, height, 4, StreamingImageBuilderOption{}, scratchArena);
+        if (!imageAsset)
+        {
+            return UiImage{};
+        }
+
+        return UiImage{ std::move(imageAsset), AZ::RHI::Size(width, height, 1) };
     }
 
     void DynamicUiImageComponent::SetImage(AZ::Data::Instance<AZ::RPI::StreamingImage> image, AZ::RHI::Size size)
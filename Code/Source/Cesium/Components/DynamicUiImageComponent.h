@@ -1,6 +1,8 @@
 #pragma once
 
 #include "Cesium/EBus/DynamicUiImageComponentBus.h"
+#include "Cesium/Gltf/ImageDecoder.h"
+#include "Cesium/Systems/UiImageCache.h"
 #include <LyShine/IDraw2d.h>
 #include <LyShine/Bus/UiElementBus.h>
 #include <LyShine/Bus/UiCanvasBus.h>
@@ -60,6 +62,8 @@ namespace Cesium
 
         void ScaleImageToFit();
 
+        static UiImage CreateImageAsset(gsl::span<const std::byte> data, const ImageDecodeOption& option);
+
         bool m_isEnable{ true };
         AZ::RHI::Size m_realImageSize{ 0, 0, 0 };
         AZ::RHI::Size m_scaledImageSize{ 0, 0, 0 };
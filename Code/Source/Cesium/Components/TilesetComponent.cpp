@@ -62,6 +62,9 @@ namespace Cesium
         {
             RasterOverlayContainerRequestBus::Handler::BusDisconnect();
             m_rasterOverlayContainerUnloadedEvent.Signal();
+
+            // the tileset waits for its loads to finish when it is destroyed, so requests that are still pending are cancelled first
+            m_cancellationToken.Cancel();
             m_tileset.reset();
             m_renderResourcesPreparer.reset();
         }
@@ -73,7 +76,9 @@ namespace Cesium
             {
                 m_tilesetLoaded = false;
                 m_rasterOverlayContainerUnloadedEvent.Signal();
+                m_cancellationToken.Cancel();
                 m_tileset.reset();
+                m_cancellationToken = HttpCancellationToken{};
             }
 
             switch (type)
@@ -97,15 +102,15 @@ namespace Cesium
             }
         }
 
-        Cesium3DTilesSelection::TilesetExternals CreateTilesetExternal(IOKind kind)
+        Cesium3DTilesSelection::TilesetExternals CreateTilesetExternal(IOKind kind, const TilesetRenderConfiguration& renderConfiguration)
         {
             // create render resources preparer if not exist
             AZ::Render::MeshFeatureProcessorInterface* meshFeatureProcessor =
                 AZ::RPI::Scene::GetFeatureProcessorForEntity<AZ::Render::MeshFeatureProcessorInterface>(m_selfEntity);
-            m_renderResourcesPreparer = std::make_shared<RenderResourcesPreparer>(meshFeatureProcessor);
+            m_renderResourcesPreparer = std::make_shared<RenderResourcesPreparer>(meshFeatureProcessor, renderConfiguration);
 
             return Cesium3DTilesSelection::TilesetExternals{
-                CesiumInterface::Get()->GetAssetAccessor(kind),
+                CesiumInterface::Get()->CreateCancellableAssetAccessor(kind, m_cancellationToken),
                 m_renderResourcesPreparer,
                 CesiumAsync::AsyncSystem(CesiumInterface::Get()->GetTaskProcessor()),
                 CesiumInterface::Get()->GetCreditSystem(),
@@ -120,7 +125,7 @@ namespace Cesium
                 return;
             }
 
-            Cesium3DTilesSelection::TilesetExternals externals = CreateTilesetExternal(IOKind::LocalFile);
+            Cesium3DTilesSelection::TilesetExternals externals = CreateTilesetExternal(IOKind::LocalFile, renderConfiguration);
             Cesium3DTilesSelection::TilesetOptions options;
             options.contentOptions.generateMissingNormalsSmooth = renderConfiguration.m_generateMissingNormalAsSmooth;
             m_tileset = AZStd::make_unique<Cesium3DTilesSelection::Tileset>(externals, source.m_filePath.c_str(), options);
@@ -133,7 +138,7 @@ namespace Cesium
                 return;
             }
 
-            Cesium3DTilesSelection::TilesetExternals externals = CreateTilesetExternal(IOKind::Http);
+            Cesium3DTilesSelection::TilesetExternals externals = CreateTilesetExternal(IOKind::Http, renderConfiguration);
             Cesium3DTilesSelection::TilesetOptions options;
             options.contentOptions.generateMissingNormalsSmooth = renderConfiguration.m_generateMissingNormalAsSmooth;
             m_tileset = AZStd::make_unique<Cesium3DTilesSelection::Tileset>(externals, source.m_url.c_str(), options);
@@ -146,7 +151,7 @@ namespace Cesium
                 return;
             }
 
-            Cesium3DTilesSelection::TilesetExternals externals = CreateTilesetExternal(IOKind::Http);
+            Cesium3DTilesSelection::TilesetExternals externals = CreateTilesetExternal(IOKind::Http, renderConfiguration);
             Cesium3DTilesSelection::TilesetOptions options;
             options.contentOptions.generateMissingNormalsSmooth = renderConfiguration.m_generateMissingNormalAsSmooth;
             m_tileset = AZStd::make_unique<Cesium3DTilesSelection::Tileset>(
@@ -265,6 +270,7 @@ namespace Cesium
         AZ::EntityId m_selfEntity;
         TilesetCameraConfigurations m_cameraConfigurations;
         std::shared_ptr<RenderResourcesPreparer> m_renderResourcesPreparer;
+        HttpCancellationToken m_cancellationToken;
         AZStd::unique_ptr<Cesium3DTilesSelection::Tileset> m_tileset;
         TilesetLoadedEvent m_tilesetLoadedEvent;
         RasterOverlayContainerLoadedEvent m_rasterOverlayContainerLoadedEvent;
@@ -476,6 +482,8 @@ namespace Cesium
 
             if (!viewStates.empty())
             {
+                m_impl->m_renderResourcesPreparer->SetViewportSize(viewStates.front().getViewportSize());
+
                 // check if the root is visible. If it's not, then we should remove all the cache
                 const auto rootTile = m_impl->m_tileset->getRootTile();
                 if (rootTile)
@@ -518,8 +526,12 @@ namespace Cesium
                     {
                         void* renderResources = tile->getRendererResources();
                         m_impl->m_renderResourcesPreparer->SetVisible(renderResources, true);
+                        m_impl->m_renderResourcesPreparer->UpdateScreenCoverage(*tile, viewStates);
                     }
                 }
+
+                m_impl->m_renderResourcesPreparer->UpdatePointBudget();
+                m_impl->m_renderResourcesPreparer->UpdateTextureStreaming();
             }
         }
     }
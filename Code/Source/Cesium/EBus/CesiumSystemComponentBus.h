@@ -1,11 +1,22 @@
 #pragma once
 
+#include "Cesium/Gltf/VertexCacheTelemetry.h"
+#include "Cesium/Systems/HttpTelemetry.h"
 #include <AzCore/Component/ComponentBus.h>
+#include <vector>
 
 namespace Cesium
 {
     class CesiumSystemRequest : public AZ::ComponentBus
     {
+    public:
+        // statistics of every host the gem has requested something from, e.g. to size the simultaneous tile loads of a tileset or
+        // to find slow servers. They are also printed by the cesium_DumpHttpStatistics console command
+        virtual std::vector<HttpHostStatistics> GetHttpHostStatistics() = 0;
+
+        // totals of the vertex cache optimizations of every primitive loaded so far. Also printed by the
+        // cesium_DumpVertexCacheStatistics console command
+        virtual VertexCacheStatistics GetVertexCacheStatistics() = 0;
     };
 
     class CesiumSystemRequestEBusTraits : public AZ::EBusTraits
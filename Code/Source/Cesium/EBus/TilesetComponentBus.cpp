@@ -38,16 +38,69 @@ namespace Cesium
     {
         if (auto serializeContext = azrtti_cast<AZ::SerializeContext*>(context))
         {
-            serializeContext->Class<TilesetRenderConfiguration>()->Version(0)->Field(
-                "GenerateMissingNormalAsSmooth", &TilesetRenderConfiguration::m_generateMissingNormalAsSmooth);
+            serializeContext->Class<TilesetRenderConfiguration>()
+                ->Version(10)
+                ->Field("GenerateMissingNormalAsSmooth", &TilesetRenderConfiguration::m_generateMissingNormalAsSmooth)
+                ->Field("PointCloudPointBudget", &TilesetRenderConfiguration::m_pointCloudPointBudget)
+                ->Field("PointCloudPointSize", &TilesetRenderConfiguration::m_pointCloudPointSize)
+                ->Field("PointCloudAttenuation", &TilesetRenderConfiguration::m_pointCloudAttenuation)
+                ->Field("PointCloudGeometricErrorScale", &TilesetRenderConfiguration::m_pointCloudGeometricErrorScale)
+                ->Field("PointCloudMaximumAttenuation", &TilesetRenderConfiguration::m_pointCloudMaximumAttenuation)
+                ->Field("OptimizeVertexCache", &TilesetRenderConfiguration::m_optimizeVertexCache)
+                ->Field(
+                    "VertexCacheOptimizationMinimumTriangleCount",
+                    &TilesetRenderConfiguration::m_vertexCacheOptimizationMinimumTriangleCount)
+                ->Field("TangentGenerationMode", &TilesetRenderConfiguration::m_tangentGenerationMode)
+                ->Field("CompressTextures", &TilesetRenderConfiguration::m_compressTextures)
+                ->Field("GenerateMipmaps", &TilesetRenderConfiguration::m_generateMipmaps)
+                ->Field("ShareTextures", &TilesetRenderConfiguration::m_shareTextures)
+                ->Field("PoolRasterOverlayTiles", &TilesetRenderConfiguration::m_poolRasterOverlayTiles)
+                ->Field("CompositeRasterOverlays", &TilesetRenderConfiguration::m_compositeRasterOverlays)
+                ->Field("StreamTexturesByScreenCoverage", &TilesetRenderConfiguration::m_streamTexturesByScreenCoverage)
+                ->Field("ReleaseDecodedImages", &TilesetRenderConfiguration::m_releaseDecodedImages);
         }
 
         if (auto behaviorContext = azrtti_cast<AZ::BehaviorContext*>(context))
         {
+            behaviorContext->Enum<static_cast<int>(TangentGenerationMode::MikkTSpace)>("TangentGenerationMode_MikkTSpace")
+                ->Enum<static_cast<int>(TangentGenerationMode::FastPerTriangle)>("TangentGenerationMode_FastPerTriangle")
+                ->Enum<static_cast<int>(TangentGenerationMode::FastAccumulated)>("TangentGenerationMode_FastAccumulated");
+
+            auto getTangentGenerationMode = [](TilesetRenderConfiguration* configuration)
+            {
+                return configuration->m_tangentGenerationMode;
+            };
+
+            auto setTangentGenerationMode = [](TilesetRenderConfiguration* configuration, int mode)
+            {
+                configuration->m_tangentGenerationMode = static_cast<TangentGenerationMode>(mode);
+            };
+
             behaviorContext->Class<TilesetRenderConfiguration>("TilesetRenderConfiguration")
                 ->Attribute(AZ::Script::Attributes::Category, "Cesium/3DTiles")
                 ->Property(
-                    "GenerateMissingNormalAsSmooth", BehaviorValueProperty(&TilesetRenderConfiguration::m_generateMissingNormalAsSmooth));
+                    "GenerateMissingNormalAsSmooth", BehaviorValueProperty(&TilesetRenderConfiguration::m_generateMissingNormalAsSmooth))
+                ->Property("PointCloudPointBudget", BehaviorValueProperty(&TilesetRenderConfiguration::m_pointCloudPointBudget))
+                ->Property("PointCloudPointSize", BehaviorValueProperty(&TilesetRenderConfiguration::m_pointCloudPointSize))
+                ->Property("PointCloudAttenuation", BehaviorValueProperty(&TilesetRenderConfiguration::m_pointCloudAttenuation))
+                ->Property(
+                    "PointCloudGeometricErrorScale", BehaviorValueProperty(&TilesetRenderConfiguration::m_pointCloudGeometricErrorScale))
+                ->Property(
+                    "PointCloudMaximumAttenuation", BehaviorValueProperty(&TilesetRenderConfiguration::m_pointCloudMaximumAttenuation))
+                ->Property("OptimizeVertexCache", BehaviorValueProperty(&TilesetRenderConfiguration::m_optimizeVertexCache))
+                ->Property(
+                    "VertexCacheOptimizationMinimumTriangleCount",
+                    BehaviorValueProperty(&TilesetRenderConfiguration::m_vertexCacheOptimizationMinimumTriangleCount))
+                ->Property("TangentGenerationMode", getTangentGenerationMode, setTangentGenerationMode)
+                ->Property("CompressTextures", BehaviorValueProperty(&TilesetRenderConfiguration::m_compressTextures))
+                ->Property("GenerateMipmaps", BehaviorValueProperty(&TilesetRenderConfiguration::m_generateMipmaps))
+                ->Property("ShareTextures", BehaviorValueProperty(&TilesetRenderConfiguration::m_shareTextures))
+                ->Property("PoolRasterOverlayTiles", BehaviorValueProperty(&TilesetRenderConfiguration::m_poolRasterOverlayTiles))
+                ->Property("CompositeRasterOverlays", BehaviorValueProperty(&TilesetRenderConfiguration::m_compositeRasterOverlays))
+                ->Property(
+                    "StreamTexturesByScreenCoverage",
+                    BehaviorValueProperty(&TilesetRenderConfiguration::m_streamTexturesByScreenCoverage))
+                ->Property("ReleaseDecodedImages", BehaviorValueProperty(&TilesetRenderConfiguration::m_releaseDecodedImages));
         }
     }
 
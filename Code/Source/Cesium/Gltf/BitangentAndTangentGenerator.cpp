@@ -1,8 +1,27 @@
 #include "Cesium/Gltf/BitangentAndTangentGenerator.h"
 #include <mikkelsen/mikktspace.h>
+#include <cmath>
 
 namespace Cesium
 {
+    namespace
+    {
+        glm::vec2 ToFloatUV(const glm::vec2& uv)
+        {
+            return uv;
+        }
+
+        glm::vec2 ToFloatUV(const glm::u8vec2& uv)
+        {
+            return glm::vec2(uv) / 255.0f;
+        }
+
+        glm::vec2 ToFloatUV(const glm::u16vec2& uv)
+        {
+            return glm::vec2(uv) / 65535.0f;
+        }
+    } // namespace
+
     struct BitangentAndTangentGenerator::MikktspaceCustomData
     {
         AZStd::span<glm::vec3> positions{};
@@ -224,4 +243,155 @@ namespace Cesium
         mikkContext.m_pUserData = &customData;
         return (genTangSpaceDefault(&mikkContext) == 0);
     }
+
+    bool BitangentAndTangentGenerator::GenerateFast(
+        const AZStd::span<glm::vec3>& positions,
+        const AZStd::span<glm::vec3>& normals,
+        const AZStd::span<glm::vec2>& uvs,
+        const AZStd::span<const std::uint32_t>& indices,
+        AZStd::vector<glm::vec4>& tangents,
+        AZStd::vector<glm::vec3>& bitangents)
+    {
+        return GenerateFastImpl(positions, normals, uvs, indices, tangents, bitangents);
+    }
+
+    bool BitangentAndTangentGenerator::GenerateFast(
+        const AZStd::span<glm::vec3>& positions,
+        const AZStd::span<glm::vec3>& normals,
+        const AZStd::span<glm::u8vec2>& uvs,
+        const AZStd::span<const std::uint32_t>& indices,
+        AZStd::vector<glm::vec4>& tangents,
+        AZStd::vector<glm::vec3>& bitangents)
+    {
+        return GenerateFastImpl(positions, normals, uvs, indices, tangents, bitangents);
+    }
+
+    bool BitangentAndTangentGenerator::GenerateFast(
+        const AZStd::span<glm::vec3>& positions,
+        const AZStd::span<glm::vec3>& normals,
+        const AZStd::span<glm::u16vec2>& uvs,
+        const AZStd::span<const std::uint32_t>& indices,
+        AZStd::vector<glm::vec4>& tangents,
+        AZStd::vector<glm::vec3>& bitangents)
+    {
+        return GenerateFastImpl(positions, normals, uvs, indices, tangents, bitangents);
+    }
+
+    template<typename UVType>
+    bool BitangentAndTangentGenerator::GenerateFastImpl(
+        const AZStd::span<glm::vec3>& positions,
+        const AZStd::span<glm::vec3>& normals,
+        const AZStd::span<UVType>& uvs,
+        const AZStd::span<const std::uint32_t>& indices,
+        AZStd::vector<glm::vec4>& tangents,
+        AZStd::vector<glm::vec3>& bitangents)
+    {
+        std::size_t vertexCount = positions.size();
+        if (normals.size() != vertexCount || uvs.size() != vertexCount)
+        {
+            return false;
+        }
+
+        // triangle tangents are summed up per vertex before they are orthonormalized
+        tangents.assign(vertexCount, glm::vec4(0.0f));
+        bitangents.assign(vertexCount, glm::vec3(0.0f));
+
+        glm::vec3 tangent;
+        glm::vec3 bitangent;
+        if (indices.empty())
+        {
+            if (vertexCount % 3 != 0)
+            {
+                return false;
+            }
+
+            for (std::size_t i = 0; i < vertexCount; i += 3)
+            {
+                ComputeTriangleTangent(
+                    positions[i], positions[i + 1], positions[i + 2], ToFloatUV(uvs[i]), ToFloatUV(uvs[i + 1]), ToFloatUV(uvs[i + 2]),
+                    tangent, bitangent);
+                for (std::size_t j = i; j < i + 3; ++j)
+                {
+                    tangents[j] = glm::vec4(tangent, 0.0f);
+                    bitangents[j] = bitangent;
+                }
+            }
+        }
+        else
+        {
+            if (indices.size() % 3 != 0)
+            {
+                return false;
+            }
+
+            for (std::size_t i = 0; i < indices.size(); i += 3)
+            {
+                std::uint32_t i0 = indices[i];
+                std::uint32_t i1 = indices[i + 1];
+                std::uint32_t i2 = indices[i + 2];
+                if (i0 >= vertexCount || i1 >= vertexCount || i2 >= vertexCount)
+                {
+                    return false;
+                }
+
+                ComputeTriangleTangent(
+                    positions[i0], positions[i1], positions[i2], ToFloatUV(uvs[i0]), ToFloatUV(uvs[i1]), ToFloatUV(uvs[i2]), tangent,
+                    bitangent);
+                tangents[i0] += glm::vec4(tangent, 0.0f);
+                tangents[i1] += glm::vec4(tangent, 0.0f);
+                tangents[i2] += glm::vec4(tangent, 0.0f);
+                bitangents[i0] += bitangent;
+                bitangents[i1] += bitangent;
+                bitangents[i2] += bitangent;
+            }
+        }
+
+        // Gram-Schmidt against the normal. The loop has no data dependent branches and only walks contiguous arrays,
+        // so it vectorizes well
+        for (std::size_t i = 0; i < vertexCount; ++i)
+        {
+            const glm::vec3& normal = normals[i];
+            glm::vec3 orthogonalTangent = glm::vec3(tangents[i]);
+            orthogonalTangent -= normal * glm::dot(normal, orthogonalTangent);
+            float lengthSquared = glm::dot(orthogonalTangent, orthogonalTangent);
+
+            // degenerate uvs leave no tangent, so use any direction perpendicular to the normal. Whichever is picked is normalized
+            // once, so the fallback costs no square root of its own
+            glm::vec3 axis = std::abs(normal.x) < 0.9f ? glm::vec3(1.0f, 0.0f, 0.0f) : glm::vec3(0.0f, 1.0f, 0.0f);
+            glm::vec3 fallbackTangent = glm::cross(glm::cross(normal, axis), normal);
+            bool degenerate = lengthSquared <= MINIMUM_TANGENT_LENGTH_SQUARED;
+            orthogonalTangent = degenerate ? fallbackTangent : orthogonalTangent;
+            lengthSquared = degenerate ? glm::dot(fallbackTangent, fallbackTangent) : lengthSquared;
+            orthogonalTangent /= std::sqrt(lengthSquared);
+
+            glm::vec3 orthogonalBitangent = glm::cross(normal, orthogonalTangent);
+            float sign = glm::dot(orthogonalBitangent, bitangents[i]) < 0.0f ? -1.0f : 1.0f;
+            tangents[i] = glm::vec4(orthogonalTangent, sign);
+            bitangents[i] = orthogonalBitangent * sign;
+        }
+
+        return true;
+    }
+
+    void BitangentAndTangentGenerator::ComputeTriangleTangent(
+        const glm::vec3& p0,
+        const glm::vec3& p1,
+        const glm::vec3& p2,
+        const glm::vec2& uv0,
+        const glm::vec2& uv1,
+        const glm::vec2& uv2,
+        glm::vec3& tangent,
+        glm::vec3& bitangent)
+    {
+        glm::vec3 edge1 = p1 - p0;
+        glm::vec3 edge2 = p2 - p0;
+        glm::vec2 deltaUV1 = uv1 - uv0;
+        glm::vec2 deltaUV2 = uv2 - uv0;
+
+        // triangles with degenerate uvs don't contribute to the accumulated tangents
+        float determinant = deltaUV1.x * deltaUV2.y - deltaUV2.x * deltaUV1.y;
+        float inverseDeterminant = std::abs(determinant) > MINIMUM_UV_DETERMINANT ? 1.0f / determinant : 0.0f;
+        tangent = (edge1 * deltaUV2.y - edge2 * deltaUV1.y) * inverseDeterminant;
+        bitangent = (edge2 * deltaUV1.x - edge1 * deltaUV2.x) * inverseDeterminant;
+    }
 } // namespace Cesium
@@ -3,6 +3,7 @@
 #include <AzCore/std/containers/span.h>
 #include <AzCore/std/containers/vector.h>
 #include <glm/glm.hpp>
+#include <cstdint>
 
 namespace Cesium
 {
@@ -30,7 +31,56 @@ namespace Cesium
             AZStd::vector<glm::vec4>& tangents,
             AZStd::vector<glm::vec3>& bitangents);
 
+        // Approximate tangents computed analytically per triangle. When indices is empty, the mesh is expected to be
+        // un-indexed and every vertex gets the tangent of its own triangle. Otherwise, the tangents of the triangles
+        // sharing a vertex are accumulated, so the mesh can stay indexed
+        static bool GenerateFast(
+            const AZStd::span<glm::vec3>& positions,
+            const AZStd::span<glm::vec3>& normals,
+            const AZStd::span<glm::vec2>& uvs,
+            const AZStd::span<const std::uint32_t>& indices,
+            AZStd::vector<glm::vec4>& tangents,
+            AZStd::vector<glm::vec3>& bitangents);
+
+        static bool GenerateFast(
+            const AZStd::span<glm::vec3>& positions,
+            const AZStd::span<glm::vec3>& normals,
+            const AZStd::span<glm::u8vec2>& unorm_uvs,
+            const AZStd::span<const std::uint32_t>& indices,
+            AZStd::vector<glm::vec4>& tangents,
+            AZStd::vector<glm::vec3>& bitangents);
+
+        static bool GenerateFast(
+            const AZStd::span<glm::vec3>& positions,
+            const AZStd::span<glm::vec3>& normals,
+            const AZStd::span<glm::u16vec2>& unorm_uvs,
+            const AZStd::span<const std::uint32_t>& indices,
+            AZStd::vector<glm::vec4>& tangents,
+            AZStd::vector<glm::vec3>& bitangents);
+
     private:
+        template<typename UVType>
+        static bool GenerateFastImpl(
+            const AZStd::span<glm::vec3>& positions,
+            const AZStd::span<glm::vec3>& normals,
+            const AZStd::span<UVType>& uvs,
+            const AZStd::span<const std::uint32_t>& indices,
+            AZStd::vector<glm::vec4>& tangents,
+            AZStd::vector<glm::vec3>& bitangents);
+
+        static void ComputeTriangleTangent(
+            const glm::vec3& p0,
+            const glm::vec3& p1,
+            const glm::vec3& p2,
+            const glm::vec2& uv0,
+            const glm::vec2& uv1,
+            const glm::vec2& uv2,
+            glm::vec3& tangent,
+            glm::vec3& bitangent);
+
+        static constexpr float MINIMUM_UV_DETERMINANT = 1e-20f;
+        static constexpr float MINIMUM_TANGENT_LENGTH_SQUARED = 1e-20f;
+
         struct MikktspaceCustomData;
 
         struct MikktspaceMethods;
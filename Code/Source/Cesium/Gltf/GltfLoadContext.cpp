@@ -28,12 +28,15 @@ namespace Cesium
     GltfLoadMaterial::GltfLoadMaterial()
         : m_materialAsset{}
         , m_needTangents{ false }
+        , m_needSecondUVSet{ false }
     {
     }
 
-    GltfLoadMaterial::GltfLoadMaterial(AZ::Data::Asset<AZ::RPI::MaterialAsset>&& materialAsset, bool needTangents)
+    GltfLoadMaterial::GltfLoadMaterial(
+        AZ::Data::Asset<AZ::RPI::MaterialAsset>&& materialAsset, bool needTangents, bool needSecondUVSet)
         : m_materialAsset{ std::move(materialAsset) }
         , m_needTangents{ needTangents }
+        , m_needSecondUVSet{ needSecondUVSet }
     {
     }
 
@@ -44,7 +47,7 @@ namespace Cesium
 
     GltfLoadPrimitive::GltfLoadPrimitive()
         : m_modelAsset{}
-        , m_materialId{ -1 }
+        , m_materialId{ INVALID_MATERIAL_ID }
     {
     }
 
@@ -75,4 +78,10 @@ namespace Cesium
     {
         return m_primitives.empty();
     }
+
+    GltfLoadModel::GltfLoadModel()
+        : m_pointCount{ 0 }
+        , m_pointSpacing{ 0.0 }
+    {
+    }
 } // namespace Cesium
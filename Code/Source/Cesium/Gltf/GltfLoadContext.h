@@ -16,6 +16,9 @@ namespace Cesium
     using TextureId = AZStd::string;
     using MaterialId = std::int32_t;
 
+    // primitives without a material and materials that are not created yet have this id
+    constexpr MaterialId INVALID_MATERIAL_ID = -1;
+
     struct GltfShaderVertexAttribute
     {
         GltfShaderVertexAttribute(
@@ -41,13 +44,14 @@ namespace Cesium
     {
         GltfLoadMaterial();
 
-        GltfLoadMaterial(AZ::Data::Asset<AZ::RPI::MaterialAsset>&& materialAsset, bool needTangents);
+        GltfLoadMaterial(AZ::Data::Asset<AZ::RPI::MaterialAsset>&& materialAsset, bool needTangents, bool needSecondUVSet);
 
         bool IsEmpty() const;
 
         AZ::Data::Asset<AZ::RPI::MaterialAsset> m_materialAsset;
         AZStd::map<AZStd::string, GltfShaderVertexAttribute> m_customVertexAttributes;
         bool m_needTangents;
+        bool m_needSecondUVSet;
     };
 
     struct GltfLoadPrimitive final
@@ -76,8 +80,15 @@ namespace Cesium
 
     struct GltfLoadModel final
     {
+        GltfLoadModel();
+
         AZStd::unordered_map<TextureId, GltfLoadTexture> m_textures;
         AZStd::vector<GltfLoadMaterial> m_materials;
         AZStd::vector<GltfLoadMesh> m_meshes;
+
+        // point cloud materials and stats. The materials need per tile properties which are only known in the main thread
+        AZStd::vector<MaterialId> m_pointMaterials;
+        std::uint64_t m_pointCount;
+        double m_pointSpacing;
     };
 } // namespace Cesium
@@ -0,0 +1,88 @@
+#include "Cesium/Gltf/GltfLoadScratchArena.h"
+#include "Cesium/Gltf/GltfPrimitiveBuilder.h"
+#include "Cesium/Gltf/GltfPointPrimitiveBuilder.h"
+#include <atomic>
+
+namespace Cesium
+{
+    namespace
+    {
+        struct ThreadArenaCache
+        {
+            std::uint64_t m_poolId{ 0 };
+            GltfLoadScratchArena* m_arena{ nullptr };
+        };
+
+        thread_local ThreadArenaCache t_threadArenaCache;
+
+        std::uint64_t GenerateScratchArenaPoolId()
+        {
+            static std::atomic_uint64_t nextPoolId = 1;
+            return nextPoolId.fetch_add(1, std::memory_order_relaxed);
+        }
+    } // namespace
+
+    GltfLoadScratchArena::GltfLoadScratchArena()
+        : m_trianglePrimitiveBuilder{ AZStd::make_unique<GltfTrianglePrimitiveBuilder>() }
+        , m_pointPrimitiveBuilder{ AZStd::make_unique<GltfPointPrimitiveBuilder>() }
+    {
+    }
+
+    GltfLoadScratchArena::~GltfLoadScratchArena() noexcept = default;
+
+    GltfTrianglePrimitiveBuilder& GltfLoadScratchArena::GetTrianglePrimitiveBuilder()
+    {
+        return *m_trianglePrimitiveBuilder;
+    }
+
+    GltfPointPrimitiveBuilder& GltfLoadScratchArena::GetPointPrimitiveBuilder()
+    {
+        return *m_pointPrimitiveBuilder;
+    }
+
+    AZStd::vector<std::byte>& GltfLoadScratchArena::GetScratchBuffer(GltfScratchBufferSlot slot, std::size_t byteSize)
+    {
+        AZStd::vector<std::byte>& buffer = m_scratchBuffers[static_cast<std::size_t>(slot)];
+        buffer.resize_no_construct(byteSize);
+        return buffer;
+    }
+
+    void GltfLoadScratchArena::Reset()
+    {
+        m_trianglePrimitiveBuilder->ReleaseScratchMemory(MAX_RETAINED_BYTES_PER_BUFFER);
+        m_pointPrimitiveBuilder->ReleaseScratchMemory(MAX_RETAINED_BYTES_PER_BUFFER);
+        for (auto& buffer : m_scratchBuffers)
+        {
+            if (buffer.capacity() > MAX_RETAINED_BYTES_PER_BUFFER)
+            {
+                AZStd::vector<std::byte>().swap(buffer);
+            }
+            else
+            {
+                buffer.clear();
+            }
+        }
+    }
+
+    GltfLoadScratchArenaPool::GltfLoadScratchArenaPool()
+        : m_poolId{ GenerateScratchArenaPoolId() }
+    {
+    }
+
+    GltfLoadScratchArenaPool::~GltfLoadScratchArenaPool() noexcept = default;
+
+    GltfLoadScratchArena& GltfLoadScratchArenaPool::GetThreadArena()
+    {
+        ThreadArenaCache& cache = t_threadArenaCache;
+        if (cache.m_poolId == m_poolId && cache.m_arena)
+        {
+            return *cache.m_arena;
+        }
+
+        AZStd::lock_guard<AZStd::mutex> lock(m_arenasMutex);
+        GltfLoadScratchArena* arena = m_arenas.emplace_back(AZStd::make_unique<GltfLoadScratchArena>()).get();
+        cache.m_poolId = m_poolId;
+        cache.m_arena = arena;
+        return *arena;
+    }
+} // namespace Cesium
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <AzCore/std/containers/array.h>
+#include <AzCore/std/containers/vector.h>
+#include <AzCore/std/parallel/mutex.h>
+#include <AzCore/std/smart_ptr/unique_ptr.h>
+#include <cstddef>
+#include <cstdint>
+
+namespace Cesium
+{
+    class GltfTrianglePrimitiveBuilder;
+    class GltfPointPrimitiveBuilder;
+
+    enum class GltfScratchBufferSlot
+    {
+        Primary,
+        Secondary,
+        MipChain,
+        BlockCompressed,
+        Count
+    };
+
+    // Scratch memory that the glTF load pipeline reuses across primitives and tiles. An arena is only ever used by one
+    // thread at a time, so nothing in here is synchronized.
+    class GltfLoadScratchArena final
+    {
+    public:
+        GltfLoadScratchArena();
+
+        ~GltfLoadScratchArena() noexcept;
+
+        GltfTrianglePrimitiveBuilder& GetTrianglePrimitiveBuilder();
+
+        GltfPointPrimitiveBuilder& GetPointPrimitiveBuilder();
+
+        AZStd::vector<std::byte>& GetScratchBuffer(GltfScratchBufferSlot slot, std::size_t byteSize);
+
+        void Reset();
+
+        // Buffers that grow past this size for an unusually large tile are released on Reset()
+        // instead of being kept around for the lifetime of the worker thread
+        static constexpr std::size_t MAX_RETAINED_BYTES_PER_BUFFER = 32 * 1024 * 1024;
+
+    private:
+        AZStd::unique_ptr<GltfTrianglePrimitiveBuilder> m_trianglePrimitiveBuilder;
+        AZStd::unique_ptr<GltfPointPrimitiveBuilder> m_pointPrimitiveBuilder;
+        AZStd::array<AZStd::vector<std::byte>, static_cast<std::size_t>(GltfScratchBufferSlot::Count)> m_scratchBuffers;
+    };
+
+    // Owns one scratch arena per thread that has loaded glTF content. Arenas are handed out through a thread local
+    // cache, so lookups after the first one for a thread don't take the lock.
+    class GltfLoadScratchArenaPool final
+    {
+    public:
+        GltfLoadScratchArenaPool();
+
+        GltfLoadScratchArenaPool(const GltfLoadScratchArenaPool&) = delete;
+
+        GltfLoadScratchArenaPool& operator=(const GltfLoadScratchArenaPool&) = delete;
+
+        ~GltfLoadScratchArenaPool() noexcept;
+
+        GltfLoadScratchArena& GetThreadArena();
+
+    private:
+        std::uint64_t m_poolId;
+        AZStd::mutex m_arenasMutex;
+        AZStd::vector<AZStd::unique_ptr<GltfLoadScratchArena>> m_arenas;
+    };
+} // namespace Cesium
@@ -1 +1,11 @@
 #include "Cesium/Gltf/GltfMaterialBuilder.h"
+
+namespace Cesium
+{
+    GltfMaterialBuilderOption::GltfMaterialBuilderOption()
+        : m_compressTextures{ false }
+        , m_generateMipmaps{ false }
+        , m_sharedTextureCache{ nullptr }
+    {
+    }
+} // namespace Cesium
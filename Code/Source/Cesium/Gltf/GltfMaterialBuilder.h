@@ -21,6 +21,19 @@ namespace AZ
 
 namespace Cesium
 {
+    class SharedTextureCache;
+
+    struct GltfMaterialBuilderOption final
+    {
+        GltfMaterialBuilderOption();
+
+        bool m_compressTextures;
+        bool m_generateMipmaps;
+
+        // when set, images are looked up in the cache of the tileset before they are created
+        SharedTextureCache* m_sharedTextureCache;
+    };
+
     class GltfMaterialBuilder
     {
     public:
@@ -33,6 +46,7 @@ namespace Cesium
         virtual void Create(
             const CesiumGltf::Model& model,
             const CesiumGltf::Material& material,
+            const GltfMaterialBuilderOption& option,
             AZStd::unordered_map<TextureId, GltfLoadTexture>& textureCache,
             GltfLoadMaterial& result) = 0;
     };
@@ -1,6 +1,9 @@
 #include "Cesium/Gltf/GltfModelBuilder.h"
 #include "Cesium/Gltf/GltfPrimitiveBuilder.h"
+#include "Cesium/Gltf/GltfPointPrimitiveBuilder.h"
 #include "Cesium/Gltf/GltfLoadContext.h"
+#include "Cesium/Gltf/GltfLoadScratchArena.h"
+#include "Cesium/Systems/CesiumSystem.h"
 #include "Cesium/Systems/GenericIOManager.h"
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/quaternion.hpp>
@@ -29,6 +32,9 @@ namespace Cesium
 {
     GltfModelBuilderOption::GltfModelBuilderOption(const glm::dmat4& transform)
         : m_transform{ transform }
+        , m_material{}
+        , m_trianglePrimitive{}
+        , m_pointCloud{}
     {
     }
 
@@ -46,7 +52,7 @@ namespace Cesium
         if (load.model)
         {
             AZStd::string parentPath = io.GetParentPath(filePath);
-            ResolveExternalImages(parentPath, reader, *load.model, io);
+            ResolveExternalImages(parentPath, *load.model, io);
             ResolveExternalBuffers(parentPath, *load.model, io);
 
             return Create(*load.model, option, result);
@@ -55,6 +61,11 @@ namespace Cesium
 
     void GltfModelBuilder::Create(const CesiumGltf::Model& model, const GltfModelBuilderOption& option, GltfLoadModel& result)
     {
+        m_materialOption = option.m_material;
+        m_trianglePrimitiveOption = option.m_trianglePrimitive;
+        m_pointCloudOption = option.m_pointCloud;
+        m_pointMaterials.clear();
+
         // Resize materials to be the same with gltf materials, so that we can use it as a cache.
         // It maybe wasteful when some gltfs has more materials than what are used in the its primitives.
         result.m_materials.resize(model.materials.size());
@@ -151,11 +162,19 @@ namespace Cesium
         const CesiumGltf::Model& model, std::size_t meshIndex, const glm::dmat4& transform, GltfLoadModel& result)
     {
         const CesiumGltf::Mesh& mesh = model.meshes[meshIndex];
-        GltfLoadMesh& gltfLoadMesh = result.m_meshes[meshIndex];
-        gltfLoadMesh.m_transform = transform;
-        gltfLoadMesh.m_primitives.reserve(mesh.primitives.size());
+        result.m_meshes[meshIndex].m_transform = transform;
+        result.m_meshes[meshIndex].m_primitives.reserve(mesh.primitives.size());
+        GltfTrianglePrimitiveBuilder& primitiveBuilder =
+            CesiumInterface::Get()->GetGltfLoadScratchArenaPool().GetThreadArena().GetTrianglePrimitiveBuilder();
         for (const CesiumGltf::MeshPrimitive& primitive : mesh.primitives)
         {
+            // points go to their own meshes, so don't hold a reference to result.m_meshes across this call
+            if (primitive.mode == CesiumGltf::MeshPrimitive::Mode::POINTS)
+            {
+                LoadPointPrimitive(model, primitive, transform, result);
+                continue;
+            }
+
             // create material asset
             const CesiumGltf::Material* material = model.getSafe<CesiumGltf::Material>(&model.materials, primitive.material);
             if (!material)
@@ -166,19 +185,60 @@ namespace Cesium
             GltfLoadMaterial& loadMaterial = result.m_materials[primitive.material];
             if (loadMaterial.IsEmpty())
             {
-                m_materialBuilder->Create(model, *material, result.m_textures, loadMaterial);
+                m_materialBuilder->Create(model, *material, m_materialOption, result.m_textures, loadMaterial);
             }
 
             // load primitive
-            GltfLoadPrimitive& loadPrimitive = gltfLoadMesh.m_primitives.emplace_back();
-            GltfTrianglePrimitiveBuilder primitiveBuilder;
-            primitiveBuilder.Create(model, primitive, loadMaterial, loadPrimitive);
+            GltfLoadPrimitive& loadPrimitive = result.m_meshes[meshIndex].m_primitives.emplace_back();
+            primitiveBuilder.Create(model, primitive, loadMaterial, m_trianglePrimitiveOption, loadPrimitive);
         }
     }
 
-    void GltfModelBuilder::ResolveExternalImages(
-        const AZStd::string& parentPath, const CesiumGltfReader::GltfReader& gltfReader, CesiumGltf::Model& model, GenericIOManager& io)
+    void GltfModelBuilder::LoadPointPrimitive(
+        const CesiumGltf::Model& model, const CesiumGltf::MeshPrimitive& primitive, const glm::dmat4& transform, GltfLoadModel& result)
     {
+        std::uint64_t maximumPointCount = m_pointCloudOption.m_maximumPointCount > result.m_pointCount
+            ? m_pointCloudOption.m_maximumPointCount - result.m_pointCount
+            : 0;
+        if (maximumPointCount == 0)
+        {
+            return;
+        }
+
+        // point materials are appended after the gltf materials and shared by the primitives using the same gltf material
+        MaterialId pointMaterialId = INVALID_MATERIAL_ID;
+        auto pointMaterialIt = m_pointMaterials.find(primitive.material);
+        if (pointMaterialIt == m_pointMaterials.end())
+        {
+            const CesiumGltf::Material* material = model.getSafe<CesiumGltf::Material>(&model.materials, primitive.material);
+            pointMaterialId = static_cast<MaterialId>(result.m_materials.size());
+            m_pointMaterialBuilder.Create(material, m_pointCloudOption, result.m_materials.emplace_back());
+            m_pointMaterials.emplace(primitive.material, pointMaterialId);
+            result.m_pointMaterials.emplace_back(pointMaterialId);
+        }
+        else
+        {
+            pointMaterialId = pointMaterialIt->second;
+        }
+
+        GltfPointPrimitiveBuilder& pointBuilder =
+            CesiumInterface::Get()->GetGltfLoadScratchArenaPool().GetThreadArena().GetPointPrimitiveBuilder();
+        GltfLoadMesh pointMesh;
+        std::uint64_t pointCount = pointBuilder.Create(
+            model, primitive, result.m_materials[pointMaterialId], pointMaterialId, transform, maximumPointCount, pointMesh);
+        if (pointCount == 0)
+        {
+            return;
+        }
+
+        result.m_pointCount += pointCount;
+        result.m_pointSpacing = AZStd::max(result.m_pointSpacing, pointBuilder.GetPointSpacing());
+        result.m_meshes.emplace_back(std::move(pointMesh));
+    }
+
+    void GltfModelBuilder::ResolveExternalImages(const AZStd::string& parentPath, CesiumGltf::Model& model, GenericIOManager& io)
+    {
+        ImageDecoderRegistry& imageDecoderRegistry = CesiumInterface::Get()->GetImageDecoderRegistry();
         for (CesiumGltf::Image& image : model.images)
         {
             if (!image.cesium.pixelData.empty())
@@ -201,13 +261,8 @@ namespace Cesium
                 continue;
             }
 
-            auto readResult = gltfReader.readImage(gsl::span<const std::byte>(content.data(), content.size()));
-            if (!readResult.image)
-            {
-                continue;
-            }
-
-            image.cesium = std::move(*readResult.image);
+            // textures are used at full resolution, and whether they are sRGB is only known once materials are built
+            imageDecoderRegistry.Decode(gsl::span<const std::byte>(content.data(), content.size()), ImageDecodeOption{}, image.cesium);
         }
     }
 
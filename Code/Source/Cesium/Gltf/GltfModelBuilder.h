@@ -1,8 +1,11 @@
 #pragma once
 
 #include "Cesium/Gltf/GltfMaterialBuilder.h"
+#include "Cesium/Gltf/GltfPointMaterialBuilder.h"
+#include "Cesium/Gltf/GltfPrimitiveBuilder.h"
 #include <AzCore/std/string/string.h>
 #include <AzCore/std/smart_ptr/unique_ptr.h>
+#include <AzCore/std/containers/unordered_map.h>
 #include <glm/glm.hpp>
 #include <vector>
 #include <cstdint>
@@ -12,23 +15,21 @@ namespace CesiumGltf
     struct Model;
     struct Scene;
     struct Node;
+    struct MeshPrimitive;
 } // namespace CesiumGltf
 
-namespace CesiumGltfReader
-{
-    class GltfReader;
-}
-
 namespace Cesium
 {
     class GenericIOManager;
-    struct GltfLoadModel;
 
     struct GltfModelBuilderOption
     {
         GltfModelBuilderOption(const glm::dmat4& transform);
 
         glm::dmat4 m_transform;
+        GltfMaterialBuilderOption m_material;
+        GltfTrianglePrimitiveBuilderOption m_trianglePrimitive;
+        GltfPointCloudOption m_pointCloud;
     };
 
     class GltfModelBuilder
@@ -49,11 +50,10 @@ namespace Cesium
 
         void LoadMesh(const CesiumGltf::Model& model, std::size_t meshIndex, const glm::dmat4& transform, GltfLoadModel& loadModel);
 
-        void ResolveExternalImages(
-            const AZStd::string& parentPath,
-            const CesiumGltfReader::GltfReader& gltfReader,
-            CesiumGltf::Model& model,
-            GenericIOManager& io);
+        void LoadPointPrimitive(
+            const CesiumGltf::Model& model, const CesiumGltf::MeshPrimitive& primitive, const glm::dmat4& transform, GltfLoadModel& result);
+
+        void ResolveExternalImages(const AZStd::string& parentPath, CesiumGltf::Model& model, GenericIOManager& io);
 
         void ResolveExternalBuffers(const AZStd::string& parentPath, CesiumGltf::Model& model, GenericIOManager& io);
 
@@ -63,5 +63,10 @@ namespace Cesium
             glm::dmat4(1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 0.0, 0.0, -1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 1.0);
 
         AZStd::unique_ptr<GltfMaterialBuilder> m_materialBuilder;
+        GltfPointMaterialBuilder m_pointMaterialBuilder;
+        GltfMaterialBuilderOption m_materialOption;
+        GltfTrianglePrimitiveBuilderOption m_trianglePrimitiveOption;
+        GltfPointCloudOption m_pointCloudOption;
+        AZStd::unordered_map<MaterialId, MaterialId> m_pointMaterials;
     };
 } // namespace Cesium
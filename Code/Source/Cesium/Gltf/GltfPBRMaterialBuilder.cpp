@@ -1,11 +1,15 @@
 #include "Cesium/Gltf/GltfPBRMaterialBuilder.h"
+#include "Cesium/Gltf/GltfLoadScratchArena.h"
+#include "Cesium/Gltf/StreamingImageBuilder.h"
+#include "Cesium/Gltf/PixelFormatConverter.h"
+#include "Cesium/Gltf/SharedTextureCache.h"
 #include "Cesium/Systems/CesiumSystem.h"
 #include "Cesium/Systems/CriticalAssetManager.h"
 #include <Atom/RPI.Reflect/Material/MaterialAssetCreator.h>
 #include <Atom/RPI.Reflect/Material/MaterialAsset.h>
+#include <Atom/RPI.Reflect/Material/ShaderCollection.h>
 #include <Atom/RPI.Reflect/Image/StreamingImageAsset.h>
-#include <Atom/RPI.Reflect/Image/StreamingImageAssetCreator.h>
-#include <Atom/RPI.Reflect/Image/ImageMipChainAssetCreator.h>
+#include <Atom/RPI.Reflect/Shader/ShaderAsset.h>
 
 // Window 10 wingdi.h header defines OPAQUE macro which mess up with CesiumGltf::Material::AlphaMode::OPAQUE.
 // This only happens with unity build
@@ -34,9 +38,12 @@ namespace Cesium
     void GltfPBRMaterialBuilder::Create(
         const CesiumGltf::Model& model,
         const CesiumGltf::Material& material,
+        const GltfMaterialBuilderOption& option,
         AZStd::unordered_map<TextureId, GltfLoadTexture>& textureCache,
         GltfLoadMaterial& result)
     {
+        m_option = option;
+
         // Create material asset
         AZ::Data::Asset<AZ::RPI::MaterialTypeAsset> materialTypeAsset;
         if (m_overrideMaterialTypeAsset)
@@ -62,7 +69,67 @@ namespace Cesium
 
         // populate result
         result.m_materialAsset = std::move(standardPBRMaterialAsset);
-        result.m_needTangents = false; // We don't load normal texture, so no need for tangents vertices for now
+        // We don't load normal texture, so tangents are only sent when the material type can't run without them.
+        // Stock StandardPBR requires every stream, while the gem's GltfStandardPBR marks them optional
+        result.m_needTangents = IsVertexStreamRequired(materialTypeAsset, AZ::RHI::ShaderSemantic("TANGENT")) ||
+            IsVertexStreamRequired(materialTypeAsset, AZ::RHI::ShaderSemantic("BITANGENT"));
+        result.m_needSecondUVSet =
+            IsVertexStreamRequired(materialTypeAsset, AZ::RHI::ShaderSemantic("UV", 1)) || IsSecondUVSetUsed(material);
+    }
+
+    bool GltfPBRMaterialBuilder::IsVertexStreamRequired(
+        const AZ::Data::Asset<AZ::RPI::MaterialTypeAsset>& materialType, const AZ::RHI::ShaderSemantic& semantic)
+    {
+        // without shaders to look at, assume the stream is required, since a missing stream fails the draw item validation
+        if (!materialType.IsReady())
+        {
+            return true;
+        }
+
+        for (const auto& shaderItem : materialType->GetShaderCollection())
+        {
+            const AZ::Data::Asset<AZ::RPI::ShaderAsset>& shaderAsset = shaderItem.GetShaderAsset();
+            if (!shaderAsset.IsReady())
+            {
+                return true;
+            }
+
+            for (const auto& streamChannel : shaderAsset->GetInputContract().m_streamChannels)
+            {
+                if (streamChannel.m_semantic == semantic && !streamChannel.m_isOptional)
+                {
+                    return true;
+                }
+            }
+        }
+
+        return false;
+    }
+
+    bool GltfPBRMaterialBuilder::IsSecondUVSetUsed(const CesiumGltf::Material& material)
+    {
+        // only the textures that are loaded count. Normal textures are not loaded yet
+        if (material.pbrMetallicRoughness)
+        {
+            const auto& baseColorTexture = material.pbrMetallicRoughness->baseColorTexture;
+            if (baseColorTexture && baseColorTexture->texCoord == 1)
+            {
+                return true;
+            }
+
+            const auto& metallicRoughnessTexture = material.pbrMetallicRoughness->metallicRoughnessTexture;
+            if (metallicRoughnessTexture && metallicRoughnessTexture->texCoord == 1)
+            {
+                return true;
+            }
+        }
+
+        if (material.emissiveTexture && material.emissiveTexture->texCoord == 1)
+        {
+            return true;
+        }
+
+        return material.occlusionTexture && material.occlusionTexture->texCoord == 1;
     }
 
     void GltfPBRMaterialBuilder::ConfigurePbrMetallicRoughness(
@@ -293,20 +360,17 @@ namespace Cesium
         // Do the fast path. Copy the whole data over
         if (imageData.channels == 1)
         {
-            newImage = Create2DImage(imageData.pixelData.data(), imageData.pixelData.size(), width, height, AZ::RHI::Format::R8_UNORM);
+            newImage = Create2DImage(imageData.pixelData.data(), width, height, 1, false);
         }
         else
         {
             // Just copy the red channel
-            std::size_t j = 0;
-            AZStd::vector<std::byte> pixels(width * height);
-            for (std::size_t i = 0; i < imageData.pixelData.size(); i += imageData.channels * imageData.bytesPerChannel)
-            {
-                pixels[j] = imageData.pixelData[i];
-                ++j;
-            }
+            GltfLoadScratchArena& scratchArena = CesiumInterface::Get()->GetGltfLoadScratchArenaPool().GetThreadArena();
+            AZStd::vector<std::byte>& pixels = scratchArena.GetScratchBuffer(GltfScratchBufferSlot::Primary, width * height);
+            PixelFormatConverter::ExtractChannel(
+                imageData.pixelData.data(), pixels.size(), static_cast<std::uint32_t>(imageData.channels), 0, pixels.data());
 
-            newImage = Create2DImage(pixels.data(), pixels.size(), width, height, AZ::RHI::Format::R8_UNORM);
+            newImage = Create2DImage(pixels.data(), width, height, 1, false);
         }
 
         auto cache = textureCache.insert({ imageSourceIdx, std::move(newImage) });
@@ -358,21 +422,15 @@ namespace Cesium
 
         if (imageData.channels == 3)
         {
-            AZStd::vector<std::byte> pixels(width * height * 4);
-            for (std::size_t i = 0; i < imageData.pixelData.size(); i += 3)
-            {
-                pixels[i] = imageData.pixelData[i];
-                pixels[i + 1] = imageData.pixelData[i + 1];
-                pixels[i + 2] = imageData.pixelData[i + 2];
-                pixels[i + 3] = static_cast<std::byte>(255);
-            }
+            GltfLoadScratchArena& scratchArena = CesiumInterface::Get()->GetGltfLoadScratchArenaPool().GetThreadArena();
+            AZStd::vector<std::byte>& pixels = scratchArena.GetScratchBuffer(GltfScratchBufferSlot::Primary, width * height * 4);
+            PixelFormatConverter::ExpandRGBToRGBA(imageData.pixelData.data(), width * height, pixels.data());
 
-            newImage = Create2DImage(pixels.data(), pixels.size(), width, height, AZ::RHI::Format::R8G8B8A8_UNORM_SRGB);
+            newImage = Create2DImage(pixels.data(), width, height, 4, true);
         }
         else
         {
-            newImage =
-                Create2DImage(imageData.pixelData.data(), imageData.pixelData.size(), width, height, AZ::RHI::Format::R8G8B8A8_UNORM_SRGB);
+            newImage = Create2DImage(imageData.pixelData.data(), width, height, 4, true);
         }
 
         auto cache = textureCache.insert({ imageSourceIdx, std::move(newImage) });
@@ -432,56 +490,32 @@ namespace Cesium
             return;
         }
 
-        std::size_t j = 0;
-        AZStd::vector<std::byte> metallicPixels(width * height);
-        AZStd::vector<std::byte> roughnessPixels(width * height);
-        for (std::size_t i = 0; i < imageData.pixelData.size(); i += imageData.channels * imageData.bytesPerChannel)
-        {
-            roughnessPixels[j] = imageData.pixelData[i + 1];
-            metallicPixels[j] = imageData.pixelData[i + 2];
-            ++j;
-        }
+        GltfLoadScratchArena& scratchArena = CesiumInterface::Get()->GetGltfLoadScratchArenaPool().GetThreadArena();
+        AZStd::vector<std::byte>& metallicPixels = scratchArena.GetScratchBuffer(GltfScratchBufferSlot::Primary, width * height);
+        AZStd::vector<std::byte>& roughnessPixels = scratchArena.GetScratchBuffer(GltfScratchBufferSlot::Secondary, width * height);
+        std::uint32_t channels = static_cast<std::uint32_t>(imageData.channels);
+        PixelFormatConverter::ExtractChannel(imageData.pixelData.data(), roughnessPixels.size(), channels, 1, roughnessPixels.data());
+        PixelFormatConverter::ExtractChannel(imageData.pixelData.data(), metallicPixels.size(), channels, 2, metallicPixels.data());
 
-        auto metallicCache = textureCache.insert(
-            { metallicImageIdx, Create2DImage(metallicPixels.data(), metallicPixels.size(), width, height, AZ::RHI::Format::R8_UNORM) });
-        auto roughnessCache = textureCache.insert(
-            { roughnessImageIdx, Create2DImage(roughnessPixels.data(), roughnessPixels.size(), width, height, AZ::RHI::Format::R8_UNORM) });
+        auto metallicCache = textureCache.insert({ metallicImageIdx, Create2DImage(metallicPixels.data(), width, height, 1, false) });
+        auto roughnessCache = textureCache.insert({ roughnessImageIdx, Create2DImage(roughnessPixels.data(), width, height, 1, false) });
         metallic = metallicCache.first->second.m_imageAsset;
         roughness = roughnessCache.first->second.m_imageAsset;
     }
 
     AZ::Data::Asset<AZ::RPI::StreamingImageAsset> GltfPBRMaterialBuilder::Create2DImage(
-        const std::byte* pixelData, std::size_t bytesPerImage, std::uint32_t width, std::uint32_t height, AZ::RHI::Format format)
+        const std::byte* pixelData, std::uint32_t width, std::uint32_t height, std::uint32_t channelCount, bool srgb) const
     {
-        // image has 4 channels, so we just copy the data over
-        AZ::RHI::ImageDescriptor imageDesc;
-        imageDesc.m_bindFlags = AZ::RHI::ImageBindFlags::ShaderRead;
-        imageDesc.m_dimension = AZ::RHI::ImageDimension::Image2D;
-        imageDesc.m_size = AZ::RHI::Size(width, height, 1);
-        imageDesc.m_format = format;
-
-        AZ::RHI::ImageSubresourceLayout imageSubresourceLayout = AZ::RHI::GetImageSubresourceLayout(imageDesc, AZ::RHI::ImageSubresource{});
-
-        // Create mip chain
-        AZ::Data::AssetId imageMipChainAssetId = CesiumInterface::Get()->GetCriticalAssetManager().GenerateRandomAssetId();
-        AZ::RPI::ImageMipChainAssetCreator mipChainCreator;
-        mipChainCreator.Begin(imageMipChainAssetId, 1, 1);
-        mipChainCreator.BeginMip(imageSubresourceLayout);
-        mipChainCreator.AddSubImage(pixelData, bytesPerImage);
-        mipChainCreator.EndMip();
-        AZ::Data::Asset<AZ::RPI::ImageMipChainAsset> mipChainAsset;
-        mipChainCreator.End(mipChainAsset);
-
-        // Create streaming image
-        AZ::Data::AssetId imageAssetId = CesiumInterface::Get()->GetCriticalAssetManager().GenerateRandomAssetId();
-        AZ::RPI::StreamingImageAssetCreator imageCreator;
-        imageCreator.Begin(imageAssetId);
-        imageCreator.SetImageDescriptor(imageDesc);
-        imageCreator.AddMipChainAsset(*mipChainAsset);
-        AZ::Data::Asset<AZ::RPI::StreamingImageAsset> imageAsset;
-        imageCreator.End(imageAsset);
-
-        return imageAsset;
+        StreamingImageBuilderOption option;
+        option.m_srgb = srgb;
+        option.m_generateMipmaps = m_option.m_generateMipmaps;
+        option.m_compress = m_option.m_compressTextures;
+        if (m_option.m_sharedTextureCache)
+        {
+            return m_option.m_sharedTextureCache->GetOrCreate(pixelData, width, height, channelCount, option);
+        }
+
+        return StreamingImageBuilder::Create(pixelData, width, height, channelCount, option);
     }
 } // namespace Cesium
 
@@ -2,6 +2,7 @@
 
 #include "Cesium/Gltf/GltfMaterialBuilder.h"
 #include "Cesium/Gltf/GltfLoadContext.h"
+#include <Atom/RHI.Reflect/ShaderSemantic.h>
 #include <Atom/RPI.Reflect/Material/MaterialTypeAsset.h>
 #include <AzCore/Asset/AssetCommon.h>
 #include <AzCore/std/containers/unordered_map.h>
@@ -37,6 +38,7 @@ namespace Cesium
         void Create(
             const CesiumGltf::Model& model,
             const CesiumGltf::Material& material,
+            const GltfMaterialBuilderOption& option,
             AZStd::unordered_map<TextureId, GltfLoadTexture>& textureCache,
             GltfLoadMaterial& result) override;
 
@@ -75,8 +77,15 @@ namespace Cesium
             TextureCache& textureCache);
 
         AZ::Data::Asset<AZ::RPI::StreamingImageAsset> Create2DImage(
-            const std::byte* pixelData, std::size_t bytesPerImage, std::uint32_t width, std::uint32_t height, AZ::RHI::Format format);
+            const std::byte* pixelData, std::uint32_t width, std::uint32_t height, std::uint32_t channelCount, bool srgb) const;
 
+        static bool IsSecondUVSetUsed(const CesiumGltf::Material& material);
+
+        // checks the input contract of every shader of the material type, so each material type is paired with the streams it needs
+        static bool IsVertexStreamRequired(
+            const AZ::Data::Asset<AZ::RPI::MaterialTypeAsset>& materialType, const AZ::RHI::ShaderSemantic& semantic);
+
+        GltfMaterialBuilderOption m_option;
         AZ::Data::Asset<AZ::RPI::MaterialTypeAsset> m_overrideMaterialTypeAsset;
 
         static constexpr const char* const MATERIALS_UNLIT_EXTENSION = "KHR_materials_unlit";
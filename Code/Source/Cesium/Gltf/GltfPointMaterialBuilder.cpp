@@ -0,0 +1,61 @@
+#include "Cesium/Gltf/GltfPointMaterialBuilder.h"
+#include "Cesium/Systems/CesiumSystem.h"
+#include "Cesium/Systems/CriticalAssetManager.h"
+#include <Atom/RPI.Reflect/Material/MaterialAssetCreator.h>
+#include <Atom/RPI.Reflect/Material/MaterialAsset.h>
+#include <AzCore/std/limits.h>
+
+// Window 10 wingdi.h header defines OPAQUE macro which mess up with CesiumGltf::Material::AlphaMode::OPAQUE.
+// This only happens with unity build
+#include <AzCore/PlatformDef.h>
+#ifdef AZ_COMPILER_MSVC
+#pragma push_macro("OPAQUE")
+#undef OPAQUE
+#endif
+
+#include <CesiumGltf/Material.h>
+
+#ifdef AZ_COMPILER_MSVC
+#pragma pop_macro("OPAQUE")
+#endif
+
+namespace Cesium
+{
+    GltfPointCloudOption::GltfPointCloudOption()
+        : m_maximumPointCount{ AZStd::numeric_limits<std::uint64_t>::max() }
+        , m_pointSize{ 2.0f }
+        , m_attenuation{ false }
+        , m_maximumAttenuation{ 8.0f }
+    {
+    }
+
+    void GltfPointMaterialBuilder::Create(
+        const CesiumGltf::Material* material, const GltfPointCloudOption& option, GltfLoadMaterial& result)
+    {
+        AZ::Data::AssetId materialAssetId = CesiumInterface::Get()->GetCriticalAssetManager().GenerateRandomAssetId();
+        AZ::RPI::MaterialAssetCreator materialCreator;
+        materialCreator.Begin(materialAssetId, CesiumInterface::Get()->GetCriticalAssetManager().m_pointCloudMaterialType);
+
+        // points are unlit, so only the base color factor of the gltf material is relevant
+        if (material && material->pbrMetallicRoughness && material->pbrMetallicRoughness->baseColorFactor.size() == 4)
+        {
+            const std::vector<double>& baseColorFactor = material->pbrMetallicRoughness->baseColorFactor;
+            materialCreator.SetPropertyValue(
+                AZ::Name("pointCloud.baseColor"),
+                AZ::Color(
+                    static_cast<float>(baseColorFactor[0]), static_cast<float>(baseColorFactor[1]), static_cast<float>(baseColorFactor[2]),
+                    static_cast<float>(baseColorFactor[3])));
+        }
+
+        materialCreator.SetPropertyValue(AZ::Name("pointCloud.pointSize"), option.m_pointSize);
+        materialCreator.SetPropertyValue(AZ::Name("pointCloud.attenuation"), option.m_attenuation);
+        materialCreator.SetPropertyValue(AZ::Name("pointCloud.maximumAttenuation"), option.m_maximumAttenuation);
+
+        AZ::Data::Asset<AZ::RPI::MaterialAsset> pointMaterialAsset;
+        materialCreator.End(pointMaterialAsset);
+
+        result.m_materialAsset = std::move(pointMaterialAsset);
+        result.m_needTangents = false;
+        result.m_needSecondUVSet = false;
+    }
+} // namespace Cesium
@@ -0,0 +1,31 @@
+#pragma once
+
+#include "Cesium/Gltf/GltfLoadContext.h"
+#include <cstdint>
+
+namespace CesiumGltf
+{
+    struct Material;
+} // namespace CesiumGltf
+
+namespace Cesium
+{
+    struct GltfPointCloudOption final
+    {
+        GltfPointCloudOption();
+
+        std::uint64_t m_maximumPointCount;
+        float m_pointSize;
+        bool m_attenuation;
+        float m_maximumAttenuation;
+    };
+
+    class GltfPointMaterialBuilder final
+    {
+    public:
+        void Create(const CesiumGltf::Material* material, const GltfPointCloudOption& option, GltfLoadMaterial& result);
+
+        static constexpr const char* const GEOMETRIC_ERROR_PROPERTY = "pointCloud.geometricError";
+        static constexpr const char* const VIEWPORT_SIZE_PROPERTY = "pointCloud.viewportSize";
+    };
+} // namespace Cesium
@@ -0,0 +1,358 @@
+#include "Cesium/Gltf/GltfPointPrimitiveBuilder.h"
+#include "Cesium/Systems/CesiumSystem.h"
+#include "Cesium/Systems/CriticalAssetManager.h"
+#include "Cesium/Math/MathHelper.h"
+#include <Atom/RPI.Reflect/Model/ModelAsset.h>
+#include <Atom/RPI.Reflect/Buffer/BufferAsset.h>
+#include <Atom/RPI.Reflect/Model/ModelLodAsset.h>
+#include <Atom/RPI.Reflect/Buffer/BufferAssetCreator.h>
+#include <Atom/RPI.Reflect/Model/ModelLodAssetCreator.h>
+#include <Atom/RPI.Reflect/Model/ModelAssetCreator.h>
+#include <AzCore/Asset/AssetCommon.h>
+#include <AzCore/std/limits.h>
+#include <glm/gtc/matrix_transform.hpp>
+
+// Window 10 wingdi.h header defines OPAQUE macro which mess up with CesiumGltf::Material::AlphaMode::OPAQUE.
+// This only happens with unity build
+#include <AzCore/PlatformDef.h>
+#ifdef AZ_COMPILER_MSVC
+#pragma push_macro("OPAQUE")
+#undef OPAQUE
+#endif
+
+#include <CesiumGltf/Model.h>
+#include <CesiumGltf/MeshPrimitive.h>
+#include <CesiumGltf/AccessorView.h>
+
+#ifdef AZ_COMPILER_MSVC
+#pragma pop_macro("OPAQUE")
+#endif
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <type_traits>
+
+namespace Cesium
+{
+    GltfPointPrimitiveBuilder::GltfPointPrimitiveBuilder()
+        : m_pointSpacing{ 0.0 }
+    {
+    }
+
+    std::uint64_t GltfPointPrimitiveBuilder::Create(
+        const CesiumGltf::Model& model,
+        const CesiumGltf::MeshPrimitive& primitive,
+        const GltfLoadMaterial& material,
+        MaterialId materialId,
+        const glm::dmat4& transform,
+        std::uint64_t maximumPointCount,
+        GltfLoadMesh& result)
+    {
+        m_pointSpacing = 0.0;
+        m_pointIndices.clear();
+        m_positions.clear();
+        m_colors.clear();
+        m_buffer.clear();
+
+        auto positionAttribute = primitive.attributes.find("POSITION");
+        if (positionAttribute == primitive.attributes.end())
+        {
+            return 0;
+        }
+
+        CesiumGltf::AccessorView<glm::vec3> positions{ model, positionAttribute->second };
+        if (positions.status() != CesiumGltf::AccessorViewStatus::Valid || positions.size() == 0)
+        {
+            return 0;
+        }
+
+        // decimate the points uniformly if the primitive doesn't fit in the budget
+        std::uint64_t pointCount = static_cast<std::uint64_t>(positions.size());
+        std::uint64_t keptPointCount = AZStd::min(pointCount, maximumPointCount);
+        if (keptPointCount == 0)
+        {
+            return 0;
+        }
+
+        m_pointIndices.resize(static_cast<std::size_t>(keptPointCount));
+        for (std::size_t i = 0; i < m_pointIndices.size(); ++i)
+        {
+            m_pointIndices[i] = static_cast<std::int64_t>(static_cast<double>(i) * static_cast<double>(pointCount) / keptPointCount);
+        }
+
+        // quantize positions inside the bounding box of the kept points
+        glm::dvec3 min{ AZStd::numeric_limits<double>::max() };
+        glm::dvec3 max{ AZStd::numeric_limits<double>::lowest() };
+        for (std::int64_t pointIndex : m_pointIndices)
+        {
+            glm::dvec3 position{ positions[pointIndex] };
+            min = glm::min(min, position);
+            max = glm::max(max, position);
+        }
+
+        glm::dvec3 extent = glm::max(max - min, glm::dvec3(MINIMUM_QUANTIZED_EXTENT));
+        glm::dvec3 quantizedScale = glm::dvec3(AZStd::numeric_limits<std::uint16_t>::max()) / extent;
+        m_positions.resize(m_pointIndices.size() * VERTICES_PER_POINT);
+        for (std::size_t i = 0; i < m_pointIndices.size(); ++i)
+        {
+            glm::dvec3 quantized = glm::round((glm::dvec3(positions[m_pointIndices[i]]) - min) * quantizedScale);
+            quantized = glm::clamp(quantized, glm::dvec3(0.0), glm::dvec3(AZStd::numeric_limits<std::uint16_t>::max()));
+            for (std::uint32_t corner = 0; corner < VERTICES_PER_POINT; ++corner)
+            {
+                m_positions[i * VERTICES_PER_POINT + corner] = glm::u16vec4(
+                    static_cast<std::uint16_t>(quantized.x), static_cast<std::uint16_t>(quantized.y),
+                    static_cast<std::uint16_t>(quantized.z),
+                    static_cast<std::uint16_t>(corner * AZStd::numeric_limits<std::uint16_t>::max() / (VERTICES_PER_POINT - 1)));
+            }
+        }
+
+        if (!CreateColors(model, primitive, positions.size()))
+        {
+            m_colors.resize(m_positions.size(), glm::u8vec4(255));
+        }
+
+        // estimate the spacing between points. Scans are often flat, so fall back to the area of the two largest axes
+        glm::dvec3 bounds = max - min;
+        double volume = bounds.x * bounds.y * bounds.z;
+        if (volume > 0.0)
+        {
+            m_pointSpacing = std::cbrt(volume / static_cast<double>(keptPointCount));
+        }
+        else
+        {
+            double area = AZStd::max(bounds.x * bounds.y, AZStd::max(bounds.x * bounds.z, bounds.y * bounds.z));
+            m_pointSpacing = std::sqrt(area / static_cast<double>(keptPointCount));
+        }
+
+        // calculate layout of the buffer. 16 bits indices are enough for most of point cloud tiles
+        std::size_t vertexCount = m_positions.size();
+        std::size_t indexCount = m_pointIndices.size() * INDICES_PER_POINT;
+        bool useShortIndices = vertexCount <= static_cast<std::size_t>(AZStd::numeric_limits<std::uint16_t>::max()) + 1;
+        AZ::RHI::Format indexFormat = useShortIndices ? AZ::RHI::Format::R16_UINT : AZ::RHI::Format::R32_UINT;
+        std::size_t indexSize = useShortIndices ? sizeof(std::uint16_t) : sizeof(std::uint32_t);
+
+        auto positionBufferViewDescriptor = AZ::RHI::BufferViewDescriptor::CreateTyped(
+            0, static_cast<std::uint32_t>(vertexCount), AZ::RHI::Format::R16G16B16A16_UNORM);
+        std::size_t totalBufferSize = vertexCount * sizeof(glm::u16vec4);
+
+        std::size_t colorByteOffset = MathHelper::Align(totalBufferSize, sizeof(glm::u8vec4));
+        auto colorBufferViewDescriptor = AZ::RHI::BufferViewDescriptor::CreateTyped(
+            static_cast<std::uint32_t>(colorByteOffset / sizeof(glm::u8vec4)), static_cast<std::uint32_t>(vertexCount),
+            AZ::RHI::Format::R8G8B8A8_UNORM);
+        totalBufferSize = colorByteOffset + vertexCount * sizeof(glm::u8vec4);
+
+        std::size_t indexByteOffset = MathHelper::Align(totalBufferSize, indexSize);
+        auto indicesBufferViewDescriptor = AZ::RHI::BufferViewDescriptor::CreateTyped(
+            static_cast<std::uint32_t>(indexByteOffset / indexSize), static_cast<std::uint32_t>(indexCount), indexFormat);
+        totalBufferSize = indexByteOffset + indexCount * indexSize;
+
+        m_buffer.resize_no_construct(totalBufferSize);
+        std::memcpy(m_buffer.data(), m_positions.data(), vertexCount * sizeof(glm::u16vec4));
+        std::memcpy(m_buffer.data() + colorByteOffset, m_colors.data(), vertexCount * sizeof(glm::u8vec4));
+        if (useShortIndices)
+        {
+            CreateIndices<std::uint16_t>(m_pointIndices.size(), m_buffer, indexByteOffset);
+        }
+        else
+        {
+            CreateIndices<std::uint32_t>(m_pointIndices.size(), m_buffer, indexByteOffset);
+        }
+
+        AZ::Data::Asset<AZ::RPI::BufferAsset> bufferAsset = CreateBufferAsset(m_buffer);
+
+        // create LOD asset. Positions are in the quantized space, so the mesh bound is the unit cube
+        AZ::Data::AssetId lodAssetId = CesiumInterface::Get()->GetCriticalAssetManager().GenerateRandomAssetId();
+        AZ::RPI::ModelLodAssetCreator lodCreator;
+        lodCreator.Begin(lodAssetId);
+        lodCreator.AddLodStreamBuffer(bufferAsset);
+
+        lodCreator.BeginMesh();
+        lodCreator.SetMeshIndexBuffer(AZ::RPI::BufferAssetView(bufferAsset, indicesBufferViewDescriptor));
+        lodCreator.AddMeshStreamBuffer(
+            AZ::RHI::ShaderSemantic("POSITION"), AZ::Name(), AZ::RPI::BufferAssetView(bufferAsset, positionBufferViewDescriptor));
+        lodCreator.AddMeshStreamBuffer(
+            AZ::RHI::ShaderSemantic("COLOR"), AZ::Name(), AZ::RPI::BufferAssetView(bufferAsset, colorBufferViewDescriptor));
+        lodCreator.SetMeshAabb(AZ::Aabb::CreateFromMinMax(AZ::Vector3(0.0f), AZ::Vector3(1.0f)));
+        lodCreator.SetMeshMaterialSlot(materialId);
+        lodCreator.EndMesh();
+
+        AZ::Data::Asset<AZ::RPI::ModelLodAsset> lodAsset;
+        lodCreator.End(lodAsset);
+
+        // create model asset
+        AZ::Data::AssetId modelAssetId = CesiumInterface::Get()->GetCriticalAssetManager().GenerateRandomAssetId();
+
+        AZ::RPI::ModelAssetCreator modelCreator;
+        modelCreator.Begin(modelAssetId);
+        modelCreator.AddLodAsset(std::move(lodAsset));
+
+        AZ::RPI::ModelMaterialSlot materialSlot;
+        materialSlot.m_stableId = materialId;
+        materialSlot.m_defaultMaterialAsset = material.m_materialAsset;
+        modelCreator.AddMaterialSlot(materialSlot);
+
+        AZ::Data::Asset<AZ::RPI::ModelAsset> modelAsset;
+        modelCreator.End(modelAsset);
+
+        // dequantization is folded into the transform of the mesh. UNORM positions are already in [0, 1] in the shader
+        result.m_transform = glm::scale(glm::translate(transform, min), extent);
+        result.m_primitives.emplace_back(std::move(modelAsset), materialId);
+
+        return keptPointCount;
+    }
+
+    double GltfPointPrimitiveBuilder::GetPointSpacing() const
+    {
+        return m_pointSpacing;
+    }
+
+    void GltfPointPrimitiveBuilder::ReleaseScratchMemory(std::size_t maxRetainedBytes)
+    {
+        auto trim = [maxRetainedBytes](auto& buffer)
+        {
+            using ValueType = typename std::remove_reference_t<decltype(buffer)>::value_type;
+            if (buffer.capacity() * sizeof(ValueType) > maxRetainedBytes)
+            {
+                std::remove_reference_t<decltype(buffer)>().swap(buffer);
+            }
+            else
+            {
+                buffer.clear();
+            }
+        };
+
+        trim(m_pointIndices);
+        trim(m_positions);
+        trim(m_colors);
+        trim(m_buffer);
+    }
+
+    bool GltfPointPrimitiveBuilder::CreateColors(
+        const CesiumGltf::Model& model, const CesiumGltf::MeshPrimitive& primitive, std::int64_t pointCount)
+    {
+        auto colorAttribute = primitive.attributes.find("COLOR_0");
+        if (colorAttribute == primitive.attributes.end())
+        {
+            return false;
+        }
+
+        const CesiumGltf::Accessor* colorAccessor = model.getSafe<CesiumGltf::Accessor>(&model.accessors, colorAttribute->second);
+        if (!colorAccessor || colorAccessor->count != pointCount)
+        {
+            return false;
+        }
+
+        if (colorAccessor->type == CesiumGltf::AccessorSpec::Type::VEC3)
+        {
+            if (colorAccessor->componentType == CesiumGltf::AccessorSpec::ComponentType::FLOAT)
+            {
+                return CopyColors(CesiumGltf::AccessorView<glm::vec3>{ model, *colorAccessor });
+            }
+            else if (colorAccessor->componentType == CesiumGltf::AccessorSpec::ComponentType::UNSIGNED_BYTE)
+            {
+                return CopyColors(CesiumGltf::AccessorView<glm::u8vec3>{ model, *colorAccessor });
+            }
+            else if (colorAccessor->componentType == CesiumGltf::AccessorSpec::ComponentType::UNSIGNED_SHORT)
+            {
+                return CopyColors(CesiumGltf::AccessorView<glm::u16vec3>{ model, *colorAccessor });
+            }
+        }
+        else if (colorAccessor->type == CesiumGltf::AccessorSpec::Type::VEC4)
+        {
+            if (colorAccessor->componentType == CesiumGltf::AccessorSpec::ComponentType::FLOAT)
+            {
+                return CopyColors(CesiumGltf::AccessorView<glm::vec4>{ model, *colorAccessor });
+            }
+            else if (colorAccessor->componentType == CesiumGltf::AccessorSpec::ComponentType::UNSIGNED_BYTE)
+            {
+                return CopyColors(CesiumGltf::AccessorView<glm::u8vec4>{ model, *colorAccessor });
+            }
+            else if (colorAccessor->componentType == CesiumGltf::AccessorSpec::ComponentType::UNSIGNED_SHORT)
+            {
+                return CopyColors(CesiumGltf::AccessorView<glm::u16vec4>{ model, *colorAccessor });
+            }
+        }
+
+        return false;
+    }
+
+    template<typename ColorType>
+    bool GltfPointPrimitiveBuilder::CopyColors(const CesiumGltf::AccessorView<ColorType>& colorAccessorView)
+    {
+        if (colorAccessorView.status() != CesiumGltf::AccessorViewStatus::Valid)
+        {
+            return false;
+        }
+
+        using ComponentType = typename ColorType::value_type;
+        m_colors.resize(m_positions.size());
+        for (std::size_t i = 0; i < m_pointIndices.size(); ++i)
+        {
+            const ColorType& color = colorAccessorView[m_pointIndices[i]];
+            glm::u8vec4 unormColor{ 255 };
+            for (glm::length_t c = 0; c < ColorType::length(); ++c)
+            {
+                if constexpr (std::is_floating_point_v<ComponentType>)
+                {
+                    unormColor[c] = static_cast<std::uint8_t>(glm::clamp(color[c], 0.0f, 1.0f) * 255.0f + 0.5f);
+                }
+                else
+                {
+                    unormColor[c] = static_cast<std::uint8_t>(color[c] >> (8 * (sizeof(ComponentType) - 1)));
+                }
+            }
+
+            for (std::uint32_t corner = 0; corner < VERTICES_PER_POINT; ++corner)
+            {
+                m_colors[i * VERTICES_PER_POINT + corner] = unormColor;
+            }
+        }
+
+        return true;
+    }
+
+    template<typename IndexType>
+    void GltfPointPrimitiveBuilder::CreateIndices(std::size_t pointCount, AZStd::vector<std::byte>& buffer, std::size_t byteOffset)
+    {
+        // two triangles per point: (0, 1, 2) and (2, 1, 3)
+        IndexType* indices = reinterpret_cast<IndexType*>(buffer.data() + byteOffset);
+        for (std::size_t i = 0; i < pointCount; ++i)
+        {
+            IndexType firstVertex = static_cast<IndexType>(i * VERTICES_PER_POINT);
+            IndexType* pointIndices = indices + i * INDICES_PER_POINT;
+            pointIndices[0] = firstVertex;
+            pointIndices[1] = static_cast<IndexType>(firstVertex + 1);
+            pointIndices[2] = static_cast<IndexType>(firstVertex + 2);
+            pointIndices[3] = static_cast<IndexType>(firstVertex + 2);
+            pointIndices[4] = static_cast<IndexType>(firstVertex + 1);
+            pointIndices[5] = static_cast<IndexType>(firstVertex + 3);
+        }
+    }
+
+    AZ::Data::Asset<AZ::RPI::BufferAsset> GltfPointPrimitiveBuilder::CreateBufferAsset(const AZStd::vector<std::byte>& buffer)
+    {
+        AZ::RHI::BufferViewDescriptor bufferViewDescriptor;
+        bufferViewDescriptor.m_elementOffset = 0;
+        bufferViewDescriptor.m_elementCount = static_cast<std::uint32_t>(buffer.size());
+        bufferViewDescriptor.m_elementSize = sizeof(std::uint8_t);
+        bufferViewDescriptor.m_elementFormat = AZ::RHI::Format::R8_UINT;
+
+        AZ::RHI::BufferDescriptor bufferDescriptor;
+        bufferDescriptor.m_bindFlags = AZ::RHI::BufferBindFlags::InputAssembly | AZ::RHI::BufferBindFlags::ShaderRead;
+        bufferDescriptor.m_byteCount = bufferViewDescriptor.m_elementCount * bufferViewDescriptor.m_elementSize;
+
+        AZ::Data::AssetId bufferAssetId = CesiumInterface::Get()->GetCriticalAssetManager().GenerateRandomAssetId();
+
+        AZ::RPI::BufferAssetCreator creator;
+        creator.Begin(bufferAssetId);
+        creator.SetBuffer(buffer.data(), bufferDescriptor.m_byteCount, bufferDescriptor);
+        creator.SetBufferViewDescriptor(bufferViewDescriptor);
+        creator.SetUseCommonPool(AZ::RPI::CommonBufferPoolType::StaticInputAssembly);
+
+        AZ::Data::Asset<AZ::RPI::BufferAsset> bufferAsset;
+        creator.End(bufferAsset);
+
+        return bufferAsset;
+    }
+} // namespace Cesium
@@ -0,0 +1,78 @@
+#pragma once
+
+#include "Cesium/Gltf/GltfLoadContext.h"
+#include <AzCore/std/containers/vector.h>
+#include <glm/glm.hpp>
+#include <cstddef>
+#include <cstdint>
+
+namespace CesiumGltf
+{
+    struct Model;
+    struct MeshPrimitive;
+
+    template<typename AccessorType>
+    class AccessorView;
+} // namespace CesiumGltf
+
+namespace AZ
+{
+    namespace RPI
+    {
+        class BufferAsset;
+    } // namespace RPI
+
+    namespace Data
+    {
+        template<typename T>
+        class Asset;
+    }
+} // namespace AZ
+
+namespace Cesium
+{
+    // Builds POINTS primitives into a compact vertex format: positions are quantized to 16 bits inside the bounding box
+    // of the primitive and colors are stored as RGBA8. Every point is expanded to a camera facing quad by the point
+    // cloud material, so each point owns 4 vertices with the corner of the quad packed in the position w component.
+    class GltfPointPrimitiveBuilder final
+    {
+    public:
+        GltfPointPrimitiveBuilder();
+
+        // Returns the number of points that are kept after decimating the primitive down to maximumPointCount
+        std::uint64_t Create(
+            const CesiumGltf::Model& model,
+            const CesiumGltf::MeshPrimitive& primitive,
+            const GltfLoadMaterial& material,
+            MaterialId materialId,
+            const glm::dmat4& transform,
+            std::uint64_t maximumPointCount,
+            GltfLoadMesh& result);
+
+        // Average distance between points of the last primitive created
+        double GetPointSpacing() const;
+
+        void ReleaseScratchMemory(std::size_t maxRetainedBytes);
+
+    private:
+        bool CreateColors(const CesiumGltf::Model& model, const CesiumGltf::MeshPrimitive& primitive, std::int64_t pointCount);
+
+        template<typename ColorType>
+        bool CopyColors(const CesiumGltf::AccessorView<ColorType>& colorAccessorView);
+
+        template<typename IndexType>
+        void CreateIndices(std::size_t pointCount, AZStd::vector<std::byte>& buffer, std::size_t byteOffset);
+
+        static AZ::Data::Asset<AZ::RPI::BufferAsset> CreateBufferAsset(const AZStd::vector<std::byte>& buffer);
+
+        static constexpr std::uint32_t VERTICES_PER_POINT = 4;
+        static constexpr std::uint32_t INDICES_PER_POINT = 6;
+        static constexpr double MINIMUM_QUANTIZED_EXTENT = 1e-4;
+
+        double m_pointSpacing;
+        AZStd::vector<std::int64_t> m_pointIndices;
+        AZStd::vector<glm::u16vec4> m_positions;
+        AZStd::vector<glm::u8vec4> m_colors;
+        AZStd::vector<std::byte> m_buffer;
+    };
+} // namespace Cesium
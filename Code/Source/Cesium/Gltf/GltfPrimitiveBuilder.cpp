@@ -32,6 +32,7 @@
 #include <cassert>
 #include <cstdint>
 #include <numeric>
+#include <type_traits>
 
 namespace Cesium
 {
@@ -80,9 +81,18 @@ namespace Cesium
         CesiumGltf::AccessorView<glm::vec4> m_tangents;
     };
 
+    GltfTrianglePrimitiveBuilderOption::GltfTrianglePrimitiveBuilderOption()
+        : m_optimizeVertexCache{ false }
+        , m_vertexCacheOptimizationMinimumTriangleCount{ 256 }
+        , m_fastTangents{ false }
+        , m_accumulateFastTangents{ false }
+    {
+    }
+
     GltfTrianglePrimitiveBuilder::LoadContext::LoadContext()
         : m_generateFlatNormal{ false }
         , m_generateTangent{ false }
+        , m_generateFastTangent{ false }
         , m_generateUnIndexedMesh{ false }
     {
     }
@@ -105,6 +115,7 @@ namespace Cesium
         const CesiumGltf::Model& model,
         const CesiumGltf::MeshPrimitive& primitive,
         const GltfLoadMaterial& material,
+        const GltfTrianglePrimitiveBuilderOption& option,
         GltfLoadPrimitive& result)
     {
         Reset();
@@ -149,13 +160,13 @@ namespace Cesium
         }
 
         // determine loading context
-        DetermineLoadContext(commonAccessorViews, material);
+        DetermineLoadContext(commonAccessorViews, material, option);
 
         // Create attributes. The order call of the functions is important
         CreatePositionsAttribute(commonAccessorViews);
         CreateNormalsAttribute(commonAccessorViews);
-        CreateUVsAttributes(commonAccessorViews, model, primitive);
-        CreateTangentsAndBitangentsAttributes(commonAccessorViews);
+        CreateUVsAttributes(commonAccessorViews, model, primitive, material);
+        CreateTangentsAndBitangentsAttributes(commonAccessorViews, material);
         CreateCustomAttributes(model, primitive, material);
 
         // after retrieving all the attributes, we reindex the indices if it's un-indexed mesh
@@ -163,6 +174,10 @@ namespace Cesium
         {
             std::iota(m_indices.begin(), m_indices.end(), 0);
         }
+        else if (option.m_optimizeVertexCache)
+        {
+            OptimizeVertexCache(option);
+        }
 
         // calculate buffer view descriptor for each attribute and total buffer size to store all of them
         // in a single buffer
@@ -176,6 +191,7 @@ namespace Cesium
             AZ::RHI::Format::R32G32B32_FLOAT);
         totalBufferSize = normalByteOffset + m_normals.size() * sizeof(glm::vec3);
 
+        // tangents and bitangents are empty when the material doesn't consume them, and their streams are left out
         std::size_t bitangentByteOffset = MathHelper::Align(totalBufferSize, sizeof(glm::vec3));
         auto bitangentBufferViewDescriptor = AZ::RHI::BufferViewDescriptor::CreateTyped(
             static_cast<std::uint32_t>(bitangentByteOffset / sizeof(glm::vec3)), static_cast<std::uint32_t>(m_bitangents.size()),
@@ -200,15 +216,12 @@ namespace Cesium
                     m_uvs[i].m_format);
                 totalBufferSize = offset + m_uvs[i].m_buffer.size();
             }
-            else
+            else if (IsUVStreamRequired(i, material))
             {
-                // since this UVs buffer is empty, we just assign its region to tangent buffer as dummy buffer since we don't
-                // care about its value anyway and tangent offset is also a multiple of R32G32_FLOAT size
-                std::size_t formatSize = AZ::RHI::GetFormatSize(AZ::RHI::Format::R32G32_FLOAT);
-                std::size_t offset = tangentByteOffset;
+                // the shaders read this UV set without it being in the glTF, so we just assign its region to position buffer as dummy
+                // buffer since we don't care about its value anyway. Positions start at offset 0 and are larger than R32G32_FLOAT
                 uvBufferViewDescriptors[i] = AZ::RHI::BufferViewDescriptor::CreateTyped(
-                    static_cast<std::uint32_t>(offset / formatSize), static_cast<std::uint32_t>(m_tangents.size()),
-                    AZ::RHI::Format::R32G32_FLOAT);
+                    0, static_cast<std::uint32_t>(m_positions.size()), AZ::RHI::Format::R32G32_FLOAT);
             }
         }
 
@@ -233,14 +246,17 @@ namespace Cesium
             AZ::RHI::Format::R32_UINT);
         totalBufferSize = offset + m_indices.size() * sizeof(std::uint32_t);
 
-        // populate the raw buffer with attributes data
-        AZStd::vector<std::byte> buffer;
+        // populate the raw buffer with attributes data. The buffer is owned by the builder, so its capacity is reused across primitives
+        AZStd::vector<std::byte>& buffer = m_buffer;
         buffer.resize_no_construct(totalBufferSize);
         CopySubregionBuffer(buffer, m_indices.data(), indicesBufferViewDescriptor);
         CopySubregionBuffer(buffer, m_positions.data(), positionBufferViewDescriptor);
         CopySubregionBuffer(buffer, m_normals.data(), normalBufferViewDescriptor);
-        CopySubregionBuffer(buffer, m_bitangents.data(), bitangentBufferViewDescriptor);
-        CopySubregionBuffer(buffer, m_tangents.data(), tangentBufferViewDescriptor);
+        if (!m_tangents.empty())
+        {
+            CopySubregionBuffer(buffer, m_bitangents.data(), bitangentBufferViewDescriptor);
+            CopySubregionBuffer(buffer, m_tangents.data(), tangentBufferViewDescriptor);
+        }
 
         for (std::size_t i = 0; i < m_uvs.size(); ++i)
         {
@@ -273,15 +289,21 @@ namespace Cesium
             AZ::RHI::ShaderSemantic("POSITION"), AZ::Name(), AZ::RPI::BufferAssetView(bufferAsset, positionBufferViewDescriptor));
         lodCreator.AddMeshStreamBuffer(
             AZ::RHI::ShaderSemantic("NORMAL"), AZ::Name(), AZ::RPI::BufferAssetView(bufferAsset, normalBufferViewDescriptor));
-        lodCreator.AddMeshStreamBuffer(
-            AZ::RHI::ShaderSemantic("BITANGENT"), AZ::Name(), AZ::RPI::BufferAssetView(bufferAsset, bitangentBufferViewDescriptor));
-        lodCreator.AddMeshStreamBuffer(
-            AZ::RHI::ShaderSemantic("TANGENT"), AZ::Name(), AZ::RPI::BufferAssetView(bufferAsset, tangentBufferViewDescriptor));
+        if (!m_tangents.empty())
+        {
+            lodCreator.AddMeshStreamBuffer(
+                AZ::RHI::ShaderSemantic("BITANGENT"), AZ::Name(), AZ::RPI::BufferAssetView(bufferAsset, bitangentBufferViewDescriptor));
+            lodCreator.AddMeshStreamBuffer(
+                AZ::RHI::ShaderSemantic("TANGENT"), AZ::Name(), AZ::RPI::BufferAssetView(bufferAsset, tangentBufferViewDescriptor));
+        }
 
         for (std::size_t i = 0; i < uvBufferViewDescriptors.size(); ++i)
         {
-            lodCreator.AddMeshStreamBuffer(
-                AZ::RHI::ShaderSemantic("UV", i), AZ::Name(), AZ::RPI::BufferAssetView(bufferAsset, uvBufferViewDescriptors[i]));
+            if (!m_uvs[i].m_buffer.empty() || IsUVStreamRequired(i, material))
+            {
+                lodCreator.AddMeshStreamBuffer(
+                    AZ::RHI::ShaderSemantic("UV", i), AZ::Name(), AZ::RPI::BufferAssetView(bufferAsset, uvBufferViewDescriptors[i]));
+            }
         }
 
         for (std::size_t i = 0; i < m_customAttributes.size(); ++i)
@@ -317,7 +339,8 @@ namespace Cesium
         result.m_materialId = primitive.material;
     }
 
-    void GltfTrianglePrimitiveBuilder::DetermineLoadContext(const CommonAccessorViews& accessorViews, const GltfLoadMaterial& material)
+    void GltfTrianglePrimitiveBuilder::DetermineLoadContext(
+        const CommonAccessorViews& accessorViews, const GltfLoadMaterial& material, const GltfTrianglePrimitiveBuilderOption& option)
     {
         // check if we should generate normal
         bool isNormalAccessorValid = accessorViews.m_normals.status() == CesiumGltf::AccessorViewStatus::Valid;
@@ -336,8 +359,12 @@ namespace Cesium
             m_context.m_generateTangent = false;
         }
 
-        // check if we should generate unindexed mesh
-        m_context.m_generateUnIndexedMesh = m_context.m_generateFlatNormal || m_context.m_generateTangent;
+        m_context.m_generateFastTangent = m_context.m_generateTangent && option.m_fastTangents;
+
+        // check if we should generate unindexed mesh. Accumulated fast tangents are smooth across shared vertices,
+        // so they don't need the mesh to be un-indexed
+        bool generateSplitTangent = m_context.m_generateTangent && !(m_context.m_generateFastTangent && option.m_accumulateFastTangents);
+        m_context.m_generateUnIndexedMesh = m_context.m_generateFlatNormal || generateSplitTangent;
     }
 
     template<typename AccessorType>
@@ -550,11 +577,26 @@ namespace Cesium
         }
     }
 
+    bool GltfTrianglePrimitiveBuilder::IsUVStreamRequired(std::size_t uvSet, const GltfLoadMaterial& material)
+    {
+        // the first UVs are always read, and the second set whenever the material type requires it or samples a texture with it
+        return uvSet == 0 || (uvSet == 1 && material.m_needSecondUVSet);
+    }
+
     void GltfTrianglePrimitiveBuilder::CreateUVsAttributes(
-        const CommonAccessorViews& commonAccessorViews, const CesiumGltf::Model& model, const CesiumGltf::MeshPrimitive& primitive)
+        const CommonAccessorViews& commonAccessorViews,
+        const CesiumGltf::Model& model,
+        const CesiumGltf::MeshPrimitive& primitive,
+        const GltfLoadMaterial& material)
     {
         for (std::size_t i = 0; i < m_uvs.size(); ++i)
         {
+            // the second uv set is an optional stream, so it is only sent when the material samples a texture with it
+            if (i == 1 && !material.m_needSecondUVSet)
+            {
+                continue;
+            }
+
             auto uvAttribute = primitive.attributes.find("TEXCOORD_" + std::to_string(i));
             if (uvAttribute == primitive.attributes.end())
             {
@@ -621,17 +663,23 @@ namespace Cesium
         }
     }
 
-    void GltfTrianglePrimitiveBuilder::CreateTangentsAndBitangentsAttributes(const CommonAccessorViews& commonAccessorViews)
+    void GltfTrianglePrimitiveBuilder::CreateTangentsAndBitangentsAttributes(
+        const CommonAccessorViews& commonAccessorViews, const GltfLoadMaterial& material)
     {
         if (m_context.m_generateTangent)
         {
-            // positions, normals, and uvs should be unindexed at this point
-            assert(m_context.m_generateUnIndexedMesh);
+            // positions, normals, and uvs should be unindexed at this point, unless fast tangents are accumulated over the indices
+            assert(m_context.m_generateUnIndexedMesh || m_context.m_generateFastTangent);
             assert(m_positions.size() == m_normals.size());
             assert(m_positions.size() > 0);
-            assert(m_positions.size() % 3 == 0);
             assert(m_normals.size() > 0);
-            assert(m_normals.size() % 3 == 0);
+
+            // un-indexed meshes still hold the source indices until they are reindexed, so they are not passed along
+            AZStd::span<const std::uint32_t> indices;
+            if (!m_context.m_generateUnIndexedMesh)
+            {
+                indices = AZStd::span<const std::uint32_t>(m_indices.data(), m_indices.size());
+            }
 
             // Try to generate tangents and bitangents
             bool success = false;
@@ -642,17 +690,23 @@ namespace Cesium
                     if (m_uvs[i].m_format == AZ::RHI::Format::R32G32_FLOAT)
                     {
                         AZStd::span<glm::vec2> uvs(reinterpret_cast<glm::vec2*>(m_uvs[i].m_buffer.data()), m_uvs[i].m_elementCount);
-                        success = BitangentAndTangentGenerator::Generate(m_positions, m_normals, uvs, m_tangents, m_bitangents);
+                        success = m_context.m_generateFastTangent
+                            ? BitangentAndTangentGenerator::GenerateFast(m_positions, m_normals, uvs, indices, m_tangents, m_bitangents)
+                            : BitangentAndTangentGenerator::Generate(m_positions, m_normals, uvs, m_tangents, m_bitangents);
                     }
                     else if (m_uvs[i].m_format == AZ::RHI::Format::R8G8_UNORM)
                     {
                         AZStd::span<glm::u8vec2> uvs(reinterpret_cast<glm::u8vec2*>(m_uvs[i].m_buffer.data()), m_uvs[i].m_elementCount);
-                        success = BitangentAndTangentGenerator::Generate(m_positions, m_normals, uvs, m_tangents, m_bitangents);
+                        success = m_context.m_generateFastTangent
+                            ? BitangentAndTangentGenerator::GenerateFast(m_positions, m_normals, uvs, indices, m_tangents, m_bitangents)
+                            : BitangentAndTangentGenerator::Generate(m_positions, m_normals, uvs, m_tangents, m_bitangents);
                     }
                     else if (m_uvs[i].m_format == AZ::RHI::Format::R16G16_UNORM)
                     {
                         AZStd::span<glm::u16vec2> uvs(reinterpret_cast<glm::u16vec2*>(m_uvs[i].m_buffer.data()), m_uvs[i].m_elementCount);
-                        success = BitangentAndTangentGenerator::Generate(m_positions, m_normals, uvs, m_tangents, m_bitangents);
+                        success = m_context.m_generateFastTangent
+                            ? BitangentAndTangentGenerator::GenerateFast(m_positions, m_normals, uvs, indices, m_tangents, m_bitangents)
+                            : BitangentAndTangentGenerator::Generate(m_positions, m_normals, uvs, m_tangents, m_bitangents);
                     }
                     else
                     {
@@ -670,6 +724,8 @@ namespace Cesium
             // if we still cannot generate MikkTSpace, then we generate dummy
             if (!success)
             {
+                m_tangents.clear();
+                m_bitangents.clear();
                 m_tangents.resize(m_positions.size(), glm::vec4(1.0f, 0.0f, 0.0f, 1.0f));
                 m_bitangents.resize(m_positions.size(), glm::vec3(0.0f, 1.0f, 0.0f));
             }
@@ -677,6 +733,12 @@ namespace Cesium
             return;
         }
 
+        // tangents and bitangents are optional streams, so leave them out when the material doesn't use them
+        if (!material.m_needTangents)
+        {
+            return;
+        }
+
         // check if tangents accessor is valid. If it is, we just copy to the buffer
         const CesiumGltf::AccessorView<glm::vec4>& tangents = commonAccessorViews.m_tangents;
         if ((tangents.status() == CesiumGltf::AccessorViewStatus::Valid) && (tangents.size() > 0) &&
@@ -756,7 +818,7 @@ namespace Cesium
         if (accessor.type == CesiumGltf::AccessorSpec::Type::SCALAR)
         {
             CesiumGltf::AccessorView<ComponentType> accessorView{ model, accessor };
-            VertexRawBuffer vertexBuffer;
+            VertexRawBuffer vertexBuffer = AcquireRawBuffer();
             vertexBuffer.m_elementCount = static_cast<std::size_t>(accessorView.size());
             vertexBuffer.m_format = customShaderAttribute.m_format;
             CopyAccessorToBuffer(accessorView, vertexBuffer.m_buffer);
@@ -766,7 +828,7 @@ namespace Cesium
         else if (accessor.type == CesiumGltf::AccessorSpec::Type::VEC2)
         {
             CesiumGltf::AccessorView<glm::vec<2, ComponentType, glm::defaultp>> accessorView{ model, accessor };
-            VertexRawBuffer vertexBuffer;
+            VertexRawBuffer vertexBuffer = AcquireRawBuffer();
             vertexBuffer.m_elementCount = static_cast<std::size_t>(accessorView.size());
             vertexBuffer.m_format = customShaderAttribute.m_format;
             CopyAccessorToBuffer(accessorView, vertexBuffer.m_buffer);
@@ -776,7 +838,7 @@ namespace Cesium
         else if (accessor.type == CesiumGltf::AccessorSpec::Type::VEC3)
         {
             CesiumGltf::AccessorView<glm::vec<3, ComponentType, glm::defaultp>> accessorView{ model, accessor };
-            VertexRawBuffer vertexBuffer;
+            VertexRawBuffer vertexBuffer = AcquireRawBuffer();
             vertexBuffer.m_elementCount = static_cast<std::size_t>(accessorView.size());
             vertexBuffer.m_format = customShaderAttribute.m_format;
             CopyAccessorToBuffer(accessorView, vertexBuffer.m_buffer);
@@ -786,7 +848,7 @@ namespace Cesium
         else if (accessor.type == CesiumGltf::AccessorSpec::Type::VEC4)
         {
             CesiumGltf::AccessorView<glm::vec<4, ComponentType, glm::defaultp>> accessorView{ model, accessor };
-            VertexRawBuffer vertexBuffer;
+            VertexRawBuffer vertexBuffer = AcquireRawBuffer();
             vertexBuffer.m_elementCount = static_cast<std::size_t>(accessorView.size());
             vertexBuffer.m_format = customShaderAttribute.m_format;
             CopyAccessorToBuffer(accessorView, vertexBuffer.m_buffer);
@@ -819,6 +881,90 @@ namespace Cesium
         }
     }
 
+    void GltfTrianglePrimitiveBuilder::OptimizeVertexCache(const GltfTrianglePrimitiveBuilderOption& option)
+    {
+        std::size_t triangleCount = m_indices.size() / 3;
+        if (triangleCount < option.m_vertexCacheOptimizationMinimumTriangleCount)
+        {
+            return;
+        }
+
+        // every vertex stream is remapped with the same order, so leave the primitive alone if a custom attribute doesn't line up
+        std::size_t vertexCount = m_positions.size();
+        for (const auto& customAttribute : m_customAttributes)
+        {
+            if (customAttribute.m_buffer.m_elementCount != vertexCount)
+            {
+                return;
+            }
+        }
+
+        assert(m_normals.size() == vertexCount);
+        assert(m_tangents.empty() || m_tangents.size() == vertexCount);
+        assert(m_bitangents.size() == m_tangents.size());
+
+        float acmrBefore = m_vertexCacheOptimizer.CalculateACMR(m_indices, vertexCount);
+        if (!m_vertexCacheOptimizer.OptimizeVertexCache(m_indices, vertexCount))
+        {
+            return;
+        }
+
+        std::size_t fetchVertexCount = m_vertexCacheOptimizer.OptimizeVertexFetch(m_indices, vertexCount, m_vertexRemap);
+        float acmrAfter = m_vertexCacheOptimizer.CalculateACMR(m_indices, fetchVertexCount);
+
+        // vertices that are not referenced by any triangle are dropped by the remap
+        RemapVertexBuffer(reinterpret_cast<std::byte*>(m_positions.data()), sizeof(glm::vec3));
+        m_positions.resize(fetchVertexCount);
+        RemapVertexBuffer(reinterpret_cast<std::byte*>(m_normals.data()), sizeof(glm::vec3));
+        m_normals.resize(fetchVertexCount);
+        if (!m_tangents.empty())
+        {
+            RemapVertexBuffer(reinterpret_cast<std::byte*>(m_tangents.data()), sizeof(glm::vec4));
+            m_tangents.resize(fetchVertexCount);
+            RemapVertexBuffer(reinterpret_cast<std::byte*>(m_bitangents.data()), sizeof(glm::vec3));
+            m_bitangents.resize(fetchVertexCount);
+        }
+
+        for (auto& uv : m_uvs)
+        {
+            if (!uv.m_buffer.empty())
+            {
+                std::size_t elementSize = AZ::RHI::GetFormatSize(uv.m_format);
+                RemapVertexBuffer(uv.m_buffer.data(), elementSize);
+                uv.m_buffer.resize(fetchVertexCount * elementSize);
+                uv.m_elementCount = fetchVertexCount;
+            }
+        }
+
+        for (auto& customAttribute : m_customAttributes)
+        {
+            VertexRawBuffer& rawBuffer = customAttribute.m_buffer;
+            std::size_t elementSize = rawBuffer.m_buffer.size() / vertexCount;
+            RemapVertexBuffer(rawBuffer.m_buffer.data(), elementSize);
+            rawBuffer.m_buffer.resize(fetchVertexCount * elementSize);
+            rawBuffer.m_elementCount = fetchVertexCount;
+        }
+
+        // a log line per primitive would flood the log on large tilesets, so the results are summed up for cesium_DumpVertexCacheStatistics
+        CesiumInterface::Get()->GetVertexCacheTelemetry().Record(triangleCount, acmrBefore, acmrAfter);
+    }
+
+    void GltfTrianglePrimitiveBuilder::RemapVertexBuffer(std::byte* data, std::size_t elementSize)
+    {
+        // go through a copy, since a vertex can land on top of one that is not moved yet
+        std::size_t vertexCount = m_vertexRemap.size();
+        m_vertexRemapScratch.resize_no_construct(vertexCount * elementSize);
+        memcpy(m_vertexRemapScratch.data(), data, vertexCount * elementSize);
+        for (std::size_t i = 0; i < vertexCount; ++i)
+        {
+            std::uint32_t newIndex = m_vertexRemap[i];
+            if (newIndex != VertexCacheOptimizer::INVALID_INDEX)
+            {
+                memcpy(data + newIndex * elementSize, m_vertexRemapScratch.data() + i * elementSize, elementSize);
+            }
+        }
+    }
+
     void GltfTrianglePrimitiveBuilder::CopySubregionBuffer(
         AZStd::vector<std::byte>& buffer, const void* src, const AZ::RHI::BufferViewDescriptor& descriptor)
     {
@@ -842,7 +988,62 @@ namespace Cesium
             m_uvs[i].m_format = AZ::RHI::Format::Unknown;
         }
 
+        // keep the custom attribute buffers around, so that their capacity can be reused by the next primitive
+        for (auto& customAttribute : m_customAttributes)
+        {
+            m_freeRawBuffers.emplace_back(std::move(customAttribute.m_buffer));
+        }
+
         m_customAttributes.clear();
+        m_buffer.clear();
+    }
+
+    void GltfTrianglePrimitiveBuilder::ReleaseScratchMemory(std::size_t maxRetainedBytes)
+    {
+        Reset();
+
+        auto trim = [maxRetainedBytes](auto& vector)
+        {
+            using VectorType = std::remove_reference_t<decltype(vector)>;
+            if (vector.capacity() * sizeof(typename VectorType::value_type) > maxRetainedBytes)
+            {
+                VectorType().swap(vector);
+            }
+        };
+
+        trim(m_indices);
+        trim(m_positions);
+        trim(m_normals);
+        trim(m_tangents);
+        trim(m_bitangents);
+        trim(m_buffer);
+        trim(m_vertexRemap);
+        trim(m_vertexRemapScratch);
+        m_vertexCacheOptimizer.ReleaseScratchMemory(maxRetainedBytes);
+        for (auto& uv : m_uvs)
+        {
+            trim(uv.m_buffer);
+        }
+
+        for (auto& rawBuffer : m_freeRawBuffers)
+        {
+            trim(rawBuffer.m_buffer);
+        }
+    }
+
+    GltfTrianglePrimitiveBuilder::VertexRawBuffer GltfTrianglePrimitiveBuilder::AcquireRawBuffer()
+    {
+        if (m_freeRawBuffers.empty())
+        {
+            return VertexRawBuffer{};
+        }
+
+        VertexRawBuffer rawBuffer = std::move(m_freeRawBuffers.back());
+        m_freeRawBuffers.pop_back();
+        rawBuffer.m_buffer.clear();
+        rawBuffer.m_elementCount = 0;
+        rawBuffer.m_format = AZ::RHI::Format::Unknown;
+        return rawBuffer;
     }
 
     AZ::Aabb GltfTrianglePrimitiveBuilder::CreateAabbFromPositions(const CesiumGltf::AccessorView<glm::vec3>& positionAccessorView)
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Cesium/Gltf/GltfLoadContext.h"
+#include "Cesium/Gltf/VertexCacheOptimizer.h"
 #include <Atom/RHI.Reflect/Format.h>
 #include <AzCore/std/containers/vector.h>
 #include <AzCore/std/containers/array.h>
@@ -35,6 +36,16 @@ namespace AZ
 
 namespace Cesium
 {
+    struct GltfTrianglePrimitiveBuilderOption final
+    {
+        GltfTrianglePrimitiveBuilderOption();
+
+        bool m_optimizeVertexCache;
+        std::uint32_t m_vertexCacheOptimizationMinimumTriangleCount;
+        bool m_fastTangents;
+        bool m_accumulateFastTangents;
+    };
+
     class GltfTrianglePrimitiveBuilder final
     {
         struct CommonAccessorViews;
@@ -45,6 +56,7 @@ namespace Cesium
 
             bool m_generateFlatNormal;
             bool m_generateTangent;
+            bool m_generateFastTangent;
             bool m_generateUnIndexedMesh;
         };
 
@@ -70,10 +82,14 @@ namespace Cesium
             const CesiumGltf::Model& model,
             const CesiumGltf::MeshPrimitive& primitive,
             const GltfLoadMaterial& material,
+            const GltfTrianglePrimitiveBuilderOption& option,
             GltfLoadPrimitive& result);
 
+        void ReleaseScratchMemory(std::size_t maxRetainedBytes);
+
     private:
-        void DetermineLoadContext(const CommonAccessorViews& accessorViews, const GltfLoadMaterial& material);
+        void DetermineLoadContext(
+            const CommonAccessorViews& accessorViews, const GltfLoadMaterial& material, const GltfTrianglePrimitiveBuilderOption& option);
 
         template<typename AccessorType>
         void CopyAccessorToBuffer(
@@ -92,10 +108,15 @@ namespace Cesium
 
         void CreateNormalsAttribute(const CommonAccessorViews& commonAccessorViews);
 
+        static bool IsUVStreamRequired(std::size_t uvSet, const GltfLoadMaterial& material);
+
         void CreateUVsAttributes(
-            const CommonAccessorViews& commonAccessorViews, const CesiumGltf::Model& model, const CesiumGltf::MeshPrimitive& primitive);
+            const CommonAccessorViews& commonAccessorViews,
+            const CesiumGltf::Model& model,
+            const CesiumGltf::MeshPrimitive& primitive,
+            const GltfLoadMaterial& material);
 
-        void CreateTangentsAndBitangentsAttributes(const CommonAccessorViews& commonAccessorViews);
+        void CreateTangentsAndBitangentsAttributes(const CommonAccessorViews& commonAccessorViews, const GltfLoadMaterial& material);
 
         void CreateCustomAttributes(
             const CesiumGltf::Model& model, const CesiumGltf::MeshPrimitive& primitive, const GltfLoadMaterial& material);
@@ -106,10 +127,16 @@ namespace Cesium
 
         void CreateFlatNormal();
 
+        void OptimizeVertexCache(const GltfTrianglePrimitiveBuilderOption& option);
+
+        void RemapVertexBuffer(std::byte* data, std::size_t elementSize);
+
         void CopySubregionBuffer(AZStd::vector<std::byte>& buffer, const void* src, const AZ::RHI::BufferViewDescriptor& descriptor);
 
         void Reset();
 
+        VertexRawBuffer AcquireRawBuffer();
+
         static AZ::Data::Asset<AZ::RPI::BufferAsset> CreateBufferAsset(const AZStd::vector<std::byte>& buffer);
 
         static AZ::Aabb CreateAabbFromPositions(const CesiumGltf::AccessorView<glm::vec3>& positionAccessorView);
@@ -124,5 +151,10 @@ namespace Cesium
         AZStd::vector<glm::vec3> m_bitangents;
         AZStd::array<VertexRawBuffer, 2> m_uvs;
         AZStd::vector<VertexCustomAttribute> m_customAttributes;
+        AZStd::vector<VertexRawBuffer> m_freeRawBuffers;
+        AZStd::vector<std::byte> m_buffer;
+        VertexCacheOptimizer m_vertexCacheOptimizer;
+        AZStd::vector<std::uint32_t> m_vertexRemap;
+        AZStd::vector<std::byte> m_vertexRemapScratch;
     };
 } // namespace Cesium
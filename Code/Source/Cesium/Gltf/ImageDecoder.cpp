@@ -0,0 +1,360 @@
+#include "Cesium/Gltf/ImageDecoder.h"
+#include "Cesium/Gltf/MipChainGenerator.h"
+#include "Cesium/Gltf/PixelFormatConverter.h"
+#include <AzCore/std/parallel/lock.h>
+#include <AzCore/std/algorithm.h>
+#include <cstring>
+
+// Window 10 wingdi.h header defines OPAQUE macro which mess up with CesiumGltf::Material::AlphaMode::OPAQUE.
+// This only happens with unity build
+#include <AzCore/PlatformDef.h>
+#ifdef AZ_COMPILER_MSVC
+#pragma push_macro("OPAQUE")
+#undef OPAQUE
+#endif
+
+#include <CesiumGltf/ImageCesium.h>
+#include <CesiumGltfReader/GltfReader.h>
+
+#ifdef AZ_COMPILER_MSVC
+#pragma pop_macro("OPAQUE")
+#endif
+
+#if defined(CESIUM_USE_TURBOJPEG)
+#include <turbojpeg.h>
+#endif
+
+#if defined(CESIUM_USE_LIBWEBP)
+#include <webp/decode.h>
+#endif
+
+#if defined(CESIUM_USE_SPNG)
+#include <spng.h>
+#endif
+
+namespace Cesium
+{
+    namespace
+    {
+        // cesium-native decodes with stb_image, which handles every format glTF and the raster overlays use, only slower
+        class StbImageDecoder final : public ImageDecoder
+        {
+        public:
+            bool CanDecode([[maybe_unused]] gsl::span<const std::byte> data) const override
+            {
+                return true;
+            }
+
+            bool Decode(
+                gsl::span<const std::byte> data,
+                [[maybe_unused]] const ImageDecodeOption& option,
+                CesiumGltf::ImageCesium& image) const override
+            {
+                CesiumGltfReader::GltfReader reader;
+                auto result = reader.readImage(data);
+                if (!result.image)
+                {
+                    return false;
+                }
+
+                image = std::move(*result.image);
+                return true;
+            }
+        };
+
+#if defined(CESIUM_USE_TURBOJPEG)
+        // libjpeg-turbo scales by 1/2, 1/4 and 1/8 during the IDCT, which is much cheaper than decoding the full image
+        class TurboJpegImageDecoder final : public ImageDecoder
+        {
+        public:
+            bool CanDecode(gsl::span<const std::byte> data) const override
+            {
+                return data.size() > 3 && data[0] == std::byte{ 0xFF } && data[1] == std::byte{ 0xD8 } && data[2] == std::byte{ 0xFF };
+            }
+
+            bool Decode(gsl::span<const std::byte> data, const ImageDecodeOption& option, CesiumGltf::ImageCesium& image) const override
+            {
+                tjhandle handle = tjInitDecompress();
+                if (!handle)
+                {
+                    return false;
+                }
+
+                const unsigned char* jpeg = reinterpret_cast<const unsigned char*>(data.data());
+                unsigned long jpegSize = static_cast<unsigned long>(data.size());
+                int width = 0;
+                int height = 0;
+                int subsampling = 0;
+                int colorspace = 0;
+                bool decoded = false;
+                if (tjDecompressHeader3(handle, jpeg, jpegSize, &width, &height, &subsampling, &colorspace) == 0 && width > 0 &&
+                    height > 0)
+                {
+                    std::uint32_t reductionCount = AZStd::min(
+                        ImageDecoderRegistry::GetReductionCount(
+                            static_cast<std::uint32_t>(width), static_cast<std::uint32_t>(height), option.m_targetSize),
+                        MAX_SCALE_REDUCTION);
+                    tjscalingfactor scalingFactor{ 1, 1 << reductionCount };
+                    int scaledWidth = TJSCALED(width, scalingFactor);
+                    int scaledHeight = TJSCALED(height, scalingFactor);
+
+                    image.width = scaledWidth;
+                    image.height = scaledHeight;
+                    image.channels = 4;
+                    image.bytesPerChannel = 1;
+                    image.pixelData.resize(static_cast<std::size_t>(scaledWidth) * scaledHeight * 4);
+                    decoded = tjDecompress2(
+                                  handle, jpeg, jpegSize, reinterpret_cast<unsigned char*>(image.pixelData.data()), scaledWidth, 0,
+                                  scaledHeight, TJPF_RGBA, 0) == 0;
+                }
+
+                tjDestroy(handle);
+                return decoded;
+            }
+
+        private:
+            static constexpr std::uint32_t MAX_SCALE_REDUCTION = 3;
+        };
+#endif
+
+#if defined(CESIUM_USE_LIBWEBP)
+        class WebPImageDecoder final : public ImageDecoder
+        {
+        public:
+            bool CanDecode(gsl::span<const std::byte> data) const override
+            {
+                return data.size() > 12 && std::memcmp(data.data(), "RIFF", 4) == 0 && std::memcmp(data.data() + 8, "WEBP", 4) == 0;
+            }
+
+            bool Decode(gsl::span<const std::byte> data, const ImageDecodeOption& option, CesiumGltf::ImageCesium& image) const override
+            {
+                WebPDecoderConfig config;
+                if (!WebPInitDecoderConfig(&config))
+                {
+                    return false;
+                }
+
+                const std::uint8_t* webp = reinterpret_cast<const std::uint8_t*>(data.data());
+                if (WebPGetFeatures(webp, data.size(), &config.input) != VP8_STATUS_OK)
+                {
+                    return false;
+                }
+
+                // the scaler of libwebp resamples while decoding rows, so reductions never allocate the full image
+                std::uint32_t reductionCount = ImageDecoderRegistry::GetReductionCount(
+                    static_cast<std::uint32_t>(config.input.width), static_cast<std::uint32_t>(config.input.height), option.m_targetSize);
+                int width = AZStd::max(config.input.width >> reductionCount, 1);
+                int height = AZStd::max(config.input.height >> reductionCount, 1);
+                if (reductionCount > 0)
+                {
+                    config.options.use_scaling = 1;
+                    config.options.scaled_width = width;
+                    config.options.scaled_height = height;
+                }
+
+                image.width = width;
+                image.height = height;
+                image.channels = 4;
+                image.bytesPerChannel = 1;
+                image.pixelData.resize(static_cast<std::size_t>(width) * height * 4);
+                config.output.colorspace = MODE_RGBA;
+                config.output.is_external_memory = 1;
+                config.output.u.RGBA.rgba = reinterpret_cast<std::uint8_t*>(image.pixelData.data());
+                config.output.u.RGBA.stride = width * 4;
+                config.output.u.RGBA.size = image.pixelData.size();
+                bool decoded = WebPDecode(webp, data.size(), &config) == VP8_STATUS_OK;
+                WebPFreeDecBuffer(&config.output);
+                return decoded;
+            }
+        };
+#endif
+
+#if defined(CESIUM_USE_SPNG)
+        // libspng unfilters rows with SSE or NEON. It can't scale while decoding, so the registry reduces the image afterward
+        class SpngImageDecoder final : public ImageDecoder
+        {
+        public:
+            bool CanDecode(gsl::span<const std::byte> data) const override
+            {
+                static constexpr std::uint8_t PNG_SIGNATURE[] = { 0x89, 0x50, 0x4E, 0x47, 0x0D, 0x0A, 0x1A, 0x0A };
+                return data.size() > sizeof(PNG_SIGNATURE) && std::memcmp(data.data(), PNG_SIGNATURE, sizeof(PNG_SIGNATURE)) == 0;
+            }
+
+            bool Decode(
+                gsl::span<const std::byte> data,
+                [[maybe_unused]] const ImageDecodeOption& option,
+                CesiumGltf::ImageCesium& image) const override
+            {
+                spng_ctx* context = spng_ctx_new(0);
+                if (!context)
+                {
+                    return false;
+                }
+
+                // 16 bits and palette images are converted to 8 bits RGBA by the decoder
+                spng_ihdr header;
+                std::size_t decodedSize = 0;
+                bool decoded = false;
+                if (spng_set_png_buffer(context, data.data(), data.size()) == 0 && spng_get_ihdr(context, &header) == 0 &&
+                    spng_decoded_image_size(context, SPNG_FMT_RGBA8, &decodedSize) == 0)
+                {
+                    image.width = static_cast<std::int32_t>(header.width);
+                    image.height = static_cast<std::int32_t>(header.height);
+                    image.channels = 4;
+                    image.bytesPerChannel = 1;
+                    image.pixelData.resize(decodedSize);
+                    decoded = spng_decode_image(context, image.pixelData.data(), decodedSize, SPNG_FMT_RGBA8, SPNG_DECODE_TRNS) == 0;
+                }
+
+                spng_ctx_free(context);
+                return decoded;
+            }
+        };
+#endif
+    } // namespace
+
+    ImageDecodeOption::ImageDecodeOption()
+        : m_targetSize{ 0 }
+        , m_srgb{ true }
+    {
+    }
+
+    ImageDecoderRegistry::ImageDecoderRegistry()
+    {
+        AddDecoder(AZStd::make_unique<StbImageDecoder>(), FALLBACK_DECODER_PRIORITY);
+#if defined(CESIUM_USE_TURBOJPEG)
+        AddDecoder(AZStd::make_unique<TurboJpegImageDecoder>(), FAST_DECODER_PRIORITY);
+#endif
+#if defined(CESIUM_USE_LIBWEBP)
+        AddDecoder(AZStd::make_unique<WebPImageDecoder>(), FAST_DECODER_PRIORITY);
+#endif
+#if defined(CESIUM_USE_SPNG)
+        AddDecoder(AZStd::make_unique<SpngImageDecoder>(), FAST_DECODER_PRIORITY);
+#endif
+    }
+
+    void ImageDecoderRegistry::AddDecoder(AZStd::unique_ptr<ImageDecoder> decoder, std::int32_t priority)
+    {
+        if (!decoder)
+        {
+            return;
+        }
+
+        // decoders with the same priority are tried in the order they are added
+        AZStd::unique_lock<AZStd::shared_mutex> lock(m_decodersMutex);
+        auto it = AZStd::upper_bound(
+            m_decoders.begin(), m_decoders.end(), priority,
+            [](std::int32_t value, const RegisteredDecoder& registered)
+            {
+                return value > registered.m_priority;
+            });
+        m_decoders.insert(it, RegisteredDecoder{ std::move(decoder), priority });
+    }
+
+    bool ImageDecoderRegistry::Decode(
+        gsl::span<const std::byte> data, const ImageDecodeOption& option, CesiumGltf::ImageCesium& image) const
+    {
+        if (data.empty())
+        {
+            return false;
+        }
+
+        AZStd::shared_lock<AZStd::shared_mutex> lock(m_decodersMutex);
+        for (const RegisteredDecoder& registered : m_decoders)
+        {
+            if (!registered.m_decoder->CanDecode(data))
+            {
+                continue;
+            }
+
+            CesiumGltf::ImageCesium decoded;
+            if (registered.m_decoder->Decode(data, option, decoded) && ConvertToRGBA(decoded))
+            {
+                ReduceToTargetSize(option, decoded);
+                image = std::move(decoded);
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    std::uint32_t ImageDecoderRegistry::GetReductionCount(std::uint32_t width, std::uint32_t height, std::uint32_t targetSize)
+    {
+        if (targetSize == 0)
+        {
+            return 0;
+        }
+
+        std::uint32_t size = AZStd::max(width, height);
+        std::uint32_t reductionCount = 0;
+        while ((size >> (reductionCount + 1)) >= targetSize && (AZStd::min(width, height) >> (reductionCount + 1)) > 0)
+        {
+            ++reductionCount;
+        }
+
+        return reductionCount;
+    }
+
+    bool ImageDecoderRegistry::ConvertToRGBA(CesiumGltf::ImageCesium& image)
+    {
+        if (image.width <= 0 || image.height <= 0)
+        {
+            return false;
+        }
+
+        // GPU compressed images and layouts other than 8 bits RGB or RGBA are left for the image builders to handle
+        if (image.compressedPixelFormat != CesiumGltf::GpuCompressedPixelFormat::NONE || image.bytesPerChannel != 1 ||
+            (image.channels != 3 && image.channels != 4))
+        {
+            return true;
+        }
+
+        std::size_t pixelCount = static_cast<std::size_t>(image.width) * static_cast<std::size_t>(image.height);
+        if (image.pixelData.size() != pixelCount * image.channels)
+        {
+            return false;
+        }
+
+        if (image.channels == 4)
+        {
+            return true;
+        }
+
+        std::vector<std::byte> rgba(pixelCount * 4);
+        PixelFormatConverter::ExpandRGBToRGBA(image.pixelData.data(), pixelCount, rgba.data());
+        image.pixelData = std::move(rgba);
+        image.channels = 4;
+        return true;
+    }
+
+    bool ImageDecoderRegistry::IsUncompressedRGBA(const CesiumGltf::ImageCesium& image)
+    {
+        return image.compressedPixelFormat == CesiumGltf::GpuCompressedPixelFormat::NONE && image.bytesPerChannel == 1 &&
+            image.channels == 4;
+    }
+
+    void ImageDecoderRegistry::ReduceToTargetSize(const ImageDecodeOption& option, CesiumGltf::ImageCesium& image)
+    {
+        if (!IsUncompressedRGBA(image))
+        {
+            return;
+        }
+
+        std::uint32_t width = static_cast<std::uint32_t>(image.width);
+        std::uint32_t height = static_cast<std::uint32_t>(image.height);
+        std::uint32_t reductionCount = GetReductionCount(width, height, option.m_targetSize);
+        for (std::uint32_t i = 0; i < reductionCount; ++i)
+        {
+            std::vector<std::byte> mip(
+                static_cast<std::size_t>(MipChainGenerator::GetMipSize(width, 1)) * MipChainGenerator::GetMipSize(height, 1) * 4);
+            MipChainGenerator::GenerateMip(image.pixelData.data(), width, height, 4, option.m_srgb, mip.data());
+            image.pixelData = std::move(mip);
+            width = MipChainGenerator::GetMipSize(width, 1);
+            height = MipChainGenerator::GetMipSize(height, 1);
+        }
+
+        image.width = static_cast<std::int32_t>(width);
+        image.height = static_cast<std::int32_t>(height);
+    }
+} // namespace Cesium
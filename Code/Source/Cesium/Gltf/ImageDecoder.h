@@ -0,0 +1,81 @@
+#pragma once
+
+#include <AzCore/std/containers/vector.h>
+#include <AzCore/std/parallel/shared_mutex.h>
+#include <AzCore/std/smart_ptr/unique_ptr.h>
+#include <gsl/span>
+#include <cstddef>
+#include <cstdint>
+
+namespace CesiumGltf
+{
+    struct ImageCesium;
+}
+
+namespace Cesium
+{
+    struct ImageDecodeOption final
+    {
+        ImageDecodeOption();
+
+        // when it's not 0, the image is decoded at the smallest power of 2 reduction whose longer side is still at least this
+        // large. Decoders that can't scale while decoding are downsampled afterward
+        std::uint32_t m_targetSize;
+
+        // whether the color channels are averaged in linear space when the image is downsampled
+        bool m_srgb;
+    };
+
+    // Backend that decodes one or more compressed image formats into 8 bits per channel RGBA pixels
+    class ImageDecoder
+    {
+    public:
+        virtual ~ImageDecoder() noexcept = default;
+
+        virtual bool CanDecode(gsl::span<const std::byte> data) const = 0;
+
+        // decoders may return an image that is larger than the target size, but never a smaller one
+        virtual bool Decode(gsl::span<const std::byte> data, const ImageDecodeOption& option, CesiumGltf::ImageCesium& image) const = 0;
+    };
+
+    // Decodes images with the highest priority backend that recognizes the data, falling back to the next one when a backend fails.
+    // The stb based decoder of cesium-native is always registered last, and backends for libjpeg-turbo, libwebp and libspng are
+    // registered in front of it when the gem is built with them. 8 bits RGB is expanded to RGBA. Images in other layouts, like
+    // the GPU compressed ones of KTX2, are returned as the backend decoded them and are not reduced. Decoding is safe from
+    // multiple threads.
+    class ImageDecoderRegistry final
+    {
+    public:
+        ImageDecoderRegistry();
+
+        ImageDecoderRegistry(const ImageDecoderRegistry&) = delete;
+
+        ImageDecoderRegistry& operator=(const ImageDecoderRegistry&) = delete;
+
+        void AddDecoder(AZStd::unique_ptr<ImageDecoder> decoder, std::int32_t priority);
+
+        bool Decode(gsl::span<const std::byte> data, const ImageDecodeOption& option, CesiumGltf::ImageCesium& image) const;
+
+        static constexpr std::int32_t FALLBACK_DECODER_PRIORITY = 0;
+        static constexpr std::int32_t FAST_DECODER_PRIORITY = 100;
+
+        // number of times the image can be halved without its longer side going below the target size
+        static std::uint32_t GetReductionCount(std::uint32_t width, std::uint32_t height, std::uint32_t targetSize);
+
+    private:
+        struct RegisteredDecoder final
+        {
+            AZStd::unique_ptr<ImageDecoder> m_decoder;
+            std::int32_t m_priority;
+        };
+
+        static bool ConvertToRGBA(CesiumGltf::ImageCesium& image);
+
+        static bool IsUncompressedRGBA(const CesiumGltf::ImageCesium& image);
+
+        static void ReduceToTargetSize(const ImageDecodeOption& option, CesiumGltf::ImageCesium& image);
+
+        mutable AZStd::shared_mutex m_decodersMutex;
+        AZStd::vector<RegisteredDecoder> m_decoders;
+    };
+} // namespace Cesium
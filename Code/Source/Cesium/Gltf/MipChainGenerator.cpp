@@ -0,0 +1,219 @@
+#include "Cesium/Gltf/MipChainGenerator.h"
+#include <AzCore/base.h>
+#include <AzCore/std/algorithm.h>
+#include <cmath>
+
+#if AZ_TRAIT_USE_PLATFORM_SIMD_SSE
+#include <tmmintrin.h>
+#elif AZ_TRAIT_USE_PLATFORM_SIMD_NEON
+#include <arm_neon.h>
+#endif
+
+namespace Cesium
+{
+    MipChainGenerator::SrgbTables::SrgbTables()
+        : m_toLinear{}
+        , m_toSrgb{}
+    {
+        for (std::size_t i = 0; i < m_toLinear.size(); ++i)
+        {
+            float srgb = static_cast<float>(i) / 255.0f;
+            m_toLinear[i] = srgb <= 0.04045f ? srgb / 12.92f : std::pow((srgb + 0.055f) / 1.055f, 2.4f);
+        }
+
+        for (std::size_t i = 0; i < m_toSrgb.size(); ++i)
+        {
+            float linear = static_cast<float>(i) / static_cast<float>(m_toSrgb.size() - 1);
+            float srgb = linear <= 0.0031308f ? linear * 12.92f : 1.055f * std::pow(linear, 1.0f / 2.4f) - 0.055f;
+            m_toSrgb[i] = static_cast<std::uint8_t>(AZStd::clamp(srgb * 255.0f + 0.5f, 0.0f, 255.0f));
+        }
+    }
+
+    std::uint32_t MipChainGenerator::GetMipLevelCount(std::uint32_t width, std::uint32_t height)
+    {
+        std::uint32_t levelCount = 1;
+        std::uint32_t size = AZStd::max(width, height);
+        while (size > 1 && levelCount < MAX_MIP_LEVELS)
+        {
+            size >>= 1;
+            ++levelCount;
+        }
+
+        return levelCount;
+    }
+
+    std::uint32_t MipChainGenerator::GetMipSize(std::uint32_t size, std::uint32_t mipLevel)
+    {
+        return AZStd::max(size >> mipLevel, 1u);
+    }
+
+    void MipChainGenerator::GenerateMip(
+        const std::byte* source,
+        std::uint32_t width,
+        std::uint32_t height,
+        std::uint32_t channelCount,
+        bool srgb,
+        std::byte* destination)
+    {
+        std::uint32_t mipWidth = GetMipSize(width, 1);
+        std::uint32_t mipHeight = GetMipSize(height, 1);
+        std::uint32_t linearChannelStart = srgb ? AZStd::min(channelCount, 3u) : 0;
+        for (std::uint32_t y = 0; y < mipHeight; ++y)
+        {
+            // a source with a size of 1 is only downsampled along the other axis
+            const std::byte* row0 = source + static_cast<std::size_t>(y * 2) * width * channelCount;
+            const std::byte* row1 = source + static_cast<std::size_t>(AZStd::min(y * 2 + 1, height - 1)) * width * channelCount;
+            std::byte* mipRow = destination + static_cast<std::size_t>(y) * mipWidth * channelCount;
+
+            // sRGB channels go through the lookup tables, so only linear images are vectorized
+            std::uint32_t vectorizedWidth = 0;
+            if (linearChannelStart == 0 && width > 1)
+            {
+                vectorizedWidth = GenerateLinearMipRow(row0, row1, mipWidth, channelCount, mipRow);
+            }
+
+            GenerateMipRowScalar(row0, row1, width, channelCount, linearChannelStart, vectorizedWidth, mipWidth, mipRow);
+        }
+    }
+
+    std::uint32_t MipChainGenerator::GenerateLinearMipRow(
+        const std::byte* row0, const std::byte* row1, std::uint32_t mipWidth, std::uint32_t channelCount, std::byte* mipRow)
+    {
+        if (channelCount != 1 && channelCount != 2 && channelCount != 4)
+        {
+            return 0;
+        }
+
+        std::uint32_t vectorizedWidth = 0;
+#if AZ_TRAIT_USE_PLATFORM_SIMD_SSE
+        // 32 bytes of each row make 16 bytes of the mip. The pixels of each pair are interleaved channel by channel, so that
+        // multiplying and adding with ones sums the pair into 16 bits
+        const __m128i ones = _mm_set1_epi8(1);
+        const __m128i two = _mm_set1_epi16(2);
+        __m128i pairShuffle = _mm_setr_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+        if (channelCount == 4)
+        {
+            pairShuffle = _mm_setr_epi8(0, 4, 1, 5, 2, 6, 3, 7, 8, 12, 9, 13, 10, 14, 11, 15);
+        }
+        else if (channelCount == 2)
+        {
+            pairShuffle = _mm_setr_epi8(0, 2, 1, 3, 4, 6, 5, 7, 8, 10, 9, 11, 12, 14, 13, 15);
+        }
+
+        std::uint32_t pixelsPerIteration = BYTES_PER_ITERATION / channelCount;
+        vectorizedWidth = mipWidth - mipWidth % pixelsPerIteration;
+        for (std::uint32_t x = 0; x < vectorizedWidth; x += pixelsPerIteration)
+        {
+            std::size_t offset = static_cast<std::size_t>(x) * 2 * channelCount;
+            const __m128i* input0 = reinterpret_cast<const __m128i*>(row0 + offset);
+            const __m128i* input1 = reinterpret_cast<const __m128i*>(row1 + offset);
+            __m128i low = _mm_add_epi16(
+                _mm_maddubs_epi16(_mm_shuffle_epi8(_mm_loadu_si128(input0), pairShuffle), ones),
+                _mm_maddubs_epi16(_mm_shuffle_epi8(_mm_loadu_si128(input1), pairShuffle), ones));
+            __m128i high = _mm_add_epi16(
+                _mm_maddubs_epi16(_mm_shuffle_epi8(_mm_loadu_si128(input0 + 1), pairShuffle), ones),
+                _mm_maddubs_epi16(_mm_shuffle_epi8(_mm_loadu_si128(input1 + 1), pairShuffle), ones));
+            low = _mm_srli_epi16(_mm_add_epi16(low, two), 2);
+            high = _mm_srli_epi16(_mm_add_epi16(high, two), 2);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(mipRow + static_cast<std::size_t>(x) * channelCount), _mm_packus_epi16(low, high));
+        }
+#elif AZ_TRAIT_USE_PLATFORM_SIMD_NEON
+        // 16 pixels of each row are split into channels, and neighbours are summed pairwise into 8 pixels of the mip
+        const std::uint8_t* input0 = reinterpret_cast<const std::uint8_t*>(row0);
+        const std::uint8_t* input1 = reinterpret_cast<const std::uint8_t*>(row1);
+        std::uint8_t* output = reinterpret_cast<std::uint8_t*>(mipRow);
+        constexpr std::uint32_t pixelsPerIteration = 8;
+        vectorizedWidth = mipWidth - mipWidth % pixelsPerIteration;
+        for (std::uint32_t x = 0; x < vectorizedWidth; x += pixelsPerIteration)
+        {
+            std::size_t offset = static_cast<std::size_t>(x) * 2 * channelCount;
+            std::uint8_t* mipPixels = output + static_cast<std::size_t>(x) * channelCount;
+            if (channelCount == 4)
+            {
+                uint8x16x4_t pixels0 = vld4q_u8(input0 + offset);
+                uint8x16x4_t pixels1 = vld4q_u8(input1 + offset);
+                uint8x8x4_t mipPixel;
+                for (int c = 0; c < 4; ++c)
+                {
+                    mipPixel.val[c] = vrshrn_n_u16(vpadalq_u8(vpaddlq_u8(pixels0.val[c]), pixels1.val[c]), 2);
+                }
+
+                vst4_u8(mipPixels, mipPixel);
+            }
+            else if (channelCount == 2)
+            {
+                uint8x16x2_t pixels0 = vld2q_u8(input0 + offset);
+                uint8x16x2_t pixels1 = vld2q_u8(input1 + offset);
+                uint8x8x2_t mipPixel;
+                mipPixel.val[0] = vrshrn_n_u16(vpadalq_u8(vpaddlq_u8(pixels0.val[0]), pixels1.val[0]), 2);
+                mipPixel.val[1] = vrshrn_n_u16(vpadalq_u8(vpaddlq_u8(pixels0.val[1]), pixels1.val[1]), 2);
+                vst2_u8(mipPixels, mipPixel);
+            }
+            else
+            {
+                vst1_u8(mipPixels, vrshrn_n_u16(vpadalq_u8(vpaddlq_u8(vld1q_u8(input0 + offset)), vld1q_u8(input1 + offset)), 2));
+            }
+        }
+#else
+        AZ_UNUSED(row0);
+        AZ_UNUSED(row1);
+        AZ_UNUSED(mipWidth);
+        AZ_UNUSED(mipRow);
+#endif
+
+        return vectorizedWidth;
+    }
+
+    void MipChainGenerator::GenerateMipRowScalar(
+        const std::byte* row0,
+        const std::byte* row1,
+        std::uint32_t width,
+        std::uint32_t channelCount,
+        std::uint32_t linearChannelStart,
+        std::uint32_t mipXBegin,
+        std::uint32_t mipXEnd,
+        std::byte* mipRow)
+    {
+        const SrgbTables& tables = GetSrgbTables();
+        float toSrgbScale = static_cast<float>(tables.m_toSrgb.size() - 1);
+        for (std::uint32_t x = mipXBegin; x < mipXEnd; ++x)
+        {
+            std::size_t x0 = static_cast<std::size_t>(x * 2) * channelCount;
+            std::size_t x1 = static_cast<std::size_t>(AZStd::min(x * 2 + 1, width - 1)) * channelCount;
+            std::byte* mipPixel = mipRow + static_cast<std::size_t>(x) * channelCount;
+            for (std::uint32_t c = 0; c < linearChannelStart; ++c)
+            {
+                float linear = tables.m_toLinear[static_cast<std::uint8_t>(row0[x0 + c])] +
+                    tables.m_toLinear[static_cast<std::uint8_t>(row0[x1 + c])] +
+                    tables.m_toLinear[static_cast<std::uint8_t>(row1[x0 + c])] +
+                    tables.m_toLinear[static_cast<std::uint8_t>(row1[x1 + c])];
+                mipPixel[c] = static_cast<std::byte>(tables.m_toSrgb[static_cast<std::size_t>(linear * 0.25f * toSrgbScale + 0.5f)]);
+            }
+
+            for (std::uint32_t c = linearChannelStart; c < channelCount; ++c)
+            {
+                std::uint32_t sum = static_cast<std::uint32_t>(row0[x0 + c]) + static_cast<std::uint32_t>(row0[x1 + c]) +
+                    static_cast<std::uint32_t>(row1[x0 + c]) + static_cast<std::uint32_t>(row1[x1 + c]);
+                mipPixel[c] = static_cast<std::byte>((sum + 2) >> 2);
+            }
+        }
+    }
+
+    float MipChainGenerator::SrgbToLinear(std::uint8_t srgb)
+    {
+        return GetSrgbTables().m_toLinear[srgb];
+    }
+
+    std::uint8_t MipChainGenerator::LinearToSrgb(float linear)
+    {
+        const SrgbTables& tables = GetSrgbTables();
+        float toSrgbScale = static_cast<float>(tables.m_toSrgb.size() - 1);
+        return tables.m_toSrgb[static_cast<std::size_t>(AZStd::clamp(linear, 0.0f, 1.0f) * toSrgbScale + 0.5f)];
+    }
+
+    const MipChainGenerator::SrgbTables& MipChainGenerator::GetSrgbTables()
+    {
+        static const SrgbTables tables;
+        return tables;
+    }
+} // namespace Cesium
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <AzCore/std/containers/array.h>
+#include <cstddef>
+#include <cstdint>
+
+namespace Cesium
+{
+    // Downsamples 8 bits per channel images with a 2x2 box filter. The color channels of sRGB images are averaged in linear
+    // space, so that mips don't get darker than the top mip. Odd sizes round down, and the last row or column is dropped.
+    // Linear images with 1, 2 or 4 channels are averaged with SSE or NEON when the platform supports it.
+    class MipChainGenerator final
+    {
+    public:
+        static std::uint32_t GetMipLevelCount(std::uint32_t width, std::uint32_t height);
+
+        static std::uint32_t GetMipSize(std::uint32_t size, std::uint32_t mipLevel);
+
+        // destination has to hold GetMipSize(width, 1) * GetMipSize(height, 1) pixels. Only the first 3 channels are treated as
+        // sRGB, alpha is always linear
+        static void GenerateMip(
+            const std::byte* source,
+            std::uint32_t width,
+            std::uint32_t height,
+            std::uint32_t channelCount,
+            bool srgb,
+            std::byte* destination);
+
+        static float SrgbToLinear(std::uint8_t srgb);
+
+        static std::uint8_t LinearToSrgb(float linear);
+
+        static constexpr std::uint32_t MAX_MIP_LEVELS = 16;
+
+        static constexpr std::uint32_t BYTES_PER_ITERATION = 16;
+
+    private:
+        struct SrgbTables final
+        {
+            SrgbTables();
+
+            AZStd::array<float, 256> m_toLinear;
+            AZStd::array<std::uint8_t, 4096> m_toSrgb;
+        };
+
+        // averages a row of an image with 1, 2 or 4 linear channels with SSE or NEON, and returns how many pixels of the mip row it
+        // wrote. The rest of the row is left to the scalar code
+        static std::uint32_t GenerateLinearMipRow(
+            const std::byte* row0, const std::byte* row1, std::uint32_t mipWidth, std::uint32_t channelCount, std::byte* mipRow);
+
+        static void GenerateMipRowScalar(
+            const std::byte* row0,
+            const std::byte* row1,
+            std::uint32_t width,
+            std::uint32_t channelCount,
+            std::uint32_t linearChannelStart,
+            std::uint32_t mipXBegin,
+            std::uint32_t mipXEnd,
+            std::byte* mipRow);
+
+        static const SrgbTables& GetSrgbTables();
+    };
+} // namespace Cesium
@@ -0,0 +1,105 @@
+#include "Cesium/Gltf/PixelFormatConverter.h"
+#include <AzCore/base.h>
+
+#if AZ_TRAIT_USE_PLATFORM_SIMD_SSE
+#include <tmmintrin.h>
+#elif AZ_TRAIT_USE_PLATFORM_SIMD_NEON
+#include <arm_neon.h>
+#endif
+
+namespace Cesium
+{
+    void PixelFormatConverter::ExpandRGBToRGBA(const std::byte* source, std::size_t pixelCount, std::byte* destination)
+    {
+        std::size_t vectorizedPixelCount = 0;
+#if AZ_TRAIT_USE_PLATFORM_SIMD_SSE
+        // 16 pixels are 3 loads. Each 4 pixels of RGB are shuffled into place and alpha is or-ed in
+        const __m128i shuffle = _mm_setr_epi8(0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1);
+        const __m128i alpha = _mm_set1_epi32(static_cast<int>(0xFF000000));
+        vectorizedPixelCount = pixelCount - pixelCount % PIXELS_PER_ITERATION;
+        for (std::size_t i = 0; i < vectorizedPixelCount; i += PIXELS_PER_ITERATION)
+        {
+            const __m128i* input = reinterpret_cast<const __m128i*>(source + i * 3);
+            __m128i* output = reinterpret_cast<__m128i*>(destination + i * 4);
+            __m128i in0 = _mm_loadu_si128(input);
+            __m128i in1 = _mm_loadu_si128(input + 1);
+            __m128i in2 = _mm_loadu_si128(input + 2);
+            _mm_storeu_si128(output, _mm_or_si128(_mm_shuffle_epi8(in0, shuffle), alpha));
+            _mm_storeu_si128(output + 1, _mm_or_si128(_mm_shuffle_epi8(_mm_alignr_epi8(in1, in0, 12), shuffle), alpha));
+            _mm_storeu_si128(output + 2, _mm_or_si128(_mm_shuffle_epi8(_mm_alignr_epi8(in2, in1, 8), shuffle), alpha));
+            _mm_storeu_si128(output + 3, _mm_or_si128(_mm_shuffle_epi8(_mm_srli_si128(in2, 4), shuffle), alpha));
+        }
+#elif AZ_TRAIT_USE_PLATFORM_SIMD_NEON
+        vectorizedPixelCount = pixelCount - pixelCount % PIXELS_PER_ITERATION;
+        for (std::size_t i = 0; i < vectorizedPixelCount; i += PIXELS_PER_ITERATION)
+        {
+            uint8x16x3_t rgb = vld3q_u8(reinterpret_cast<const std::uint8_t*>(source + i * 3));
+            uint8x16x4_t rgba;
+            rgba.val[0] = rgb.val[0];
+            rgba.val[1] = rgb.val[1];
+            rgba.val[2] = rgb.val[2];
+            rgba.val[3] = vdupq_n_u8(255);
+            vst4q_u8(reinterpret_cast<std::uint8_t*>(destination + i * 4), rgba);
+        }
+#endif
+
+        ExpandRGBToRGBAScalar(source + vectorizedPixelCount * 3, pixelCount - vectorizedPixelCount, destination + vectorizedPixelCount * 4);
+    }
+
+    void PixelFormatConverter::ExtractChannel(
+        const std::byte* source, std::size_t pixelCount, std::uint32_t channelCount, std::uint32_t channel, std::byte* destination)
+    {
+        // only 4 channels images have a vectorized path. Other layouts are rare enough for tiles
+        std::size_t vectorizedPixelCount = 0;
+        if (channelCount == 4)
+        {
+#if AZ_TRAIT_USE_PLATFORM_SIMD_SSE
+            // shift the channel to the low byte of each pixel, then narrow 4 x 4 pixels down to 16 bytes
+            const __m128i mask = _mm_set1_epi32(0xFF);
+            const __m128i shift = _mm_cvtsi32_si128(static_cast<int>(channel * 8));
+            vectorizedPixelCount = pixelCount - pixelCount % PIXELS_PER_ITERATION;
+            for (std::size_t i = 0; i < vectorizedPixelCount; i += PIXELS_PER_ITERATION)
+            {
+                const __m128i* input = reinterpret_cast<const __m128i*>(source + i * 4);
+                __m128i p0 = _mm_and_si128(_mm_srl_epi32(_mm_loadu_si128(input), shift), mask);
+                __m128i p1 = _mm_and_si128(_mm_srl_epi32(_mm_loadu_si128(input + 1), shift), mask);
+                __m128i p2 = _mm_and_si128(_mm_srl_epi32(_mm_loadu_si128(input + 2), shift), mask);
+                __m128i p3 = _mm_and_si128(_mm_srl_epi32(_mm_loadu_si128(input + 3), shift), mask);
+                __m128i packed = _mm_packus_epi16(_mm_packs_epi32(p0, p1), _mm_packs_epi32(p2, p3));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + i), packed);
+            }
+#elif AZ_TRAIT_USE_PLATFORM_SIMD_NEON
+            vectorizedPixelCount = pixelCount - pixelCount % PIXELS_PER_ITERATION;
+            for (std::size_t i = 0; i < vectorizedPixelCount; i += PIXELS_PER_ITERATION)
+            {
+                uint8x16x4_t rgba = vld4q_u8(reinterpret_cast<const std::uint8_t*>(source + i * 4));
+                vst1q_u8(reinterpret_cast<std::uint8_t*>(destination + i), rgba.val[channel]);
+            }
+#endif
+        }
+
+        ExtractChannelScalar(
+            source + vectorizedPixelCount * channelCount, pixelCount - vectorizedPixelCount, channelCount, channel,
+            destination + vectorizedPixelCount);
+    }
+
+    void PixelFormatConverter::ExpandRGBToRGBAScalar(const std::byte* source, std::size_t pixelCount, std::byte* destination)
+    {
+        for (std::size_t i = 0; i < pixelCount; ++i)
+        {
+            destination[i * 4] = source[i * 3];
+            destination[i * 4 + 1] = source[i * 3 + 1];
+            destination[i * 4 + 2] = source[i * 3 + 2];
+            destination[i * 4 + 3] = static_cast<std::byte>(255);
+        }
+    }
+
+    void PixelFormatConverter::ExtractChannelScalar(
+        const std::byte* source, std::size_t pixelCount, std::uint32_t channelCount, std::uint32_t channel, std::byte* destination)
+    {
+        for (std::size_t i = 0; i < pixelCount; ++i)
+        {
+            destination[i] = source[i * channelCount + channel];
+        }
+    }
+} // namespace Cesium
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Cesium
+{
+    // Channel conversion kernels for 8 bits per channel images. 16 pixels are converted per iteration with SSE or NEON when the
+    // platform supports it, and the remaining pixels fall back to scalar code.
+    class PixelFormatConverter final
+    {
+    public:
+        // destination holds pixelCount * 4 bytes. Alpha is set to opaque
+        static void ExpandRGBToRGBA(const std::byte* source, std::size_t pixelCount, std::byte* destination);
+
+        // destination holds pixelCount bytes
+        static void ExtractChannel(
+            const std::byte* source, std::size_t pixelCount, std::uint32_t channelCount, std::uint32_t channel, std::byte* destination);
+
+        static constexpr std::size_t PIXELS_PER_ITERATION = 16;
+
+    private:
+        static void ExpandRGBToRGBAScalar(const std::byte* source, std::size_t pixelCount, std::byte* destination);
+
+        static void ExtractChannelScalar(
+            const std::byte* source, std::size_t pixelCount, std::uint32_t channelCount, std::uint32_t channel, std::byte* destination);
+    };
+} // namespace Cesium
@@ -0,0 +1,237 @@
+#include "Cesium/Gltf/SharedTextureCache.h"
+#include <Atom/RPI.Reflect/Image/StreamingImageAsset.h>
+#include <AzCore/std/algorithm.h>
+#include <AzCore/std/hash.h>
+#include <cstring>
+
+namespace Cesium
+{
+    namespace
+    {
+        constexpr std::uint64_t PRIME_1 = 0x9E3779B185EBCA87ull;
+        constexpr std::uint64_t PRIME_2 = 0xC2B2AE3D27D4EB4Full;
+        constexpr std::uint64_t PRIME_3 = 0x165667B19E3779F9ull;
+        constexpr std::uint64_t PRIME_4 = 0x85EBCA77C2B2AE63ull;
+
+        // the two hashes use different primes, seeds and rotations, so that they don't collide on the same inputs
+        struct HashParameters
+        {
+            std::uint64_t m_multiplier;
+            std::uint64_t m_wordMultiplier;
+            std::uint32_t m_rotation;
+            std::uint64_t m_seeds[4];
+        };
+
+        constexpr HashParameters FIRST_HASH = { PRIME_1, PRIME_2, 31, { PRIME_1 + PRIME_2, PRIME_2, 0, 0 - PRIME_1 } };
+        constexpr HashParameters SECOND_HASH = { PRIME_3, PRIME_4, 27, { PRIME_3, PRIME_3 + PRIME_4, PRIME_4, 0 - PRIME_3 } };
+
+        std::uint64_t RotateLeft(std::uint64_t value, std::uint32_t count)
+        {
+            return (value << count) | (value >> (64 - count));
+        }
+
+        std::uint64_t MixWord(std::uint64_t lane, std::uint64_t word, const HashParameters& parameters)
+        {
+            return RotateLeft(lane + word * parameters.m_wordMultiplier, parameters.m_rotation) * parameters.m_multiplier;
+        }
+
+        std::uint64_t FinishHash(
+            const std::uint64_t (&lanes)[4],
+            const std::byte* tail,
+            std::size_t tailSize,
+            std::size_t byteSize,
+            const HashParameters& parameters)
+        {
+            std::uint64_t hash = RotateLeft(lanes[0], 1) + RotateLeft(lanes[1], 7) + RotateLeft(lanes[2], 12) + RotateLeft(lanes[3], 18);
+            hash ^= static_cast<std::uint64_t>(byteSize) * parameters.m_multiplier;
+            for (std::size_t i = 0; i < tailSize; ++i)
+            {
+                hash = RotateLeft(hash ^ (static_cast<std::uint64_t>(tail[i]) * parameters.m_wordMultiplier), 11) * parameters.m_multiplier;
+            }
+
+            hash ^= hash >> 33;
+            hash *= parameters.m_wordMultiplier;
+            hash ^= hash >> 29;
+            return hash;
+        }
+    } // namespace
+
+    SharedTexturePixelHash::SharedTexturePixelHash()
+        : m_first{ 0 }
+        , m_second{ 0 }
+    {
+    }
+
+    SharedTexturePixelHash::SharedTexturePixelHash(std::uint64_t first, std::uint64_t second)
+        : m_first{ first }
+        , m_second{ second }
+    {
+    }
+
+    bool SharedTexturePixelHash::operator==(const SharedTexturePixelHash& rhs) const
+    {
+        return m_first == rhs.m_first && m_second == rhs.m_second;
+    }
+
+    bool SharedTexturePixelHash::operator!=(const SharedTexturePixelHash& rhs) const
+    {
+        return !(*this == rhs);
+    }
+
+    SharedTextureKey::SharedTextureKey()
+        : m_pixelHash{}
+        , m_width{ 0 }
+        , m_height{ 0 }
+        , m_channelCount{ 0 }
+        , m_srgb{ false }
+        , m_generateMipmaps{ false }
+        , m_compress{ false }
+    {
+    }
+
+    SharedTextureKey::SharedTextureKey(
+        const SharedTexturePixelHash& pixelHash,
+        std::uint32_t width,
+        std::uint32_t height,
+        std::uint32_t channelCount,
+        const StreamingImageBuilderOption& option)
+        : m_pixelHash{ pixelHash }
+        , m_width{ width }
+        , m_height{ height }
+        , m_channelCount{ channelCount }
+        , m_srgb{ option.m_srgb }
+        , m_generateMipmaps{ option.m_generateMipmaps }
+        , m_compress{ option.m_compress }
+    {
+    }
+
+    bool SharedTextureKey::operator==(const SharedTextureKey& rhs) const
+    {
+        return m_pixelHash == rhs.m_pixelHash && m_width == rhs.m_width && m_height == rhs.m_height &&
+            m_channelCount == rhs.m_channelCount && m_srgb == rhs.m_srgb && m_generateMipmaps == rhs.m_generateMipmaps &&
+            m_compress == rhs.m_compress;
+    }
+
+    std::size_t SharedTextureKeyHasher::operator()(const SharedTextureKey& key) const
+    {
+        std::size_t seed = static_cast<std::size_t>(key.m_pixelHash.m_first);
+        AZStd::hash_combine(seed, key.m_width);
+        AZStd::hash_combine(seed, key.m_height);
+        AZStd::hash_combine(seed, key.m_channelCount);
+        AZStd::hash_combine(seed, (key.m_srgb ? 1u : 0u) | (key.m_generateMipmaps ? 2u : 0u) | (key.m_compress ? 4u : 0u));
+        return seed;
+    }
+
+    SharedTextureCache::SharedTextureCache()
+        : m_pruneSize{ MIN_PRUNE_SIZE }
+    {
+    }
+
+    AZ::Data::Asset<AZ::RPI::StreamingImageAsset> SharedTextureCache::GetOrCreate(
+        const std::byte* pixels,
+        std::uint32_t width,
+        std::uint32_t height,
+        std::uint32_t channelCount,
+        const StreamingImageBuilderOption& option)
+    {
+        if (!pixels || width == 0 || height == 0)
+        {
+            return {};
+        }
+
+        std::size_t byteSize = static_cast<std::size_t>(width) * height * channelCount;
+        SharedTextureKey key{ HashPixels(pixels, byteSize), width, height, channelCount, option };
+        {
+            AZStd::lock_guard<AZStd::mutex> lock(m_imagesMutex);
+            auto cachedImage = m_images.find(key);
+            if (cachedImage != m_images.end())
+            {
+                return cachedImage->second;
+            }
+        }
+
+        // build the image outside of the lock, so that load threads don't wait on each other's mips and compression.
+        // If another thread created the same image in the meantime, its asset wins and this one is dropped
+        AZ::Data::Asset<AZ::RPI::StreamingImageAsset> newImage = StreamingImageBuilder::Create(pixels, width, height, channelCount, option);
+        if (!newImage)
+        {
+            return {};
+        }
+
+        AZStd::lock_guard<AZStd::mutex> lock(m_imagesMutex);
+        auto cachedImage = m_images.find(key);
+        if (cachedImage != m_images.end())
+        {
+            return cachedImage->second;
+        }
+
+        m_images.emplace(key, newImage);
+        if (m_images.size() >= m_pruneSize)
+        {
+            EraseUnreferencedImages();
+        }
+
+        return newImage;
+    }
+
+    std::size_t SharedTextureCache::GetSize()
+    {
+        AZStd::lock_guard<AZStd::mutex> lock(m_imagesMutex);
+        return m_images.size();
+    }
+
+    void SharedTextureCache::Clear()
+    {
+        AZStd::lock_guard<AZStd::mutex> lock(m_imagesMutex);
+        m_images.clear();
+        m_pruneSize = MIN_PRUNE_SIZE;
+    }
+
+    void SharedTextureCache::RemoveUnreferencedImages()
+    {
+        AZStd::lock_guard<AZStd::mutex> lock(m_imagesMutex);
+        EraseUnreferencedImages();
+    }
+
+    SharedTexturePixelHash SharedTextureCache::HashPixels(const std::byte* pixels, std::size_t byteSize)
+    {
+        // 4 independent lanes of 8 bytes per hash keep the multiplies pipelined, so both hashes run close to memory bandwidth
+        std::uint64_t firstLanes[4] = { FIRST_HASH.m_seeds[0], FIRST_HASH.m_seeds[1], FIRST_HASH.m_seeds[2], FIRST_HASH.m_seeds[3] };
+        std::uint64_t secondLanes[4] = { SECOND_HASH.m_seeds[0], SECOND_HASH.m_seeds[1], SECOND_HASH.m_seeds[2], SECOND_HASH.m_seeds[3] };
+        std::size_t offset = 0;
+        for (; offset + 32 <= byteSize; offset += 32)
+        {
+            for (std::size_t i = 0; i < 4; ++i)
+            {
+                std::uint64_t word;
+                std::memcpy(&word, pixels + offset + i * 8, sizeof(word));
+                firstLanes[i] = MixWord(firstLanes[i], word, FIRST_HASH);
+                secondLanes[i] = MixWord(secondLanes[i], word, SECOND_HASH);
+            }
+        }
+
+        const std::byte* tail = pixels + offset;
+        std::size_t tailSize = byteSize - offset;
+        return SharedTexturePixelHash{ FinishHash(firstLanes, tail, tailSize, byteSize, FIRST_HASH),
+                                       FinishHash(secondLanes, tail, tailSize, byteSize, SECOND_HASH) };
+    }
+
+    void SharedTextureCache::EraseUnreferencedImages()
+    {
+        // an image that is only referenced by the cache isn't used by any tile any more
+        for (auto it = m_images.begin(); it != m_images.end();)
+        {
+            if (!it->second || it->second->GetUseCount() <= 1)
+            {
+                it = m_images.erase(it);
+            }
+            else
+            {
+                ++it;
+            }
+        }
+
+        // prune again once the cache doubles, so the cost stays amortized over insertions
+        m_pruneSize = AZStd::max(MIN_PRUNE_SIZE, m_images.size() * 2);
+    }
+} // namespace Cesium
@@ -0,0 +1,101 @@
+#pragma once
+
+#include "Cesium/Gltf/StreamingImageBuilder.h"
+#include <AzCore/Asset/AssetCommon.h>
+#include <AzCore/std/containers/unordered_map.h>
+#include <AzCore/std/parallel/mutex.h>
+#include <cstddef>
+#include <cstdint>
+
+namespace AZ
+{
+    namespace RPI
+    {
+        class StreamingImageAsset;
+    }
+} // namespace AZ
+
+namespace Cesium
+{
+    // 128 bits made of two 64 bits hashes that are computed independently in the same pass over the pixels
+    struct SharedTexturePixelHash final
+    {
+        SharedTexturePixelHash();
+
+        SharedTexturePixelHash(std::uint64_t first, std::uint64_t second);
+
+        bool operator==(const SharedTexturePixelHash& rhs) const;
+
+        bool operator!=(const SharedTexturePixelHash& rhs) const;
+
+        std::uint64_t m_first;
+        std::uint64_t m_second;
+    };
+
+    struct SharedTextureKey final
+    {
+        SharedTextureKey();
+
+        SharedTextureKey(
+            const SharedTexturePixelHash& pixelHash,
+            std::uint32_t width,
+            std::uint32_t height,
+            std::uint32_t channelCount,
+            const StreamingImageBuilderOption& option);
+
+        bool operator==(const SharedTextureKey& rhs) const;
+
+        SharedTexturePixelHash m_pixelHash;
+        std::uint32_t m_width;
+        std::uint32_t m_height;
+        std::uint32_t m_channelCount;
+        bool m_srgb;
+        bool m_generateMipmaps;
+        bool m_compress;
+    };
+
+    struct SharedTextureKeyHasher final
+    {
+        std::size_t operator()(const SharedTextureKey& key) const;
+    };
+
+    // Texture cache shared by all the tiles of a tileset. Images are keyed by a 128 bits hash of their decoded pixels and their
+    // format, so atlases and facade textures that many tiles embed are only created once. The cache keeps no copy of the pixels:
+    // at 128 bits a collision between the textures of a tileset is far less likely than a corrupted download. The cache doesn't
+    // keep images alive: entries that nothing else references any more are dropped when the cache grows, or when the owner
+    // removes them after freeing tiles. It is safe to use from multiple load threads.
+    class SharedTextureCache final
+    {
+    public:
+        SharedTextureCache();
+
+        SharedTextureCache(const SharedTextureCache&) = delete;
+
+        SharedTextureCache& operator=(const SharedTextureCache&) = delete;
+
+        AZ::Data::Asset<AZ::RPI::StreamingImageAsset> GetOrCreate(
+            const std::byte* pixels,
+            std::uint32_t width,
+            std::uint32_t height,
+            std::uint32_t channelCount,
+            const StreamingImageBuilderOption& option);
+
+        std::size_t GetSize();
+
+        void Clear();
+
+        // drops the entries that nothing else references any more
+        void RemoveUnreferencedImages();
+
+        static SharedTexturePixelHash HashPixels(const std::byte* pixels, std::size_t byteSize);
+
+    private:
+        void EraseUnreferencedImages();
+
+        static constexpr std::size_t MIN_PRUNE_SIZE = 64;
+
+        AZStd::mutex m_imagesMutex;
+        AZStd::unordered_map<SharedTextureKey, AZ::Data::Asset<AZ::RPI::StreamingImageAsset>, SharedTextureKeyHasher> m_images;
+        std::size_t m_pruneSize;
+    };
+} // namespace Cesium
@@ -0,0 +1,185 @@
+#include "Cesium/Gltf/StreamingImageBuilder.h"
+#include "Cesium/Gltf/GltfLoadScratchArena.h"
+#include "Cesium/Gltf/MipChainGenerator.h"
+#include "Cesium/Gltf/TextureBlockCompressor.h"
+#include "Cesium/Systems/CesiumSystem.h"
+#include "Cesium/Systems/CriticalAssetManager.h"
+#include <Atom/RPI.Reflect/Image/StreamingImageAsset.h>
+#include <Atom/RPI.Reflect/Image/StreamingImageAssetCreator.h>
+#include <Atom/RPI.Reflect/Image/ImageMipChainAssetCreator.h>
+#include <AzCore/std/containers/array.h>
+#include <AzCore/std/algorithm.h>
+
+namespace Cesium
+{
+    StreamingImageBuilderOption::StreamingImageBuilderOption()
+        : m_srgb{ false }
+        , m_generateMipmaps{ false }
+        , m_compress{ false }
+    {
+    }
+
+    AZ::Data::Asset<AZ::RPI::StreamingImageAsset> StreamingImageBuilder::Create(
+        const std::byte* pixels,
+        std::uint32_t width,
+        std::uint32_t height,
+        std::uint32_t channelCount,
+        const StreamingImageBuilderOption& option)
+    {
+        GltfLoadScratchArena& scratchArena = CesiumInterface::Get()->GetGltfLoadScratchArenaPool().GetThreadArena();
+        return Create(pixels, width, height, channelCount, option, scratchArena);
+    }
+
+    AZ::Data::Asset<AZ::RPI::StreamingImageAsset> StreamingImageBuilder::Create(
+        const std::byte* pixels,
+        std::uint32_t width,
+        std::uint32_t height,
+        std::uint32_t channelCount,
+        const StreamingImageBuilderOption& option,
+        GltfLoadScratchArena& scratchArena)
+    {
+        if (!pixels || width == 0 || height == 0 || (channelCount != 1 && channelCount != 4))
+        {
+            return {};
+        }
+
+        // the top mip is read from the source directly. The other mips are stored one after another in the scratch arena
+        std::uint32_t levelCount = option.m_generateMipmaps ? MipChainGenerator::GetMipLevelCount(width, height) : 1;
+        AZStd::array<const std::byte*, MipChainGenerator::MAX_MIP_LEVELS> levelPixels{};
+        AZStd::array<std::size_t, MipChainGenerator::MAX_MIP_LEVELS> levelSizes{};
+        for (std::uint32_t level = 0; level < levelCount; ++level)
+        {
+            levelSizes[level] = static_cast<std::size_t>(MipChainGenerator::GetMipSize(width, level)) *
+                MipChainGenerator::GetMipSize(height, level) * channelCount;
+        }
+
+        std::size_t mipChainSize = 0;
+        for (std::uint32_t level = 1; level < levelCount; ++level)
+        {
+            mipChainSize += levelSizes[level];
+        }
+
+        AZStd::vector<std::byte>& mipChain = scratchArena.GetScratchBuffer(GltfScratchBufferSlot::MipChain, mipChainSize);
+        levelPixels[0] = pixels;
+        std::size_t mipOffset = 0;
+        for (std::uint32_t level = 1; level < levelCount; ++level)
+        {
+            std::byte* mip = mipChain.data() + mipOffset;
+            MipChainGenerator::GenerateMip(
+                levelPixels[level - 1], MipChainGenerator::GetMipSize(width, level - 1), MipChainGenerator::GetMipSize(height, level - 1),
+                channelCount, option.m_srgb, mip);
+            levelPixels[level] = mip;
+            mipOffset += levelSizes[level];
+        }
+
+        // pick the format. Opaque color images don't need the alpha block of BC3
+        bool compress = option.m_compress && TextureBlockCompressor::CanCompress(width, height);
+        AZ::RHI::Format format = AZ::RHI::Format::Unknown;
+        if (channelCount == 1)
+        {
+            format = compress ? AZ::RHI::Format::BC4_UNORM : AZ::RHI::Format::R8_UNORM;
+        }
+        else if (!compress)
+        {
+            format = option.m_srgb ? AZ::RHI::Format::R8G8B8A8_UNORM_SRGB : AZ::RHI::Format::R8G8B8A8_UNORM;
+        }
+        else if (TextureBlockCompressor::IsOpaque(pixels, width, height))
+        {
+            format = option.m_srgb ? AZ::RHI::Format::BC1_UNORM_SRGB : AZ::RHI::Format::BC1_UNORM;
+        }
+        else
+        {
+            format = option.m_srgb ? AZ::RHI::Format::BC3_UNORM_SRGB : AZ::RHI::Format::BC3_UNORM;
+        }
+
+        if (compress)
+        {
+            AZStd::array<std::size_t, MipChainGenerator::MAX_MIP_LEVELS> blockSizes{};
+            std::size_t totalBlockSize = 0;
+            for (std::uint32_t level = 0; level < levelCount; ++level)
+            {
+                std::uint32_t mipWidth = MipChainGenerator::GetMipSize(width, level);
+                std::uint32_t mipHeight = MipChainGenerator::GetMipSize(height, level);
+                if (channelCount == 1)
+                {
+                    blockSizes[level] = TextureBlockCompressor::GetBC4Size(mipWidth, mipHeight);
+                }
+                else if (format == AZ::RHI::Format::BC1_UNORM_SRGB || format == AZ::RHI::Format::BC1_UNORM)
+                {
+                    blockSizes[level] = TextureBlockCompressor::GetBC1Size(mipWidth, mipHeight);
+                }
+                else
+                {
+                    blockSizes[level] = TextureBlockCompressor::GetBC3Size(mipWidth, mipHeight);
+                }
+
+                totalBlockSize += blockSizes[level];
+            }
+
+            AZStd::vector<std::byte>& blocks = scratchArena.GetScratchBuffer(GltfScratchBufferSlot::BlockCompressed, totalBlockSize);
+            std::size_t blockOffset = 0;
+            for (std::uint32_t level = 0; level < levelCount; ++level)
+            {
+                std::uint32_t mipWidth = MipChainGenerator::GetMipSize(width, level);
+                std::uint32_t mipHeight = MipChainGenerator::GetMipSize(height, level);
+                std::byte* output = blocks.data() + blockOffset;
+                if (channelCount == 1)
+                {
+                    TextureBlockCompressor::CompressBC4(levelPixels[level], mipWidth, mipHeight, 1, 0, output);
+                }
+                else if (format == AZ::RHI::Format::BC1_UNORM_SRGB || format == AZ::RHI::Format::BC1_UNORM)
+                {
+                    TextureBlockCompressor::CompressBC1(levelPixels[level], mipWidth, mipHeight, 4, output);
+                }
+                else
+                {
+                    TextureBlockCompressor::CompressBC3(levelPixels[level], mipWidth, mipHeight, output);
+                }
+
+                levelPixels[level] = output;
+                levelSizes[level] = blockSizes[level];
+                blockOffset += blockSizes[level];
+            }
+        }
+
+        AZ::RHI::ImageDescriptor imageDesc;
+        imageDesc.m_bindFlags = AZ::RHI::ImageBindFlags::ShaderRead;
+        imageDesc.m_dimension = AZ::RHI::ImageDimension::Image2D;
+        imageDesc.m_size = AZ::RHI::Size(width, height, 1);
+        imageDesc.m_mipLevels = static_cast<std::uint16_t>(levelCount);
+        imageDesc.m_format = format;
+
+        // Create mip chains. Large mips get a chain each, and the small ones are grouped into the tail chain
+        const CriticalAssetManager& criticalAssetManager = CesiumInterface::Get()->GetCriticalAssetManager();
+        AZ::RPI::StreamingImageAssetCreator imageCreator;
+        imageCreator.Begin(criticalAssetManager.GenerateRandomAssetId());
+        imageCreator.SetImageDescriptor(imageDesc);
+        std::uint32_t chainStart = 0;
+        while (chainStart < levelCount)
+        {
+            std::uint32_t mipSize =
+                AZStd::max(MipChainGenerator::GetMipSize(width, chainStart), MipChainGenerator::GetMipSize(height, chainStart));
+            std::uint32_t chainLevelCount = mipSize > MAX_TAIL_MIP_SIZE ? 1 : levelCount - chainStart;
+
+            AZ::RPI::ImageMipChainAssetCreator mipChainCreator;
+            mipChainCreator.Begin(criticalAssetManager.GenerateRandomAssetId(), static_cast<std::uint16_t>(chainLevelCount), 1);
+            for (std::uint32_t level = chainStart; level < chainStart + chainLevelCount; ++level)
+            {
+                AZ::RHI::ImageSubresource subresource;
+                subresource.m_mipSlice = static_cast<std::uint16_t>(level);
+                mipChainCreator.BeginMip(AZ::RHI::GetImageSubresourceLayout(imageDesc, subresource));
+                mipChainCreator.AddSubImage(levelPixels[level], levelSizes[level]);
+                mipChainCreator.EndMip();
+            }
+
+            AZ::Data::Asset<AZ::RPI::ImageMipChainAsset> mipChainAsset;
+            mipChainCreator.End(mipChainAsset);
+            imageCreator.AddMipChainAsset(*mipChainAsset);
+            chainStart += chainLevelCount;
+        }
+
+        AZ::Data::Asset<AZ::RPI::StreamingImageAsset> imageAsset;
+        imageCreator.End(imageAsset);
+        return imageAsset;
+    }
+} // namespace Cesium
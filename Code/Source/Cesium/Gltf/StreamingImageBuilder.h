@@ -0,0 +1,54 @@
+#pragma once
+
+#include <AzCore/Asset/AssetCommon.h>
+#include <cstddef>
+#include <cstdint>
+
+namespace AZ
+{
+    namespace RPI
+    {
+        class StreamingImageAsset;
+    }
+} // namespace AZ
+
+namespace Cesium
+{
+    class GltfLoadScratchArena;
+
+    struct StreamingImageBuilderOption final
+    {
+        StreamingImageBuilderOption();
+
+        bool m_srgb;
+        bool m_generateMipmaps;
+        bool m_compress;
+    };
+
+    // Creates streaming image assets from tightly packed 8 bits per channel pixels with either 1 or 4 channels. Mips are generated
+    // and block compressed on the calling thread using the scratch arena of the thread. Every mip larger than the tail gets its own
+    // mip chain asset, so that the streaming image pool can evict them under memory pressure.
+    class StreamingImageBuilder final
+    {
+    public:
+        static AZ::Data::Asset<AZ::RPI::StreamingImageAsset> Create(
+            const std::byte* pixels,
+            std::uint32_t width,
+            std::uint32_t height,
+            std::uint32_t channelCount,
+            const StreamingImageBuilderOption& option);
+
+        // same as above, but the mips and blocks are built in the given arena. Callers outside of the glTF load pipeline pass an arena
+        // of their own, so that they never touch the scratch memory of a worker thread that the tile loads share
+        static AZ::Data::Asset<AZ::RPI::StreamingImageAsset> Create(
+            const std::byte* pixels,
+            std::uint32_t width,
+            std::uint32_t height,
+            std::uint32_t channelCount,
+            const StreamingImageBuilderOption& option,
+            GltfLoadScratchArena& scratchArena);
+
+    private:
+        static constexpr std::uint32_t MAX_TAIL_MIP_SIZE = 64;
+    };
+} // namespace Cesium
@@ -0,0 +1,360 @@
+#include "Cesium/Gltf/TextureBlockCompressor.h"
+#include <AzCore/std/algorithm.h>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace Cesium
+{
+    namespace
+    {
+        // weight of color0 for each BC1 index in 4-color mode
+        constexpr float COLOR0_WEIGHTS[4] = { 1.0f, 0.0f, 2.0f / 3.0f, 1.0f / 3.0f };
+
+        void WriteUint16(std::uint16_t value, std::byte* output)
+        {
+            output[0] = static_cast<std::byte>(value & 0xFF);
+            output[1] = static_cast<std::byte>(value >> 8);
+        }
+    } // namespace
+
+    bool TextureBlockCompressor::CanCompress(std::uint32_t width, std::uint32_t height)
+    {
+        return width > 0 && height > 0 && width % BLOCK_SIZE == 0 && height % BLOCK_SIZE == 0;
+    }
+
+    std::size_t TextureBlockCompressor::GetBC1Size(std::uint32_t width, std::uint32_t height)
+    {
+        return GetBlockCount(width, height) * BC1_BLOCK_BYTES;
+    }
+
+    std::size_t TextureBlockCompressor::GetBC3Size(std::uint32_t width, std::uint32_t height)
+    {
+        return GetBlockCount(width, height) * BC3_BLOCK_BYTES;
+    }
+
+    std::size_t TextureBlockCompressor::GetBC4Size(std::uint32_t width, std::uint32_t height)
+    {
+        return GetBlockCount(width, height) * BC4_BLOCK_BYTES;
+    }
+
+    std::size_t TextureBlockCompressor::GetBlockCount(std::uint32_t width, std::uint32_t height)
+    {
+        return static_cast<std::size_t>((width + BLOCK_SIZE - 1) / BLOCK_SIZE) * ((height + BLOCK_SIZE - 1) / BLOCK_SIZE);
+    }
+
+    bool TextureBlockCompressor::IsOpaque(const std::byte* pixels, std::uint32_t width, std::uint32_t height)
+    {
+        std::size_t pixelCount = static_cast<std::size_t>(width) * height;
+        for (std::size_t i = 0; i < pixelCount; ++i)
+        {
+            if (pixels[i * 4 + 3] != static_cast<std::byte>(255))
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    void TextureBlockCompressor::CompressBC1(
+        const std::byte* pixels, std::uint32_t width, std::uint32_t height, std::uint32_t channelCount, std::byte* output)
+    {
+        ColorBlock block;
+        for (std::uint32_t blockY = 0; blockY < (height + BLOCK_SIZE - 1) / BLOCK_SIZE; ++blockY)
+        {
+            for (std::uint32_t blockX = 0; blockX < (width + BLOCK_SIZE - 1) / BLOCK_SIZE; ++blockX)
+            {
+                LoadColorBlock(pixels, width, height, channelCount, blockX, blockY, block);
+                EncodeColorBlock(block, output);
+                output += BC1_BLOCK_BYTES;
+            }
+        }
+    }
+
+    void TextureBlockCompressor::CompressBC3(const std::byte* pixels, std::uint32_t width, std::uint32_t height, std::byte* output)
+    {
+        ColorBlock colorBlock;
+        ChannelBlock alphaBlock;
+        for (std::uint32_t blockY = 0; blockY < (height + BLOCK_SIZE - 1) / BLOCK_SIZE; ++blockY)
+        {
+            for (std::uint32_t blockX = 0; blockX < (width + BLOCK_SIZE - 1) / BLOCK_SIZE; ++blockX)
+            {
+                // BC3 is a BC4 alpha block followed by a BC1 color block
+                LoadChannelBlock(pixels, width, height, 4, 3, blockX, blockY, alphaBlock);
+                EncodeChannelBlock(alphaBlock, output);
+                LoadColorBlock(pixels, width, height, 4, blockX, blockY, colorBlock);
+                EncodeColorBlock(colorBlock, output + BC4_BLOCK_BYTES);
+                output += BC3_BLOCK_BYTES;
+            }
+        }
+    }
+
+    void TextureBlockCompressor::CompressBC4(
+        const std::byte* pixels,
+        std::uint32_t width,
+        std::uint32_t height,
+        std::uint32_t channelCount,
+        std::uint32_t channel,
+        std::byte* output)
+    {
+        ChannelBlock block;
+        for (std::uint32_t blockY = 0; blockY < (height + BLOCK_SIZE - 1) / BLOCK_SIZE; ++blockY)
+        {
+            for (std::uint32_t blockX = 0; blockX < (width + BLOCK_SIZE - 1) / BLOCK_SIZE; ++blockX)
+            {
+                LoadChannelBlock(pixels, width, height, channelCount, channel, blockX, blockY, block);
+                EncodeChannelBlock(block, output);
+                output += BC4_BLOCK_BYTES;
+            }
+        }
+    }
+
+    void TextureBlockCompressor::LoadColorBlock(
+        const std::byte* pixels,
+        std::uint32_t width,
+        std::uint32_t height,
+        std::uint32_t channelCount,
+        std::uint32_t blockX,
+        std::uint32_t blockY,
+        ColorBlock& block)
+    {
+        // blocks past the edge of the image repeat the last row and column
+        for (std::uint32_t y = 0; y < BLOCK_SIZE; ++y)
+        {
+            std::size_t row = static_cast<std::size_t>(AZStd::min(blockY * BLOCK_SIZE + y, height - 1)) * width;
+            for (std::uint32_t x = 0; x < BLOCK_SIZE; ++x)
+            {
+                const std::byte* pixel = pixels + (row + AZStd::min(blockX * BLOCK_SIZE + x, width - 1)) * channelCount;
+                block[y * BLOCK_SIZE + x] = glm::vec3(
+                    static_cast<std::uint8_t>(pixel[0]), static_cast<std::uint8_t>(pixel[1]), static_cast<std::uint8_t>(pixel[2]));
+            }
+        }
+    }
+
+    void TextureBlockCompressor::LoadChannelBlock(
+        const std::byte* pixels,
+        std::uint32_t width,
+        std::uint32_t height,
+        std::uint32_t channelCount,
+        std::uint32_t channel,
+        std::uint32_t blockX,
+        std::uint32_t blockY,
+        ChannelBlock& block)
+    {
+        // blocks past the edge of the image repeat the last row and column
+        for (std::uint32_t y = 0; y < BLOCK_SIZE; ++y)
+        {
+            std::size_t row = static_cast<std::size_t>(AZStd::min(blockY * BLOCK_SIZE + y, height - 1)) * width;
+            for (std::uint32_t x = 0; x < BLOCK_SIZE; ++x)
+            {
+                const std::byte* pixel = pixels + (row + AZStd::min(blockX * BLOCK_SIZE + x, width - 1)) * channelCount;
+                block[y * BLOCK_SIZE + x] = static_cast<std::uint8_t>(pixel[channel]);
+            }
+        }
+    }
+
+    void TextureBlockCompressor::EncodeColorBlock(const ColorBlock& block, std::byte* output)
+    {
+        glm::vec3 mean{ 0.0f };
+        glm::vec3 minColor{ 255.0f };
+        glm::vec3 maxColor{ 0.0f };
+        for (const glm::vec3& color : block)
+        {
+            mean += color;
+            minColor = glm::min(minColor, color);
+            maxColor = glm::max(maxColor, color);
+        }
+        mean /= static_cast<float>(PIXELS_PER_BLOCK);
+
+        AZStd::array<std::uint8_t, PIXELS_PER_BLOCK> indices{};
+        std::uint16_t color0 = QuantizeRGB565(mean);
+        std::uint16_t color1 = color0;
+        if (minColor != maxColor)
+        {
+            // the principal axis of the covariance matrix is found with a few power iterations, starting from the bounding box diagonal
+            float covariance[6] = { 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f };
+            for (const glm::vec3& color : block)
+            {
+                glm::vec3 d = color - mean;
+                covariance[0] += d.r * d.r;
+                covariance[1] += d.r * d.g;
+                covariance[2] += d.r * d.b;
+                covariance[3] += d.g * d.g;
+                covariance[4] += d.g * d.b;
+                covariance[5] += d.b * d.b;
+            }
+
+            glm::vec3 axis = maxColor - minColor;
+            for (std::uint32_t i = 0; i < POWER_ITERATION_COUNT; ++i)
+            {
+                glm::vec3 next{ covariance[0] * axis.r + covariance[1] * axis.g + covariance[2] * axis.b,
+                                covariance[1] * axis.r + covariance[3] * axis.g + covariance[4] * axis.b,
+                                covariance[2] * axis.r + covariance[4] * axis.g + covariance[5] * axis.b };
+                float largest = std::max({ std::abs(next.r), std::abs(next.g), std::abs(next.b) });
+                if (largest == 0.0f)
+                {
+                    break;
+                }
+
+                axis = next / largest;
+            }
+
+            // endpoints are the colors at the extremes of the axis
+            std::size_t minIndex = 0;
+            std::size_t maxIndex = 0;
+            float minProjection = glm::dot(block[0], axis);
+            float maxProjection = minProjection;
+            for (std::size_t i = 1; i < block.size(); ++i)
+            {
+                float projection = glm::dot(block[i], axis);
+                if (projection < minProjection)
+                {
+                    minProjection = projection;
+                    minIndex = i;
+                }
+                else if (projection > maxProjection)
+                {
+                    maxProjection = projection;
+                    maxIndex = i;
+                }
+            }
+
+            color0 = QuantizeRGB565(block[maxIndex]);
+            color1 = QuantizeRGB565(block[minIndex]);
+            float error = FindColorIndices(block, color0, color1, indices);
+
+            // refine the endpoints once with the least squares fit of the chosen indices
+            float aa = 0.0f;
+            float bb = 0.0f;
+            float ab = 0.0f;
+            glm::vec3 ax{ 0.0f };
+            glm::vec3 bx{ 0.0f };
+            for (std::size_t i = 0; i < block.size(); ++i)
+            {
+                float a = COLOR0_WEIGHTS[indices[i]];
+                float b = 1.0f - a;
+                aa += a * a;
+                bb += b * b;
+                ab += a * b;
+                ax += a * block[i];
+                bx += b * block[i];
+            }
+
+            float determinant = aa * bb - ab * ab;
+            if (std::abs(determinant) > 1e-6f)
+            {
+                glm::vec3 refinedColor0 = glm::clamp((ax * bb - bx * ab) / determinant, 0.0f, 255.0f);
+                glm::vec3 refinedColor1 = glm::clamp((bx * aa - ax * ab) / determinant, 0.0f, 255.0f);
+                std::uint16_t refined0 = QuantizeRGB565(refinedColor0);
+                std::uint16_t refined1 = QuantizeRGB565(refinedColor1);
+                AZStd::array<std::uint8_t, PIXELS_PER_BLOCK> refinedIndices{};
+                if (FindColorIndices(block, refined0, refined1, refinedIndices) < error)
+                {
+                    color0 = refined0;
+                    color1 = refined1;
+                    indices = refinedIndices;
+                }
+            }
+        }
+
+        // color0 > color1 selects the 4-color mode. Swapping the endpoints swaps index 0 with 1 and 2 with 3
+        if (color0 < color1)
+        {
+            std::swap(color0, color1);
+            for (std::uint8_t& index : indices)
+            {
+                index ^= 1;
+            }
+        }
+        else if (color0 == color1)
+        {
+            indices.fill(0);
+        }
+
+        std::uint32_t packedIndices = 0;
+        for (std::size_t i = 0; i < indices.size(); ++i)
+        {
+            packedIndices |= static_cast<std::uint32_t>(indices[i]) << (2 * i);
+        }
+
+        WriteUint16(color0, output);
+        WriteUint16(color1, output + 2);
+        WriteUint16(static_cast<std::uint16_t>(packedIndices & 0xFFFF), output + 4);
+        WriteUint16(static_cast<std::uint16_t>(packedIndices >> 16), output + 6);
+    }
+
+    void TextureBlockCompressor::EncodeChannelBlock(const ChannelBlock& block, std::byte* output)
+    {
+        auto [minIt, maxIt] = std::minmax_element(block.begin(), block.end());
+        std::uint8_t minValue = *minIt;
+        std::uint8_t maxValue = *maxIt;
+
+        // value0 > value1 selects the 8 values mode, where indices 2 to 7 interpolate from value0 to value1
+        std::uint64_t packedIndices = 0;
+        if (maxValue != minValue)
+        {
+            float scale = 7.0f / static_cast<float>(maxValue - minValue);
+            for (std::size_t i = 0; i < block.size(); ++i)
+            {
+                std::uint32_t step = static_cast<std::uint32_t>(static_cast<float>(block[i] - minValue) * scale + 0.5f);
+                std::uint64_t index = step == 7 ? 0 : (step == 0 ? 1 : 8 - step);
+                packedIndices |= index << (3 * i);
+            }
+        }
+
+        output[0] = static_cast<std::byte>(maxValue);
+        output[1] = static_cast<std::byte>(minValue);
+        for (std::size_t i = 0; i < 6; ++i)
+        {
+            output[2 + i] = static_cast<std::byte>((packedIndices >> (8 * i)) & 0xFF);
+        }
+    }
+
+    float TextureBlockCompressor::FindColorIndices(
+        const ColorBlock& block, std::uint16_t color0, std::uint16_t color1, AZStd::array<std::uint8_t, PIXELS_PER_BLOCK>& indices)
+    {
+        glm::vec3 palette[4];
+        palette[0] = ExpandRGB565(color0);
+        palette[1] = ExpandRGB565(color1);
+        palette[2] = (2.0f * palette[0] + palette[1]) / 3.0f;
+        palette[3] = (palette[0] + 2.0f * palette[1]) / 3.0f;
+
+        float totalError = 0.0f;
+        for (std::size_t i = 0; i < block.size(); ++i)
+        {
+            float bestError = std::numeric_limits<float>::max();
+            for (std::uint8_t j = 0; j < 4; ++j)
+            {
+                glm::vec3 d = block[i] - palette[j];
+                float error = glm::dot(d, d);
+                if (error < bestError)
+                {
+                    bestError = error;
+                    indices[i] = j;
+                }
+            }
+
+            totalError += bestError;
+        }
+
+        return totalError;
+    }
+
+    std::uint16_t TextureBlockCompressor::QuantizeRGB565(const glm::vec3& color)
+    {
+        std::uint32_t r = static_cast<std::uint32_t>(color.r * 31.0f / 255.0f + 0.5f);
+        std::uint32_t g = static_cast<std::uint32_t>(color.g * 63.0f / 255.0f + 0.5f);
+        std::uint32_t b = static_cast<std::uint32_t>(color.b * 31.0f / 255.0f + 0.5f);
+        return static_cast<std::uint16_t>((std::min(r, 31u) << 11) | (std::min(g, 63u) << 5) | std::min(b, 31u));
+    }
+
+    glm::vec3 TextureBlockCompressor::ExpandRGB565(std::uint16_t color)
+    {
+        std::uint32_t r = (color >> 11) & 0x1F;
+        std::uint32_t g = (color >> 5) & 0x3F;
+        std::uint32_t b = color & 0x1F;
+        return glm::vec3(
+            static_cast<float>((r << 3) | (r >> 2)), static_cast<float>((g << 2) | (g >> 4)), static_cast<float>((b << 3) | (b >> 2)));
+    }
+} // namespace Cesium
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <AzCore/std/containers/array.h>
+#include <glm/glm.hpp>
+#include <cstddef>
+#include <cstdint>
+
+namespace Cesium
+{
+    // Encodes 8 bits per channel images into BC1, BC3 and BC4 blocks on the load thread. Color endpoints are fitted along the
+    // principal axis of each block and refined once with least squares, which is a lot cheaper than an exhaustive BC7 search
+    // while still cutting the size of an RGBA8 texture by 8x for opaque images.
+    class TextureBlockCompressor final
+    {
+    public:
+        // Block compressed top mips need a size that is a multiple of the block size. Smaller mips are padded to whole blocks
+        // by repeating their edge pixels
+        static bool CanCompress(std::uint32_t width, std::uint32_t height);
+
+        static std::size_t GetBC1Size(std::uint32_t width, std::uint32_t height);
+
+        static std::size_t GetBC3Size(std::uint32_t width, std::uint32_t height);
+
+        static std::size_t GetBC4Size(std::uint32_t width, std::uint32_t height);
+
+        // Returns true if every alpha value of the RGBA image is opaque, so that it can be encoded with BC1
+        static bool IsOpaque(const std::byte* pixels, std::uint32_t width, std::uint32_t height);
+
+        // Encodes the first 3 channels of an image with channelCount >= 3 as opaque BC1
+        static void CompressBC1(
+            const std::byte* pixels, std::uint32_t width, std::uint32_t height, std::uint32_t channelCount, std::byte* output);
+
+        // Encodes an RGBA image as BC3
+        static void CompressBC3(const std::byte* pixels, std::uint32_t width, std::uint32_t height, std::byte* output);
+
+        // Encodes one channel of an image as BC4
+        static void CompressBC4(
+            const std::byte* pixels,
+            std::uint32_t width,
+            std::uint32_t height,
+            std::uint32_t channelCount,
+            std::uint32_t channel,
+            std::byte* output);
+
+        static constexpr std::uint32_t BLOCK_SIZE = 4;
+        static constexpr std::uint32_t PIXELS_PER_BLOCK = BLOCK_SIZE * BLOCK_SIZE;
+
+    private:
+        using ColorBlock = AZStd::array<glm::vec3, PIXELS_PER_BLOCK>;
+        using ChannelBlock = AZStd::array<std::uint8_t, PIXELS_PER_BLOCK>;
+
+        static std::size_t GetBlockCount(std::uint32_t width, std::uint32_t height);
+
+        static void LoadColorBlock(
+            const std::byte* pixels,
+            std::uint32_t width,
+            std::uint32_t height,
+            std::uint32_t channelCount,
+            std::uint32_t blockX,
+            std::uint32_t blockY,
+            ColorBlock& block);
+
+        static void LoadChannelBlock(
+            const std::byte* pixels,
+            std::uint32_t width,
+            std::uint32_t height,
+            std::uint32_t channelCount,
+            std::uint32_t channel,
+            std::uint32_t blockX,
+            std::uint32_t blockY,
+            ChannelBlock& block);
+
+        static void EncodeColorBlock(const ColorBlock& block, std::byte* output);
+
+        static void EncodeChannelBlock(const ChannelBlock& block, std::byte* output);
+
+        static float FindColorIndices(
+            const ColorBlock& block, std::uint16_t color0, std::uint16_t color1, AZStd::array<std::uint8_t, PIXELS_PER_BLOCK>& indices);
+
+        static std::uint16_t QuantizeRGB565(const glm::vec3& color);
+
+        static glm::vec3 ExpandRGB565(std::uint16_t color);
+
+        static constexpr std::size_t BC1_BLOCK_BYTES = 8;
+        static constexpr std::size_t BC3_BLOCK_BYTES = 16;
+        static constexpr std::size_t BC4_BLOCK_BYTES = 8;
+        static constexpr std::uint32_t POWER_ITERATION_COUNT = 4;
+    };
+} // namespace Cesium
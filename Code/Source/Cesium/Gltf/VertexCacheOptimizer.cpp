@@ -0,0 +1,288 @@
+#include "Cesium/Gltf/VertexCacheOptimizer.h"
+#include <algorithm>
+#include <cmath>
+#include <type_traits>
+
+namespace Cesium
+{
+    VertexCacheOptimizer::VertexCacheOptimizer()
+        : m_cachePositionScores{}
+        , m_valenceScores{}
+        , m_liveTriangleCounts{}
+        , m_adjacencyOffsets{}
+        , m_adjacency{}
+        , m_adjacencyCursors{}
+        , m_vertexScores{}
+        , m_emittedTriangles{}
+        , m_cacheTimestamps{}
+        , m_output{}
+    {
+        // the vertices of the last triangle get a fixed score, so that the next triangle doesn't favor a particular edge
+        for (std::uint32_t i = 0; i < CACHE_SIZE; ++i)
+        {
+            if (i < 3)
+            {
+                m_cachePositionScores[i] = LAST_TRIANGLE_SCORE;
+            }
+            else
+            {
+                float scaler = 1.0f / static_cast<float>(CACHE_SIZE - 3);
+                m_cachePositionScores[i] = std::pow(1.0f - static_cast<float>(i - 3) * scaler, CACHE_DECAY_POWER);
+            }
+        }
+
+        // boost vertices with few triangles left, so that lone triangles don't get stranded
+        for (std::uint32_t i = 0; i < MAX_SCORED_VALENCE; ++i)
+        {
+            m_valenceScores[i] = i == 0 ? 0.0f : VALENCE_BOOST_SCALE * std::pow(static_cast<float>(i), -VALENCE_BOOST_POWER);
+        }
+    }
+
+    float VertexCacheOptimizer::CalculateACMR(
+        const AZStd::vector<std::uint32_t>& indices, std::size_t vertexCount, std::uint32_t cacheSize)
+    {
+        std::size_t triangleCount = indices.size() / 3;
+        if (triangleCount == 0)
+        {
+            return 0.0f;
+        }
+
+        // FIFO simulation: a vertex is in the cache if it was pushed less than cacheSize misses ago
+        m_cacheTimestamps.assign(vertexCount, 0);
+        std::uint32_t timestamp = cacheSize + 1;
+        std::size_t cacheMisses = 0;
+        for (std::uint32_t index : indices)
+        {
+            if (index >= vertexCount)
+            {
+                continue;
+            }
+
+            if (timestamp - m_cacheTimestamps[index] > cacheSize)
+            {
+                m_cacheTimestamps[index] = timestamp++;
+                ++cacheMisses;
+            }
+        }
+
+        return static_cast<float>(cacheMisses) / static_cast<float>(triangleCount);
+    }
+
+    bool VertexCacheOptimizer::OptimizeVertexCache(AZStd::vector<std::uint32_t>& indices, std::size_t vertexCount)
+    {
+        std::size_t triangleCount = indices.size() / 3;
+        if (triangleCount == 0 || vertexCount == 0)
+        {
+            return false;
+        }
+
+        // build vertex to triangles adjacency
+        m_liveTriangleCounts.assign(vertexCount, 0);
+        for (std::uint32_t index : indices)
+        {
+            if (index >= vertexCount)
+            {
+                return false;
+            }
+
+            ++m_liveTriangleCounts[index];
+        }
+
+        m_adjacencyOffsets.resize_no_construct(vertexCount + 1);
+        m_adjacencyOffsets[0] = 0;
+        for (std::size_t i = 0; i < vertexCount; ++i)
+        {
+            m_adjacencyOffsets[i + 1] = m_adjacencyOffsets[i] + m_liveTriangleCounts[i];
+        }
+
+        m_adjacency.resize_no_construct(indices.size());
+        m_adjacencyCursors.assign(vertexCount, 0);
+        for (std::size_t i = 0; i < indices.size(); ++i)
+        {
+            std::uint32_t vertex = indices[i];
+            m_adjacency[m_adjacencyOffsets[vertex] + m_adjacencyCursors[vertex]++] = static_cast<std::uint32_t>(i / 3);
+        }
+
+        // initial scores. Nothing is in the cache yet
+        m_vertexScores.resize_no_construct(vertexCount);
+        for (std::size_t i = 0; i < vertexCount; ++i)
+        {
+            m_vertexScores[i] = ScoreVertex(-1, m_liveTriangleCounts[i]);
+        }
+
+        std::size_t bestTriangle = 0;
+        float bestScore = -1.0f;
+        for (std::size_t i = 0; i < triangleCount; ++i)
+        {
+            float score = m_vertexScores[indices[i * 3]] + m_vertexScores[indices[i * 3 + 1]] + m_vertexScores[indices[i * 3 + 2]];
+            if (score > bestScore)
+            {
+                bestScore = score;
+                bestTriangle = i;
+            }
+        }
+
+        m_emittedTriangles.assign(triangleCount, 0);
+        m_output.clear();
+        m_output.reserve(indices.size());
+
+        AZStd::array<std::uint32_t, CACHE_SIZE + 3> cache;
+        AZStd::array<std::uint32_t, CACHE_SIZE + 3> newCache;
+        std::size_t cacheCount = 0;
+        std::size_t inputCursor = 0;
+        while (bestTriangle < triangleCount)
+        {
+            const std::uint32_t* triangle = indices.data() + bestTriangle * 3;
+            m_output.insert(m_output.end(), triangle, triangle + 3);
+            m_emittedTriangles[bestTriangle] = 1;
+
+            // remove the triangle from the live triangles of its vertices
+            for (std::size_t i = 0; i < 3; ++i)
+            {
+                std::uint32_t vertex = triangle[i];
+                std::uint32_t* triangles = m_adjacency.data() + m_adjacencyOffsets[vertex];
+                std::uint32_t liveCount = m_liveTriangleCounts[vertex];
+                for (std::uint32_t j = 0; j < liveCount; ++j)
+                {
+                    if (triangles[j] == bestTriangle)
+                    {
+                        std::swap(triangles[j], triangles[liveCount - 1]);
+                        --m_liveTriangleCounts[vertex];
+                        break;
+                    }
+                }
+            }
+
+            // the vertices of the emitted triangle move to the front of the LRU cache
+            std::size_t newCacheCount = 0;
+            for (std::size_t i = 0; i < 3; ++i)
+            {
+                std::uint32_t vertex = triangle[i];
+                if (std::find(newCache.begin(), newCache.begin() + newCacheCount, vertex) == newCache.begin() + newCacheCount)
+                {
+                    newCache[newCacheCount++] = vertex;
+                }
+            }
+
+            for (std::size_t i = 0; i < cacheCount; ++i)
+            {
+                std::uint32_t vertex = cache[i];
+                if (vertex != triangle[0] && vertex != triangle[1] && vertex != triangle[2])
+                {
+                    newCache[newCacheCount++] = vertex;
+                }
+            }
+
+            // rescore the vertices whose cache position changed. Vertices past the cache size are evicted
+            for (std::size_t i = 0; i < newCacheCount; ++i)
+            {
+                std::uint32_t vertex = newCache[i];
+                std::int32_t cachePosition = i < CACHE_SIZE ? static_cast<std::int32_t>(i) : -1;
+                m_vertexScores[vertex] = ScoreVertex(cachePosition, m_liveTriangleCounts[vertex]);
+            }
+
+            std::swap(cache, newCache);
+            cacheCount = std::min<std::size_t>(newCacheCount, CACHE_SIZE);
+
+            // the next triangle is the best one among the live triangles of the cached vertices
+            bestTriangle = triangleCount;
+            bestScore = -1.0f;
+            for (std::size_t i = 0; i < cacheCount; ++i)
+            {
+                std::uint32_t vertex = cache[i];
+                const std::uint32_t* triangles = m_adjacency.data() + m_adjacencyOffsets[vertex];
+                for (std::uint32_t j = 0; j < m_liveTriangleCounts[vertex]; ++j)
+                {
+                    std::uint32_t candidate = triangles[j];
+                    const std::uint32_t* candidateIndices = indices.data() + static_cast<std::size_t>(candidate) * 3;
+                    float score = m_vertexScores[candidateIndices[0]] + m_vertexScores[candidateIndices[1]] +
+                        m_vertexScores[candidateIndices[2]];
+                    if (score > bestScore)
+                    {
+                        bestScore = score;
+                        bestTriangle = candidate;
+                    }
+                }
+            }
+
+            // dead end: continue with the next triangle in input order
+            if (bestTriangle == triangleCount)
+            {
+                while (inputCursor < triangleCount && m_emittedTriangles[inputCursor])
+                {
+                    ++inputCursor;
+                }
+
+                bestTriangle = inputCursor;
+            }
+        }
+
+        indices.swap(m_output);
+        return true;
+    }
+
+    std::size_t VertexCacheOptimizer::OptimizeVertexFetch(
+        AZStd::vector<std::uint32_t>& indices, std::size_t vertexCount, AZStd::vector<std::uint32_t>& remap)
+    {
+        remap.assign(vertexCount, INVALID_INDEX);
+        std::uint32_t nextVertex = 0;
+        for (std::uint32_t& index : indices)
+        {
+            if (index >= vertexCount)
+            {
+                continue;
+            }
+
+            if (remap[index] == INVALID_INDEX)
+            {
+                remap[index] = nextVertex++;
+            }
+
+            index = remap[index];
+        }
+
+        return nextVertex;
+    }
+
+    void VertexCacheOptimizer::ReleaseScratchMemory(std::size_t maxRetainedBytes)
+    {
+        auto trim = [maxRetainedBytes](auto& vector)
+        {
+            using VectorType = std::remove_reference_t<decltype(vector)>;
+            if (vector.capacity() * sizeof(typename VectorType::value_type) > maxRetainedBytes)
+            {
+                VectorType().swap(vector);
+            }
+        };
+
+        trim(m_liveTriangleCounts);
+        trim(m_adjacencyOffsets);
+        trim(m_adjacency);
+        trim(m_adjacencyCursors);
+        trim(m_vertexScores);
+        trim(m_emittedTriangles);
+        trim(m_cacheTimestamps);
+        trim(m_output);
+    }
+
+    float VertexCacheOptimizer::ScoreVertex(std::int32_t cachePosition, std::uint32_t liveTriangleCount) const
+    {
+        // vertices without triangles left will never be used again
+        if (liveTriangleCount == 0)
+        {
+            return -1.0f;
+        }
+
+        float score = cachePosition >= 0 ? m_cachePositionScores[static_cast<std::size_t>(cachePosition)] : 0.0f;
+        if (liveTriangleCount < MAX_SCORED_VALENCE)
+        {
+            score += m_valenceScores[liveTriangleCount];
+        }
+        else
+        {
+            score += VALENCE_BOOST_SCALE * std::pow(static_cast<float>(liveTriangleCount), -VALENCE_BOOST_POWER);
+        }
+
+        return score;
+    }
+} // namespace Cesium
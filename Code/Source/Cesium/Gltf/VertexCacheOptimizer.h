@@ -0,0 +1,55 @@
+#pragma once
+
+#include <AzCore/std/containers/array.h>
+#include <AzCore/std/containers/vector.h>
+#include <cstddef>
+#include <cstdint>
+
+namespace Cesium
+{
+    // Reorders triangle lists for post-transform cache locality using Forsyth's linear-speed algorithm, and remaps
+    // vertices in the order they are first referenced for vertex fetch locality. The scratch buffers are kept
+    // between calls, so an instance is meant to be owned by a builder that is reused on the same thread.
+    class VertexCacheOptimizer final
+    {
+    public:
+        VertexCacheOptimizer();
+
+        // Average number of cache misses per triangle for a FIFO cache of cacheSize entries. Lower is better,
+        // with 0.5 being the best achievable for large regular grids and 3.0 the worst
+        float CalculateACMR(const AZStd::vector<std::uint32_t>& indices, std::size_t vertexCount, std::uint32_t cacheSize = ACMR_CACHE_SIZE);
+
+        // Returns false and leaves the indices untouched if any index is out of range
+        bool OptimizeVertexCache(AZStd::vector<std::uint32_t>& indices, std::size_t vertexCount);
+
+        // Fills remap with the new location of each vertex, or INVALID_INDEX for vertices that are not referenced.
+        // Returns the number of vertices that are referenced
+        std::size_t OptimizeVertexFetch(AZStd::vector<std::uint32_t>& indices, std::size_t vertexCount, AZStd::vector<std::uint32_t>& remap);
+
+        void ReleaseScratchMemory(std::size_t maxRetainedBytes);
+
+        static constexpr std::uint32_t INVALID_INDEX = static_cast<std::uint32_t>(-1);
+        static constexpr std::uint32_t ACMR_CACHE_SIZE = 16;
+
+    private:
+        float ScoreVertex(std::int32_t cachePosition, std::uint32_t liveTriangleCount) const;
+
+        static constexpr std::uint32_t CACHE_SIZE = 32;
+        static constexpr std::uint32_t MAX_SCORED_VALENCE = 32;
+        static constexpr float CACHE_DECAY_POWER = 1.5f;
+        static constexpr float LAST_TRIANGLE_SCORE = 0.75f;
+        static constexpr float VALENCE_BOOST_SCALE = 2.0f;
+        static constexpr float VALENCE_BOOST_POWER = 0.5f;
+
+        AZStd::array<float, CACHE_SIZE> m_cachePositionScores;
+        AZStd::array<float, MAX_SCORED_VALENCE> m_valenceScores;
+        AZStd::vector<std::uint32_t> m_liveTriangleCounts;
+        AZStd::vector<std::uint32_t> m_adjacencyOffsets;
+        AZStd::vector<std::uint32_t> m_adjacency;
+        AZStd::vector<std::uint32_t> m_adjacencyCursors;
+        AZStd::vector<float> m_vertexScores;
+        AZStd::vector<std::uint8_t> m_emittedTriangles;
+        AZStd::vector<std::uint32_t> m_cacheTimestamps;
+        AZStd::vector<std::uint32_t> m_output;
+    };
+} // namespace Cesium
@@ -0,0 +1,52 @@
+#include "Cesium/Gltf/VertexCacheTelemetry.h"
+#include <cmath>
+
+namespace Cesium
+{
+    VertexCacheStatistics::VertexCacheStatistics()
+        : m_primitiveCount{ 0 }
+        , m_triangleCount{ 0 }
+        , m_missCountBefore{ 0.0 }
+        , m_missCountAfter{ 0.0 }
+    {
+    }
+
+    double VertexCacheStatistics::GetMeanACMRBefore() const
+    {
+        return m_triangleCount == 0 ? 0.0 : m_missCountBefore / static_cast<double>(m_triangleCount);
+    }
+
+    double VertexCacheStatistics::GetMeanACMRAfter() const
+    {
+        return m_triangleCount == 0 ? 0.0 : m_missCountAfter / static_cast<double>(m_triangleCount);
+    }
+
+    VertexCacheTelemetry::VertexCacheTelemetry()
+        : m_primitiveCount{ 0 }
+        , m_triangleCount{ 0 }
+        , m_scaledMissCountBefore{ 0 }
+        , m_scaledMissCountAfter{ 0 }
+    {
+    }
+
+    void VertexCacheTelemetry::Record(std::size_t triangleCount, float acmrBefore, float acmrAfter)
+    {
+        double triangles = static_cast<double>(triangleCount);
+        m_primitiveCount.fetch_add(1, std::memory_order_relaxed);
+        m_triangleCount.fetch_add(triangleCount, std::memory_order_relaxed);
+        m_scaledMissCountBefore.fetch_add(
+            static_cast<std::uint64_t>(std::llround(acmrBefore * triangles * MISS_SCALE)), std::memory_order_relaxed);
+        m_scaledMissCountAfter.fetch_add(
+            static_cast<std::uint64_t>(std::llround(acmrAfter * triangles * MISS_SCALE)), std::memory_order_relaxed);
+    }
+
+    VertexCacheStatistics VertexCacheTelemetry::GetStatistics() const
+    {
+        VertexCacheStatistics statistics;
+        statistics.m_primitiveCount = m_primitiveCount.load(std::memory_order_relaxed);
+        statistics.m_triangleCount = m_triangleCount.load(std::memory_order_relaxed);
+        statistics.m_missCountBefore = static_cast<double>(m_scaledMissCountBefore.load(std::memory_order_relaxed)) / MISS_SCALE;
+        statistics.m_missCountAfter = static_cast<double>(m_scaledMissCountAfter.load(std::memory_order_relaxed)) / MISS_SCALE;
+        return statistics;
+    }
+} // namespace Cesium
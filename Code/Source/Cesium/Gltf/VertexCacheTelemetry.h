@@ -0,0 +1,48 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace Cesium
+{
+    struct VertexCacheStatistics final
+    {
+        VertexCacheStatistics();
+
+        // average cache misses per triangle over every optimized triangle, before and after the optimization
+        double GetMeanACMRBefore() const;
+
+        double GetMeanACMRAfter() const;
+
+        std::uint64_t m_primitiveCount;
+        std::uint64_t m_triangleCount;
+        double m_missCountBefore;
+        double m_missCountAfter;
+    };
+
+    // Totals of the vertex cache optimizations of every primitive the load threads build, so that the effect of the optimization
+    // can be checked without a log line per primitive. Recording is lock free
+    class VertexCacheTelemetry final
+    {
+    public:
+        VertexCacheTelemetry();
+
+        VertexCacheTelemetry(const VertexCacheTelemetry&) = delete;
+
+        VertexCacheTelemetry& operator=(const VertexCacheTelemetry&) = delete;
+
+        void Record(std::size_t triangleCount, float acmrBefore, float acmrAfter);
+
+        VertexCacheStatistics GetStatistics() const;
+
+    private:
+        // misses are counted in thousandths, so the totals stay integers
+        static constexpr double MISS_SCALE = 1000.0;
+
+        std::atomic<std::uint64_t> m_primitiveCount;
+        std::atomic<std::uint64_t> m_triangleCount;
+        std::atomic<std::uint64_t> m_scaledMissCountBefore;
+        std::atomic<std::uint64_t> m_scaledMissCountAfter;
+    };
+} // namespace Cesium
@@ -0,0 +1,71 @@
+#include "Cesium/Systems/BlockingHttpClientBackend.h"
+#include <AzFramework/AzFramework_Traits_Platform.h>
+#include <AzCore/PlatformDef.h>
+#include <AzCore/Jobs/JobManager.h>
+#include <AzCore/Jobs/JobContext.h>
+#include <AzCore/Jobs/JobFunction.h>
+#include <AzCore/std/parallel/thread.h>
+
+// The AWS Native SDK AWSAllocator triggers a warning due to accessing members of std::allocator directly.
+AZ_PUSH_DISABLE_WARNING(4251 4996, "-Wunknown-warning-option")
+#include <aws/core/client/ClientConfiguration.h>
+#include <aws/core/http/HttpClient.h>
+#include <aws/core/http/HttpClientFactory.h>
+#include <aws/core/http/HttpRequest.h>
+#include <aws/core/http/HttpResponse.h>
+AZ_POP_DISABLE_WARNING
+
+namespace Cesium
+{
+    BlockingHttpClientBackend::BlockingHttpClientBackend(const HttpClientConfiguration& configuration)
+        : m_maxActiveRequests{ 0 }
+        , m_maxActiveRequestsPerHost{ configuration.m_maxConnectionsPerHost }
+    {
+        AZ::JobManagerDesc jobDesc;
+        for (size_t i = 0; i < AZStd::thread::hardware_concurrency(); ++i)
+        {
+            jobDesc.m_workerThreads.push_back({ static_cast<int>(i) });
+        }
+        m_ioJobManager = AZStd::make_unique<AZ::JobManager>(jobDesc);
+        m_ioJobContext = AZStd::make_unique<AZ::JobContext>(*m_ioJobManager);
+
+        // every request blocks an io thread until it is done, so there are never more of them active than threads
+        m_maxActiveRequests = static_cast<std::uint32_t>(jobDesc.m_workerThreads.size());
+
+        Aws::Client::ClientConfiguration config;
+        config.enableTcpKeepAlive = AZ_TRAIT_AZFRAMEWORK_AWS_ENABLE_TCP_KEEP_ALIVE_SUPPORTED;
+        config.connectTimeoutMs = static_cast<long>(configuration.m_connectTimeoutMs);
+
+        // the client keeps a connection per io thread alive, so later requests skip the TCP and TLS handshakes
+        config.maxConnections = static_cast<unsigned>(m_maxActiveRequests);
+        m_awsHttpClient = Aws::Http::CreateHttpClient(config);
+    }
+
+    BlockingHttpClientBackend::~BlockingHttpClientBackend() noexcept
+    {
+        m_ioJobContext.reset();
+        m_ioJobManager.reset();
+        m_awsHttpClient.reset();
+    }
+
+    std::uint32_t BlockingHttpClientBackend::GetMaxActiveRequests() const
+    {
+        return m_maxActiveRequests;
+    }
+
+    std::uint32_t BlockingHttpClientBackend::GetMaxActiveRequestsPerHost() const
+    {
+        return m_maxActiveRequestsPerHost;
+    }
+
+    void BlockingHttpClientBackend::Send(const std::shared_ptr<Aws::Http::HttpRequest>& request, CompletionCallback onComplete)
+    {
+        AZ::Job* job = aznew AZ::JobFunction<std::function<void()>>(
+            [awsHttpClient = m_awsHttpClient, request, onComplete = std::move(onComplete)]()
+            {
+                onComplete(awsHttpClient->MakeRequest(request));
+            },
+            true, m_ioJobContext.get());
+        job->Start();
+    }
+} // namespace Cesium
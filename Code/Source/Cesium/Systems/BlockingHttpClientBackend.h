@@ -0,0 +1,45 @@
+#pragma once
+
+#include "Cesium/Systems/HttpClientBackend.h"
+#include <AzCore/std/smart_ptr/unique_ptr.h>
+#include <cstdint>
+#include <memory>
+
+namespace AZ
+{
+    class JobManager;
+    class JobContext;
+} // namespace AZ
+
+namespace Aws
+{
+    namespace Http
+    {
+        class HttpClient;
+    }
+} // namespace Aws
+
+namespace Cesium
+{
+    // Sends every request with the blocking AWS http client on its own io job, so there are at most as many transfers as io threads
+    class BlockingHttpClientBackend final : public HttpClientBackend
+    {
+    public:
+        explicit BlockingHttpClientBackend(const HttpClientConfiguration& configuration);
+
+        ~BlockingHttpClientBackend() noexcept override;
+
+        std::uint32_t GetMaxActiveRequests() const override;
+
+        std::uint32_t GetMaxActiveRequestsPerHost() const override;
+
+        void Send(const std::shared_ptr<Aws::Http::HttpRequest>& request, CompletionCallback onComplete) override;
+
+    private:
+        AZStd::unique_ptr<AZ::JobManager> m_ioJobManager;
+        AZStd::unique_ptr<AZ::JobContext> m_ioJobContext;
+        std::shared_ptr<Aws::Http::HttpClient> m_awsHttpClient;
+        std::uint32_t m_maxActiveRequests;
+        std::uint32_t m_maxActiveRequestsPerHost;
+    };
+} // namespace Cesium
@@ -3,17 +3,30 @@
 #include "Cesium/Systems/HttpAssetAccessor.h"
 #include "Cesium/Systems/GenericAssetAccessor.h"
 #include "Cesium/Systems/TaskProcessor.h"
+#include <AzCore/IO/Path/Path.h>
+#include <AzCore/IO/SystemFile.h>
+#include <AzCore/Settings/SettingsRegistry.h>
+#include <AzCore/Settings/SettingsRegistryMergeUtils.h>
+#include <CesiumAsync/CachingAssetAccessor.h>
+#include <CesiumAsync/SqliteCache.h>
 
 namespace Cesium
 {
     CesiumSystem::CesiumSystem()
     {
+        // initialize logger
+        m_logger = spdlog::default_logger();
+        m_logger->sinks().clear();
+        m_logger->sinks().push_back(std::make_shared<LoggerSink>());
+
         // initialize IO managers
-        m_httpManager = AZStd::make_unique<HttpManager>();
+        m_httpManager = AZStd::make_unique<HttpManager>(CreateHttpClientConfiguration());
         m_localFileManager = AZStd::make_unique<LocalFileManager>();
 
         // initialize asset accessors
-        m_httpAssetAccessor = std::make_shared<HttpAssetAccessor>(m_httpManager.get());
+        m_uncachedHttpAssetAccessor = std::make_shared<HttpAssetAccessor>(m_httpManager.get());
+        m_httpCacheDatabase = CreateHttpCacheDatabase(m_logger);
+        m_httpAssetAccessor = AddHttpCache(m_uncachedHttpAssetAccessor);
         m_localFileAssetAccessor = std::make_shared<GenericAssetAccessor>(m_localFileManager.get(), "");
 
         // initialize task processor
@@ -21,11 +34,6 @@ namespace Cesium
 
         // initialize credit system
         m_creditSystem = std::make_shared<Cesium3DTilesSelection::CreditSystem>();
-
-        // initialize logger
-        m_logger = spdlog::default_logger();
-        m_logger->sinks().clear();
-        m_logger->sinks().push_back(std::make_shared<LoggerSink>());
     }
 
     GenericIOManager& CesiumSystem::GetIOManager(IOKind kind)
@@ -54,6 +62,20 @@ namespace Cesium
         }
     }
 
+    std::shared_ptr<CesiumAsync::IAssetAccessor> CesiumSystem::CreateCancellableAssetAccessor(
+        IOKind kind, const HttpCancellationToken& cancellationToken) const
+    {
+        switch (kind)
+        {
+        case Cesium::IOKind::LocalFile:
+            return m_localFileAssetAccessor;
+        case Cesium::IOKind::Http:
+            return AddHttpCache(m_uncachedHttpAssetAccessor->CreateCancellableAccessor(cancellationToken));
+        default:
+            return AddHttpCache(m_uncachedHttpAssetAccessor->CreateCancellableAccessor(cancellationToken));
+        }
+    }
+
     const std::shared_ptr<CesiumAsync::ITaskProcessor>& CesiumSystem::GetTaskProcessor() const
     {
         return m_taskProcessor;
@@ -73,4 +95,121 @@ namespace Cesium
     {
         return m_criticalAssetManager;
     }
+
+    GltfLoadScratchArenaPool& CesiumSystem::GetGltfLoadScratchArenaPool()
+    {
+        return m_gltfLoadScratchArenaPool;
+    }
+
+    VertexCacheTelemetry& CesiumSystem::GetVertexCacheTelemetry()
+    {
+        return m_vertexCacheTelemetry;
+    }
+
+    ImageDecoderRegistry& CesiumSystem::GetImageDecoderRegistry()
+    {
+        return m_imageDecoderRegistry;
+    }
+
+    UiImageCache& CesiumSystem::GetUiImageCache()
+    {
+        return m_uiImageCache;
+    }
+
+    std::vector<HttpHostStatistics> CesiumSystem::GetHttpHostStatistics()
+    {
+        return m_httpManager->GetHostStatistics();
+    }
+
+    void CesiumSystem::Tick()
+    {
+        m_httpManager->Tick();
+    }
+
+    HttpClientConfiguration CesiumSystem::CreateHttpClientConfiguration()
+    {
+        HttpClientConfiguration configuration;
+        auto settingsRegistry = AZ::SettingsRegistry::Get();
+        if (!settingsRegistry)
+        {
+            return configuration;
+        }
+
+        // settings that are missing, or zero where zero makes no sense, keep their default
+        auto readSetting = [settingsRegistry](const char* key, std::uint32_t& value, bool allowZero)
+        {
+            AZ::u64 setting = 0;
+            if (settingsRegistry->Get(setting, key) && (allowZero || setting > 0))
+            {
+                value = static_cast<std::uint32_t>(setting);
+            }
+        };
+
+        readSetting(HTTP_MAX_CONNECTIONS_PER_HOST_SETTING, configuration.m_maxConnectionsPerHost, false);
+        readSetting(HTTP_CONNECT_TIMEOUT_MS_SETTING, configuration.m_connectTimeoutMs, false);
+        readSetting(HTTP_MAX_RETRIES_SETTING, configuration.m_maxRetries, true);
+        readSetting(HTTP_RETRY_BASE_DELAY_MS_SETTING, configuration.m_retryBaseDelayMs, true);
+        readSetting(HTTP_RETRY_MAX_DELAY_MS_SETTING, configuration.m_retryMaxDelayMs, true);
+        readSetting(HTTP_MAX_REQUESTS_PER_SECOND_PER_HOST_SETTING, configuration.m_maxRequestsPerSecondPerHost, false);
+        return configuration;
+    }
+
+    std::shared_ptr<CesiumAsync::ICacheDatabase> CesiumSystem::CreateHttpCacheDatabase(const std::shared_ptr<spdlog::logger>& logger)
+    {
+        auto settingsRegistry = AZ::SettingsRegistry::Get();
+        if (!settingsRegistry)
+        {
+            return nullptr;
+        }
+
+        bool cacheEnabled = true;
+        settingsRegistry->Get(cacheEnabled, HTTP_CACHE_ENABLED_SETTING);
+        if (!cacheEnabled)
+        {
+            return nullptr;
+        }
+
+        // the cache lives in the project user folder by default, so it survives between sessions but is never committed
+        AZ::IO::FixedMaxPath cachePath;
+        AZ::SettingsRegistryInterface::FixedValueString cachePathSetting;
+        if (settingsRegistry->Get(cachePathSetting, HTTP_CACHE_PATH_SETTING) && !cachePathSetting.empty())
+        {
+            cachePath = cachePathSetting.c_str();
+        }
+        else
+        {
+            AZ::IO::FixedMaxPath projectUserPath;
+            if (!settingsRegistry->Get(projectUserPath.Native(), AZ::SettingsRegistryMergeUtils::FilePathKey_ProjectUserPath))
+            {
+                return nullptr;
+            }
+
+            cachePath = projectUserPath / "Cesium" / HTTP_CACHE_FILE_NAME;
+        }
+
+        if (!AZ::IO::SystemFile::CreateDir(cachePath.ParentPath().c_str()))
+        {
+            return nullptr;
+        }
+
+        AZ::u64 maximumItems = DEFAULT_HTTP_CACHE_MAXIMUM_ITEMS;
+        settingsRegistry->Get(maximumItems, HTTP_CACHE_MAXIMUM_ITEMS_SETTING);
+
+        // entries are kept in a single sqlite database, which is shared by the accessors of every tileset
+        return std::make_shared<CesiumAsync::SqliteCache>(logger, std::string(cachePath.c_str()), maximumItems);
+    }
+
+    std::shared_ptr<CesiumAsync::IAssetAccessor> CesiumSystem::AddHttpCache(
+        const std::shared_ptr<CesiumAsync::IAssetAccessor>& assetAccessor) const
+    {
+        if (!m_httpCacheDatabase)
+        {
+            return assetAccessor;
+        }
+
+        // the caching accessor serves fresh entries from the database, revalidates stale ones with their ETag or Last-Modified, and
+        // prunes the least recently accessed entries once the database holds too many items
+        return std::make_shared<CesiumAsync::CachingAssetAccessor>(
+            m_logger, assetAccessor, m_httpCacheDatabase, HTTP_CACHE_REQUESTS_PER_PRUNE);
+    }
 } // namespace Cesium
\ No newline at end of file
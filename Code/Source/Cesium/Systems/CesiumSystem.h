@@ -4,20 +4,27 @@
 #include "Cesium/Systems/LocalFileManager.h"
 #include "Cesium/Systems/HttpManager.h"
 #include "Cesium/Systems/CriticalAssetManager.h"
+#include "Cesium/Systems/UiImageCache.h"
+#include "Cesium/Gltf/GltfLoadScratchArena.h"
+#include "Cesium/Gltf/ImageDecoder.h"
+#include "Cesium/Gltf/VertexCacheTelemetry.h"
 #include <AzCore/JSON/rapidjson.h>
 #include <AzCore/Interface/Interface.h>
 #include <AzCore/RTTI/TypeInfo.h>
 #include <AzCore/std/smart_ptr/unique_ptr.h>
 #include <Cesium3DTilesSelection/CreditSystem.h>
 #include <CesiumAsync/IAssetAccessor.h>
+#include <CesiumAsync/ICacheDatabase.h>
 #include <CesiumAsync/ITaskProcessor.h>
 #include <spdlog/logger.h>
+#include <cstdint>
 #include <memory>
 
 namespace Cesium
 {
     class GenericIOManager;
     class CriticalAssetManager;
+    class HttpAssetAccessor;
 
     enum class IOKind
     {
@@ -36,6 +43,10 @@ namespace Cesium
 
         const std::shared_ptr<CesiumAsync::IAssetAccessor>& GetAssetAccessor(IOKind kind) const;
 
+        // creates an accessor for a single tileset, whose requests are dropped or aborted once the token is cancelled
+        std::shared_ptr<CesiumAsync::IAssetAccessor> CreateCancellableAssetAccessor(
+            IOKind kind, const HttpCancellationToken& cancellationToken) const;
+
         const std::shared_ptr<CesiumAsync::ITaskProcessor>& GetTaskProcessor() const;
 
         const std::shared_ptr<spdlog::logger>& GetLogger() const;
@@ -44,15 +55,53 @@ namespace Cesium
 
         const CriticalAssetManager& GetCriticalAssetManager() const;
 
+        GltfLoadScratchArenaPool& GetGltfLoadScratchArenaPool();
+
+        VertexCacheTelemetry& GetVertexCacheTelemetry();
+
+        ImageDecoderRegistry& GetImageDecoderRegistry();
+
+        UiImageCache& GetUiImageCache();
+
+        std::vector<HttpHostStatistics> GetHttpHostStatistics();
+
+        // called once a frame on the main thread
+        void Tick();
+
     private:
+        static HttpClientConfiguration CreateHttpClientConfiguration();
+
+        static std::shared_ptr<CesiumAsync::ICacheDatabase> CreateHttpCacheDatabase(const std::shared_ptr<spdlog::logger>& logger);
+
+        std::shared_ptr<CesiumAsync::IAssetAccessor> AddHttpCache(const std::shared_ptr<CesiumAsync::IAssetAccessor>& assetAccessor) const;
+
+        static constexpr const char* const HTTP_MAX_CONNECTIONS_PER_HOST_SETTING = "/Cesium/Http/MaxConnectionsPerHost";
+        static constexpr const char* const HTTP_CONNECT_TIMEOUT_MS_SETTING = "/Cesium/Http/ConnectTimeoutMs";
+        static constexpr const char* const HTTP_MAX_RETRIES_SETTING = "/Cesium/Http/MaxRetries";
+        static constexpr const char* const HTTP_RETRY_BASE_DELAY_MS_SETTING = "/Cesium/Http/RetryBaseDelayMs";
+        static constexpr const char* const HTTP_RETRY_MAX_DELAY_MS_SETTING = "/Cesium/Http/RetryMaxDelayMs";
+        static constexpr const char* const HTTP_MAX_REQUESTS_PER_SECOND_PER_HOST_SETTING = "/Cesium/Http/MaxRequestsPerSecondPerHost";
+        static constexpr const char* const HTTP_CACHE_ENABLED_SETTING = "/Cesium/HttpCache/Enabled";
+        static constexpr const char* const HTTP_CACHE_PATH_SETTING = "/Cesium/HttpCache/Path";
+        static constexpr const char* const HTTP_CACHE_MAXIMUM_ITEMS_SETTING = "/Cesium/HttpCache/MaximumItems";
+        static constexpr const char* const HTTP_CACHE_FILE_NAME = "cesium-request-cache.sqlite";
+        static constexpr std::uint64_t DEFAULT_HTTP_CACHE_MAXIMUM_ITEMS = 4096;
+        static constexpr std::int32_t HTTP_CACHE_REQUESTS_PER_PRUNE = 10000;
+
         AZStd::unique_ptr<HttpManager> m_httpManager;
         AZStd::unique_ptr<LocalFileManager> m_localFileManager;
+        std::shared_ptr<HttpAssetAccessor> m_uncachedHttpAssetAccessor;
+        std::shared_ptr<CesiumAsync::ICacheDatabase> m_httpCacheDatabase;
         std::shared_ptr<CesiumAsync::IAssetAccessor> m_httpAssetAccessor;
         std::shared_ptr<CesiumAsync::IAssetAccessor> m_localFileAssetAccessor;
         std::shared_ptr<CesiumAsync::ITaskProcessor> m_taskProcessor;
         std::shared_ptr<spdlog::logger> m_logger;
         std::shared_ptr<Cesium3DTilesSelection::CreditSystem> m_creditSystem;
         CriticalAssetManager m_criticalAssetManager;
+        GltfLoadScratchArenaPool m_gltfLoadScratchArenaPool;
+        VertexCacheTelemetry m_vertexCacheTelemetry;
+        ImageDecoderRegistry m_imageDecoderRegistry;
+        UiImageCache m_uiImageCache;
     };
 } // namespace Cesium
 
@@ -12,12 +12,14 @@ namespace Cesium
     {
         m_standardPbrMaterialType.Release();
         m_rasterMaterialType.Release();
+        m_pointCloudMaterialType.Release();
     }
 
     void CriticalAssetManager::OnCatalogLoaded([[maybe_unused]] const char* catalogFile)
     {
         m_standardPbrMaterialType = AZ::RPI::AssetUtils::LoadCriticalAsset<AZ::RPI::MaterialTypeAsset>(STANDARD_PBR_MAT_TYPE);
         m_rasterMaterialType = AZ::RPI::AssetUtils::LoadCriticalAsset<AZ::RPI::MaterialTypeAsset>(RASTER_MAT_TYPE);
+        m_pointCloudMaterialType = AZ::RPI::AssetUtils::LoadCriticalAsset<AZ::RPI::MaterialTypeAsset>(POINT_CLOUD_MAT_TYPE);
         AzFramework::AssetCatalogEventBus::Handler::BusDisconnect();
     }
 
@@ -20,9 +20,11 @@ namespace Cesium
 
         AZ::Data::Asset<AZ::RPI::MaterialTypeAsset> m_standardPbrMaterialType;
         AZ::Data::Asset<AZ::RPI::MaterialTypeAsset> m_rasterMaterialType;
+        AZ::Data::Asset<AZ::RPI::MaterialTypeAsset> m_pointCloudMaterialType;
 
     private:
         static constexpr const char* const STANDARD_PBR_MAT_TYPE = "Materials/Types/StandardPBR.azmaterialtype";
         static constexpr const char* const RASTER_MAT_TYPE = "Materials/Types/GltfStandardPBR.azmaterialtype";
+        static constexpr const char* const POINT_CLOUD_MAT_TYPE = "Materials/Types/GltfPointCloud.azmaterialtype";
     };
 } // namespace Cesium
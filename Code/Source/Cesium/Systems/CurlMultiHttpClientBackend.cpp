@@ -0,0 +1,379 @@
+#if defined(CESIUM_USE_CURL_MULTI)
+
+#include "Cesium/Systems/CurlMultiHttpClientBackend.h"
+#include <AzCore/PlatformDef.h>
+
+// The AWS Native SDK AWSAllocator triggers a warning due to accessing members of std::allocator directly.
+AZ_PUSH_DISABLE_WARNING(4251 4996, "-Wunknown-warning-option")
+#include <aws/core/client/CoreErrors.h>
+#include <aws/core/http/HttpRequest.h>
+#include <aws/core/http/standard/StandardHttpResponse.h>
+AZ_POP_DISABLE_WARNING
+
+#include <iterator>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace Cesium
+{
+    struct CurlMultiHttpClientBackend::Transfer
+    {
+        Transfer(const std::shared_ptr<Aws::Http::HttpRequest>& request, CompletionCallback&& onComplete)
+            : m_request{ request }
+            , m_response{ std::make_shared<Aws::Http::Standard::StandardHttpResponse>(request) }
+            , m_onComplete{ std::move(onComplete) }
+            , m_easyHandle{ nullptr }
+            , m_headers{ nullptr }
+            , m_headersReceived{ false }
+        {
+        }
+
+        // the headers are only handed to the response once the final response starts, so that the headers of redirects and
+        // interim responses never select the decoder or the reserved size of the body
+        void ReceiveHeaders(long responseCode)
+        {
+            m_headersReceived = true;
+            m_response->SetResponseCode(static_cast<Aws::Http::HttpResponseCode>(responseCode));
+            for (const auto& header : m_responseHeaders)
+            {
+                m_response->AddHeader(Aws::String(header.first.c_str()), Aws::String(header.second.c_str()));
+            }
+
+            const auto& headersReceivedHandler = m_request->GetHeadersReceivedEventHandler();
+            if (headersReceivedHandler)
+            {
+                headersReceivedHandler(m_request.get(), m_response.get());
+            }
+        }
+
+        std::shared_ptr<Aws::Http::HttpRequest> m_request;
+        std::shared_ptr<Aws::Http::Standard::StandardHttpResponse> m_response;
+        CompletionCallback m_onComplete;
+        CURL* m_easyHandle;
+        curl_slist* m_headers;
+        std::string m_url;
+        std::string m_body;
+        std::vector<std::pair<std::string, std::string>> m_responseHeaders;
+        bool m_headersReceived;
+    };
+
+    CurlMultiHttpClientBackend::CurlMultiHttpClientBackend(const HttpClientConfiguration& configuration)
+        : m_multiHandle{ nullptr }
+        , m_shareHandle{ nullptr }
+        , m_connectTimeoutMs{ static_cast<long>(configuration.m_connectTimeoutMs) }
+        , m_stopping{ false }
+    {
+        curl_global_init(CURL_GLOBAL_ALL);
+        m_multiHandle = curl_multi_init();
+        curl_multi_setopt(m_multiHandle, CURLMOPT_PIPELINING, CURLPIPE_MULTIPLEX);
+        curl_multi_setopt(m_multiHandle, CURLMOPT_MAX_HOST_CONNECTIONS, static_cast<long>(configuration.m_maxConnectionsPerHost));
+
+        // the multi handle already pools connections. TLS sessions and DNS lookups are shared as well, so a new connection to a known
+        // host resumes its TLS session instead of doing a full handshake. Only the io thread uses the handles, so no locks are needed
+        m_shareHandle = curl_share_init();
+        curl_share_setopt(m_shareHandle, CURLSHOPT_SHARE, CURL_LOCK_DATA_SSL_SESSION);
+        curl_share_setopt(m_shareHandle, CURLSHOPT_SHARE, CURL_LOCK_DATA_DNS);
+
+        AZStd::thread_desc threadDesc;
+        threadDesc.m_name = "Cesium Http IO";
+        m_ioThread = AZStd::thread(
+            threadDesc,
+            [this]()
+            {
+                Run();
+            });
+    }
+
+    CurlMultiHttpClientBackend::~CurlMultiHttpClientBackend() noexcept
+    {
+        m_stopping = true;
+        curl_multi_wakeup(m_multiHandle);
+        m_ioThread.join();
+
+        curl_multi_cleanup(m_multiHandle);
+        curl_share_cleanup(m_shareHandle);
+        curl_global_cleanup();
+    }
+
+    std::uint32_t CurlMultiHttpClientBackend::GetMaxActiveRequests() const
+    {
+        return MAX_ACTIVE_REQUESTS;
+    }
+
+    std::uint32_t CurlMultiHttpClientBackend::GetMaxActiveRequestsPerHost() const
+    {
+        return MAX_ACTIVE_REQUESTS_PER_HOST;
+    }
+
+    void CurlMultiHttpClientBackend::Send(const std::shared_ptr<Aws::Http::HttpRequest>& request, CompletionCallback onComplete)
+    {
+        auto transfer = std::make_unique<Transfer>(request, std::move(onComplete));
+        {
+            std::lock_guard<std::mutex> lock(m_queueMutex);
+            if (!m_stopping)
+            {
+                m_queuedTransfers.emplace_back(std::move(transfer));
+            }
+        }
+
+        if (transfer)
+        {
+            CompleteTransfer(*transfer, CURLE_ABORTED_BY_CALLBACK, 0);
+            return;
+        }
+
+        curl_multi_wakeup(m_multiHandle);
+    }
+
+    void CurlMultiHttpClientBackend::Run()
+    {
+        // the multi handle and the easy handles are only touched by this thread. Other threads queue transfers and wake it up
+        std::vector<std::unique_ptr<Transfer>> queuedTransfers;
+        while (!m_stopping)
+        {
+            {
+                std::lock_guard<std::mutex> lock(m_queueMutex);
+                queuedTransfers.swap(m_queuedTransfers);
+            }
+
+            for (auto& queuedTransfer : queuedTransfers)
+            {
+                StartTransfer(std::move(queuedTransfer));
+            }
+            queuedTransfers.clear();
+
+            int runningTransfers = 0;
+            curl_multi_perform(m_multiHandle, &runningTransfers);
+
+            int queuedMessages = 0;
+            while (CURLMsg* message = curl_multi_info_read(m_multiHandle, &queuedMessages))
+            {
+                if (message->msg == CURLMSG_DONE)
+                {
+                    FinishTransfer(message->easy_handle, message->data.result);
+                }
+            }
+
+            curl_multi_poll(m_multiHandle, nullptr, 0, POLL_TIMEOUT_MS, nullptr);
+        }
+
+        // transfers that are still running or waiting are completed as aborted, so nothing is left waiting for them
+        std::vector<CURL*> activeHandles;
+        activeHandles.reserve(m_activeTransfers.size());
+        for (const auto& activeTransfer : m_activeTransfers)
+        {
+            activeHandles.emplace_back(activeTransfer.first);
+        }
+
+        for (CURL* activeHandle : activeHandles)
+        {
+            FinishTransfer(activeHandle, CURLE_ABORTED_BY_CALLBACK);
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(m_queueMutex);
+            queuedTransfers.swap(m_queuedTransfers);
+        }
+
+        for (auto& queuedTransfer : queuedTransfers)
+        {
+            CompleteTransfer(*queuedTransfer, CURLE_ABORTED_BY_CALLBACK, 0);
+        }
+    }
+
+    void CurlMultiHttpClientBackend::StartTransfer(std::unique_ptr<Transfer> transfer)
+    {
+        CURL* easyHandle = curl_easy_init();
+        if (!easyHandle)
+        {
+            CompleteTransfer(*transfer, CURLE_FAILED_INIT, 0);
+            return;
+        }
+
+        const Aws::Http::HttpRequest& request = *transfer->m_request;
+        transfer->m_easyHandle = easyHandle;
+        transfer->m_url = request.GetURIString().c_str();
+        curl_easy_setopt(easyHandle, CURLOPT_URL, transfer->m_url.c_str());
+        curl_easy_setopt(easyHandle, CURLOPT_PRIVATE, transfer.get());
+        curl_easy_setopt(easyHandle, CURLOPT_NOSIGNAL, 1L);
+        curl_easy_setopt(easyHandle, CURLOPT_FOLLOWLOCATION, 1L);
+        curl_easy_setopt(easyHandle, CURLOPT_TCP_KEEPALIVE, 1L);
+        curl_easy_setopt(easyHandle, CURLOPT_CONNECTTIMEOUT_MS, m_connectTimeoutMs);
+        curl_easy_setopt(easyHandle, CURLOPT_SHARE, m_shareHandle);
+
+        // wait for a connection that can be multiplexed instead of opening a new one for every request
+        curl_easy_setopt(easyHandle, CURLOPT_HTTP_VERSION, CURL_HTTP_VERSION_2TLS);
+        curl_easy_setopt(easyHandle, CURLOPT_PIPEWAIT, 1L);
+
+        curl_easy_setopt(easyHandle, CURLOPT_HEADERFUNCTION, &CurlMultiHttpClientBackend::OnHeader);
+        curl_easy_setopt(easyHandle, CURLOPT_HEADERDATA, transfer.get());
+        curl_easy_setopt(easyHandle, CURLOPT_WRITEFUNCTION, &CurlMultiHttpClientBackend::OnBody);
+        curl_easy_setopt(easyHandle, CURLOPT_WRITEDATA, transfer.get());
+        curl_easy_setopt(easyHandle, CURLOPT_XFERINFOFUNCTION, &CurlMultiHttpClientBackend::OnProgress);
+        curl_easy_setopt(easyHandle, CURLOPT_XFERINFODATA, transfer.get());
+        curl_easy_setopt(easyHandle, CURLOPT_NOPROGRESS, 0L);
+
+        // bodies are decoded by HttpManager, so Accept-Encoding is sent as it is and curl doesn't decode anything
+        for (const auto& header : request.GetHeaders())
+        {
+            std::string headerLine = std::string(header.first.c_str()) + ": " + header.second.c_str();
+            transfer->m_headers = curl_slist_append(transfer->m_headers, headerLine.c_str());
+        }
+        transfer->m_headers = curl_slist_append(transfer->m_headers, "Expect:");
+        curl_easy_setopt(easyHandle, CURLOPT_HTTPHEADER, transfer->m_headers);
+
+        if (const auto& contentBody = request.GetContentBody())
+        {
+            transfer->m_body.assign(std::istreambuf_iterator<char>(*contentBody), std::istreambuf_iterator<char>());
+        }
+
+        switch (request.GetMethod())
+        {
+        case Aws::Http::HttpMethod::HTTP_GET:
+            curl_easy_setopt(easyHandle, CURLOPT_HTTPGET, 1L);
+            break;
+        case Aws::Http::HttpMethod::HTTP_HEAD:
+            curl_easy_setopt(easyHandle, CURLOPT_NOBODY, 1L);
+            break;
+        case Aws::Http::HttpMethod::HTTP_POST:
+            curl_easy_setopt(easyHandle, CURLOPT_POST, 1L);
+            break;
+        case Aws::Http::HttpMethod::HTTP_PUT:
+            curl_easy_setopt(easyHandle, CURLOPT_CUSTOMREQUEST, "PUT");
+            break;
+        case Aws::Http::HttpMethod::HTTP_DELETE:
+            curl_easy_setopt(easyHandle, CURLOPT_CUSTOMREQUEST, "DELETE");
+            break;
+        case Aws::Http::HttpMethod::HTTP_PATCH:
+            curl_easy_setopt(easyHandle, CURLOPT_CUSTOMREQUEST, "PATCH");
+            break;
+        default:
+            break;
+        }
+
+        if (!transfer->m_body.empty() || request.GetMethod() == Aws::Http::HttpMethod::HTTP_POST)
+        {
+            curl_easy_setopt(easyHandle, CURLOPT_POSTFIELDS, transfer->m_body.data());
+            curl_easy_setopt(easyHandle, CURLOPT_POSTFIELDSIZE_LARGE, static_cast<curl_off_t>(transfer->m_body.size()));
+        }
+
+        if (curl_multi_add_handle(m_multiHandle, easyHandle) != CURLM_OK)
+        {
+            curl_easy_cleanup(easyHandle);
+            CompleteTransfer(*transfer, CURLE_FAILED_INIT, 0);
+            return;
+        }
+
+        m_activeTransfers.emplace(easyHandle, std::move(transfer));
+    }
+
+    void CurlMultiHttpClientBackend::FinishTransfer(CURL* easyHandle, CURLcode result)
+    {
+        auto activeTransfer = m_activeTransfers.find(easyHandle);
+        if (activeTransfer == m_activeTransfers.end())
+        {
+            return;
+        }
+
+        std::unique_ptr<Transfer> transfer = std::move(activeTransfer->second);
+        m_activeTransfers.erase(activeTransfer);
+
+        long responseCode = 0;
+        curl_easy_getinfo(easyHandle, CURLINFO_RESPONSE_CODE, &responseCode);
+        curl_multi_remove_handle(m_multiHandle, easyHandle);
+        curl_easy_cleanup(easyHandle);
+
+        CompleteTransfer(*transfer, result, responseCode);
+    }
+
+    void CurlMultiHttpClientBackend::CompleteTransfer(Transfer& transfer, CURLcode result, long responseCode)
+    {
+        if (transfer.m_headers)
+        {
+            curl_slist_free_all(transfer.m_headers);
+            transfer.m_headers = nullptr;
+        }
+
+        // failed transfers are reported the same way as the AWS clients report them
+        if (result == CURLE_OK)
+        {
+            // responses without a body never reached OnBody
+            if (!transfer.m_headersReceived)
+            {
+                transfer.ReceiveHeaders(responseCode);
+            }
+        }
+        else
+        {
+            transfer.m_response->SetResponseCode(Aws::Http::HttpResponseCode::REQUEST_NOT_MADE);
+            transfer.m_response->SetClientErrorType(Aws::Client::CoreErrors::NETWORK_CONNECTION);
+            transfer.m_response->SetClientErrorMessage(curl_easy_strerror(result));
+        }
+
+        transfer.m_onComplete(transfer.m_response);
+    }
+
+    std::size_t CurlMultiHttpClientBackend::OnHeader(char* data, std::size_t size, std::size_t count, void* userData)
+    {
+        Transfer* transfer = static_cast<Transfer*>(userData);
+        std::size_t length = size * count;
+        std::string_view headerLine(data, length);
+
+        // every response of a redirect chain, and every interim response, starts with its own status line
+        if (headerLine.substr(0, 5) == "HTTP/")
+        {
+            transfer->m_responseHeaders.clear();
+            return length;
+        }
+
+        std::size_t separator = headerLine.find(':');
+        if (separator == std::string_view::npos)
+        {
+            return length;
+        }
+
+        constexpr std::string_view whitespaces = " \t\r\n";
+        std::string_view name = headerLine.substr(0, separator);
+        std::string_view value = headerLine.substr(separator + 1);
+        std::size_t valueBegin = value.find_first_not_of(whitespaces);
+        std::size_t valueEnd = value.find_last_not_of(whitespaces);
+        value = valueBegin == std::string_view::npos ? std::string_view{} : value.substr(valueBegin, valueEnd - valueBegin + 1);
+
+        transfer->m_responseHeaders.emplace_back(name, value);
+        return length;
+    }
+
+    std::size_t CurlMultiHttpClientBackend::OnBody(char* data, std::size_t size, std::size_t count, void* userData)
+    {
+        Transfer* transfer = static_cast<Transfer*>(userData);
+
+        // the headers of the final response are complete once its body starts, so the body stream can be prepared for it
+        if (!transfer->m_headersReceived)
+        {
+            long responseCode = 0;
+            curl_easy_getinfo(transfer->m_easyHandle, CURLINFO_RESPONSE_CODE, &responseCode);
+            transfer->ReceiveHeaders(responseCode);
+        }
+
+        std::size_t length = size * count;
+        auto& body = transfer->m_response->GetResponseBody();
+        body.write(data, static_cast<std::streamsize>(length));
+        return body ? length : 0;
+    }
+
+    int CurlMultiHttpClientBackend::OnProgress(
+        void* userData,
+        [[maybe_unused]] curl_off_t downloadTotal,
+        [[maybe_unused]] curl_off_t downloaded,
+        [[maybe_unused]] curl_off_t uploadTotal,
+        [[maybe_unused]] curl_off_t uploaded)
+    {
+        // a non zero result aborts the transfer
+        Transfer* transfer = static_cast<Transfer*>(userData);
+        const auto& continueRequest = transfer->m_request->GetContinueRequestHandler();
+        return continueRequest && !continueRequest(transfer->m_request.get()) ? 1 : 0;
+    }
+} // namespace Cesium
+
+#endif
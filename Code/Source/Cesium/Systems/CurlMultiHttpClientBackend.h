@@ -0,0 +1,69 @@
+#pragma once
+
+#if defined(CESIUM_USE_CURL_MULTI)
+
+#include "Cesium/Systems/HttpClientBackend.h"
+#include <AzCore/std/parallel/thread.h>
+#include <curl/curl.h>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace Cesium
+{
+    // Runs every transfer on a single io thread through a curl multi handle. Requests to the same host share HTTP/2 connections when
+    // the server supports it, so hundreds of transfers can be active without a thread blocked on each of them
+    class CurlMultiHttpClientBackend final : public HttpClientBackend
+    {
+        struct Transfer;
+
+    public:
+        explicit CurlMultiHttpClientBackend(const HttpClientConfiguration& configuration);
+
+        ~CurlMultiHttpClientBackend() noexcept override;
+
+        std::uint32_t GetMaxActiveRequests() const override;
+
+        std::uint32_t GetMaxActiveRequestsPerHost() const override;
+
+        void Send(const std::shared_ptr<Aws::Http::HttpRequest>& request, CompletionCallback onComplete) override;
+
+    private:
+        void Run();
+
+        void StartTransfer(std::unique_ptr<Transfer> transfer);
+
+        void FinishTransfer(CURL* easyHandle, CURLcode result);
+
+        static void CompleteTransfer(Transfer& transfer, CURLcode result, long responseCode);
+
+        static std::size_t OnHeader(char* data, std::size_t size, std::size_t count, void* userData);
+
+        static std::size_t OnBody(char* data, std::size_t size, std::size_t count, void* userData);
+
+        static int OnProgress(
+            void* userData, curl_off_t downloadTotal, curl_off_t downloaded, curl_off_t uploadTotal, curl_off_t uploaded);
+
+        static constexpr std::uint32_t MAX_ACTIVE_REQUESTS = 256;
+
+        // streams are multiplexed over the connections to a host, so a host can have many more requests than connections
+        static constexpr std::uint32_t MAX_ACTIVE_REQUESTS_PER_HOST = 64;
+        static constexpr int POLL_TIMEOUT_MS = 1000;
+
+        CURLM* m_multiHandle;
+        CURLSH* m_shareHandle;
+        long m_connectTimeoutMs;
+        std::mutex m_queueMutex;
+        std::vector<std::unique_ptr<Transfer>> m_queuedTransfers;
+        std::unordered_map<CURL*, std::unique_ptr<Transfer>> m_activeTransfers;
+        std::atomic<bool> m_stopping;
+        AZStd::thread m_ioThread;
+    };
+} // namespace Cesium
+
+#endif
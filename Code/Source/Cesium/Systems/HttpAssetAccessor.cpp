@@ -2,30 +2,116 @@
 #include "Cesium/PlatformInfo/PlatformInfo.h"
 #include <cassert>
 #include <string>
-#include <zlib.h>
+#include <string_view>
 
 namespace Cesium
 {
+    HttpAssetAccessor::InFlightRequest::InFlightRequest()
+        : m_abandoned{ false }
+    {
+    }
+
     HttpAssetAccessor::HttpAssetAccessor(HttpManager* httpManager)
         : m_httpManager{ httpManager }
+        , m_inFlightRequests{ std::make_shared<InFlightRequests>() }
+        , m_priority{ HttpRequestPriority::Metadata }
+        , m_cancellationToken{}
     {
         std::string engineVersion = PlatformInfo::GetEngineVersion().c_str();
         m_userAgentHeaderValue = std::string("Mozilla/5.0 (") + PlatformInfo::GetPlatformName().c_str() + ") Cesium For O3DE/" +
             engineVersion + " (Project " + PlatformInfo::GetProjectName().c_str() + " Engine O3DE " + engineVersion + ")";
     }
 
+    HttpAssetAccessor::HttpAssetAccessor(
+        const HttpAssetAccessor& parent, HttpRequestPriority priority, const HttpCancellationToken& cancellationToken)
+        : m_userAgentHeaderValue{ parent.m_userAgentHeaderValue }
+        , m_httpManager{ parent.m_httpManager }
+        , m_inFlightRequests{ parent.m_inFlightRequests }
+        , m_priority{ priority }
+        , m_cancellationToken{ cancellationToken }
+    {
+    }
+
+    std::shared_ptr<HttpAssetAccessor> HttpAssetAccessor::CreateCancellableAccessor(const HttpCancellationToken& cancellationToken) const
+    {
+        return std::shared_ptr<HttpAssetAccessor>(new HttpAssetAccessor(*this, HttpRequestPriority::Tile, cancellationToken));
+    }
+
     CesiumAsync::Future<std::shared_ptr<CesiumAsync::IAssetRequest>> HttpAssetAccessor::requestAsset(
         const CesiumAsync::AsyncSystem& asyncSystem, const std::string& url, const std::vector<THeader>& headers)
     {
         CesiumAsync::HttpHeaders requestHeaders = ConvertToCesiumHeaders(headers);
         requestHeaders[USER_AGENT_HEADER_KEY] = m_userAgentHeaderValue;
+
+        // attach to the identical request if it is still in flight, so that only one of them goes to the network. Requests that are
+        // being cancelled can't be joined anymore, so they are replaced by a new one
+        std::string requestKey = CreateInFlightRequestKey(url, requestHeaders);
+        auto promise = asyncSystem.createPromise<std::shared_ptr<CesiumAsync::IAssetRequest>>();
+        auto future = promise.getFuture();
+        std::shared_ptr<InFlightRequest> inFlightRequest;
+        {
+            std::lock_guard<std::mutex> lock(m_inFlightRequests->m_mutex);
+            std::shared_ptr<InFlightRequest>& existingRequest = m_inFlightRequests->m_requests[requestKey];
+            if (existingRequest && !existingRequest->m_abandoned)
+            {
+                existingRequest->m_promises.emplace_back(std::move(promise));
+                existingRequest->m_cancellationTokens.emplace_back(m_cancellationToken);
+                return future;
+            }
+
+            existingRequest = std::make_shared<InFlightRequest>();
+            existingRequest->m_promises.emplace_back(std::move(promise));
+            existingRequest->m_cancellationTokens.emplace_back(m_cancellationToken);
+            inFlightRequest = existingRequest;
+        }
+
         HttpRequestParameter parameter(AZStd ::string(url.c_str()), Aws::Http::HttpMethod::HTTP_GET, std::move(requestHeaders));
-        return m_httpManager->AddRequest(asyncSystem, std::move(parameter))
+        parameter.m_priority = GetRequestPriority(url);
+
+        // tile servers answer bursts with 429 or 503, which would otherwise fail the tile for good
+        parameter.m_retryable = true;
+        parameter.m_continueRequest = [inFlightRequests = m_inFlightRequests, inFlightRequest]()
+        {
+            std::lock_guard<std::mutex> lock(inFlightRequests->m_mutex);
+            for (const auto& cancellationToken : inFlightRequest->m_cancellationTokens)
+            {
+                if (!cancellationToken.IsCancelled())
+                {
+                    return true;
+                }
+            }
+
+            inFlightRequest->m_abandoned = true;
+            return false;
+        };
+
+        m_httpManager->AddRequest(asyncSystem, std::move(parameter))
             .thenImmediately(
-                [](HttpResult&& result) -> std::shared_ptr<CesiumAsync::IAssetRequest>
+                [inFlightRequests = m_inFlightRequests, inFlightRequest, requestKey = std::move(requestKey)](HttpResult&& result)
                 {
-                    return HttpAssetAccessor::CreateO3DEAssetRequest(*result.m_request, result.m_response.get());
+                    std::shared_ptr<CesiumAsync::IAssetRequest> completedRequest =
+                        HttpAssetAccessor::CreateO3DEAssetRequest(*result.m_request, result.m_response.get());
+
+                    std::vector<CesiumAsync::Promise<std::shared_ptr<CesiumAsync::IAssetRequest>>> promises;
+                    {
+                        std::lock_guard<std::mutex> lock(inFlightRequests->m_mutex);
+                        auto existingRequest = inFlightRequests->m_requests.find(requestKey);
+                        if (existingRequest != inFlightRequests->m_requests.end() && existingRequest->second == inFlightRequest)
+                        {
+                            inFlightRequests->m_requests.erase(existingRequest);
+                        }
+
+                        promises = std::move(inFlightRequest->m_promises);
+                        inFlightRequest->m_abandoned = true;
+                    }
+
+                    for (auto& promise : promises)
+                    {
+                        promise.resolve(completedRequest);
+                    }
                 });
+
+        return future;
     }
 
     CesiumAsync::Future<std::shared_ptr<CesiumAsync::IAssetRequest>> HttpAssetAccessor::post(
@@ -39,6 +125,7 @@ namespace Cesium
         AZStd::string requestBody(reinterpret_cast<const char*>(contentPayload.data()), contentPayload.size());
         HttpRequestParameter parameter(
             AZStd ::string(url.c_str()), Aws::Http::HttpMethod::HTTP_POST, std::move(requestHeaders), std::move(requestBody));
+        parameter.m_priority = HttpRequestPriority::Metadata;
         return m_httpManager->AddRequest(asyncSystem, std::move(parameter))
             .thenImmediately(
                 [](HttpResult&& result) -> std::shared_ptr<CesiumAsync::IAssetRequest>
@@ -49,6 +136,36 @@ namespace Cesium
 
     void HttpAssetAccessor::tick() noexcept
     {
+        // the http manager is shared by every accessor, so it is ticked once a frame by the Cesium system instead
+    }
+
+    HttpRequestPriority HttpAssetAccessor::GetRequestPriority(const std::string& url) const
+    {
+        // tileset.json, layer.json and the other json documents describe how the tiles are found, so they go first
+        std::size_t pathEnd = url.find_first_of("?#");
+        std::string_view path(url.data(), pathEnd == std::string::npos ? url.size() : pathEnd);
+        constexpr std::string_view jsonExtension = ".json";
+        if (path.size() >= jsonExtension.size() && path.substr(path.size() - jsonExtension.size()) == jsonExtension)
+        {
+            return HttpRequestPriority::Metadata;
+        }
+
+        return m_priority;
+    }
+
+    std::string HttpAssetAccessor::CreateInFlightRequestKey(const std::string& url, const CesiumAsync::HttpHeaders& headers)
+    {
+        // headers are kept sorted, so the same set of headers always produces the same key
+        std::string key = url;
+        for (const auto& header : headers)
+        {
+            key += '\n';
+            key += header.first;
+            key += ':';
+            key += header.second;
+        }
+
+        return key;
     }
 
     std::string HttpAssetAccessor::ConvertMethodToString(Aws::Http::HttpMethod method)
@@ -121,63 +238,14 @@ namespace Cesium
         std::string contentType = response.GetContentType().c_str();
         CesiumAsync::HttpHeaders headers = ConvertToCesiumHeaders(response.GetHeaders());
 
-        // try to decompress gzip if there are any
+        // HttpManager has already decoded the body, so it's no longer described by Content-Encoding, and Content-Length is the
+        // size of the decoded body. Caches store these headers next to the body
         IOContent responseContent = HttpManager::GetResponseBodyContent(response);
-        auto contentEncoding = headers.find(CONTENT_ENCODING_HEADER_KEY);
-        if (contentEncoding != headers.end())
+        if (headers.erase(CONTENT_ENCODING_HEADER_KEY) > 0)
         {
-            if (contentEncoding->second.find("gzip") != std::string::npos)
-            {
-                return std::make_unique<HttpAssetResponse>(
-                    statusCode, std::move(contentType), std::move(headers), DecodeGzip(responseContent));
-            }
+            headers[CONTENT_LENGTH_HEADER_KEY] = std::to_string(responseContent.size());
         }
 
         return std::make_unique<HttpAssetResponse>(statusCode, std::move(contentType), std::move(headers), std::move(responseContent));
     }
-
-    IOContent HttpAssetAccessor::DecodeGzip(IOContent& content)
-    {
-        z_stream zs; // z_stream is zlib's control structure
-        memset(&zs, 0, sizeof(zs));
-
-        if (inflateInit2(&zs, MAX_WBITS + 16) != Z_OK)
-        {
-            return std::move(content);
-        }
-
-        zs.next_in = reinterpret_cast<Bytef*>(content.data());
-        zs.avail_in = static_cast<uInt>(content.size());
-
-        int ret;
-        char outbuffer[32768];
-        IOContent output;
-
-        // get the decompressed bytes blockwise using repeated calls to inflate
-        do
-        {
-            zs.next_out = reinterpret_cast<Bytef*>(outbuffer);
-            zs.avail_out = sizeof(outbuffer);
-
-            ret = inflate(&zs, 0);
-
-            if (output.size() < zs.total_out)
-            {
-                std::size_t decompressSoFar = output.size();
-                std::size_t addSize = zs.total_out - output.size();
-                output.resize(output.size() + addSize);
-                std::memcpy(output.data() + decompressSoFar, outbuffer, addSize);
-            }
-
-        } while (ret == Z_OK);
-
-        inflateEnd(&zs);
-
-        if (ret != Z_STREAM_END)
-        {
-            return std::move(content);
-        }
-
-        return output;
-    }
 } // namespace Cesium
@@ -6,11 +6,14 @@
 #include <CesiumAsync/Future.h>
 #include <CesiumAsync/IAssetAccessor.h>
 #include <CesiumAsync/IAssetResponse.h>
+#include <CesiumAsync/Promise.h>
 #include <aws/core/http/HttpTypes.h>
 #include <cstdint>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace Aws
@@ -105,9 +108,31 @@ namespace Cesium
 
     class HttpAssetAccessor final : public CesiumAsync::IAssetAccessor
     {
+        // A GET request that is waiting for its response. Duplicate requests add their promise and cancellation token to it, so that
+        // all of them are resolved with the same response, and the request is only cancelled once every one of them is
+        struct InFlightRequest
+        {
+            InFlightRequest();
+
+            std::vector<CesiumAsync::Promise<std::shared_ptr<CesiumAsync::IAssetRequest>>> m_promises;
+            std::vector<HttpCancellationToken> m_cancellationTokens;
+            bool m_abandoned;
+        };
+
+        // in flight requests keyed by url and headers. It is shared by every accessor created from the same parent
+        struct InFlightRequests
+        {
+            std::mutex m_mutex;
+            std::unordered_map<std::string, std::shared_ptr<InFlightRequest>> m_requests;
+        };
+
     public:
         HttpAssetAccessor(HttpManager* httpManager);
 
+        // creates an accessor that sends tile requests on the tile lane, and cancels them once the token is cancelled. Identical
+        // requests are still shared with this accessor and every other one created from it
+        std::shared_ptr<HttpAssetAccessor> CreateCancellableAccessor(const HttpCancellationToken& cancellationToken) const;
+
         CesiumAsync::Future<std::shared_ptr<CesiumAsync::IAssetRequest>> requestAsset(
             const CesiumAsync::AsyncSystem& asyncSystem, const std::string& url, const std::vector<THeader>& headers = {}) override;
 
@@ -120,6 +145,12 @@ namespace Cesium
         void tick() noexcept override;
 
     private:
+        HttpAssetAccessor(const HttpAssetAccessor& parent, HttpRequestPriority priority, const HttpCancellationToken& cancellationToken);
+
+        HttpRequestPriority GetRequestPriority(const std::string& url) const;
+
+        static std::string CreateInFlightRequestKey(const std::string& url, const CesiumAsync::HttpHeaders& headers);
+
         static std::string ConvertMethodToString(Aws::Http::HttpMethod method);
 
         static CesiumAsync::HttpHeaders ConvertToCesiumHeaders(const std::vector<THeader>& headers);
@@ -131,12 +162,14 @@ namespace Cesium
 
         static std::unique_ptr<HttpAssetResponse> CreateO3DEAssetResponse(Aws::Http::HttpResponse& response);
 
-        static IOContent DecodeGzip(IOContent& content);
-
         static constexpr const char* const USER_AGENT_HEADER_KEY = "User-Agent";
         static constexpr const char* const CONTENT_ENCODING_HEADER_KEY = "Content-Encoding";
+        static constexpr const char* const CONTENT_LENGTH_HEADER_KEY = "Content-Length";
 
         std::string m_userAgentHeaderValue;
         HttpManager* m_httpManager;
+        std::shared_ptr<InFlightRequests> m_inFlightRequests;
+        HttpRequestPriority m_priority;
+        HttpCancellationToken m_cancellationToken;
     };
 } // namespace Cesium
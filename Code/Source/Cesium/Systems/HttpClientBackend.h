@@ -0,0 +1,52 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+
+namespace Aws
+{
+    namespace Http
+    {
+        class HttpRequest;
+        class HttpResponse;
+    } // namespace Http
+} // namespace Aws
+
+namespace Cesium
+{
+    struct HttpClientConfiguration final
+    {
+        // connections are kept alive and reused for later requests to the same host, so this also bounds the idle connections
+        std::uint32_t m_maxConnectionsPerHost{ 6 };
+
+        std::uint32_t m_connectTimeoutMs{ 10000 };
+
+        // retryable requests that fail with 408, 429, 502, 503, 504 or a dropped connection are sent again after Retry-After, or
+        // after a random delay of up to base * 2^attempt
+        std::uint32_t m_maxRetries{ 3 };
+
+        std::uint32_t m_retryBaseDelayMs{ 250 };
+
+        std::uint32_t m_retryMaxDelayMs{ 30000 };
+
+        // every host starts at this rate. It is halved whenever the host fails like above, and grows back while it succeeds
+        std::uint32_t m_maxRequestsPerSecondPerHost{ 500 };
+    };
+
+    // Transfers the requests that HttpManager has scheduled. The completion callback can be called from any thread, and with a null
+    // response when the request could not be made at all
+    class HttpClientBackend
+    {
+    public:
+        using CompletionCallback = std::function<void(const std::shared_ptr<Aws::Http::HttpResponse>&)>;
+
+        virtual ~HttpClientBackend() noexcept = default;
+
+        virtual std::uint32_t GetMaxActiveRequests() const = 0;
+
+        virtual std::uint32_t GetMaxActiveRequestsPerHost() const = 0;
+
+        virtual void Send(const std::shared_ptr<Aws::Http::HttpRequest>& request, CompletionCallback onComplete) = 0;
+    };
+} // namespace Cesium
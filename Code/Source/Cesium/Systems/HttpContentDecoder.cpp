@@ -0,0 +1,382 @@
+#include "Cesium/Systems/HttpContentDecoder.h"
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <zlib.h>
+
+#if defined(CESIUM_USE_BROTLI)
+#include <brotli/decode.h>
+#endif
+
+#if defined(CESIUM_USE_ZSTD)
+#include <zstd.h>
+#endif
+
+namespace Cesium
+{
+    namespace
+    {
+        // handles both gzip and deflate, since zlib detects the header of either format
+        class GzipContentDecoder final : public HttpContentDecoder
+        {
+        public:
+            explicit GzipContentDecoder(bool allowRawDeflate)
+                : m_stream{}
+                , m_header{}
+                , m_headerSize{ 0 }
+                , m_allowRawDeflate{ allowRawDeflate }
+                , m_initialized{ false }
+                , m_finished{ false }
+            {
+                if (!m_allowRawDeflate)
+                {
+                    m_initialized = inflateInit2(&m_stream, MAX_WBITS + 32) == Z_OK;
+                }
+            }
+
+            ~GzipContentDecoder() noexcept override
+            {
+                if (m_initialized)
+                {
+                    inflateEnd(&m_stream);
+                }
+            }
+
+            bool Decode(const std::byte* data, std::size_t size, IOContent& output) override
+            {
+                if (m_initialized)
+                {
+                    return Inflate(data, size, output);
+                }
+
+                if (!m_allowRawDeflate)
+                {
+                    return false;
+                }
+
+                // deflate bodies should be zlib streams, but some servers send raw deflate without a header. The format is only known
+                // once the two header bytes are in, which may take more than one call
+                std::size_t headerBytes = std::min(size, m_header.size() - m_headerSize);
+                std::copy(data, data + headerBytes, m_header.begin() + m_headerSize);
+                m_headerSize += headerBytes;
+                if (m_headerSize < m_header.size())
+                {
+                    return true;
+                }
+
+                int windowBits = HasZlibOrGzipHeader() ? MAX_WBITS + 32 : -MAX_WBITS;
+                m_initialized = inflateInit2(&m_stream, windowBits) == Z_OK;
+                if (!m_initialized || !Inflate(m_header.data(), m_header.size(), output))
+                {
+                    return false;
+                }
+
+                return Inflate(data + headerBytes, size - headerBytes, output);
+            }
+
+            bool IsFinished() const override
+            {
+                return m_finished;
+            }
+
+        private:
+            bool Inflate(const std::byte* data, std::size_t size, IOContent& output)
+            {
+                m_stream.next_in = const_cast<Bytef*>(reinterpret_cast<const Bytef*>(data));
+                m_stream.avail_in = static_cast<uInt>(size);
+
+                // keep inflating while there is input, or while the last block was filled and inflate may still have output pending
+                bool outputFull = false;
+                while (!m_finished && (m_stream.avail_in > 0 || outputFull))
+                {
+                    std::byte* block = GetOutputBlock();
+                    m_stream.next_out = reinterpret_cast<Bytef*>(block);
+                    m_stream.avail_out = static_cast<uInt>(OUTPUT_BLOCK_SIZE);
+
+                    int result = inflate(&m_stream, Z_NO_FLUSH);
+                    AppendOutputBlock(block, OUTPUT_BLOCK_SIZE - m_stream.avail_out, output);
+                    outputFull = m_stream.avail_out == 0;
+                    if (result == Z_STREAM_END)
+                    {
+                        m_finished = true;
+                    }
+                    else if (result == Z_BUF_ERROR)
+                    {
+                        break;
+                    }
+                    else if (result != Z_OK)
+                    {
+                        return false;
+                    }
+                }
+
+                return true;
+            }
+
+            bool HasZlibOrGzipHeader() const
+            {
+                std::uint32_t first = static_cast<std::uint32_t>(m_header[0]);
+                std::uint32_t second = static_cast<std::uint32_t>(m_header[1]);
+                if (first == 0x1f && second == 0x8b)
+                {
+                    return true;
+                }
+
+                // deflate method, a window of at most 32K, and a check value that makes the header a multiple of 31
+                return (first & 0x0f) == Z_DEFLATED && (first >> 4) <= 7 && ((first << 8) | second) % 31 == 0;
+            }
+
+            z_stream m_stream;
+            std::array<std::byte, 2> m_header;
+            std::size_t m_headerSize;
+            bool m_allowRawDeflate;
+            bool m_initialized;
+            bool m_finished;
+        };
+
+#if defined(CESIUM_USE_BROTLI)
+        class BrotliContentDecoder final : public HttpContentDecoder
+        {
+        public:
+            BrotliContentDecoder()
+                : m_state{ BrotliDecoderCreateInstance(nullptr, nullptr, nullptr) }
+                , m_finished{ false }
+            {
+            }
+
+            ~BrotliContentDecoder() noexcept override
+            {
+                if (m_state)
+                {
+                    BrotliDecoderDestroyInstance(m_state);
+                }
+            }
+
+            bool Decode(const std::byte* data, std::size_t size, IOContent& output) override
+            {
+                if (!m_state)
+                {
+                    return false;
+                }
+
+                const std::uint8_t* nextIn = reinterpret_cast<const std::uint8_t*>(data);
+                std::size_t availableIn = size;
+                while (!m_finished)
+                {
+                    std::byte* block = GetOutputBlock();
+                    std::uint8_t* nextOut = reinterpret_cast<std::uint8_t*>(block);
+                    std::size_t availableOut = OUTPUT_BLOCK_SIZE;
+
+                    BrotliDecoderResult result =
+                        BrotliDecoderDecompressStream(m_state, &availableIn, &nextIn, &availableOut, &nextOut, nullptr);
+                    AppendOutputBlock(block, OUTPUT_BLOCK_SIZE - availableOut, output);
+                    if (result == BROTLI_DECODER_RESULT_SUCCESS)
+                    {
+                        m_finished = true;
+                    }
+                    else if (result == BROTLI_DECODER_RESULT_NEEDS_MORE_INPUT)
+                    {
+                        break;
+                    }
+                    else if (result == BROTLI_DECODER_RESULT_ERROR)
+                    {
+                        return false;
+                    }
+                }
+
+                return true;
+            }
+
+            bool IsFinished() const override
+            {
+                return m_finished;
+            }
+
+        private:
+            BrotliDecoderState* m_state;
+            bool m_finished;
+        };
+#endif
+
+#if defined(CESIUM_USE_ZSTD)
+        class ZstdContentDecoder final : public HttpContentDecoder
+        {
+        public:
+            ZstdContentDecoder()
+                : m_context{ ZSTD_createDCtx() }
+                , m_frameHeaderChecked{ false }
+                , m_finished{ false }
+            {
+            }
+
+            ~ZstdContentDecoder() noexcept override
+            {
+                if (m_context)
+                {
+                    ZSTD_freeDCtx(m_context);
+                }
+            }
+
+            bool Decode(const std::byte* data, std::size_t size, IOContent& output) override
+            {
+                if (!m_context)
+                {
+                    return false;
+                }
+
+                // the frame header usually carries the decoded size, so the output is allocated exactly once
+                if (!m_frameHeaderChecked)
+                {
+                    m_frameHeaderChecked = true;
+                    unsigned long long contentSize = ZSTD_getFrameContentSize(data, size);
+                    if (contentSize != ZSTD_CONTENTSIZE_UNKNOWN && contentSize != ZSTD_CONTENTSIZE_ERROR &&
+                        contentSize <= MAX_RESERVED_OUTPUT_SIZE)
+                    {
+                        output.reserve(output.size() + static_cast<std::size_t>(contentSize));
+                    }
+                }
+
+                ZSTD_inBuffer input{ data, size, 0 };
+                bool outputFull = false;
+                while (!m_finished && (input.pos < input.size || outputFull))
+                {
+                    ZSTD_outBuffer block{ GetOutputBlock(), OUTPUT_BLOCK_SIZE, 0 };
+
+                    std::size_t result = ZSTD_decompressStream(m_context, &block, &input);
+                    AppendOutputBlock(static_cast<const std::byte*>(block.dst), block.pos, output);
+                    if (ZSTD_isError(result))
+                    {
+                        return false;
+                    }
+
+                    m_finished = result == 0;
+                    outputFull = block.pos == block.size;
+                }
+
+                return true;
+            }
+
+            bool IsFinished() const override
+            {
+                return m_finished;
+            }
+
+        private:
+            ZSTD_DCtx* m_context;
+            bool m_frameHeaderChecked;
+            bool m_finished;
+        };
+#endif
+
+        std::string_view TrimEncoding(std::string_view contentEncoding)
+        {
+            std::size_t begin = contentEncoding.find_first_not_of(" \t");
+            if (begin == std::string_view::npos)
+            {
+                return {};
+            }
+
+            std::size_t end = contentEncoding.find_last_not_of(" \t");
+            return contentEncoding.substr(begin, end - begin + 1);
+        }
+    } // namespace
+
+    void HttpContentDecoder::Reserve(std::size_t encodedSize, IOContent& output) const
+    {
+        std::size_t expectedSize = std::min(encodedSize * EXPECTED_COMPRESSION_RATIO, MAX_RESERVED_OUTPUT_SIZE);
+        output.reserve(std::max(output.size(), expectedSize));
+    }
+
+    std::unique_ptr<HttpContentDecoder> HttpContentDecoder::Create(std::string_view contentEncoding)
+    {
+        // encodings are matched exactly. Bodies encoded more than once are rare enough to be left as they are
+        contentEncoding = TrimEncoding(contentEncoding);
+        if (contentEncoding == "gzip" || contentEncoding == "x-gzip")
+        {
+            return std::make_unique<GzipContentDecoder>(false);
+        }
+
+        if (contentEncoding == "deflate")
+        {
+            return std::make_unique<GzipContentDecoder>(true);
+        }
+
+#if defined(CESIUM_USE_BROTLI)
+        if (contentEncoding == "br")
+        {
+            return std::make_unique<BrotliContentDecoder>();
+        }
+#endif
+
+#if defined(CESIUM_USE_ZSTD)
+        if (contentEncoding == "zstd")
+        {
+            return std::make_unique<ZstdContentDecoder>();
+        }
+#endif
+
+        return nullptr;
+    }
+
+    const char* HttpContentDecoder::GetAcceptEncoding()
+    {
+#if defined(CESIUM_USE_BROTLI) && defined(CESIUM_USE_ZSTD)
+        return "zstd, br, gzip, deflate";
+#elif defined(CESIUM_USE_BROTLI)
+        return "br, gzip, deflate";
+#elif defined(CESIUM_USE_ZSTD)
+        return "zstd, gzip, deflate";
+#else
+        return "gzip, deflate";
+#endif
+    }
+
+    bool HttpContentDecoder::DecodeContent(std::string_view contentEncoding, IOContent& content)
+    {
+        std::unique_ptr<HttpContentDecoder> decoder = Create(contentEncoding);
+        if (!decoder)
+        {
+            return TrimEncoding(contentEncoding).empty() || TrimEncoding(contentEncoding) == "identity";
+        }
+
+        IOContent output;
+        decoder->Reserve(content.size(), output);
+        for (std::size_t offset = 0; offset < content.size(); offset += DECODE_CONTENT_CHUNK_SIZE)
+        {
+            std::size_t chunkSize = std::min(DECODE_CONTENT_CHUNK_SIZE, content.size() - offset);
+            if (!decoder->Decode(content.data() + offset, chunkSize, output))
+            {
+                return false;
+            }
+        }
+
+        if (!decoder->IsFinished())
+        {
+            return false;
+        }
+
+        content = std::move(output);
+        return true;
+    }
+
+    HttpContentDecoder::HttpContentDecoder()
+        : m_outputBlock{ new std::byte[OUTPUT_BLOCK_SIZE] }
+    {
+    }
+
+    std::byte* HttpContentDecoder::GetOutputBlock()
+    {
+        return m_outputBlock.get();
+    }
+
+    void HttpContentDecoder::AppendOutputBlock(const std::byte* block, std::size_t size, IOContent& output)
+    {
+        std::size_t decodedSize = output.size();
+        if (output.capacity() - decodedSize < size)
+        {
+            output.reserve(std::max(output.capacity() * 2, decodedSize + std::max(size, OUTPUT_BLOCK_SIZE)));
+        }
+
+        output.insert(output.end(), block, block + size);
+    }
+} // namespace Cesium
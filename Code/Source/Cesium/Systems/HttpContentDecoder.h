@@ -0,0 +1,55 @@
+#pragma once
+
+#include "Cesium/Systems/GenericIOManager.h"
+#include <cstddef>
+#include <memory>
+#include <string_view>
+
+namespace Cesium
+{
+    // Decompresses a response body while it is being received. Decoded bytes are appended to the content, which grows
+    // geometrically unless it was reserved up front
+    class HttpContentDecoder
+    {
+    public:
+        virtual ~HttpContentDecoder() noexcept = default;
+
+        // returns false when the data is not valid for the encoding
+        virtual bool Decode(const std::byte* data, std::size_t size, IOContent& output) = 0;
+
+        virtual bool IsFinished() const = 0;
+
+        // reserves the output from the size of the encoded body. Decoders that find the decoded size in the stream itself reserve
+        // the exact size once they see it
+        void Reserve(std::size_t encodedSize, IOContent& output) const;
+
+        // returns nullptr for identity and for encodings that are not supported
+        static std::unique_ptr<HttpContentDecoder> Create(std::string_view contentEncoding);
+
+        // the Accept-Encoding header value that lists every encoding Create() supports
+        static const char* GetAcceptEncoding();
+
+        // decodes a body that has already been received in full. Returns false when it can't be decoded
+        static bool DecodeContent(std::string_view contentEncoding, IOContent& content);
+
+    protected:
+        HttpContentDecoder();
+
+        // returns the block that the next decoded bytes are written to. It is small enough to stay in cache, and it is not
+        // initialized, so decoding doesn't write the output twice
+        std::byte* GetOutputBlock();
+
+        // appends the bytes that were decoded into the output block. The output grows geometrically, and it is never
+        // reallocated while it has the capacity for them
+        static void AppendOutputBlock(const std::byte* block, std::size_t size, IOContent& output);
+
+        static constexpr std::size_t OUTPUT_BLOCK_SIZE = 32 * 1024;
+        static constexpr std::size_t EXPECTED_COMPRESSION_RATIO = 4;
+        static constexpr std::size_t MAX_RESERVED_OUTPUT_SIZE = 256 * 1024 * 1024;
+
+    private:
+        static constexpr std::size_t DECODE_CONTENT_CHUNK_SIZE = 1024 * 1024;
+
+        std::unique_ptr<std::byte[]> m_outputBlock;
+    };
+} // namespace Cesium
@@ -1,11 +1,11 @@
 #include "Cesium/Systems/HttpManager.h"
-#include <AzFramework/AzFramework_Traits_Platform.h>
+#include "Cesium/Systems/BlockingHttpClientBackend.h"
+#include "Cesium/Systems/CurlMultiHttpClientBackend.h"
+#include "Cesium/Systems/HttpContentDecoder.h"
+#include "Cesium/Systems/HttpResponseBodyStream.h"
 #include <AWSNativeSDKInit/AWSNativeSDKInit.h>
 #include <AzCore/PlatformDef.h>
 #include <AzCore/Utils/Utils.h>
-#include <AzCore/Jobs/JobManager.h>
-#include <AzCore/Jobs/JobContext.h>
-#include <AzCore/Jobs/JobFunction.h>
 #include <CesiumUtility/Uri.h>
 #include <CesiumAsync/Promise.h>
 
@@ -15,40 +15,50 @@
 // _SILENCE_CXX17_OLD_ALLOCATOR_MEMBERS_DEPRECATION_WARNING or _SILENCE_ALL_CXX17_DEPRECATION_WARNINGS to acknowledge that you have received
 // this warning.
 AZ_PUSH_DISABLE_WARNING(4251 4996, "-Wunknown-warning-option")
-#include <aws/core/client/ClientConfiguration.h>
-#include <aws/core/http/HttpClient.h>
 #include <aws/core/http/HttpClientFactory.h>
 #include <aws/core/http/HttpRequest.h>
 #include <aws/core/http/HttpResponse.h>
+#include <aws/core/utils/DateTime.h>
+#include <aws/core/utils/memory/AWSMemory.h>
 AZ_POP_DISABLE_WARNING
 
+#include <algorithm>
+#include <cstdlib>
+#include <future>
+#include <iterator>
 #include <stdexcept>
+#include <unordered_set>
+#include <vector>
 
 namespace Cesium
 {
     struct HttpManager::RequestHandler
     {
-        RequestHandler(
-            const std::shared_ptr<Aws::Http::HttpClient>& awsHttpClient,
-            HttpRequestParameter&& httpRequestParameter,
-            const CesiumAsync::Promise<HttpResult>& promise)
-            : m_awsHttpClient{ awsHttpClient }
-            , m_httpRequestParameter{ std::move(httpRequestParameter) }
+        RequestHandler(HttpRequestParameter&& httpRequestParameter, const CesiumAsync::Promise<HttpResult>& promise)
+            : m_httpRequestParameter{ std::move(httpRequestParameter) }
             , m_promise{ promise }
         {
         }
 
-        void operator()()
+        std::shared_ptr<Aws::Http::HttpRequest> CreateRequest() const
         {
             Aws::Http::URI awsURI(m_httpRequestParameter.m_url.c_str());
-            auto awsHttpRequest = Aws::Http::CreateHttpRequest(
-                awsURI, m_httpRequestParameter.m_method, Aws::Utils::Stream::DefaultResponseStreamFactoryMethod);
+            auto awsHttpRequest = HttpManager::CreateHttpRequest(awsURI, m_httpRequestParameter.m_method);
 
             for (const auto& it : m_httpRequestParameter.m_headers)
             {
                 awsHttpRequest->SetHeaderValue(it.first.c_str(), it.second.c_str());
             }
 
+            if (m_httpRequestParameter.m_continueRequest)
+            {
+                awsHttpRequest->SetContinueRequestHandle(
+                    [continueRequest = m_httpRequestParameter.m_continueRequest]([[maybe_unused]] const Aws::Http::HttpRequest* request)
+                    {
+                        return continueRequest();
+                    });
+            }
+
             if (!m_httpRequestParameter.m_body.empty())
             {
                 auto body = std::make_shared<Aws::StringStream>();
@@ -57,49 +67,51 @@ namespace Cesium
                 awsHttpRequest->SetContentLength(std::to_string(m_httpRequestParameter.m_body.length()).c_str());
             }
 
-            auto awsHttpResponse = m_awsHttpClient->MakeRequest(awsHttpRequest);
-            m_promise.resolve({ awsHttpRequest, awsHttpResponse });
+            return awsHttpRequest;
+        }
+
+        void Complete(const std::shared_ptr<Aws::Http::HttpRequest>& request, const std::shared_ptr<Aws::Http::HttpResponse>& response)
+        {
+            m_promise.resolve({ request, response });
+        }
+
+        void Cancel()
+        {
+            Aws::Http::URI awsURI(m_httpRequestParameter.m_url.c_str());
+            m_promise.resolve({ HttpManager::CreateHttpRequest(awsURI, m_httpRequestParameter.m_method), nullptr });
         }
 
-        std::shared_ptr<Aws::Http::HttpClient> m_awsHttpClient;
         HttpRequestParameter m_httpRequestParameter;
         CesiumAsync::Promise<HttpResult> m_promise;
     };
 
     struct HttpManager::GenericIORequestHandler
     {
-        GenericIORequestHandler(
-            const std::shared_ptr<Aws::Http::HttpClient>& awsHttpClient,
-            const IORequestParameter& request,
-            const CesiumAsync::Promise<IOContent>& promise)
-            : m_awsHttpClient{ awsHttpClient }
-            , m_request{ request }
+        GenericIORequestHandler(const IORequestParameter& request, const CesiumAsync::Promise<IOContent>& promise)
+            : m_request{ request }
             , m_promise{ promise }
         {
         }
 
-        GenericIORequestHandler(
-            const std::shared_ptr<Aws::Http::HttpClient>& awsHttpClient,
-            IORequestParameter&& request,
-            const CesiumAsync::Promise<IOContent>& promise)
-            : m_awsHttpClient{ awsHttpClient }
-            , m_request{ std::move(request) }
+        GenericIORequestHandler(IORequestParameter&& request, const CesiumAsync::Promise<IOContent>& promise)
+            : m_request{ std::move(request) }
             , m_promise{ promise }
         {
         }
 
-        void operator()()
+        std::shared_ptr<Aws::Http::HttpRequest> CreateRequest() const
         {
-            std::string absoluteUrl = CesiumUtility::Uri::resolve(m_request.m_parentPath.c_str(), m_request.m_path.c_str());
-
-            Aws::Http::URI awsURI(absoluteUrl.c_str());
-            auto awsHttpRequest = Aws::Http::CreateHttpRequest(
-                awsURI, Aws::Http::HttpMethod::HTTP_GET, Aws::Utils::Stream::DefaultResponseStreamFactoryMethod);
+            Aws::Http::URI awsURI(GetAbsoluteUrl().c_str());
+            return HttpManager::CreateHttpRequest(awsURI, Aws::Http::HttpMethod::HTTP_GET);
+        }
 
-            auto awsHttpResponse = m_awsHttpClient->MakeRequest(awsHttpRequest);
-            if (awsHttpResponse)
+        void Complete(
+            [[maybe_unused]] const std::shared_ptr<Aws::Http::HttpRequest>& request,
+            const std::shared_ptr<Aws::Http::HttpResponse>& response)
+        {
+            if (response)
             {
-                m_promise.resolve(HttpManager::GetResponseBodyContent(*awsHttpResponse));
+                m_promise.resolve(HttpManager::GetResponseBodyContent(*response));
             }
             else
             {
@@ -107,34 +119,115 @@ namespace Cesium
             }
         }
 
-        std::shared_ptr<Aws::Http::HttpClient> m_awsHttpClient;
+        void Cancel()
+        {
+            m_promise.resolve(IOContent{});
+        }
+
+        std::string GetAbsoluteUrl() const
+        {
+            return CesiumUtility::Uri::resolve(m_request.m_parentPath.c_str(), m_request.m_path.c_str());
+        }
+
         IORequestParameter m_request;
         CesiumAsync::Promise<IOContent> m_promise;
     };
 
-    HttpManager::HttpManager()
+    namespace
+    {
+        std::atomic<std::uint64_t> g_cancellationCount{ 0 };
+    } // namespace
+
+    HttpCancellationToken::HttpCancellationToken()
+        : m_cancelled{ std::make_shared<std::atomic<bool>>(false) }
+    {
+    }
+
+    void HttpCancellationToken::Cancel()
     {
-        AZ::JobManagerDesc jobDesc;
-        for (size_t i = 0; i < AZStd::thread::hardware_concurrency(); ++i)
+        if (!m_cancelled->exchange(true))
         {
-            jobDesc.m_workerThreads.push_back({ static_cast<int>(i) });
+            g_cancellationCount.fetch_add(1);
         }
-        m_ioJobManager = AZStd::make_unique<AZ::JobManager>(jobDesc);
-        m_ioJobContext = AZStd::make_unique<AZ::JobContext>(*m_ioJobManager);
+    }
+
+    bool HttpCancellationToken::IsCancelled() const
+    {
+        return m_cancelled->load();
+    }
+
+    std::uint64_t HttpCancellationToken::GetCancellationCount()
+    {
+        return g_cancellationCount.load();
+    }
+
+    HttpManager::HttpManager()
+        : HttpManager(nullptr, HttpClientConfiguration{})
+    {
+    }
+
+    HttpManager::HttpManager(const HttpClientConfiguration& configuration)
+        : HttpManager(nullptr, configuration)
+    {
+    }
+
+    HttpManager::HttpManager(AZStd::unique_ptr<HttpClientBackend> backend)
+        : HttpManager(std::move(backend), HttpClientConfiguration{})
+    {
+    }
 
+    HttpManager::HttpManager(AZStd::unique_ptr<HttpClientBackend> backend, const HttpClientConfiguration& configuration)
+        : m_configuration{ configuration }
+        , m_retryJitter{ std::random_device{}() }
+        , m_nextSequence{ 0 }
+        , m_sweptCancellationCount{ 0 }
+        , m_activeRequestCount{ 0 }
+        , m_maxActiveRequests{ 0 }
+        , m_maxActiveRequestsPerHost{ 0 }
+        , m_shuttingDown{ false }
+    {
+        // requests and responses are AWS types whichever backend sends them, so the SDK is initialized before any backend
         AZ::Utils::SetEnv("AWS_EC2_METADATA_DISABLED", "True", true);
         AWSNativeSDKInit::InitializationManager::InitAwsApi();
 
-        Aws::Client::ClientConfiguration config;
-        config.enableTcpKeepAlive = AZ_TRAIT_AZFRAMEWORK_AWS_ENABLE_TCP_KEEP_ALIVE_SUPPORTED;
-        m_awsHttpClient = Aws::Http::CreateHttpClient(config);
+        m_backend = backend ? std::move(backend) : CreateDefaultBackend(configuration);
+        m_maxActiveRequests = m_backend->GetMaxActiveRequests();
+        m_maxActiveRequestsPerHost = m_backend->GetMaxActiveRequestsPerHost();
     }
 
     HttpManager::~HttpManager() noexcept
     {
-        m_ioJobContext.reset();
-        m_ioJobManager.reset();
-        m_awsHttpClient.reset();
+        // requests that have not been sent are completed, so nothing is left waiting for them
+        std::vector<ScheduledRequest> pendingRequests;
+        {
+            std::lock_guard<std::mutex> lock(m_schedulerMutex);
+            m_shuttingDown = true;
+            for (auto& lane : m_lanes)
+            {
+                for (auto& [host, hostQueue] : lane.m_hostQueues)
+                {
+                    std::move(hostQueue.begin(), hostQueue.end(), std::back_inserter(pendingRequests));
+                }
+
+                lane.m_hostQueues.clear();
+                lane.m_readyHosts.clear();
+            }
+
+            for (auto& [notBefore, delayedRequest] : m_delayedRequests)
+            {
+                pendingRequests.emplace_back(std::move(delayedRequest));
+            }
+
+            m_delayedRequests.clear();
+        }
+
+        for (auto& pendingRequest : pendingRequests)
+        {
+            pendingRequest.m_cancel();
+        }
+
+        // the backend completes the requests that are still being transferred before it is gone
+        m_backend.reset();
         AWSNativeSDKInit::InitializationManager::Shutdown();
     }
 
@@ -142,10 +235,28 @@ namespace Cesium
         const CesiumAsync::AsyncSystem& asyncSystem, HttpRequestParameter&& httpRequestParameter)
     {
         auto promise = asyncSystem.createPromise<HttpResult>();
-        AZ::Job* job = aznew AZ::JobFunction<std::function<void()>>(
-            RequestHandler{ m_awsHttpClient, std::move(httpRequestParameter), promise }, true, m_ioJobContext.get());
-        job->Start();
+        HttpRequestPriority priority = httpRequestParameter.m_priority;
+        ScheduledRequest scheduledRequest;
+        scheduledRequest.m_host = GetHost(httpRequestParameter.m_url.c_str());
+        scheduledRequest.m_continueRequest = httpRequestParameter.m_continueRequest;
+        scheduledRequest.m_retryable = httpRequestParameter.m_retryable;
+
+        auto handler = std::make_shared<RequestHandler>(std::move(httpRequestParameter), promise);
+        scheduledRequest.m_createRequest = [handler]()
+        {
+            return handler->CreateRequest();
+        };
+        scheduledRequest.m_complete =
+            [handler](const std::shared_ptr<Aws::Http::HttpRequest>& request, const std::shared_ptr<Aws::Http::HttpResponse>& response)
+        {
+            handler->Complete(request, response);
+        };
+        scheduledRequest.m_cancel = [handler]()
+        {
+            handler->Cancel();
+        };
 
+        ScheduleRequest(priority, std::move(scheduledRequest));
         return promise.getFuture();
     }
 
@@ -162,23 +273,33 @@ namespace Cesium
 
     IOContent HttpManager::GetFileContent(const IORequestParameter& request)
     {
+        // the request goes through the same backend as every other request, so it reuses their pooled connections and counts
+        // against the host limit
+        auto content = std::make_shared<std::promise<IOContent>>();
+        std::future<IOContent> contentFuture = content->get_future();
         std::string absoluteUrl = CesiumUtility::Uri::resolve(request.m_parentPath.c_str(), request.m_path.c_str());
 
-        Aws::Client::ClientConfiguration config;
-        config.enableTcpKeepAlive = AZ_TRAIT_AZFRAMEWORK_AWS_ENABLE_TCP_KEEP_ALIVE_SUPPORTED;
-        std::shared_ptr<Aws::Http::HttpClient> awsHttpClient = Aws::Http::CreateHttpClient(config);
-
-        Aws::Http::URI awsURI(absoluteUrl.c_str());
-        auto awsHttpRequest =
-            Aws::Http::CreateHttpRequest(awsURI, Aws::Http::HttpMethod::HTTP_GET, Aws::Utils::Stream::DefaultResponseStreamFactoryMethod);
-
-        auto awsHttpResponse = awsHttpClient->MakeRequest(awsHttpRequest);
-        if (!awsHttpRequest || !awsHttpResponse)
+        ScheduledRequest scheduledRequest;
+        scheduledRequest.m_host = GetHost(absoluteUrl);
+        scheduledRequest.m_createRequest = [absoluteUrl]()
         {
-            return {};
-        }
+            Aws::Http::URI awsURI(absoluteUrl.c_str());
+            return CreateHttpRequest(awsURI, Aws::Http::HttpMethod::HTTP_GET);
+        };
+        scheduledRequest.m_complete = [content](
+            [[maybe_unused]] const std::shared_ptr<Aws::Http::HttpRequest>& awsHttpRequest,
+            const std::shared_ptr<Aws::Http::HttpResponse>& awsHttpResponse)
+        {
+            content->set_value(awsHttpResponse ? GetResponseBodyContent(*awsHttpResponse) : IOContent{});
+        };
+        scheduledRequest.m_cancel = [content]()
+        {
+            content->set_value(IOContent{});
+        };
 
-        return GetResponseBodyContent(*awsHttpResponse);
+        // the calling thread is blocked until the content arrives, so the request goes ahead of the tiles that are waiting
+        ScheduleRequest(HttpRequestPriority::Metadata, std::move(scheduledRequest));
+        return contentFuture.get();
     }
 
     IOContent HttpManager::GetFileContent(IORequestParameter&& request)
@@ -190,10 +311,26 @@ namespace Cesium
         const CesiumAsync::AsyncSystem& asyncSystem, const IORequestParameter& request)
     {
         auto promise = asyncSystem.createPromise<IOContent>();
-        AZ::Job* job = aznew AZ::JobFunction<std::function<void()>>(
-            GenericIORequestHandler{ m_awsHttpClient, request, promise }, true, m_ioJobContext.get());
-        job->Start();
+        auto handler = std::make_shared<GenericIORequestHandler>(request, promise);
 
+        // only UI images are requested through the generic IO interface
+        ScheduledRequest scheduledRequest;
+        scheduledRequest.m_host = GetHost(handler->GetAbsoluteUrl());
+        scheduledRequest.m_createRequest = [handler]()
+        {
+            return handler->CreateRequest();
+        };
+        scheduledRequest.m_complete =
+            [handler](const std::shared_ptr<Aws::Http::HttpRequest>& request, const std::shared_ptr<Aws::Http::HttpResponse>& response)
+        {
+            handler->Complete(request, response);
+        };
+        scheduledRequest.m_cancel = [handler]()
+        {
+            handler->Cancel();
+        };
+
+        ScheduleRequest(HttpRequestPriority::Ui, std::move(scheduledRequest));
         return promise.getFuture();
     }
 
@@ -201,26 +338,620 @@ namespace Cesium
         const CesiumAsync::AsyncSystem& asyncSystem, IORequestParameter&& request)
     {
         auto promise = asyncSystem.createPromise<IOContent>();
-        AZ::Job* job = aznew AZ::JobFunction<std::function<void()>>(
-            GenericIORequestHandler{ m_awsHttpClient, std::move(request), promise }, true, m_ioJobContext.get());
-        job->Start();
+        auto handler = std::make_shared<GenericIORequestHandler>(std::move(request), promise);
 
+        // only UI images are requested through the generic IO interface
+        ScheduledRequest scheduledRequest;
+        scheduledRequest.m_host = GetHost(handler->GetAbsoluteUrl());
+        scheduledRequest.m_createRequest = [handler]()
+        {
+            return handler->CreateRequest();
+        };
+        scheduledRequest.m_complete =
+            [handler](const std::shared_ptr<Aws::Http::HttpRequest>& request, const std::shared_ptr<Aws::Http::HttpResponse>& response)
+        {
+            handler->Complete(request, response);
+        };
+        scheduledRequest.m_cancel = [handler]()
+        {
+            handler->Cancel();
+        };
+
+        ScheduleRequest(HttpRequestPriority::Ui, std::move(scheduledRequest));
         return promise.getFuture();
     }
 
+    void HttpManager::Tick()
+    {
+        // the count is read before sweeping, so a token cancelled during the sweep is swept again on the next tick
+        std::uint64_t cancellationCount = HttpCancellationToken::GetCancellationCount();
+        if (cancellationCount != m_sweptCancellationCount)
+        {
+            m_sweptCancellationCount = cancellationCount;
+            SweepCancelledRequests();
+        }
+
+        {
+            // rate limited hosts may have tokens again
+            std::lock_guard<std::mutex> lock(m_schedulerMutex);
+            for (const auto& host : m_rateLimitedHosts)
+            {
+                MarkHostReady(host);
+            }
+
+            m_rateLimitedHosts.clear();
+        }
+
+        DispatchRequests();
+    }
+
+    void HttpManager::DispatchRequests()
+    {
+        // requests are taken out under the lock, but their continue predicates are only called once it is released. A request
+        // that turns out to be cancelled gives its slot back, so the loop runs again to fill it
+        bool releasedSlot = true;
+        while (releasedSlot)
+        {
+            releasedSlot = false;
+            std::vector<ScheduledRequest> startedRequests;
+            {
+                std::lock_guard<std::mutex> lock(m_schedulerMutex);
+                if (m_shuttingDown)
+                {
+                    return;
+                }
+
+                auto now = std::chrono::steady_clock::now();
+                PromoteDueRetries(now);
+                TakeRequestsToSend(now, startedRequests);
+            }
+
+            for (auto& startedRequest : startedRequests)
+            {
+                if (startedRequest.m_continueRequest && !startedRequest.m_continueRequest())
+                {
+                    startedRequest.m_cancel();
+                    std::lock_guard<std::mutex> lock(m_schedulerMutex);
+                    ReleaseHostSlot(startedRequest.m_host);
+                    releasedSlot = true;
+                    continue;
+                }
+
+                auto awsHttpRequest = startedRequest.m_createRequest();
+                m_backend->Send(
+                    awsHttpRequest,
+                    [this, awsHttpRequest, request = std::move(startedRequest)](
+                        const std::shared_ptr<Aws::Http::HttpResponse>& awsHttpResponse) mutable
+                    {
+                        CompleteRequest(std::move(request), awsHttpRequest, awsHttpResponse);
+                    });
+            }
+        }
+    }
+
+    void HttpManager::SweepCancelledRequests()
+    {
+        struct PendingPredicate
+        {
+            std::size_t m_lane;
+            std::string m_host;
+            std::uint64_t m_sequence;
+            std::function<bool()> m_continueRequest;
+        };
+
+        // the predicates are copied out, so that nothing else waits on the lock while they run
+        std::vector<PendingPredicate> predicates;
+        std::vector<std::uint64_t> delayedPredicateSequences;
+        std::vector<std::function<bool()>> delayedPredicates;
+        {
+            std::lock_guard<std::mutex> lock(m_schedulerMutex);
+            for (std::size_t laneIndex = 0; laneIndex < m_lanes.size(); ++laneIndex)
+            {
+                for (const auto& [host, hostQueue] : m_lanes[laneIndex].m_hostQueues)
+                {
+                    for (const auto& request : hostQueue)
+                    {
+                        if (request.m_continueRequest)
+                        {
+                            predicates.push_back(PendingPredicate{ laneIndex, host, request.m_sequence, request.m_continueRequest });
+                        }
+                    }
+                }
+            }
+
+            for (const auto& [notBefore, request] : m_delayedRequests)
+            {
+                if (request.m_continueRequest)
+                {
+                    delayedPredicateSequences.emplace_back(request.m_sequence);
+                    delayedPredicates.emplace_back(request.m_continueRequest);
+                }
+            }
+        }
+
+        std::vector<PendingPredicate> cancelledPredicates;
+        for (auto& predicate : predicates)
+        {
+            if (!predicate.m_continueRequest())
+            {
+                cancelledPredicates.emplace_back(std::move(predicate));
+            }
+        }
+
+        std::unordered_set<std::uint64_t> cancelledDelayedSequences;
+        for (std::size_t i = 0; i < delayedPredicates.size(); ++i)
+        {
+            if (!delayedPredicates[i]())
+            {
+                cancelledDelayedSequences.emplace(delayedPredicateSequences[i]);
+            }
+        }
+
+        if (cancelledPredicates.empty() && cancelledDelayedSequences.empty())
+        {
+            return;
+        }
+
+        // only the queues of hosts that have cancelled requests are touched. Requests that were sent in the meantime are gone from
+        // their queue, and are handled when they complete
+        std::vector<ScheduledRequest> cancelledRequests;
+        {
+            std::lock_guard<std::mutex> lock(m_schedulerMutex);
+            for (const auto& predicate : cancelledPredicates)
+            {
+                Lane& lane = m_lanes[predicate.m_lane];
+                auto hostQueue = lane.m_hostQueues.find(predicate.m_host);
+                if (hostQueue == lane.m_hostQueues.end())
+                {
+                    continue;
+                }
+
+                auto request = std::find_if(
+                    hostQueue->second.begin(),
+                    hostQueue->second.end(),
+                    [&predicate](const ScheduledRequest& pendingRequest)
+                    {
+                        return pendingRequest.m_sequence == predicate.m_sequence;
+                    });
+                if (request == hostQueue->second.end())
+                {
+                    continue;
+                }
+
+                // the host is ready under the sequence of its first request, which may be the one that is removed
+                bool ready = lane.m_readyHosts.erase({ hostQueue->second.front().m_sequence, predicate.m_host }) > 0;
+                cancelledRequests.emplace_back(std::move(*request));
+                hostQueue->second.erase(request);
+                if (hostQueue->second.empty())
+                {
+                    lane.m_hostQueues.erase(hostQueue);
+                }
+                else if (ready)
+                {
+                    lane.m_readyHosts.emplace(hostQueue->second.front().m_sequence, predicate.m_host);
+                }
+            }
+
+            for (auto it = m_delayedRequests.begin(); it != m_delayedRequests.end() && !cancelledDelayedSequences.empty();)
+            {
+                if (cancelledDelayedSequences.erase(it->second.m_sequence) > 0)
+                {
+                    cancelledRequests.emplace_back(std::move(it->second));
+                    it = m_delayedRequests.erase(it);
+                    continue;
+                }
+
+                ++it;
+            }
+        }
+
+        for (auto& cancelledRequest : cancelledRequests)
+        {
+            cancelledRequest.m_cancel();
+        }
+    }
+
+    std::vector<HttpHostStatistics> HttpManager::GetHostStatistics()
+    {
+        std::vector<HttpHostStatistics> hosts = m_telemetry.GetHostStatistics();
+        std::lock_guard<std::mutex> lock(m_schedulerMutex);
+        for (auto& host : hosts)
+        {
+            auto hostActiveRequestCount = m_activeRequestsPerHost.find(host.m_host);
+            if (hostActiveRequestCount != m_activeRequestsPerHost.end())
+            {
+                host.m_activeRequestCount = hostActiveRequestCount->second;
+            }
+        }
+
+        return hosts;
+    }
+
+    void HttpManager::ScheduleRequest(HttpRequestPriority priority, ScheduledRequest&& request)
+    {
+        request.m_priority = priority;
+        bool scheduled = false;
+        {
+            std::lock_guard<std::mutex> lock(m_schedulerMutex);
+            if (!m_shuttingDown)
+            {
+                EnqueueRequest(std::move(request));
+                scheduled = true;
+            }
+        }
+
+        if (!scheduled)
+        {
+            request.m_cancel();
+            return;
+        }
+
+        DispatchRequests();
+    }
+
+    void HttpManager::CompleteRequest(
+        ScheduledRequest&& request,
+        const std::shared_ptr<Aws::Http::HttpRequest>& awsHttpRequest,
+        const std::shared_ptr<Aws::Http::HttpResponse>& awsHttpResponse)
+    {
+        // requests that were aborted because nobody waits for them anymore don't say anything about the host
+        bool cancelled = request.m_continueRequest && !request.m_continueRequest();
+        bool failed = !cancelled && IsTransientFailure(awsHttpResponse.get());
+        std::string host = request.m_host;
+
+        // the body is measured before anything else, since completing the request takes it out of the response
+        bool retry = failed && request.m_retryable && request.m_attempt < m_configuration.m_maxRetries;
+        RecordRequestMetrics(request, awsHttpResponse.get(), retry);
+
+        bool retried = false;
+        if (retry)
+        {
+            std::lock_guard<std::mutex> lock(m_schedulerMutex);
+            if (!m_shuttingDown)
+            {
+                request.m_notBefore = std::chrono::steady_clock::now() + GetRetryDelay(awsHttpResponse.get(), request.m_attempt);
+                ++request.m_attempt;
+
+                // retries wait for their backoff here, and are queued again by the first dispatch after it. That is the next request
+                // that finishes or the next tick, whichever comes first
+                auto notBefore = request.m_notBefore;
+                m_delayedRequests.emplace(notBefore, std::move(request));
+                retried = true;
+            }
+        }
+
+        if (!retried)
+        {
+            request.m_complete(awsHttpRequest, awsHttpResponse);
+        }
+
+        FinishRequest(host, cancelled ? RequestOutcome::Cancelled : failed ? RequestOutcome::Failed : RequestOutcome::Succeeded);
+    }
+
+    void HttpManager::FinishRequest(const std::string& host, RequestOutcome outcome)
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_schedulerMutex);
+            ReleaseHostSlot(host);
+
+            // the rate of a host backs off multiplicatively when it fails and recovers additively, so it settles just below the rate
+            // the host can serve
+            auto rateLimiter = m_hostRateLimiters.find(host);
+            if (rateLimiter != m_hostRateLimiters.end() && outcome != RequestOutcome::Cancelled)
+            {
+                HostRateLimiter& limiter = rateLimiter->second;
+                if (outcome == RequestOutcome::Failed)
+                {
+                    limiter.m_requestsPerSecond =
+                        std::max(MIN_REQUESTS_PER_SECOND_PER_HOST, limiter.m_requestsPerSecond * REQUESTS_PER_SECOND_DECREASE_FACTOR);
+                    limiter.m_tokens = std::min(limiter.m_tokens, 0.0);
+                }
+                else
+                {
+                    limiter.m_requestsPerSecond = std::min(
+                        static_cast<double>(m_configuration.m_maxRequestsPerSecondPerHost),
+                        limiter.m_requestsPerSecond + REQUESTS_PER_SECOND_INCREASE);
+                }
+            }
+        }
+
+        DispatchRequests();
+    }
+
+    void HttpManager::EnqueueRequest(ScheduledRequest&& request)
+    {
+        request.m_sequence = m_nextSequence++;
+        Lane& lane = m_lanes[static_cast<std::size_t>(request.m_priority)];
+        std::deque<ScheduledRequest>& hostQueue = lane.m_hostQueues[request.m_host];
+        if (hostQueue.empty())
+        {
+            lane.m_readyHosts.emplace(request.m_sequence, request.m_host);
+        }
+
+        hostQueue.emplace_back(std::move(request));
+    }
+
+    void HttpManager::PromoteDueRetries(std::chrono::steady_clock::time_point now)
+    {
+        while (!m_delayedRequests.empty() && m_delayedRequests.begin()->first <= now)
+        {
+            EnqueueRequest(std::move(m_delayedRequests.begin()->second));
+            m_delayedRequests.erase(m_delayedRequests.begin());
+        }
+    }
+
+    void HttpManager::TakeRequestsToSend(std::chrono::steady_clock::time_point now, std::vector<ScheduledRequest>& requestsToSend)
+    {
+        // only the first ready host of a lane is looked at. It either sends its first request, or it is parked until one of its
+        // requests finishes, so each step costs the same however many requests are pending
+        for (auto& lane : m_lanes)
+        {
+            while (!lane.m_readyHosts.empty() && m_activeRequestCount < m_maxActiveRequests)
+            {
+                std::string host = lane.m_readyHosts.begin()->second;
+                lane.m_readyHosts.erase(lane.m_readyHosts.begin());
+
+                std::uint32_t& hostActiveRequestCount = m_activeRequestsPerHost[host];
+                if (hostActiveRequestCount >= m_maxActiveRequestsPerHost)
+                {
+                    continue;
+                }
+
+                if (!TryAcquireHostToken(host, hostActiveRequestCount, now))
+                {
+                    m_rateLimitedHosts.emplace(host);
+                    continue;
+                }
+
+                auto hostQueue = lane.m_hostQueues.find(host);
+                ScheduledRequest request = std::move(hostQueue->second.front());
+                hostQueue->second.pop_front();
+                if (hostQueue->second.empty())
+                {
+                    lane.m_hostQueues.erase(hostQueue);
+                }
+                else
+                {
+                    lane.m_readyHosts.emplace(hostQueue->second.front().m_sequence, host);
+                }
+
+                ++hostActiveRequestCount;
+                ++m_activeRequestCount;
+                m_telemetry.RecordRequestStarted(host, hostActiveRequestCount);
+                request.m_sendTime = now;
+                requestsToSend.emplace_back(std::move(request));
+            }
+
+            if (m_activeRequestCount >= m_maxActiveRequests)
+            {
+                return;
+            }
+        }
+    }
+
+    void HttpManager::ReleaseHostSlot(const std::string& host)
+    {
+        --m_activeRequestCount;
+        auto hostActiveRequestCount = m_activeRequestsPerHost.find(host);
+        if (--hostActiveRequestCount->second == 0)
+        {
+            m_activeRequestsPerHost.erase(hostActiveRequestCount);
+        }
+
+        MarkHostReady(host);
+    }
+
+    void HttpManager::MarkHostReady(const std::string& host)
+    {
+        for (auto& lane : m_lanes)
+        {
+            auto hostQueue = lane.m_hostQueues.find(host);
+            if (hostQueue != lane.m_hostQueues.end())
+            {
+                lane.m_readyHosts.emplace(hostQueue->second.front().m_sequence, host);
+            }
+        }
+    }
+
+    void HttpManager::RecordRequestMetrics(const ScheduledRequest& request, Aws::Http::HttpResponse* response, bool retried)
+    {
+        auto now = std::chrono::steady_clock::now();
+        HttpRequestMetrics metrics;
+        metrics.m_responseCode = response ? static_cast<int>(response->GetResponseCode()) : -1;
+        metrics.m_retried = retried;
+        metrics.m_bytesReceived = 0;
+        metrics.m_bytesDecoded = 0;
+        metrics.m_totalTime = std::chrono::duration_cast<std::chrono::milliseconds>(now - request.m_sendTime);
+
+        HttpResponseBodyStream* bodyStream = response ? HttpResponseBodyStream::FromStream(response->GetResponseBody()) : nullptr;
+        if (bodyStream && bodyStream->GetBuffer().GetReceivedSize() > 0)
+        {
+            const HttpResponseBodyBuffer& buffer = bodyStream->GetBuffer();
+            metrics.m_bytesReceived = buffer.GetReceivedSize();
+            metrics.m_bytesDecoded = buffer.GetContentSize();
+            metrics.m_timeToFirstByte =
+                std::chrono::duration_cast<std::chrono::milliseconds>(buffer.GetFirstByteTime() - request.m_sendTime);
+        }
+
+        m_telemetry.RecordRequestCompleted(request.m_host, metrics);
+    }
+
+    bool HttpManager::TryAcquireHostToken(
+        const std::string& host, std::uint32_t hostActiveRequestCount, std::chrono::steady_clock::time_point now)
+    {
+        auto rateLimiter = m_hostRateLimiters.find(host);
+        if (rateLimiter == m_hostRateLimiters.end())
+        {
+            double requestsPerSecond = static_cast<double>(m_configuration.m_maxRequestsPerSecondPerHost);
+            rateLimiter = m_hostRateLimiters.emplace(host, HostRateLimiter{ requestsPerSecond, requestsPerSecond, now }).first;
+        }
+
+        HostRateLimiter& limiter = rateLimiter->second;
+        double elapsedSeconds = std::chrono::duration<double>(now - limiter.m_lastRefill).count();
+        double capacity = std::max(1.0, limiter.m_requestsPerSecond);
+        limiter.m_tokens = std::min(capacity, limiter.m_tokens + elapsedSeconds * limiter.m_requestsPerSecond);
+        limiter.m_lastRefill = now;
+
+        // a host without active requests always gets one, so that a request nobody dispatches again for a while is not stuck
+        if (limiter.m_tokens < 1.0 && hostActiveRequestCount > 0)
+        {
+            return false;
+        }
+
+        limiter.m_tokens -= 1.0;
+        return true;
+    }
+
+    std::chrono::milliseconds HttpManager::GetRetryDelay(const Aws::Http::HttpResponse* response, std::uint32_t attempt)
+    {
+        std::chrono::milliseconds maxDelay(m_configuration.m_retryMaxDelayMs);
+
+        // Retry-After is either a number of seconds or an HTTP date
+        if (response && response->HasHeader(RETRY_AFTER_HEADER))
+        {
+            const Aws::String& retryAfter = response->GetHeader(RETRY_AFTER_HEADER);
+            if (!retryAfter.empty() && retryAfter.find_first_not_of("0123456789") == Aws::String::npos)
+            {
+                std::uint64_t delaySeconds = std::strtoull(retryAfter.c_str(), nullptr, 10);
+                return std::chrono::milliseconds(std::min<std::uint64_t>(delaySeconds * 1000, m_configuration.m_retryMaxDelayMs));
+            }
+
+            Aws::Utils::DateTime retryDate(retryAfter, Aws::Utils::DateFormat::RFC822);
+            if (retryDate.WasParseSuccessful())
+            {
+                std::int64_t delayMs = retryDate.Millis() - Aws::Utils::DateTime::CurrentTimeMillis();
+                return std::min(maxDelay, std::chrono::milliseconds(std::max<std::int64_t>(delayMs, 0)));
+            }
+        }
+
+        // full jitter spreads the retries of requests that failed together, so they don't hit the host at the same time again
+        std::uint64_t backoffMs = static_cast<std::uint64_t>(m_configuration.m_retryBaseDelayMs) << std::min(attempt, 16u);
+        backoffMs = std::min(backoffMs, static_cast<std::uint64_t>(m_configuration.m_retryMaxDelayMs));
+        std::uniform_int_distribution<std::uint64_t> jitter(0, backoffMs);
+        return std::chrono::milliseconds(jitter(m_retryJitter));
+    }
+
+    bool HttpManager::IsTransientFailure(const Aws::Http::HttpResponse* response)
+    {
+        if (!response)
+        {
+            return true;
+        }
+
+        switch (response->GetResponseCode())
+        {
+        case Aws::Http::HttpResponseCode::REQUEST_NOT_MADE:
+        case Aws::Http::HttpResponseCode::REQUEST_TIMEOUT:
+        case Aws::Http::HttpResponseCode::TOO_MANY_REQUESTS:
+        case Aws::Http::HttpResponseCode::BAD_GATEWAY:
+        case Aws::Http::HttpResponseCode::SERVICE_UNAVAILABLE:
+        case Aws::Http::HttpResponseCode::GATEWAY_TIMEOUT:
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    AZStd::unique_ptr<HttpClientBackend> HttpManager::CreateDefaultBackend(const HttpClientConfiguration& configuration)
+    {
+#if defined(CESIUM_USE_CURL_MULTI)
+        return AZStd::make_unique<CurlMultiHttpClientBackend>(configuration);
+#else
+        return AZStd::make_unique<BlockingHttpClientBackend>(configuration);
+#endif
+    }
+
+    std::string HttpManager::GetHost(const std::string& url)
+    {
+        std::size_t hostBegin = url.find("://");
+        hostBegin = hostBegin == std::string::npos ? 0 : hostBegin + 3;
+        std::size_t hostEnd = url.find_first_of("/?#", hostBegin);
+        if (hostEnd == std::string::npos)
+        {
+            return url.substr(hostBegin);
+        }
+
+        return url.substr(hostBegin, hostEnd - hostBegin);
+    }
+
     IOContent HttpManager::GetResponseBodyContent(Aws::Http::HttpResponse& response)
     {
         auto& ioStream = response.GetResponseBody();
-        std::size_t readSoFar = 0;
-        const std::size_t maxRead = 256;
+        if (HttpResponseBodyStream* bodyStream = HttpResponseBodyStream::FromStream(ioStream))
+        {
+            if (bodyStream->GetBuffer().HasDecodingFailed() || !bodyStream->GetBuffer().IsDecodingFinished())
+            {
+                return {};
+            }
+
+            return bodyStream->GetBuffer().TakeContent();
+        }
+
+        // bodies that weren't written by HttpResponseBodyStream are read block by block
         IOContent content;
+        std::size_t readSoFar = 0;
         while (ioStream)
         {
-            content.resize(readSoFar + maxRead);
-            ioStream.read(reinterpret_cast<char*>(content.data() + readSoFar), maxRead);
-            readSoFar += maxRead;
+            content.resize(readSoFar + RESPONSE_BODY_READ_BLOCK_SIZE);
+            ioStream.read(reinterpret_cast<char*>(content.data() + readSoFar), RESPONSE_BODY_READ_BLOCK_SIZE);
+            readSoFar += static_cast<std::size_t>(ioStream.gcount());
+        }
+
+        content.resize(readSoFar);
+
+        // and decoded once they are complete
+        if (response.HasHeader(Aws::Http::CONTENT_ENCODING_HEADER) &&
+            !HttpContentDecoder::DecodeContent(response.GetHeader(Aws::Http::CONTENT_ENCODING_HEADER).c_str(), content))
+        {
+            return {};
         }
 
         return content;
     }
+
+    std::shared_ptr<Aws::Http::HttpRequest> HttpManager::CreateHttpRequest(const Aws::Http::URI& uri, Aws::Http::HttpMethod method)
+    {
+        auto awsHttpRequest = Aws::Http::CreateHttpRequest(
+            uri, method,
+            []() -> Aws::IOStream*
+            {
+                return Aws::New<HttpResponseBodyStream>(RESPONSE_BODY_ALLOCATION_TAG);
+            });
+
+        // compressed bodies are decoded while they arrive, and the body is written straight into a buffer of the size that the
+        // server announced
+        awsHttpRequest->SetHeaderValue(Aws::Http::ACCEPT_ENCODING_HEADER, HttpContentDecoder::GetAcceptEncoding());
+        awsHttpRequest->SetHeadersReceivedEventHandler(
+            []([[maybe_unused]] const Aws::Http::HttpRequest* request, Aws::Http::HttpResponse* response)
+            {
+                if (!response)
+                {
+                    return;
+                }
+
+                HttpResponseBodyStream* bodyStream = HttpResponseBodyStream::FromStream(response->GetResponseBody());
+                if (!bodyStream)
+                {
+                    return;
+                }
+
+                if (response->HasHeader(Aws::Http::CONTENT_ENCODING_HEADER))
+                {
+                    bodyStream->GetBuffer().SetDecoder(
+                        HttpContentDecoder::Create(response->GetHeader(Aws::Http::CONTENT_ENCODING_HEADER).c_str()));
+                }
+
+                if (response->HasHeader(Aws::Http::CONTENT_LENGTH_HEADER))
+                {
+                    std::uint64_t contentLength =
+                        std::strtoull(response->GetHeader(Aws::Http::CONTENT_LENGTH_HEADER).c_str(), nullptr, 10);
+                    if (contentLength <= MAX_PRESIZED_RESPONSE_BODY_SIZE)
+                    {
+                        bodyStream->GetBuffer().Reserve(static_cast<std::size_t>(contentLength));
+                    }
+                }
+            });
+
+        return awsHttpRequest;
+    }
 } // namespace Cesium
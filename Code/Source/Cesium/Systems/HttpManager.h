@@ -1,35 +1,67 @@
 #pragma once
 
 #include "Cesium/Systems/GenericIOManager.h"
+#include "Cesium/Systems/HttpClientBackend.h"
+#include "Cesium/Systems/HttpTelemetry.h"
 #include <AzCore/std/string/string.h>
 #include <AzCore/std/smart_ptr/unique_ptr.h>
 #include <CesiumAsync/AsyncSystem.h>
 #include <CesiumAsync/Future.h>
 #include <CesiumAsync/HttpHeaders.h>
 #include <aws/core/http/HttpResponse.h>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
 
-namespace AZ
+namespace Cesium
 {
-    class JobManager;
-    class JobContext;
-    class Job;
-} // namespace AZ
+    // Requests are sent lane by lane, and in the order they were added within a lane. cesium-native already issues tile
+    // requests ordered by their screen space error, so they are kept in that order
+    enum class HttpRequestPriority
+    {
+        Metadata,
+        Ui,
+        Tile,
+        Count
+    };
 
-namespace Aws
-{
-    namespace Http
+    // Cancels every request that was made with a copy of the token
+    class HttpCancellationToken final
     {
-        class HttpClient;
-    }
-} // namespace Aws
+    public:
+        HttpCancellationToken();
+
+        void Cancel();
+
+        bool IsCancelled() const;
+
+        // how many tokens have been cancelled so far. HttpManager only looks for cancelled requests once it changes
+        static std::uint64_t GetCancellationCount();
+
+    private:
+        std::shared_ptr<std::atomic<bool>> m_cancelled;
+    };
 
-namespace Cesium
-{
     struct HttpRequestParameter final
     {
         HttpRequestParameter(AZStd::string&& url, Aws::Http::HttpMethod method)
             : m_url{ std::move(url) }
             , m_method{ method }
+            , m_priority{ HttpRequestPriority::Tile }
+            , m_retryable{ false }
         {
         }
 
@@ -37,6 +69,8 @@ namespace Cesium
             : m_url{ std::move(url) }
             , m_method{ method }
             , m_headers{ std::move(headers) }
+            , m_priority{ HttpRequestPriority::Tile }
+            , m_retryable{ false }
         {
         }
 
@@ -45,6 +79,8 @@ namespace Cesium
             , m_method{ method }
             , m_headers{ std::move(headers) }
             , m_body{ std::move(body) }
+            , m_priority{ HttpRequestPriority::Tile }
+            , m_retryable{ false }
         {
         }
 
@@ -55,6 +91,16 @@ namespace Cesium
         CesiumAsync::HttpHeaders m_headers;
 
         AZStd::string m_body;
+
+        HttpRequestPriority m_priority;
+
+        // only idempotent requests should be retried, since a failed response doesn't mean the server did nothing
+        bool m_retryable;
+
+        // checked before the request is sent and while it is transferred. Once it returns false, the request is dropped or
+        // aborted, and it completes without a response. Requests that wait in the queue are only checked again after an
+        // HttpCancellationToken is cancelled, so the predicate should turn false through one
+        std::function<bool()> m_continueRequest;
     };
 
     struct HttpResult final
@@ -68,9 +114,58 @@ namespace Cesium
         struct RequestHandler;
         struct GenericIORequestHandler;
 
+        struct ScheduledRequest
+        {
+            std::string m_host;
+            std::uint64_t m_sequence{ 0 };
+            HttpRequestPriority m_priority{ HttpRequestPriority::Tile };
+            bool m_retryable{ false };
+            std::uint32_t m_attempt{ 0 };
+            std::chrono::steady_clock::time_point m_notBefore{};
+            std::chrono::steady_clock::time_point m_sendTime{};
+            std::function<bool()> m_continueRequest;
+            std::function<std::shared_ptr<Aws::Http::HttpRequest>()> m_createRequest;
+            std::function<void(const std::shared_ptr<Aws::Http::HttpRequest>&, const std::shared_ptr<Aws::Http::HttpResponse>&)> m_complete;
+            std::function<void()> m_cancel;
+        };
+
+        // requests of a lane are queued per host, so that a host at its limit is skipped without looking at any of its requests
+        struct Lane
+        {
+            std::unordered_map<std::string, std::deque<ScheduledRequest>> m_hostQueues;
+
+            // hosts that may be able to send, ordered by the sequence of their first request, so the lane is still sent in the order
+            // requests were added. Hosts at their limit are left out until one of their requests finishes, and hosts out of tokens
+            // until the next tick
+            std::set<std::pair<std::uint64_t, std::string>> m_readyHosts;
+        };
+
+        // what a finished request tells about its host. Cancelled requests tell nothing, so they leave its rate alone
+        enum class RequestOutcome
+        {
+            Succeeded,
+            Failed,
+            Cancelled
+        };
+
+        // token bucket that holds up to a second of requests
+        struct HostRateLimiter
+        {
+            double m_requestsPerSecond;
+            double m_tokens;
+            std::chrono::steady_clock::time_point m_lastRefill;
+        };
+
     public:
         HttpManager();
 
+        // the default backend multiplexes requests over curl when it is available, and falls back to the blocking AWS client
+        explicit HttpManager(const HttpClientConfiguration& configuration);
+
+        explicit HttpManager(AZStd::unique_ptr<HttpClientBackend> backend);
+
+        HttpManager(AZStd::unique_ptr<HttpClientBackend> backend, const HttpClientConfiguration& configuration);
+
         ~HttpManager() noexcept;
 
         CesiumAsync::Future<HttpResult> AddRequest(
@@ -90,9 +185,82 @@ namespace Cesium
 
         static IOContent GetResponseBodyContent(Aws::Http::HttpResponse& response);
 
+        // called once a frame by the Cesium system. Completes pending requests when a cancellation token has been cancelled since
+        // the last tick, gives rate limited hosts another chance, and sends what fits. Retries whose backoff is over are sent by the
+        // first dispatch after it, so without other requests finishing, they wait for the next tick
+        void Tick();
+
+        // statistics of every host that has been sent a request, including how many requests it has active right now
+        std::vector<HttpHostStatistics> GetHostStatistics();
+
     private:
-        AZStd::unique_ptr<AZ::JobManager> m_ioJobManager;
-        AZStd::unique_ptr<AZ::JobContext> m_ioJobContext;
-        std::shared_ptr<Aws::Http::HttpClient> m_awsHttpClient;
+        // sends pending requests while their lane and host have capacity
+        void DispatchRequests();
+
+        // calls the continue predicates of every pending request, outside of the scheduler lock since they are code of the caller.
+        // Only done after a token has been cancelled
+        void SweepCancelledRequests();
+
+        void ScheduleRequest(HttpRequestPriority priority, ScheduledRequest&& request);
+
+        // the functions below expect the scheduler lock to be held
+        void EnqueueRequest(ScheduledRequest&& request);
+
+        void PromoteDueRetries(std::chrono::steady_clock::time_point now);
+
+        void TakeRequestsToSend(std::chrono::steady_clock::time_point now, std::vector<ScheduledRequest>& requestsToSend);
+
+        void ReleaseHostSlot(const std::string& host);
+
+        void MarkHostReady(const std::string& host);
+
+        void CompleteRequest(
+            ScheduledRequest&& request,
+            const std::shared_ptr<Aws::Http::HttpRequest>& awsHttpRequest,
+            const std::shared_ptr<Aws::Http::HttpResponse>& awsHttpResponse);
+
+        void FinishRequest(const std::string& host, RequestOutcome outcome);
+
+        void RecordRequestMetrics(const ScheduledRequest& request, Aws::Http::HttpResponse* response, bool retried);
+
+        bool TryAcquireHostToken(const std::string& host, std::uint32_t hostActiveRequestCount, std::chrono::steady_clock::time_point now);
+
+        std::chrono::milliseconds GetRetryDelay(const Aws::Http::HttpResponse* response, std::uint32_t attempt);
+
+        static bool IsTransientFailure(const Aws::Http::HttpResponse* response);
+
+        static std::string GetHost(const std::string& url);
+
+        static AZStd::unique_ptr<HttpClientBackend> CreateDefaultBackend(const HttpClientConfiguration& configuration);
+
+        static std::shared_ptr<Aws::Http::HttpRequest> CreateHttpRequest(const Aws::Http::URI& uri, Aws::Http::HttpMethod method);
+
+        static constexpr const char* const RESPONSE_BODY_ALLOCATION_TAG = "CesiumHttpResponseBody";
+        static constexpr std::size_t RESPONSE_BODY_READ_BLOCK_SIZE = 16 * 1024;
+
+        // Content-Length is only trusted up to this size. Larger bodies grow as they arrive
+        static constexpr std::uint64_t MAX_PRESIZED_RESPONSE_BODY_SIZE = 256 * 1024 * 1024;
+
+        static constexpr const char* const RETRY_AFTER_HEADER = "retry-after";
+        static constexpr double MIN_REQUESTS_PER_SECOND_PER_HOST = 1.0;
+        static constexpr double REQUESTS_PER_SECOND_DECREASE_FACTOR = 0.5;
+        static constexpr double REQUESTS_PER_SECOND_INCREASE = 1.0;
+
+        HttpClientConfiguration m_configuration;
+        HttpTelemetry m_telemetry;
+        AZStd::unique_ptr<HttpClientBackend> m_backend;
+        std::mutex m_schedulerMutex;
+        std::array<Lane, static_cast<std::size_t>(HttpRequestPriority::Count)> m_lanes;
+        std::multimap<std::chrono::steady_clock::time_point, ScheduledRequest> m_delayedRequests;
+        std::unordered_map<std::string, std::uint32_t> m_activeRequestsPerHost;
+        std::unordered_map<std::string, HostRateLimiter> m_hostRateLimiters;
+        std::unordered_set<std::string> m_rateLimitedHosts;
+        std::mt19937 m_retryJitter;
+        std::uint64_t m_nextSequence;
+        std::uint64_t m_sweptCancellationCount;
+        std::uint32_t m_activeRequestCount;
+        std::uint32_t m_maxActiveRequests;
+        std::uint32_t m_maxActiveRequestsPerHost;
+        bool m_shuttingDown;
     };
 } // namespace Cesium
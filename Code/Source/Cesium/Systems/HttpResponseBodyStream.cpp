@@ -0,0 +1,191 @@
+#include "Cesium/Systems/HttpResponseBodyStream.h"
+
+namespace Cesium
+{
+    HttpResponseBodyBuffer::HttpResponseBodyBuffer()
+        : m_readPosition{ 0 }
+        , m_receivedSize{ 0 }
+        , m_decodingFailed{ false }
+    {
+    }
+
+    void HttpResponseBodyBuffer::SetDecoder(std::unique_ptr<HttpContentDecoder> decoder)
+    {
+        m_decoder = std::move(decoder);
+    }
+
+    bool HttpResponseBodyBuffer::HasDecodingFailed() const
+    {
+        return m_decodingFailed;
+    }
+
+    bool HttpResponseBodyBuffer::IsDecodingFinished() const
+    {
+        return !m_decoder || m_receivedSize == 0 || m_decoder->IsFinished();
+    }
+
+    void HttpResponseBodyBuffer::Reserve(std::size_t size)
+    {
+        if (m_decoder)
+        {
+            m_decoder->Reserve(size, m_content);
+        }
+        else
+        {
+            m_content.reserve(size);
+        }
+    }
+
+    IOContent HttpResponseBodyBuffer::TakeContent()
+    {
+        InvalidateReadArea();
+        m_readPosition = 0;
+        IOContent content = std::move(m_content);
+        m_content = IOContent{};
+        m_decoder.reset();
+        return content;
+    }
+
+    std::size_t HttpResponseBodyBuffer::GetReceivedSize() const
+    {
+        return m_receivedSize;
+    }
+
+    std::size_t HttpResponseBodyBuffer::GetContentSize() const
+    {
+        return m_content.size();
+    }
+
+    std::chrono::steady_clock::time_point HttpResponseBodyBuffer::GetFirstByteTime() const
+    {
+        return m_firstByteTime;
+    }
+
+    HttpResponseBodyBuffer::int_type HttpResponseBodyBuffer::overflow(int_type ch)
+    {
+        if (traits_type::eq_int_type(ch, traits_type::eof()))
+        {
+            return traits_type::not_eof(ch);
+        }
+
+        char_type data = traits_type::to_char_type(ch);
+        xsputn(&data, 1);
+        return ch;
+    }
+
+    std::streamsize HttpResponseBodyBuffer::xsputn(const char_type* data, std::streamsize count)
+    {
+        if (count <= 0)
+        {
+            return 0;
+        }
+
+        if (m_receivedSize == 0)
+        {
+            m_firstByteTime = std::chrono::steady_clock::now();
+        }
+
+        m_receivedSize += static_cast<std::size_t>(count);
+
+        // writing may reallocate the content, so the read area is set up again on the next read
+        InvalidateReadArea();
+        const std::byte* bytes = reinterpret_cast<const std::byte*>(data);
+        if (!m_decoder)
+        {
+            m_content.insert(m_content.end(), bytes, bytes + count);
+        }
+        else if (!m_decodingFailed && !m_decoder->Decode(bytes, static_cast<std::size_t>(count), m_content))
+        {
+            // the rest of a corrupted body is still consumed, so that the connection finishes normally
+            m_decodingFailed = true;
+        }
+
+        return count;
+    }
+
+    HttpResponseBodyBuffer::int_type HttpResponseBodyBuffer::underflow()
+    {
+        InvalidateReadArea();
+        if (m_readPosition >= m_content.size())
+        {
+            return traits_type::eof();
+        }
+
+        char_type* begin = reinterpret_cast<char_type*>(m_content.data());
+        setg(begin, begin + m_readPosition, begin + m_content.size());
+        return traits_type::to_int_type(*gptr());
+    }
+
+    HttpResponseBodyBuffer::pos_type HttpResponseBodyBuffer::seekoff(
+        off_type offset, std::ios_base::seekdir direction, std::ios_base::openmode which)
+    {
+        // writes always append, so the put position is the size of the content
+        if (which & std::ios_base::out)
+        {
+            if (offset != 0 || direction == std::ios_base::beg)
+            {
+                return pos_type(off_type(-1));
+            }
+
+            return pos_type(static_cast<off_type>(m_content.size()));
+        }
+
+        InvalidateReadArea();
+        off_type base = 0;
+        if (direction == std::ios_base::cur)
+        {
+            base = static_cast<off_type>(m_readPosition);
+        }
+        else if (direction == std::ios_base::end)
+        {
+            base = static_cast<off_type>(m_content.size());
+        }
+
+        off_type position = base + offset;
+        if (position < 0 || position > static_cast<off_type>(m_content.size()))
+        {
+            return pos_type(off_type(-1));
+        }
+
+        m_readPosition = static_cast<std::size_t>(position);
+        return pos_type(position);
+    }
+
+    HttpResponseBodyBuffer::pos_type HttpResponseBodyBuffer::seekpos(pos_type position, std::ios_base::openmode which)
+    {
+        return seekoff(off_type(position), std::ios_base::beg, which);
+    }
+
+    void HttpResponseBodyBuffer::InvalidateReadArea()
+    {
+        if (eback())
+        {
+            m_readPosition = static_cast<std::size_t>(gptr() - eback());
+            setg(nullptr, nullptr, nullptr);
+        }
+    }
+
+    HttpResponseBodyStream::HttpResponseBodyStream()
+        : Aws::IOStream(&m_buffer)
+    {
+        pword(GetStreamMarkerIndex()) = this;
+    }
+
+    HttpResponseBodyBuffer& HttpResponseBodyStream::GetBuffer()
+    {
+        return m_buffer;
+    }
+
+    HttpResponseBodyStream* HttpResponseBodyStream::FromStream(Aws::IOStream& stream)
+    {
+        // streams don't carry their type without RTTI, so every body stream stores itself in a stream slot
+        void* marker = stream.pword(GetStreamMarkerIndex());
+        return marker == &stream ? static_cast<HttpResponseBodyStream*>(&stream) : nullptr;
+    }
+
+    int HttpResponseBodyStream::GetStreamMarkerIndex()
+    {
+        static const int markerIndex = std::ios_base::xalloc();
+        return markerIndex;
+    }
+} // namespace Cesium
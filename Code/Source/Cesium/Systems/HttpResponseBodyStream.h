@@ -0,0 +1,85 @@
+#pragma once
+
+#include "Cesium/Systems/GenericIOManager.h"
+#include "Cesium/Systems/HttpContentDecoder.h"
+#include <AzCore/PlatformDef.h>
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <streambuf>
+
+// The AWS Native SDK AWSAllocator triggers a warning due to accessing members of std::allocator directly.
+AZ_PUSH_DISABLE_WARNING(4251 4996, "-Wunknown-warning-option")
+#include <aws/core/utils/memory/stl/AWSStreamFwd.h>
+AZ_POP_DISABLE_WARNING
+
+namespace Cesium
+{
+    // Stream buffer that appends the response body straight into an IOContent. The content grows geometrically, or is allocated
+    // once when the size of the body is known up front, and it is moved out when the response is done. When the body is
+    // compressed, it is decoded as it arrives and only the decoded bytes are kept.
+    class HttpResponseBodyBuffer final : public std::streambuf
+    {
+    public:
+        HttpResponseBodyBuffer();
+
+        void SetDecoder(std::unique_ptr<HttpContentDecoder> decoder);
+
+        bool HasDecodingFailed() const;
+
+        // false while the decoder hasn't seen the end of the encoded stream, so a body that was cut off is not mistaken for a
+        // complete one. Bodies without an encoding are always complete, and so are empty ones
+        bool IsDecodingFinished() const;
+
+        // reserves the content from the size of the body as it is sent, which is the encoded size when there is a decoder
+        void Reserve(std::size_t size);
+
+        IOContent TakeContent();
+
+        // the number of body bytes written so far, before they were decoded
+        std::size_t GetReceivedSize() const;
+
+        std::size_t GetContentSize() const;
+
+        // only valid once some of the body has been received
+        std::chrono::steady_clock::time_point GetFirstByteTime() const;
+
+    protected:
+        int_type overflow(int_type ch) override;
+
+        std::streamsize xsputn(const char_type* data, std::streamsize count) override;
+
+        int_type underflow() override;
+
+        pos_type seekoff(off_type offset, std::ios_base::seekdir direction, std::ios_base::openmode which) override;
+
+        pos_type seekpos(pos_type position, std::ios_base::openmode which) override;
+
+    private:
+        void InvalidateReadArea();
+
+        IOContent m_content;
+        std::size_t m_readPosition;
+        std::unique_ptr<HttpContentDecoder> m_decoder;
+        std::size_t m_receivedSize;
+        std::chrono::steady_clock::time_point m_firstByteTime;
+        bool m_decodingFailed;
+    };
+
+    // Response stream that HttpManager creates for every request, so that the body can be taken without copying it
+    class HttpResponseBodyStream final : public Aws::IOStream
+    {
+    public:
+        HttpResponseBodyStream();
+
+        HttpResponseBodyBuffer& GetBuffer();
+
+        // returns nullptr when the stream was created by another factory
+        static HttpResponseBodyStream* FromStream(Aws::IOStream& stream);
+
+    private:
+        static int GetStreamMarkerIndex();
+
+        HttpResponseBodyBuffer m_buffer;
+    };
+} // namespace Cesium
@@ -0,0 +1,125 @@
+#include "Cesium/Systems/HttpTelemetry.h"
+#include <algorithm>
+#include <cmath>
+
+namespace Cesium
+{
+    HttpLatencyHistogram::HttpLatencyHistogram()
+        : m_bucketCounts{}
+        , m_count{ 0 }
+        , m_totalMs{ 0 }
+    {
+    }
+
+    void HttpLatencyHistogram::Record(std::chrono::milliseconds duration)
+    {
+        std::uint64_t durationMs = static_cast<std::uint64_t>(std::max<std::chrono::milliseconds::rep>(duration.count(), 0));
+        auto bucket = std::lower_bound(BUCKET_UPPER_BOUNDS_MS.begin(), BUCKET_UPPER_BOUNDS_MS.end(), durationMs);
+        ++m_bucketCounts[static_cast<std::size_t>(bucket - BUCKET_UPPER_BOUNDS_MS.begin())];
+        ++m_count;
+        m_totalMs += durationMs;
+    }
+
+    std::uint64_t HttpLatencyHistogram::GetCount() const
+    {
+        return m_count;
+    }
+
+    const std::array<std::uint64_t, HttpLatencyHistogram::BUCKET_COUNT>& HttpLatencyHistogram::GetBucketCounts() const
+    {
+        return m_bucketCounts;
+    }
+
+    double HttpLatencyHistogram::GetMeanMs() const
+    {
+        return m_count == 0 ? 0.0 : static_cast<double>(m_totalMs) / static_cast<double>(m_count);
+    }
+
+    std::uint32_t HttpLatencyHistogram::GetPercentileMs(double percentile) const
+    {
+        if (m_count == 0)
+        {
+            return 0;
+        }
+
+        std::uint64_t rank = static_cast<std::uint64_t>(std::ceil(std::clamp(percentile, 0.0, 1.0) * static_cast<double>(m_count)));
+        rank = std::max<std::uint64_t>(rank, 1);
+        std::uint64_t countSoFar = 0;
+        for (std::size_t i = 0; i < BUCKET_UPPER_BOUNDS_MS.size(); ++i)
+        {
+            countSoFar += m_bucketCounts[i];
+            if (countSoFar >= rank)
+            {
+                return BUCKET_UPPER_BOUNDS_MS[i];
+            }
+        }
+
+        return BUCKET_UPPER_BOUNDS_MS.back();
+    }
+
+    HttpHostStatistics::HttpHostStatistics()
+        : m_requestCount{ 0 }
+        , m_retryCount{ 0 }
+        , m_bytesReceived{ 0 }
+        , m_bytesDecoded{ 0 }
+        , m_activeRequestCount{ 0 }
+        , m_peakActiveRequestCount{ 0 }
+    {
+    }
+
+    void HttpTelemetry::RecordRequestStarted(const std::string& host, std::uint32_t hostActiveRequestCount)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        HttpHostStatistics& statistics = GetOrAddHost(host);
+        statistics.m_peakActiveRequestCount = std::max(statistics.m_peakActiveRequestCount, hostActiveRequestCount);
+    }
+
+    void HttpTelemetry::RecordRequestCompleted(const std::string& host, const HttpRequestMetrics& metrics)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        HttpHostStatistics& statistics = GetOrAddHost(host);
+        ++statistics.m_requestCount;
+        ++statistics.m_responseCodeCounts[metrics.m_responseCode];
+        statistics.m_retryCount += metrics.m_retried ? 1 : 0;
+        statistics.m_bytesReceived += metrics.m_bytesReceived;
+        statistics.m_bytesDecoded += metrics.m_bytesDecoded;
+        statistics.m_totalTime.Record(metrics.m_totalTime);
+        if (metrics.m_timeToFirstByte)
+        {
+            statistics.m_timeToFirstByte.Record(*metrics.m_timeToFirstByte);
+        }
+    }
+
+    std::vector<HttpHostStatistics> HttpTelemetry::GetHostStatistics() const
+    {
+        std::vector<HttpHostStatistics> hosts;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            hosts.reserve(m_hosts.size());
+            for (const auto& host : m_hosts)
+            {
+                hosts.emplace_back(host.second);
+            }
+        }
+
+        std::sort(
+            hosts.begin(),
+            hosts.end(),
+            [](const HttpHostStatistics& lhs, const HttpHostStatistics& rhs)
+            {
+                return lhs.m_host < rhs.m_host;
+            });
+        return hosts;
+    }
+
+    HttpHostStatistics& HttpTelemetry::GetOrAddHost(const std::string& host)
+    {
+        HttpHostStatistics& statistics = m_hosts[host];
+        if (statistics.m_host.empty())
+        {
+            statistics.m_host = host;
+        }
+
+        return statistics;
+    }
+} // namespace Cesium
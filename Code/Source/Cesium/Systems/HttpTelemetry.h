@@ -0,0 +1,102 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace Cesium
+{
+    // Counts durations into fixed buckets, so recording is cheap and percentiles are only as precise as the bucket bounds
+    class HttpLatencyHistogram final
+    {
+    public:
+        static constexpr std::array<std::uint32_t, 10> BUCKET_UPPER_BOUNDS_MS{ 10, 25, 50, 100, 250, 500, 1000, 2500, 5000, 10000 };
+
+        // the last bucket counts everything above the largest bound
+        static constexpr std::size_t BUCKET_COUNT = BUCKET_UPPER_BOUNDS_MS.size() + 1;
+
+        HttpLatencyHistogram();
+
+        void Record(std::chrono::milliseconds duration);
+
+        std::uint64_t GetCount() const;
+
+        const std::array<std::uint64_t, BUCKET_COUNT>& GetBucketCounts() const;
+
+        double GetMeanMs() const;
+
+        // returns the upper bound of the bucket that holds the percentile, or the largest bound when it is above all of them
+        std::uint32_t GetPercentileMs(double percentile) const;
+
+    private:
+        std::array<std::uint64_t, BUCKET_COUNT> m_bucketCounts;
+        std::uint64_t m_count;
+        std::uint64_t m_totalMs;
+    };
+
+    struct HttpHostStatistics final
+    {
+        HttpHostStatistics();
+
+        std::string m_host;
+
+        // every attempt is counted, so retried requests count more than once
+        std::uint64_t m_requestCount;
+
+        std::uint64_t m_retryCount;
+
+        // bytes of the body as they were received, and after they were decompressed
+        std::uint64_t m_bytesReceived;
+
+        std::uint64_t m_bytesDecoded;
+
+        HttpLatencyHistogram m_timeToFirstByte;
+
+        HttpLatencyHistogram m_totalTime;
+
+        // keyed by the HTTP status. Requests that never got a response are counted under -1
+        std::map<int, std::uint64_t> m_responseCodeCounts;
+
+        std::uint32_t m_activeRequestCount;
+
+        std::uint32_t m_peakActiveRequestCount;
+    };
+
+    struct HttpRequestMetrics final
+    {
+        int m_responseCode;
+        bool m_retried;
+        std::size_t m_bytesReceived;
+        std::size_t m_bytesDecoded;
+
+        // empty when the response had no body
+        std::optional<std::chrono::milliseconds> m_timeToFirstByte;
+
+        std::chrono::milliseconds m_totalTime;
+    };
+
+    // Accumulates the statistics of every host that HttpManager has sent requests to, for as long as the manager lives
+    class HttpTelemetry final
+    {
+    public:
+        void RecordRequestStarted(const std::string& host, std::uint32_t hostActiveRequestCount);
+
+        void RecordRequestCompleted(const std::string& host, const HttpRequestMetrics& metrics);
+
+        // the active request counts are left at zero, since only the scheduler knows them
+        std::vector<HttpHostStatistics> GetHostStatistics() const;
+
+    private:
+        HttpHostStatistics& GetOrAddHost(const std::string& host);
+
+        mutable std::mutex m_mutex;
+        std::unordered_map<std::string, HttpHostStatistics> m_hosts;
+    };
+} // namespace Cesium
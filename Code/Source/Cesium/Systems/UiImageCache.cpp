@@ -0,0 +1,107 @@
+#include "Cesium/Systems/UiImageCache.h"
+#include <Atom/RPI.Reflect/Image/StreamingImageAsset.h>
+
+namespace Cesium
+{
+    UiImage::UiImage()
+        : m_size{ 0, 0, 0 }
+    {
+    }
+
+    UiImage::UiImage(AZ::Data::Asset<AZ::RPI::StreamingImageAsset> imageAsset, const AZ::RHI::Size& size)
+        : m_imageAsset{ std::move(imageAsset) }
+        , m_size{ size }
+    {
+    }
+
+    UiImageCache::Entry::Entry()
+        : m_lastUse{ 0 }
+        , m_loaded{ false }
+    {
+    }
+
+    UiImageCache::UiImageCache()
+        : m_useCounter{ 0 }
+    {
+    }
+
+    bool UiImageCache::Request(const AZStd::string& key, ImageReadyCallback callback)
+    {
+        auto entryIt = m_entries.find(key);
+        if (entryIt == m_entries.end())
+        {
+            EvictLeastRecentlyUsed();
+            Entry& entry = m_entries[key];
+            entry.m_lastUse = ++m_useCounter;
+            entry.m_pendingCallbacks.emplace_back(std::move(callback));
+            return true;
+        }
+
+        Entry& entry = entryIt->second;
+        entry.m_lastUse = ++m_useCounter;
+        if (entry.m_loaded)
+        {
+            callback(entry.m_image);
+        }
+        else
+        {
+            entry.m_pendingCallbacks.emplace_back(std::move(callback));
+        }
+
+        return false;
+    }
+
+    void UiImageCache::Complete(const AZStd::string& key, const UiImage& image)
+    {
+        auto entryIt = m_entries.find(key);
+        if (entryIt == m_entries.end())
+        {
+            return;
+        }
+
+        // the callbacks may request images themselves, so take them out before calling them
+        AZStd::vector<ImageReadyCallback> callbacks = std::move(entryIt->second.m_pendingCallbacks);
+        if (image.m_imageAsset)
+        {
+            entryIt->second.m_image = image;
+            entryIt->second.m_loaded = true;
+        }
+        else
+        {
+            m_entries.erase(entryIt);
+        }
+
+        for (const ImageReadyCallback& callback : callbacks)
+        {
+            callback(image);
+        }
+    }
+
+    std::size_t UiImageCache::GetCachedImageCount() const
+    {
+        return m_entries.size();
+    }
+
+    void UiImageCache::EvictLeastRecentlyUsed()
+    {
+        if (m_entries.size() < MAX_CACHED_IMAGES)
+        {
+            return;
+        }
+
+        // images that are still loading have callers waiting on them
+        auto leastRecentlyUsed = m_entries.end();
+        for (auto it = m_entries.begin(); it != m_entries.end(); ++it)
+        {
+            if (it->second.m_loaded && (leastRecentlyUsed == m_entries.end() || it->second.m_lastUse < leastRecentlyUsed->second.m_lastUse))
+            {
+                leastRecentlyUsed = it;
+            }
+        }
+
+        if (leastRecentlyUsed != m_entries.end())
+        {
+            m_entries.erase(leastRecentlyUsed);
+        }
+    }
+} // namespace Cesium
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <Atom/RHI.Reflect/Size.h>
+#include <AzCore/Asset/AssetCommon.h>
+#include <AzCore/std/containers/unordered_map.h>
+#include <AzCore/std/containers/vector.h>
+#include <AzCore/std/functional.h>
+#include <AzCore/std/string/string.h>
+#include <cstddef>
+#include <cstdint>
+
+namespace AZ
+{
+    namespace RPI
+    {
+        class StreamingImageAsset;
+    }
+} // namespace AZ
+
+namespace Cesium
+{
+    struct UiImage final
+    {
+        UiImage();
+
+        UiImage(AZ::Data::Asset<AZ::RPI::StreamingImageAsset> imageAsset, const AZ::RHI::Size& size);
+
+        AZ::Data::Asset<AZ::RPI::StreamingImageAsset> m_imageAsset;
+        AZ::RHI::Size m_size;
+    };
+
+    // Decoded UI images keyed by their url, so that logos that many credits show are only fetched and decoded once. Requests for
+    // an image that is still loading wait for it instead of loading it again. Only the assets are cached: the GPU image is released
+    // when no UI element shows it any more. Failed loads are not cached. The cache is only used from the main thread.
+    class UiImageCache final
+    {
+    public:
+        using ImageReadyCallback = AZStd::function<void(const UiImage&)>;
+
+        UiImageCache();
+
+        UiImageCache(const UiImageCache&) = delete;
+
+        UiImageCache& operator=(const UiImageCache&) = delete;
+
+        // returns true when the caller has to load the image and pass it to Complete(). Otherwise the callback is called right away
+        // for cached images, or once the pending load completes
+        bool Request(const AZStd::string& key, ImageReadyCallback callback);
+
+        void Complete(const AZStd::string& key, const UiImage& image);
+
+        std::size_t GetCachedImageCount() const;
+
+        static constexpr std::size_t MAX_CACHED_IMAGES = 64;
+
+    private:
+        struct Entry final
+        {
+            Entry();
+
+            UiImage m_image;
+            AZStd::vector<ImageReadyCallback> m_pendingCallbacks;
+            std::uint64_t m_lastUse;
+            bool m_loaded;
+        };
+
+        void EvictLeastRecentlyUsed();
+
+        AZStd::unordered_map<AZStd::string, Entry> m_entries;
+        std::uint64_t m_useCounter;
+    };
+} // namespace Cesium
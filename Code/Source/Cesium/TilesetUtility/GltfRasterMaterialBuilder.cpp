@@ -25,10 +25,11 @@ namespace Cesium
     void GltfRasterMaterialBuilder::Create(
         const CesiumGltf::Model& model,
         const CesiumGltf::Material& material,
+        const GltfMaterialBuilderOption& option,
         AZStd::unordered_map<TextureId, GltfLoadTexture>& textureCache,
         GltfLoadMaterial& result)
     {
-        m_pbrMaterialBuilder.Create(model, material, textureCache, result);
+        m_pbrMaterialBuilder.Create(model, material, option, textureCache, result);
 
         // add custom attributes to the material, so that primitive builder will know how to find attributes from gltf primitive to send
         // them to GPU correctly
@@ -45,6 +46,7 @@ namespace Cesium
         const AZ::Data::Asset<AZ::RPI::ImageAsset>& raster,
         std::uint32_t textureUv,
         const AZ::Vector4& uvTranslateScale,
+        const AZ::Vector4& atlasTranslateScale,
         const AZ::Data::Asset<AZ::RPI::MaterialAsset>& parent)
     {
         AZStd::string prefix = AZStd::string::format("raster%d", rasterLayer);
@@ -55,6 +57,7 @@ namespace Cesium
         materialCreator.SetPropertyValue(AZ::Name(prefix + ".useTexture"), true);
         materialCreator.SetPropertyValue(AZ::Name(prefix + ".textureMapUv"), textureUv);
         materialCreator.SetPropertyValue(AZ::Name(prefix + ".uvTranslateScale"), uvTranslateScale);
+        materialCreator.SetPropertyValue(AZ::Name(prefix + ".atlasTranslateScale"), atlasTranslateScale);
 
         AZ::Data::Asset<AZ::RPI::MaterialAsset> materialAsset;
         materialCreator.End(materialAsset);
@@ -67,6 +70,7 @@ namespace Cesium
         const AZ::Data::Instance<AZ::RPI::Image>& raster,
         std::uint32_t textureUv,
         const AZ::Vector4& uvTranslateScale,
+        const AZ::Vector4& atlasTranslateScale,
         AZ::Data::Instance<AZ::RPI::Material>& material)
     {
         AZStd::string prefix = AZStd::string::format("raster%d", rasterLayer);
@@ -83,6 +87,9 @@ namespace Cesium
         auto uvTranslateScaleIndex = material->FindPropertyIndex(AZ::Name(prefix + ".uvTranslateScale"));
         material->SetPropertyValue(uvTranslateScaleIndex, uvTranslateScale);
 
+        auto atlasTranslateScaleIndex = material->FindPropertyIndex(AZ::Name(prefix + ".atlasTranslateScale"));
+        material->SetPropertyValue(atlasTranslateScaleIndex, atlasTranslateScale);
+
         return material->Compile();
     }
 
@@ -102,6 +109,16 @@ namespace Cesium
         auto uvTranslateScaleIndex = material->FindPropertyIndex(AZ::Name(prefix + ".uvTranslateScale"));
         material->SetPropertyValue(uvTranslateScaleIndex, AZ::Vector4(0.0, 0.0, 1.0, 1.0));
 
+        auto atlasTranslateScaleIndex = material->FindPropertyIndex(AZ::Name(prefix + ".atlasTranslateScale"));
+        material->SetPropertyValue(atlasTranslateScaleIndex, AZ::Vector4(0.0, 0.0, 1.0, 1.0));
+
         return material->Compile();
     }
+
+    bool GltfRasterMaterialBuilder::HasRasterLayer(std::uint32_t rasterLayer, const AZ::Data::Instance<AZ::RPI::Material>& material) const
+    {
+        // materials that are not derived from the raster material type, e.g. point cloud materials, can't receive rasters
+        AZStd::string prefix = AZStd::string::format("raster%d", rasterLayer);
+        return material->FindPropertyIndex(AZ::Name(prefix + ".textureMap")).IsValid();
+    }
 } // namespace Cesium
@@ -23,6 +23,7 @@ namespace Cesium
         void Create(
             const CesiumGltf::Model& model,
             const CesiumGltf::Material& material,
+            const GltfMaterialBuilderOption& option,
             AZStd::unordered_map<TextureId, GltfLoadTexture>& textureCache,
             GltfLoadMaterial& result) override;
 
@@ -31,6 +32,7 @@ namespace Cesium
             const AZ::Data::Asset<AZ::RPI::ImageAsset>& raster,
             std::uint32_t textureUv,
             const AZ::Vector4& uvTranslateScale,
+            const AZ::Vector4& atlasTranslateScale,
             const AZ::Data::Asset<AZ::RPI::MaterialAsset>& parent);
 
         bool SetRasterForMaterial(
@@ -38,10 +40,13 @@ namespace Cesium
             const AZ::Data::Instance<AZ::RPI::Image>& raster,
             std::uint32_t textureUv,
             const AZ::Vector4& uvTranslateScale,
+            const AZ::Vector4& atlasTranslateScale,
             AZ::Data::Instance<AZ::RPI::Material>& material);
 
         bool UnsetRasterForMaterial(std::uint32_t rasterLayer, AZ::Data::Instance<AZ::RPI::Material>& material);
 
+        bool HasRasterLayer(std::uint32_t rasterLayer, const AZ::Data::Instance<AZ::RPI::Material>& material) const;
+
         static constexpr std::uint32_t MAX_RASTER_LAYERS = 2;
 
     private:
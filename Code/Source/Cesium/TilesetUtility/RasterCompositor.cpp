@@ -0,0 +1,96 @@
+#include "Cesium/TilesetUtility/RasterCompositor.h"
+#include "Cesium/Gltf/MipChainGenerator.h"
+#include <AzCore/std/algorithm.h>
+#include <cmath>
+
+namespace Cesium
+{
+    RasterCompositeInput::RasterCompositeInput()
+        : m_width{ 0 }
+        , m_height{ 0 }
+        , m_textureCoordinate{ 0 }
+        , m_translation{ 0.0 }
+        , m_scale{ 1.0 }
+    {
+    }
+
+    std::uint32_t RasterCompositor::GetCompositeSize(const AZStd::vector<RasterCompositeInput>& inputs)
+    {
+        double maxResolution = 0.0;
+        for (const RasterCompositeInput& input : inputs)
+        {
+            maxResolution = AZStd::max(maxResolution, static_cast<double>(input.m_width) * std::abs(input.m_scale.x));
+            maxResolution = AZStd::max(maxResolution, static_cast<double>(input.m_height) * std::abs(input.m_scale.y));
+        }
+
+        std::uint32_t size = MIN_COMPOSITE_SIZE;
+        while (size < MAX_COMPOSITE_SIZE && static_cast<double>(size) < maxResolution)
+        {
+            size <<= 1;
+        }
+
+        return size;
+    }
+
+    void RasterCompositor::Composite(
+        const AZStd::vector<RasterCompositeInput>& inputs, std::uint32_t size, AZStd::vector<std::byte>& result)
+    {
+        result.resize_no_construct(static_cast<std::size_t>(size) * size * 4);
+        double texelSize = 1.0 / static_cast<double>(size);
+        for (std::uint32_t y = 0; y < size; ++y)
+        {
+            for (std::uint32_t x = 0; x < size; ++x)
+            {
+                // the composite is bound without a uv transform, and the shader flips v before sampling
+                glm::dvec2 tileUv{ (x + 0.5) * texelSize, 1.0 - (y + 0.5) * texelSize };
+                glm::vec3 color{ 1.0f };
+                for (const RasterCompositeInput& input : inputs)
+                {
+                    glm::dvec2 rasterUv = tileUv * input.m_scale + input.m_translation;
+                    color *= SampleLinear(input, glm::dvec2{ rasterUv.x, 1.0 - rasterUv.y });
+                }
+
+                std::byte* pixel = result.data() + (static_cast<std::size_t>(y) * size + x) * 4;
+                pixel[0] = static_cast<std::byte>(MipChainGenerator::LinearToSrgb(color.r));
+                pixel[1] = static_cast<std::byte>(MipChainGenerator::LinearToSrgb(color.g));
+                pixel[2] = static_cast<std::byte>(MipChainGenerator::LinearToSrgb(color.b));
+                pixel[3] = static_cast<std::byte>(255);
+            }
+        }
+    }
+
+    glm::vec3 RasterCompositor::SampleLinear(const RasterCompositeInput& input, glm::dvec2 uv)
+    {
+        if (!input.m_pixels || input.m_width == 0 || input.m_height == 0)
+        {
+            return glm::vec3{ 1.0f };
+        }
+
+        // bilinear filter with clamp to edge addressing, like the raster sampler
+        double u = AZStd::clamp(uv.x, 0.0, 1.0) * input.m_width - 0.5;
+        double v = AZStd::clamp(uv.y, 0.0, 1.0) * input.m_height - 0.5;
+        double u0 = std::floor(u);
+        double v0 = std::floor(v);
+        float fu = static_cast<float>(u - u0);
+        float fv = static_cast<float>(v - v0);
+        std::uint32_t maxX = input.m_width - 1;
+        std::uint32_t maxY = input.m_height - 1;
+        std::uint32_t x0 = static_cast<std::uint32_t>(AZStd::clamp(u0, 0.0, static_cast<double>(maxX)));
+        std::uint32_t y0 = static_cast<std::uint32_t>(AZStd::clamp(v0, 0.0, static_cast<double>(maxY)));
+        std::uint32_t x1 = AZStd::min(static_cast<std::uint32_t>(AZStd::max(u0 + 1.0, 0.0)), maxX);
+        std::uint32_t y1 = AZStd::min(static_cast<std::uint32_t>(AZStd::max(v0 + 1.0, 0.0)), maxY);
+
+        const std::byte* pixels = input.m_pixels->data();
+        auto texel = [pixels, &input](std::uint32_t x, std::uint32_t y)
+        {
+            const std::byte* pixel = pixels + (static_cast<std::size_t>(y) * input.m_width + x) * 4;
+            return glm::vec3{ MipChainGenerator::SrgbToLinear(static_cast<std::uint8_t>(pixel[0])),
+                              MipChainGenerator::SrgbToLinear(static_cast<std::uint8_t>(pixel[1])),
+                              MipChainGenerator::SrgbToLinear(static_cast<std::uint8_t>(pixel[2])) };
+        };
+
+        glm::vec3 top = glm::mix(texel(x0, y0), texel(x1, y0), fu);
+        glm::vec3 bottom = glm::mix(texel(x0, y1), texel(x1, y1), fu);
+        return glm::mix(top, bottom, fv);
+    }
+} // namespace Cesium
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <AzCore/std/containers/vector.h>
+#include <AzCore/std/smart_ptr/shared_ptr.h>
+#include <glm/glm.hpp>
+#include <cstddef>
+#include <cstdint>
+
+namespace Cesium
+{
+    struct RasterCompositeInput final
+    {
+        RasterCompositeInput();
+
+        // tightly packed sRGB RGBA pixels of the raster tile
+        AZStd::shared_ptr<const AZStd::vector<std::byte>> m_pixels;
+        std::uint32_t m_width;
+        std::uint32_t m_height;
+        std::uint32_t m_textureCoordinate;
+        glm::dvec2 m_translation;
+        glm::dvec2 m_scale;
+    };
+
+    // Flattens the raster tiles that cover a geometry tile into one image in the overlay uv space of the geometry tile. The
+    // raster material multiplies every layer into the base color, so the composite is the product of the inputs in linear space
+    // and renders the same as binding them one by one.
+    class RasterCompositor final
+    {
+    public:
+        // the resolution of the most detailed input over the geometry tile, rounded up to a power of 2
+        static std::uint32_t GetCompositeSize(const AZStd::vector<RasterCompositeInput>& inputs);
+
+        static void Composite(const AZStd::vector<RasterCompositeInput>& inputs, std::uint32_t size, AZStd::vector<std::byte>& result);
+
+        static constexpr std::uint32_t MIN_COMPOSITE_SIZE = 64;
+        static constexpr std::uint32_t MAX_COMPOSITE_SIZE = 1024;
+
+        // overlays don't take a material layer each when they are composited, so more of them can be stacked
+        static constexpr std::uint32_t MAX_COMPOSITE_RASTER_LAYERS = 8;
+
+    private:
+        static glm::vec3 SampleLinear(const RasterCompositeInput& input, glm::dvec2 uv);
+    };
+} // namespace Cesium
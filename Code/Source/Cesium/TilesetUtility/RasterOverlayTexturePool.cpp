@@ -0,0 +1,224 @@
+#include "Cesium/TilesetUtility/RasterOverlayTexturePool.h"
+#include "Cesium/Gltf/MipChainGenerator.h"
+#include <Atom/RHI.Reflect/ImagePoolDescriptor.h>
+#include <Atom/RHI.Reflect/ImageSubresource.h>
+#include <Atom/RPI.Reflect/ResourcePoolAssetCreator.h>
+#include <AzCore/Math/Uuid.h>
+#include <AzCore/std/smart_ptr/unique_ptr.h>
+#include <AzCore/std/string/string.h>
+#include <cstring>
+
+namespace Cesium
+{
+    RasterOverlayTexturePool::RasterOverlayTexturePool(bool generateMipmaps)
+        : m_mipLevelCount{ GetMipLevelCount(generateMipmaps) }
+    {
+    }
+
+    std::uint32_t RasterOverlayTexturePool::AllocateSlot()
+    {
+        for (std::uint32_t pageIndex = 0; pageIndex < m_pages.size(); ++pageIndex)
+        {
+            Page& page = m_pages[pageIndex];
+            if (!page.m_freeSlots.empty())
+            {
+                std::uint32_t slot = pageIndex * SLOTS_PER_PAGE + page.m_freeSlots.back();
+                page.m_freeSlots.pop_back();
+                return slot;
+            }
+        }
+
+        if (!AddPage())
+        {
+            return INVALID_SLOT;
+        }
+
+        Page& page = m_pages.back();
+        std::uint32_t slot = static_cast<std::uint32_t>(m_pages.size() - 1) * SLOTS_PER_PAGE + page.m_freeSlots.back();
+        page.m_freeSlots.pop_back();
+        return slot;
+    }
+
+    void RasterOverlayTexturePool::FreeSlot(std::uint32_t slot)
+    {
+        std::uint32_t pageIndex = slot / SLOTS_PER_PAGE;
+        if (pageIndex < m_pages.size())
+        {
+            m_pages[pageIndex].m_freeSlots.emplace_back(slot % SLOTS_PER_PAGE);
+        }
+    }
+
+    bool RasterOverlayTexturePool::UpdateSlot(std::uint32_t slot, const AZStd::vector<std::byte>& slotPixels)
+    {
+        std::uint32_t pageIndex = slot / SLOTS_PER_PAGE;
+        if (pageIndex >= m_pages.size())
+        {
+            return false;
+        }
+
+        const AZ::Data::Instance<AZ::RPI::AttachmentImage>& image = m_pages[pageIndex].m_image;
+        std::uint32_t slotX = (slot % SLOTS_PER_PAGE) % SLOTS_PER_ROW;
+        std::uint32_t slotY = (slot % SLOTS_PER_PAGE) / SLOTS_PER_ROW;
+        std::size_t offset = 0;
+        for (std::uint32_t level = 0; level < m_mipLevelCount; ++level)
+        {
+            std::uint32_t mipSize = MipChainGenerator::GetMipSize(SLOT_SIZE, level);
+            std::size_t mipByteSize = static_cast<std::size_t>(mipSize) * mipSize * 4;
+            if (offset + mipByteSize > slotPixels.size())
+            {
+                return false;
+            }
+
+            AZ::RHI::ImageUpdateRequest request;
+            request.m_image = image->GetRHIImage();
+            request.m_imageSubresource.m_mipSlice = static_cast<std::uint16_t>(level);
+            request.m_imageSubresourcePixelOffset.m_left = slotX * mipSize;
+            request.m_imageSubresourcePixelOffset.m_top = slotY * mipSize;
+            request.m_sourceSubresourceLayout =
+                AZ::RHI::GetImageSubresourceLayout(AZ::RHI::Size(mipSize, mipSize, 1), AZ::RHI::Format::R8G8B8A8_UNORM_SRGB);
+            request.m_sourceData = slotPixels.data() + offset;
+            if (!image->UpdateImageContents(request))
+            {
+                return false;
+            }
+
+            offset += mipByteSize;
+        }
+
+        return true;
+    }
+
+    const AZ::Data::Instance<AZ::RPI::AttachmentImage>& RasterOverlayTexturePool::GetSlotImage(std::uint32_t slot) const
+    {
+        return m_pages[slot / SLOTS_PER_PAGE].m_image;
+    }
+
+    AZ::Vector4 RasterOverlayTexturePool::GetSlotTranslateScale(std::uint32_t slot) const
+    {
+        // the offset is applied in texture space, after the shader flips v
+        float scale = 1.0f / static_cast<float>(SLOTS_PER_ROW);
+        std::uint32_t slotX = (slot % SLOTS_PER_PAGE) % SLOTS_PER_ROW;
+        std::uint32_t slotY = (slot % SLOTS_PER_PAGE) / SLOTS_PER_ROW;
+        return AZ::Vector4{ static_cast<float>(slotX) * scale, static_cast<float>(slotY) * scale, scale, scale };
+    }
+
+    std::uint32_t RasterOverlayTexturePool::GetMipLevelCount() const
+    {
+        return m_mipLevelCount;
+    }
+
+    bool RasterOverlayTexturePool::CanPool(std::uint32_t width, std::uint32_t height, std::uint32_t channelCount)
+    {
+        return width == SLOT_SIZE && height == SLOT_SIZE && channelCount == 4;
+    }
+
+    std::uint32_t RasterOverlayTexturePool::GetMipLevelCount(bool generateMipmaps)
+    {
+        return generateMipmaps ? MAX_MIP_LEVELS : 1;
+    }
+
+    void RasterOverlayTexturePool::PrepareSlotPixels(
+        const std::byte* pixels, std::uint32_t mipLevelCount, AZStd::vector<std::byte>& slotPixels)
+    {
+        std::size_t totalSize = 0;
+        for (std::uint32_t level = 0; level < mipLevelCount; ++level)
+        {
+            std::size_t mipSize = MipChainGenerator::GetMipSize(SLOT_SIZE, level);
+            totalSize += mipSize * mipSize * 4;
+        }
+
+        slotPixels.resize_no_construct(totalSize);
+        std::memcpy(slotPixels.data(), pixels, static_cast<std::size_t>(SLOT_SIZE) * SLOT_SIZE * 4);
+
+        std::size_t offset = 0;
+        for (std::uint32_t level = 1; level < mipLevelCount; ++level)
+        {
+            std::uint32_t previousSize = MipChainGenerator::GetMipSize(SLOT_SIZE, level - 1);
+            std::size_t previousByteSize = static_cast<std::size_t>(previousSize) * previousSize * 4;
+            MipChainGenerator::GenerateMip(
+                slotPixels.data() + offset, previousSize, previousSize, 4, true, slotPixels.data() + offset + previousByteSize);
+            offset += previousByteSize;
+        }
+    }
+
+    bool RasterOverlayTexturePool::AddPage()
+    {
+        if (m_pages.size() >= MAX_PAGES || (!m_imagePool && !CreateImagePool()))
+        {
+            return false;
+        }
+
+        AZ::RHI::ImageDescriptor imageDesc = AZ::RHI::ImageDescriptor::Create2D(
+            AZ::RHI::ImageBindFlags::ShaderRead, ATLAS_SIZE, ATLAS_SIZE, AZ::RHI::Format::R8G8B8A8_UNORM_SRGB);
+        imageDesc.m_mipLevels = static_cast<std::uint16_t>(m_mipLevelCount);
+
+        AZ::Name imageName{ AZStd::string::format("CesiumRasterOverlayAtlas_%p_%zu", static_cast<void*>(this), m_pages.size()) };
+        AZ::Data::Instance<AZ::RPI::AttachmentImage> image =
+            AZ::RPI::AttachmentImage::Create(*m_imagePool, imageDesc, imageName, nullptr, nullptr);
+        if (!image)
+        {
+            return false;
+        }
+
+        // filtering near the edge of a slot can still reach its neighbors, so free slots hold black instead of whatever the
+        // memory contained. The zeroes of the top mip cover every other mip too
+        AZStd::vector<std::byte> clearPixels(static_cast<std::size_t>(ATLAS_SIZE) * ATLAS_SIZE * 4, std::byte{ 0 });
+        for (std::uint32_t level = 0; level < m_mipLevelCount; ++level)
+        {
+            std::uint32_t mipSize = MipChainGenerator::GetMipSize(ATLAS_SIZE, level);
+            AZ::RHI::ImageUpdateRequest request;
+            request.m_image = image->GetRHIImage();
+            request.m_imageSubresource.m_mipSlice = static_cast<std::uint16_t>(level);
+            request.m_sourceSubresourceLayout =
+                AZ::RHI::GetImageSubresourceLayout(AZ::RHI::Size(mipSize, mipSize, 1), AZ::RHI::Format::R8G8B8A8_UNORM_SRGB);
+            request.m_sourceData = clearPixels.data();
+            if (!image->UpdateImageContents(request))
+            {
+                return false;
+            }
+        }
+
+        Page& page = m_pages.emplace_back();
+        page.m_image = std::move(image);
+        page.m_freeSlots.reserve(SLOTS_PER_PAGE);
+        for (std::uint32_t i = SLOTS_PER_PAGE; i > 0; --i)
+        {
+            page.m_freeSlots.emplace_back(i - 1);
+        }
+
+        return true;
+    }
+
+    bool RasterOverlayTexturePool::CreateImagePool()
+    {
+        // the system attachment pool is meant for pass attachments, so the atlases get a pool whose budget is all the pages
+        auto poolDesc = AZStd::make_unique<AZ::RHI::ImagePoolDescriptor>();
+        poolDesc->m_bindFlags = AZ::RHI::ImageBindFlags::ShaderRead;
+        poolDesc->m_budgetInBytes = MAX_PAGES * GetPageByteSize();
+
+        AZ::RPI::ResourcePoolAssetCreator poolAssetCreator;
+        poolAssetCreator.Begin(AZ::Data::AssetId(AZ::Uuid::CreateRandom()));
+        poolAssetCreator.SetPoolDescriptor(AZStd::move(poolDesc));
+        poolAssetCreator.SetPoolName(AZStd::string::format("CesiumRasterOverlayAtlasPool_%p", static_cast<void*>(this)));
+        AZ::Data::Asset<AZ::RPI::ResourcePoolAsset> poolAsset;
+        if (!poolAssetCreator.End(poolAsset))
+        {
+            return false;
+        }
+
+        m_imagePool = AZ::RPI::AttachmentImagePool::FindOrCreate(poolAsset);
+        return m_imagePool != nullptr;
+    }
+
+    std::size_t RasterOverlayTexturePool::GetPageByteSize() const
+    {
+        std::size_t byteSize = 0;
+        for (std::uint32_t level = 0; level < m_mipLevelCount; ++level)
+        {
+            std::size_t mipSize = MipChainGenerator::GetMipSize(ATLAS_SIZE, level);
+            byteSize += mipSize * mipSize * 4;
+        }
+
+        return byteSize;
+    }
+} // namespace Cesium
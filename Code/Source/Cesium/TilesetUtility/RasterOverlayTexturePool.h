@@ -0,0 +1,74 @@
+#pragma once
+
+#include <Atom/RPI.Public/Image/AttachmentImage.h>
+#include <Atom/RPI.Public/Image/AttachmentImagePool.h>
+#include <AzCore/Math/Vector4.h>
+#include <AzCore/std/containers/vector.h>
+#include <cstddef>
+#include <cstdint>
+
+namespace Cesium
+{
+    // Fixed size slots of atlas images that the tiles of one raster overlay are uploaded into. Imagery tiles are almost always
+    // 256x256, so they share a handful of images instead of creating a streaming image each. Attaching a pooled tile to a material
+    // then only changes the atlas transform of the layer, not the image that is bound. Pages are added up to MAX_PAGES when the
+    // pool runs out of slots, and come from an image pool of their own whose budget is exactly MAX_PAGES pages. Only used on the
+    // main thread.
+    class RasterOverlayTexturePool final
+    {
+    public:
+        RasterOverlayTexturePool(bool generateMipmaps);
+
+        RasterOverlayTexturePool(const RasterOverlayTexturePool&) = delete;
+
+        RasterOverlayTexturePool& operator=(const RasterOverlayTexturePool&) = delete;
+
+        std::uint32_t AllocateSlot();
+
+        void FreeSlot(std::uint32_t slot);
+
+        // slotPixels holds all the mip levels of the tile one after another, the way PrepareSlotPixels() lays them out
+        bool UpdateSlot(std::uint32_t slot, const AZStd::vector<std::byte>& slotPixels);
+
+        const AZ::Data::Instance<AZ::RPI::AttachmentImage>& GetSlotImage(std::uint32_t slot) const;
+
+        // xy is the offset and zw the scale of the slot in the atlas
+        AZ::Vector4 GetSlotTranslateScale(std::uint32_t slot) const;
+
+        std::uint32_t GetMipLevelCount() const;
+
+        static bool CanPool(std::uint32_t width, std::uint32_t height, std::uint32_t channelCount);
+
+        static std::uint32_t GetMipLevelCount(bool generateMipmaps);
+
+        // lays out the mips of an sRGB RGBA tile the way UpdateSlot() expects them. Runs on the load thread
+        static void PrepareSlotPixels(const std::byte* pixels, std::uint32_t mipLevelCount, AZStd::vector<std::byte>& slotPixels);
+
+        static constexpr std::uint32_t SLOT_SIZE = 256;
+        static constexpr std::uint32_t SLOTS_PER_ROW = 8;
+        static constexpr std::uint32_t SLOTS_PER_PAGE = SLOTS_PER_ROW * SLOTS_PER_ROW;
+        static constexpr std::uint32_t ATLAS_SIZE = SLOT_SIZE * SLOTS_PER_ROW;
+        static constexpr std::uint32_t MAX_PAGES = 4;
+        static constexpr std::uint32_t INVALID_SLOT = static_cast<std::uint32_t>(-1);
+
+        // the smallest mip of a slot is 16x16, so filtering at the coarsest level doesn't reach far into the neighbor slots
+        static constexpr std::uint32_t MAX_MIP_LEVELS = 5;
+
+    private:
+        struct Page final
+        {
+            AZ::Data::Instance<AZ::RPI::AttachmentImage> m_image;
+            AZStd::vector<std::uint32_t> m_freeSlots;
+        };
+
+        bool AddPage();
+
+        bool CreateImagePool();
+
+        std::size_t GetPageByteSize() const;
+
+        std::uint32_t m_mipLevelCount;
+        AZ::Data::Instance<AZ::RPI::AttachmentImagePool> m_imagePool;
+        AZStd::vector<Page> m_pages;
+    };
+} // namespace Cesium
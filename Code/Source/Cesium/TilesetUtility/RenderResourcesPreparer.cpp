@@ -1,13 +1,22 @@
 #include "Cesium/TilesetUtility/RenderResourcesPreparer.h"
 #include "Cesium/TilesetUtility/GltfRasterMaterialBuilder.h"
+#include "Cesium/TilesetUtility/TextureMipSelector.h"
 #include "Cesium/Gltf/GltfModelBuilder.h"
 #include "Cesium/Gltf/GltfLoadContext.h"
+#include "Cesium/Gltf/GltfLoadScratchArena.h"
+#include "Cesium/Gltf/GltfPointMaterialBuilder.h"
+#include "Cesium/Gltf/PixelFormatConverter.h"
+#include "Cesium/Gltf/StreamingImageBuilder.h"
+#include "Cesium/Systems/CesiumSystem.h"
+#include "Cesium/Math/BoundingVolumeConverters.h"
 #include <Atom/Feature/Mesh/MeshFeatureProcessorInterface.h>
-#include <Atom/RPI.Reflect/Image/StreamingImageAssetCreator.h>
-#include <Atom/RPI.Reflect/Image/ImageMipChainAssetCreator.h>
+#include <Atom/RHI/Device.h>
+#include <Atom/RHI/RHISystemInterface.h>
 #include <AzCore/std/smart_ptr/unique_ptr.h>
 #include <AzCore/std/algorithm.h>
 #include <glm/gtc/matrix_transform.hpp>
+#include <cmath>
+#include <cstring>
 
 // Window 10 wingdi.h header defines OPAQUE macro which mess up with CesiumGltf::Material::AlphaMode::OPAQUE.
 // This only happens with unity build
@@ -19,6 +28,7 @@
 
 #include <Cesium3DTilesSelection/Tile.h>
 #include <Cesium3DTilesSelection/Tileset.h>
+#include <Cesium3DTilesSelection/ViewState.h>
 #include <CesiumGltf/Model.h>
 #include <CesiumUtility/JsonValue.h>
 
@@ -28,12 +38,21 @@
 
 namespace Cesium
 {
-    RenderResourcesPreparer::RenderResourcesPreparer(AZ::Render::MeshFeatureProcessorInterface* meshFeatureProcessor)
+    RenderResourcesPreparer::RenderResourcesPreparer(
+        AZ::Render::MeshFeatureProcessorInterface* meshFeatureProcessor, const TilesetRenderConfiguration& renderConfiguration)
         : m_meshFeatureProcessor{ meshFeatureProcessor }
         , m_transform{ 1.0 }
+        , m_renderConfiguration{ renderConfiguration }
+        , m_viewportSize{ 0.0 }
+        , m_compressTextures{ renderConfiguration.m_compressTextures && IsBlockCompressionSupported() }
+        , m_sharedTexturesReleased{ false }
+        , m_rasterCompositeQueue{ AZStd::make_shared<RasterCompositeQueue>() }
+        , m_nextCompositeId{ 0 }
     {
-        m_freeRasterLayers.reserve(GltfRasterMaterialBuilder::MAX_RASTER_LAYERS);
-        for (std::uint32_t i = 0; i < GltfRasterMaterialBuilder::MAX_RASTER_LAYERS; ++i)
+        std::uint32_t rasterLayerCount = renderConfiguration.m_compositeRasterOverlays ? RasterCompositor::MAX_COMPOSITE_RASTER_LAYERS
+                                                                                       : GltfRasterMaterialBuilder::MAX_RASTER_LAYERS;
+        m_freeRasterLayers.reserve(rasterLayerCount);
+        for (std::uint32_t i = 0; i < rasterLayerCount; ++i)
         {
             m_freeRasterLayers.emplace_back(i);
         }
@@ -62,6 +81,19 @@ namespace Cesium
                 return !material->NeedsCompile() || material->Compile();
             });
         m_compileMaterialsQueue.erase(it, m_compileMaterialsQueue.end());
+
+        // images that the tiles freed since the last frame were the only users of leave the shared cache here
+        if (m_sharedTexturesReleased)
+        {
+            m_sharedTexturesReleased = false;
+            m_sharedTextureCache.RemoveUnreferencedImages();
+        }
+
+        if (m_renderConfiguration.m_compositeRasterOverlays)
+        {
+            ApplyRasterComposites();
+            ScheduleRasterComposites();
+        }
     }
 
     void RenderResourcesPreparer::SetTransform(const glm::dmat4& transform)
@@ -83,9 +115,130 @@ namespace Cesium
         if (renderResources)
         {
             IntrusiveGltfModel* intrusiveModel = reinterpret_cast<IntrusiveGltfModel*>(renderResources);
-            if (intrusiveModel->m_model.IsVisible() != visible)
+            intrusiveModel->m_selected = visible;
+            ApplyVisibility(*intrusiveModel);
+        }
+    }
+
+    void RenderResourcesPreparer::SetViewportSize(const glm::dvec2& viewportSize)
+    {
+        if (m_viewportSize == viewportSize)
+        {
+            return;
+        }
+
+        m_viewportSize = viewportSize;
+        for (auto& intrusiveModel : m_intrusiveModels)
+        {
+            UpdatePointMaterials(intrusiveModel);
+        }
+    }
+
+    void RenderResourcesPreparer::UpdateScreenCoverage(
+        const Cesium3DTilesSelection::Tile& tile, const std::vector<Cesium3DTilesSelection::ViewState>& viewStates)
+    {
+        IntrusiveGltfModel* intrusiveModel = reinterpret_cast<IntrusiveGltfModel*>(tile.getRendererResources());
+        if (!intrusiveModel || (intrusiveModel->m_streamingTextures.empty() && intrusiveModel->m_pointCount == 0))
+        {
+            return;
+        }
+
+        // project the diameter of the tile the same way cesium-native projects the geometric error of the tile for SSE
+        const Cesium3DTilesSelection::BoundingVolume& boundingVolume = tile.getBoundingVolume();
+        AZ::Aabb aabb = std::visit(BoundingVolumeToAABB{ glm::dmat4{ 1.0 } }, boundingVolume);
+        double diameter = static_cast<double>(aabb.GetExtents().GetLength());
+        double screenCoverage = 0.0;
+        for (const auto& viewState : viewStates)
+        {
+            double distance = std::sqrt(viewState.computeDistanceSquaredToBoundingVolume(boundingVolume));
+            screenCoverage = AZStd::max(screenCoverage, viewState.computeScreenSpaceError(diameter, distance));
+        }
+
+        intrusiveModel->m_screenCoverage = screenCoverage;
+    }
+
+    void RenderResourcesPreparer::UpdateTextureStreaming()
+    {
+        if (!m_renderConfiguration.m_streamTexturesByScreenCoverage)
+        {
+            return;
+        }
+
+        // shared textures are streamed in for the tile that covers the most pixels
+        for (auto& target : m_textureStreamingTargets)
+        {
+            target.second.m_desiredMip = TextureStreamingTarget::INVALID_MIP;
+        }
+
+        for (auto& intrusiveModel : m_intrusiveModels)
+        {
+            double screenCoverage = intrusiveModel.m_model.IsVisible() ? intrusiveModel.m_screenCoverage : 0.0;
+            for (const StreamingTileTexture& texture : intrusiveModel.m_streamingTextures)
             {
-                intrusiveModel->m_model.SetVisible(visible);
+                auto targetIt = m_textureStreamingTargets.find(texture.m_image.get());
+                if (targetIt == m_textureStreamingTargets.end())
+                {
+                    targetIt = m_textureStreamingTargets.emplace(texture.m_image.get(), TextureStreamingTarget{ texture.m_image }).first;
+                }
+
+                std::uint16_t desiredMip = TextureMipSelector::GetDesiredMip(texture.m_size, texture.m_mipLevelCount, screenCoverage);
+                targetIt->second.m_desiredMip = AZStd::min(targetIt->second.m_desiredMip, desiredMip);
+            }
+        }
+
+        // textures that no tile refers to anymore are released. Everything else only changes target when it has to
+        for (auto it = m_textureStreamingTargets.begin(); it != m_textureStreamingTargets.end();)
+        {
+            TextureStreamingTarget& target = it->second;
+            if (target.m_desiredMip == TextureStreamingTarget::INVALID_MIP)
+            {
+                it = m_textureStreamingTargets.erase(it);
+                continue;
+            }
+
+            if (target.m_desiredMip != target.m_targetMip)
+            {
+                target.m_image->SetTargetMip(target.m_desiredMip);
+                target.m_targetMip = target.m_desiredMip;
+            }
+
+            ++it;
+        }
+    }
+
+    void RenderResourcesPreparer::UpdatePointBudget()
+    {
+        m_pointBudgetModels.clear();
+        for (auto& intrusiveModel : m_intrusiveModels)
+        {
+            if (intrusiveModel.m_selected && intrusiveModel.m_pointCount != 0)
+            {
+                m_pointBudgetModels.emplace_back(&intrusiveModel);
+            }
+        }
+
+        // tiles that cover more pixels are the ones the camera is looking at up close, so they get the budget first
+        AZStd::sort(
+            m_pointBudgetModels.begin(), m_pointBudgetModels.end(),
+            [](const IntrusiveGltfModel* lhs, const IntrusiveGltfModel* rhs)
+            {
+                return lhs->m_screenCoverage > rhs->m_screenCoverage;
+            });
+
+        std::uint64_t pointBudget = m_renderConfiguration.m_pointCloudPointBudget;
+        std::uint64_t renderedPointCount = 0;
+        for (IntrusiveGltfModel* intrusiveModel : m_pointBudgetModels)
+        {
+            bool withinPointBudget = intrusiveModel->m_pointCount <= pointBudget - renderedPointCount;
+            if (withinPointBudget)
+            {
+                renderedPointCount += intrusiveModel->m_pointCount;
+            }
+
+            if (intrusiveModel->m_withinPointBudget != withinPointBudget)
+            {
+                intrusiveModel->m_withinPointBudget = withinPointBudget;
+                ApplyVisibility(*intrusiveModel);
             }
         }
     }
@@ -97,6 +250,13 @@ namespace Cesium
             return false;
         }
 
+        // tiles that are already loaded have no images left for the upsampled children of the overlay
+        if (m_renderConfiguration.m_releaseDecodedImages)
+        {
+            AZ_Printf("Cesium", "Raster overlays can't be added to a tileset that releases its decoded images\n");
+            return false;
+        }
+
         if (m_rasterOverlayLayers.find(rasterOverlay) == m_rasterOverlayLayers.end())
         {
             m_rasterOverlayLayers.insert(AZStd::make_pair(rasterOverlay, m_freeRasterLayers.back()));
@@ -116,6 +276,9 @@ namespace Cesium
 
         m_rasterOverlayLayers.erase(layerIt);
         m_freeRasterLayers.emplace_back(layerIt->second);
+
+        // raster tiles that are still alive keep the pool around until they are freed
+        m_rasterTexturePools.erase(rasterOverlay);
     }
 
     void* RenderResourcesPreparer::prepareInLoadThread(const CesiumGltf::Model& model, const glm::dmat4& transform)
@@ -128,14 +291,35 @@ namespace Cesium
             option.m_transform = glm::translate(transform, rtc.value());
         }
 
+        option.m_material.m_compressTextures = m_compressTextures;
+        option.m_material.m_generateMipmaps = m_renderConfiguration.m_generateMipmaps;
+        option.m_material.m_sharedTextureCache = m_renderConfiguration.m_shareTextures ? &m_sharedTextureCache : nullptr;
+        option.m_trianglePrimitive.m_optimizeVertexCache = m_renderConfiguration.m_optimizeVertexCache;
+        option.m_trianglePrimitive.m_vertexCacheOptimizationMinimumTriangleCount =
+            m_renderConfiguration.m_vertexCacheOptimizationMinimumTriangleCount;
+        option.m_trianglePrimitive.m_fastTangents = m_renderConfiguration.m_tangentGenerationMode != TangentGenerationMode::MikkTSpace;
+        option.m_trianglePrimitive.m_accumulateFastTangents =
+            m_renderConfiguration.m_tangentGenerationMode == TangentGenerationMode::FastAccumulated;
+
+        // the budget is applied to the rendered tiles every frame. Only a tile that couldn't fit in the whole budget on its own is
+        // decimated here
+        option.m_pointCloud.m_maximumPointCount = m_renderConfiguration.m_pointCloudPointBudget;
+        option.m_pointCloud.m_pointSize = m_renderConfiguration.m_pointCloudPointSize;
+        option.m_pointCloud.m_attenuation = m_renderConfiguration.m_pointCloudAttenuation;
+        option.m_pointCloud.m_maximumAttenuation = m_renderConfiguration.m_pointCloudMaximumAttenuation;
+
         // build model
         AZStd::unique_ptr<GltfLoadModel> loadModel = AZStd::make_unique<GltfLoadModel>();
         GltfModelBuilder builder(AZStd::make_unique<GltfRasterMaterialBuilder>());
         builder.Create(model, option, *loadModel);
+
+        // everything the builders put in the scratch arena has been copied into assets by now
+        CesiumInterface::Get()->GetGltfLoadScratchArenaPool().GetThreadArena().Reset();
+
         return loadModel.release();
     }
 
-    void* RenderResourcesPreparer::prepareInMainThread([[maybe_unused]] Cesium3DTilesSelection::Tile& tile, void* pLoadThreadResult)
+    void* RenderResourcesPreparer::prepareInMainThread(Cesium3DTilesSelection::Tile& tile, void* pLoadThreadResult)
     {
         if (pLoadThreadResult)
         {
@@ -146,6 +330,44 @@ namespace Cesium
             intrusiveModel.m_self = std::move(handle);
             intrusiveModel.m_model.SetTransform(m_transform);
             intrusiveModel.m_model.SetVisible(false);
+
+            // leaf tiles usually have zero geometric error, so fall back to the spacing between points
+            if (!loadModel->m_pointMaterials.empty())
+            {
+                double geometricError = tile.getGeometricError() > 0.0 ? tile.getGeometricError() : loadModel->m_pointSpacing;
+                intrusiveModel.m_pointMaterials = std::move(loadModel->m_pointMaterials);
+                intrusiveModel.m_pointGeometricError =
+                    static_cast<float>(geometricError * m_renderConfiguration.m_pointCloudGeometricErrorScale);
+                UpdatePointMaterials(intrusiveModel);
+            }
+
+            // textures without mips have nothing to stream
+            if (m_renderConfiguration.m_streamTexturesByScreenCoverage)
+            {
+                for (const auto& texture : loadModel->m_textures)
+                {
+                    if (texture.second.IsEmpty())
+                    {
+                        continue;
+                    }
+
+                    const AZ::RHI::ImageDescriptor& imageDesc = texture.second.m_imageAsset->GetImageDescriptor();
+                    if (imageDesc.m_mipLevels <= 1)
+                    {
+                        continue;
+                    }
+
+                    AZ::Data::Instance<AZ::RPI::StreamingImage> image = AZ::RPI::StreamingImage::FindOrCreate(texture.second.m_imageAsset);
+                    if (image && image->IsStreamable())
+                    {
+                        intrusiveModel.m_streamingTextures.emplace_back(
+                            std::move(image), AZStd::max(imageDesc.m_size.m_width, imageDesc.m_size.m_height), imageDesc.m_mipLevels);
+                    }
+                }
+            }
+
+            intrusiveModel.m_pointCount = loadModel->m_pointCount;
+            ReleaseDecodedImages(tile);
             return &intrusiveModel;
         }
 
@@ -164,42 +386,77 @@ namespace Cesium
         if (pMainThreadResult)
         {
             IntrusiveGltfModel* intrusiveModel = reinterpret_cast<IntrusiveGltfModel*>(pMainThreadResult);
+            if (intrusiveModel->m_compositeId != 0)
+            {
+                m_compositeModels.erase(intrusiveModel->m_compositeId);
+                m_dirtyCompositeModels.erase(intrusiveModel->m_compositeId);
+            }
+
             auto handler = std::move(intrusiveModel->m_self); // move the handler out before free it. Otherwise, stack overflow
             handler.Free();
         }
+
+        m_sharedTexturesReleased = m_sharedTexturesReleased || m_renderConfiguration.m_shareTextures;
     }
 
     void* RenderResourcesPreparer::prepareRasterInLoadThread(const CesiumGltf::ImageCesium& image)
     {
         if (!image.pixelData.empty() && image.width != 0 && image.height != 0)
         {
-            // image has 4 channels, so we just copy the data over
-            AZ::RHI::ImageDescriptor imageDesc;
-            imageDesc.m_bindFlags = AZ::RHI::ImageBindFlags::ShaderRead;
-            imageDesc.m_dimension = AZ::RHI::ImageDimension::Image2D;
-            imageDesc.m_size = AZ::RHI::Size(image.width, image.height, 1);
-            imageDesc.m_format = AZ::RHI::Format::R8G8B8A8_UNORM_SRGB;
-
-            AZ::RHI::ImageSubresourceLayout imageSubresourceLayout =
-                AZ::RHI::GetImageSubresourceLayout(imageDesc, AZ::RHI::ImageSubresource{});
-
-            // Create mip chain
-            AZ::RPI::ImageMipChainAssetCreator mipChainCreator;
-            mipChainCreator.Begin(AZ::Uuid::CreateRandom(), 1, 1);
-            mipChainCreator.BeginMip(imageSubresourceLayout);
-            mipChainCreator.AddSubImage(image.pixelData.data(), image.pixelData.size());
-            mipChainCreator.EndMip();
-            AZ::Data::Asset<AZ::RPI::ImageMipChainAsset> mipChainAsset;
-            mipChainCreator.End(mipChainAsset);
-
-            // Create streaming image
-            AZ::RPI::StreamingImageAssetCreator imageCreator;
-            imageCreator.Begin(AZ::Uuid::CreateRandom());
-            imageCreator.SetImageDescriptor(imageDesc);
-            imageCreator.AddMipChainAsset(*mipChainAsset);
-
-            AZ::Data::Asset<AZ::RPI::StreamingImageAsset> imageAsset;
-            imageCreator.End(imageAsset);
+            // composited tiles only keep their pixels. The image is created when the tiles they cover are composited
+            if (m_renderConfiguration.m_compositeRasterOverlays)
+            {
+                std::uint32_t width = static_cast<std::uint32_t>(image.width);
+                std::uint32_t height = static_cast<std::uint32_t>(image.height);
+                std::size_t pixelCount = static_cast<std::size_t>(width) * height;
+                if (image.bytesPerChannel != 1 || (image.channels != 3 && image.channels != 4) ||
+                    image.pixelData.size() != pixelCount * image.channels)
+                {
+                    return nullptr;
+                }
+
+                auto pixels = AZStd::make_shared<AZStd::vector<std::byte>>(pixelCount * 4);
+                if (image.channels == 3)
+                {
+                    PixelFormatConverter::ExpandRGBToRGBA(image.pixelData.data(), pixelCount, pixels->data());
+                }
+                else
+                {
+                    std::memcpy(pixels->data(), image.pixelData.data(), pixels->size());
+                }
+
+                auto rasterOverlay = new RasterOverlay();
+                rasterOverlay->m_compositePixels = std::move(pixels);
+                rasterOverlay->m_compositeWidth = width;
+                rasterOverlay->m_compositeHeight = height;
+                return rasterOverlay;
+            }
+
+            // tiles that fit the texture pool only get their mips generated here. They are uploaded on the main thread
+            if (m_renderConfiguration.m_poolRasterOverlayTiles &&
+                RasterOverlayTexturePool::CanPool(
+                    static_cast<std::uint32_t>(image.width), static_cast<std::uint32_t>(image.height),
+                    static_cast<std::uint32_t>(image.channels)))
+            {
+                auto rasterOverlay = new RasterOverlay();
+                RasterOverlayTexturePool::PrepareSlotPixels(
+                    image.pixelData.data(), RasterOverlayTexturePool::GetMipLevelCount(m_renderConfiguration.m_generateMipmaps),
+                    rasterOverlay->m_slotPixels);
+                return rasterOverlay;
+            }
+
+            StreamingImageBuilderOption option;
+            option.m_srgb = true;
+            option.m_generateMipmaps = m_renderConfiguration.m_generateMipmaps;
+            option.m_compress = m_compressTextures;
+            const std::byte* pixels = image.pixelData.data();
+            std::uint32_t width = static_cast<std::uint32_t>(image.width);
+            std::uint32_t height = static_cast<std::uint32_t>(image.height);
+            std::uint32_t channelCount = static_cast<std::uint32_t>(image.channels);
+            AZ::Data::Asset<AZ::RPI::StreamingImageAsset> imageAsset = m_renderConfiguration.m_shareTextures
+                ? m_sharedTextureCache.GetOrCreate(pixels, width, height, channelCount, option)
+                : StreamingImageBuilder::Create(pixels, width, height, channelCount, option);
+            CesiumInterface::Get()->GetGltfLoadScratchArenaPool().GetThreadArena().Reset();
 
             if (imageAsset)
             {
@@ -213,12 +470,20 @@ namespace Cesium
     }
 
     void* RenderResourcesPreparer::prepareRasterInMainThread(
-        [[maybe_unused]] const Cesium3DTilesSelection::RasterOverlayTile& rasterTile, void* pLoadThreadResult)
+        const Cesium3DTilesSelection::RasterOverlayTile& rasterTile, void* pLoadThreadResult)
     {
         if (pLoadThreadResult)
         {
             auto rasterOverlay = reinterpret_cast<RasterOverlay*>(pLoadThreadResult);
-            rasterOverlay->m_image = AZ::RPI::StreamingImage::FindOrCreate(rasterOverlay->m_imageAsset);
+            if (!rasterOverlay->m_slotPixels.empty())
+            {
+                UploadRasterToTexturePool(rasterTile.getOverlay(), *rasterOverlay);
+            }
+            else if (rasterOverlay->m_imageAsset)
+            {
+                rasterOverlay->m_image = AZ::RPI::StreamingImage::FindOrCreate(rasterOverlay->m_imageAsset);
+            }
+
             return rasterOverlay;
         }
 
@@ -241,6 +506,8 @@ namespace Cesium
             RasterOverlay* rasterOverlay = reinterpret_cast<RasterOverlay*>(pMainThreadResult);
             delete rasterOverlay;
         }
+
+        m_sharedTexturesReleased = m_sharedTexturesReleased || m_renderConfiguration.m_shareTextures;
     }
 
     void RenderResourcesPreparer::attachRasterInMainThread(
@@ -267,46 +534,29 @@ namespace Cesium
 
                 IntrusiveGltfModel* intrusiveGltfModel = reinterpret_cast<IntrusiveGltfModel*>(tileRenderResource);
                 RasterOverlay* rasterOverlay = reinterpret_cast<RasterOverlay*>(mainThreadRasterResources);
-                GltfRasterMaterialBuilder materialBuilder;
-                GltfModel& model = intrusiveGltfModel->m_model;
-                for (auto& material : model.GetMaterials())
+                if (m_renderConfiguration.m_compositeRasterOverlays)
                 {
-                    if (!material.m_material)
-                    {
-                        continue;
-                    }
-
-                    AZ::Vector4 uvTranslateScale{ static_cast<float>(translation.x), static_cast<float>(translation.y),
-                                                  static_cast<float>(scale.x), static_cast<float>(scale.y) };
-
-                    // Just update material with raster if the current material can compile, so material can be updated right away
-                    // in the next frame. Otherwise, we create the new material with the attached raster, so that the primitive is
-                    // updated with the new material in the next frame. If we only update the material and not create new material
-                    // the terrain can be rendered with old material if that material is still compiling and flickering can happen
-                    bool canCompile = material.m_material->CanCompile();
-                    if (canCompile)
+                    if (rasterOverlay->m_compositePixels && overlayTextureCoordinateID >= 0 &&
+                        static_cast<std::uint32_t>(overlayTextureCoordinateID) < GltfRasterMaterialBuilder::MAX_RASTER_LAYERS)
                     {
-                        canCompile = materialBuilder.SetRasterForMaterial(
-                            layer, rasterOverlay->m_image, static_cast<std::uint32_t>(overlayTextureCoordinateID), uvTranslateScale,
-                            material.m_material);
+                        RasterCompositeInput& input = intrusiveGltfModel->m_compositeRasters[layer];
+                        input.m_pixels = rasterOverlay->m_compositePixels;
+                        input.m_width = rasterOverlay->m_compositeWidth;
+                        input.m_height = rasterOverlay->m_compositeHeight;
+                        input.m_textureCoordinate = static_cast<std::uint32_t>(overlayTextureCoordinateID);
+                        input.m_translation = translation;
+                        input.m_scale = scale;
+                        MarkRasterCompositeDirty(*intrusiveGltfModel);
                     }
 
-                    if (!canCompile)
-                    {
-                        auto materialAsset = materialBuilder.CreateRasterMaterial(
-                            layer, rasterOverlay->m_imageAsset, static_cast<std::uint32_t>(overlayTextureCoordinateID), uvTranslateScale,
-                            material.m_material->GetAsset());
-                        material.m_material = AZ::RPI::Material::FindOrCreate(materialAsset);
-                    }
+                    return;
                 }
 
-                for (auto& mesh : model.GetMeshes())
-                {
-                    for (auto& primitive : mesh.m_primitives)
-                    {
-                        model.UpdateMaterialForPrimitive(primitive);
-                    }
-                }
+                AZ::Vector4 uvTranslateScale{ static_cast<float>(translation.x), static_cast<float>(translation.y),
+                                              static_cast<float>(scale.x), static_cast<float>(scale.y) };
+                SetRasterForModel(
+                    *intrusiveGltfModel, layer, rasterOverlay->m_image, rasterOverlay->m_imageAsset,
+                    static_cast<std::uint32_t>(overlayTextureCoordinateID), uvTranslateScale, rasterOverlay->m_atlasTranslateScale);
             }
         }
     }
@@ -332,25 +582,320 @@ namespace Cesium
                 std::uint32_t layer = layerIt->second;
 
                 IntrusiveGltfModel* intrusiveGltfModel = reinterpret_cast<IntrusiveGltfModel*>(tileRenderResource);
-                GltfRasterMaterialBuilder materialBuilder;
-                GltfModel& model = intrusiveGltfModel->m_model;
-                for (auto& material : model.GetMaterials())
+                if (m_renderConfiguration.m_compositeRasterOverlays)
                 {
-                    if (!material.m_material)
+                    auto compositeRasterIt = intrusiveGltfModel->m_compositeRasters.find(layer);
+                    if (compositeRasterIt != intrusiveGltfModel->m_compositeRasters.end() &&
+                        compositeRasterIt->second.m_pixels == reinterpret_cast<RasterOverlay*>(mainThreadRasterResources)->m_compositePixels)
                     {
-                        continue;
+                        intrusiveGltfModel->m_compositeRasters.erase(compositeRasterIt);
+                        MarkRasterCompositeDirty(*intrusiveGltfModel);
                     }
 
-                    bool compile = materialBuilder.UnsetRasterForMaterial(layer, material.m_material);
+                    return;
+                }
+
+                UnsetRasterForModel(*intrusiveGltfModel, layer);
+            }
+        }
+    }
+
+    void RenderResourcesPreparer::SetRasterForModel(
+        IntrusiveGltfModel& intrusiveModel,
+        std::uint32_t layer,
+        const AZ::Data::Instance<AZ::RPI::Image>& image,
+        const AZ::Data::Asset<AZ::RPI::StreamingImageAsset>& imageAsset,
+        std::uint32_t textureCoordinate,
+        const AZ::Vector4& uvTranslateScale,
+        const AZ::Vector4& atlasTranslateScale)
+    {
+        GltfRasterMaterialBuilder materialBuilder;
+        GltfModel& model = intrusiveModel.m_model;
+        for (auto& material : model.GetMaterials())
+        {
+            if (!material.m_material || !materialBuilder.HasRasterLayer(layer, material.m_material))
+            {
+                continue;
+            }
+
+            // Just update material with raster if the current material can compile, so material can be updated right away
+            // in the next frame. Otherwise, we create the new material with the attached raster, so that the primitive is
+            // updated with the new material in the next frame. If we only update the material and not create new material
+            // the terrain can be rendered with old material if that material is still compiling and flickering can happen
+            bool canCompile = material.m_material->CanCompile();
+            if (canCompile)
+            {
+                canCompile = materialBuilder.SetRasterForMaterial(
+                    layer, image, textureCoordinate, uvTranslateScale, atlasTranslateScale, material.m_material);
+            }
+
+            if (!canCompile)
+            {
+                auto materialAsset = materialBuilder.CreateRasterMaterial(
+                    layer, imageAsset, textureCoordinate, uvTranslateScale, atlasTranslateScale, material.m_material->GetAsset());
+                material.m_material = AZ::RPI::Material::FindOrCreate(materialAsset);
+
+                // the atlas of a pooled raster has no asset that the material asset can reference, so it is set on the instance
+                if (!imageAsset &&
+                    !materialBuilder.SetRasterForMaterial(
+                        layer, image, textureCoordinate, uvTranslateScale, atlasTranslateScale, material.m_material))
+                {
+                    m_compileMaterialsQueue.emplace_back(material.m_material);
+                }
+            }
+        }
+
+        for (auto& mesh : model.GetMeshes())
+        {
+            for (auto& primitive : mesh.m_primitives)
+            {
+                model.UpdateMaterialForPrimitive(primitive);
+            }
+        }
+    }
+
+    void RenderResourcesPreparer::UnsetRasterForModel(IntrusiveGltfModel& intrusiveModel, std::uint32_t layer)
+    {
+        GltfRasterMaterialBuilder materialBuilder;
+        GltfModel& model = intrusiveModel.m_model;
+        for (auto& material : model.GetMaterials())
+        {
+            if (!material.m_material || !materialBuilder.HasRasterLayer(layer, material.m_material))
+            {
+                continue;
+            }
+
+            bool compile = materialBuilder.UnsetRasterForMaterial(layer, material.m_material);
+
+            // it's not guaranteed that the material will be able to compile right away, so we add it to the queue to compile later
+            if (!compile)
+            {
+                m_compileMaterialsQueue.emplace_back(material.m_material);
+            }
+        }
+    }
+
+    void RenderResourcesPreparer::MarkRasterCompositeDirty(IntrusiveGltfModel& intrusiveModel)
+    {
+        if (intrusiveModel.m_compositeId == 0)
+        {
+            intrusiveModel.m_compositeId = ++m_nextCompositeId;
+            m_compositeModels.insert({ intrusiveModel.m_compositeId, &intrusiveModel });
+        }
+
+        // rasters are attached and detached one by one when imagery refines, so the composite is redone once per frame at most
+        m_dirtyCompositeModels.insert(intrusiveModel.m_compositeId);
+    }
+
+    void RenderResourcesPreparer::ScheduleRasterComposites()
+    {
+        StreamingImageBuilderOption option;
+        option.m_srgb = true;
+        option.m_generateMipmaps = m_renderConfiguration.m_generateMipmaps;
+        option.m_compress = m_compressTextures;
+        for (std::uint64_t compositeId : m_dirtyCompositeModels)
+        {
+            auto modelIt = m_compositeModels.find(compositeId);
+            if (modelIt == m_compositeModels.end())
+            {
+                continue;
+            }
+
+            // results of composites that are still running for older inputs are dropped when they arrive
+            IntrusiveGltfModel& intrusiveModel = *modelIt->second;
+            ++intrusiveModel.m_compositeGeneration;
+            for (std::uint32_t textureCoordinate = 0; textureCoordinate < GltfRasterMaterialBuilder::MAX_RASTER_LAYERS; ++textureCoordinate)
+            {
+                // each uv set is composited into the material layer of the same index
+                AZStd::vector<RasterCompositeInput> inputs;
+                for (const auto& compositeRaster : intrusiveModel.m_compositeRasters)
+                {
+                    if (compositeRaster.second.m_textureCoordinate == textureCoordinate)
+                    {
+                        inputs.emplace_back(compositeRaster.second);
+                    }
+                }
 
-                    // it's not guaranteed that the material will be able to compile right away, so we add it to the queue to compile later
-                    if (!compile)
+                std::uint32_t textureCoordinateBit = 1u << textureCoordinate;
+                if (inputs.empty())
+                {
+                    if (intrusiveModel.m_compositeTextureCoordinates & textureCoordinateBit)
                     {
-                        m_compileMaterialsQueue.emplace_back(material.m_material);
+                        UnsetRasterForModel(intrusiveModel, textureCoordinate);
+                        intrusiveModel.m_compositeTextureCoordinates &= ~textureCoordinateBit;
                     }
+
+                    continue;
                 }
+
+                std::uint64_t generation = intrusiveModel.m_compositeGeneration;
+                AZStd::shared_ptr<RasterCompositeQueue> compositeQueue = m_rasterCompositeQueue;
+                CesiumInterface::Get()->GetTaskProcessor()->startTask(
+                    [inputs, compositeQueue, compositeId, generation, textureCoordinate, option]()
+                    {
+                        AZStd::vector<std::byte> pixels;
+                        std::uint32_t size = RasterCompositor::GetCompositeSize(inputs);
+                        RasterCompositor::Composite(inputs, size, pixels);
+                        AZ::Data::Asset<AZ::RPI::StreamingImageAsset> imageAsset =
+                            StreamingImageBuilder::Create(pixels.data(), size, size, 4, option);
+                        CesiumInterface::Get()->GetGltfLoadScratchArenaPool().GetThreadArena().Reset();
+
+                        AZStd::lock_guard<AZStd::mutex> lock(compositeQueue->m_resultsMutex);
+                        compositeQueue->m_results.push_back(
+                            RasterCompositeResult{ compositeId, generation, textureCoordinate, std::move(imageAsset) });
+                    });
             }
         }
+
+        m_dirtyCompositeModels.clear();
+    }
+
+    void RenderResourcesPreparer::ApplyRasterComposites()
+    {
+        AZStd::vector<RasterCompositeResult> results;
+        {
+            AZStd::lock_guard<AZStd::mutex> lock(m_rasterCompositeQueue->m_resultsMutex);
+            results.swap(m_rasterCompositeQueue->m_results);
+        }
+
+        for (const RasterCompositeResult& result : results)
+        {
+            auto modelIt = m_compositeModels.find(result.m_compositeId);
+            if (modelIt == m_compositeModels.end() || !result.m_imageAsset)
+            {
+                continue;
+            }
+
+            IntrusiveGltfModel& intrusiveModel = *modelIt->second;
+            if (intrusiveModel.m_compositeGeneration != result.m_generation)
+            {
+                continue;
+            }
+
+            AZ::Vector4 identity{ 0.0f, 0.0f, 1.0f, 1.0f };
+            AZ::Data::Instance<AZ::RPI::Image> image = AZ::RPI::StreamingImage::FindOrCreate(result.m_imageAsset);
+            SetRasterForModel(
+                intrusiveModel, result.m_textureCoordinate, image, result.m_imageAsset, result.m_textureCoordinate, identity, identity);
+            intrusiveModel.m_compositeTextureCoordinates |= 1u << result.m_textureCoordinate;
+        }
+    }
+
+    void RenderResourcesPreparer::ApplyVisibility(IntrusiveGltfModel& intrusiveModel)
+    {
+        bool visible = intrusiveModel.m_selected && intrusiveModel.m_withinPointBudget;
+        if (intrusiveModel.m_model.IsVisible() != visible)
+        {
+            intrusiveModel.m_model.SetVisible(visible);
+        }
+    }
+
+    void RenderResourcesPreparer::UpdatePointMaterials(IntrusiveGltfModel& intrusiveModel)
+    {
+        auto& materials = intrusiveModel.m_model.GetMaterials();
+        for (MaterialId pointMaterial : intrusiveModel.m_pointMaterials)
+        {
+            AZ::Data::Instance<AZ::RPI::Material>& material = materials[pointMaterial].m_material;
+            if (!material)
+            {
+                continue;
+            }
+
+            auto geometricErrorIndex = material->FindPropertyIndex(AZ::Name(GltfPointMaterialBuilder::GEOMETRIC_ERROR_PROPERTY));
+            material->SetPropertyValue(geometricErrorIndex, intrusiveModel.m_pointGeometricError);
+
+            auto viewportSizeIndex = material->FindPropertyIndex(AZ::Name(GltfPointMaterialBuilder::VIEWPORT_SIZE_PROPERTY));
+            material->SetPropertyValue(
+                viewportSizeIndex, AZ::Vector2(static_cast<float>(m_viewportSize.x), static_cast<float>(m_viewportSize.y)));
+
+            if (!material->Compile())
+            {
+                m_compileMaterialsQueue.emplace_back(material);
+            }
+        }
+    }
+
+    void RenderResourcesPreparer::ReleaseDecodedImages(Cesium3DTilesSelection::Tile& tile)
+    {
+        // the streaming image assets own their copy of the pixels by now. Keeping the decoded images in the tile content as well
+        // doubles the texture memory of every loaded tile. Children that are upsampled for raster overlays copy the textures
+        // of their parent though, and overlays can be added at any time, so the images are only released when the tileset opts
+        // out of overlays
+        if (!m_renderConfiguration.m_releaseDecodedImages)
+        {
+            return;
+        }
+
+        Cesium3DTilesSelection::TileContentLoadResult* content = tile.getContent();
+        if (!content || !content->model)
+        {
+            return;
+        }
+
+        for (CesiumGltf::Image& image : content->model->images)
+        {
+            std::vector<std::byte>().swap(image.cesium.pixelData);
+        }
+    }
+
+    void RenderResourcesPreparer::UploadRasterToTexturePool(
+        const Cesium3DTilesSelection::RasterOverlay& overlay, RasterOverlay& rasterOverlay)
+    {
+        AZStd::shared_ptr<RasterOverlayTexturePool>& texturePool = m_rasterTexturePools[&overlay];
+        if (!texturePool)
+        {
+            texturePool = AZStd::make_shared<RasterOverlayTexturePool>(m_renderConfiguration.m_generateMipmaps);
+        }
+
+        std::uint32_t slot = texturePool->AllocateSlot();
+        if (slot != RasterOverlayTexturePool::INVALID_SLOT && texturePool->UpdateSlot(slot, rasterOverlay.m_slotPixels))
+        {
+            rasterOverlay.m_image = texturePool->GetSlotImage(slot);
+            rasterOverlay.m_texturePool = texturePool;
+            rasterOverlay.m_textureSlot = slot;
+            rasterOverlay.m_atlasTranslateScale = texturePool->GetSlotTranslateScale(slot);
+        }
+        else
+        {
+            if (slot != RasterOverlayTexturePool::INVALID_SLOT)
+            {
+                texturePool->FreeSlot(slot);
+            }
+
+            // the pool is full. The top mip is at the start of the slot pixels, so the tile gets an image of its own
+            StreamingImageBuilderOption option;
+            option.m_srgb = true;
+            option.m_generateMipmaps = m_renderConfiguration.m_generateMipmaps;
+            rasterOverlay.m_imageAsset = StreamingImageBuilder::Create(
+                rasterOverlay.m_slotPixels.data(), RasterOverlayTexturePool::SLOT_SIZE, RasterOverlayTexturePool::SLOT_SIZE, 4, option);
+            CesiumInterface::Get()->GetGltfLoadScratchArenaPool().GetThreadArena().Reset();
+            if (rasterOverlay.m_imageAsset)
+            {
+                rasterOverlay.m_image = AZ::RPI::StreamingImage::FindOrCreate(rasterOverlay.m_imageAsset);
+            }
+        }
+
+        AZStd::vector<std::byte>().swap(rasterOverlay.m_slotPixels);
+    }
+
+    bool RenderResourcesPreparer::IsBlockCompressionSupported()
+    {
+        // BC formats are usually not available on mobile GPUs
+        AZ::RHI::RHISystemInterface* rhiSystem = AZ::RHI::RHISystemInterface::Get();
+        if (!rhiSystem || !rhiSystem->GetDevice())
+        {
+            return false;
+        }
+
+        const AZ::RHI::Device* device = rhiSystem->GetDevice();
+        for (AZ::RHI::Format format : { AZ::RHI::Format::BC1_UNORM_SRGB, AZ::RHI::Format::BC3_UNORM_SRGB, AZ::RHI::Format::BC4_UNORM })
+        {
+            if (!AZ::RHI::CheckBitsAll(device->GetFormatCapabilities(format), AZ::RHI::FormatCapabilities::Sample))
+            {
+                return false;
+            }
+        }
+
+        return true;
     }
 
     AZStd::optional<glm::dvec3> RenderResourcesPreparer::GetRTCFromGltf(const CesiumGltf::Model& model)
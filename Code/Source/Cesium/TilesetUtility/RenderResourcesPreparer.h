@@ -1,6 +1,11 @@
 #pragma once
 
 #include "Cesium/Gltf/GltfModel.h"
+#include "Cesium/Gltf/GltfLoadContext.h"
+#include "Cesium/Gltf/SharedTextureCache.h"
+#include "Cesium/TilesetUtility/RasterCompositor.h"
+#include "Cesium/TilesetUtility/RasterOverlayTexturePool.h"
+#include <Cesium/EBus/TilesetComponentBus.h>
 #include <Atom/RPI.Public/Material/Material.h>
 #include <Atom/RPI.Public/Image/StreamingImage.h>
 #include <Atom/RPI.Reflect/Image/StreamingImageAsset.h>
@@ -10,8 +15,15 @@
 #include <AzCore/std/optional.h>
 #include <AzCore/std/containers/vector.h>
 #include <AzCore/std/containers/map.h>
+#include <AzCore/std/containers/unordered_map.h>
+#include <AzCore/std/containers/unordered_set.h>
+#include <AzCore/std/parallel/mutex.h>
+#include <AzCore/std/smart_ptr/shared_ptr.h>
+#include <AzCore/std/smart_ptr/make_shared.h>
 #include <Cesium3DTilesSelection/IPrepareRendererResources.h>
 #include <glm/glm.hpp>
+#include <limits>
+#include <vector>
 
 namespace AZ
 {
@@ -29,25 +41,124 @@ namespace CesiumGltf
 namespace Cesium3DTilesSelection
 {
     class RasterOverlay;
-}
+    class ViewState;
+} // namespace Cesium3DTilesSelection
 
 namespace Cesium
 {
     struct RasterOverlay
     {
-        AZ::Data::Instance<AZ::RPI::StreamingImage> m_image;
+        RasterOverlay()
+            : m_textureSlot{ RasterOverlayTexturePool::INVALID_SLOT }
+            , m_atlasTranslateScale{ 0.0f, 0.0f, 1.0f, 1.0f }
+            , m_compositeWidth{ 0 }
+            , m_compositeHeight{ 0 }
+        {
+        }
+
+        ~RasterOverlay() noexcept
+        {
+            if (m_texturePool && m_textureSlot != RasterOverlayTexturePool::INVALID_SLOT)
+            {
+                m_texturePool->FreeSlot(m_textureSlot);
+            }
+        }
+
+        AZ::Data::Instance<AZ::RPI::Image> m_image;
         AZ::Data::Asset<AZ::RPI::StreamingImageAsset> m_imageAsset;
+
+        // mips of a tile that goes into the texture pool of its overlay. Uploaded and released on the main thread
+        AZStd::vector<std::byte> m_slotPixels;
+        AZStd::shared_ptr<RasterOverlayTexturePool> m_texturePool;
+        std::uint32_t m_textureSlot;
+        AZ::Vector4 m_atlasTranslateScale;
+
+        // RGBA pixels that are kept around for compositing instead of creating an image
+        AZStd::shared_ptr<const AZStd::vector<std::byte>> m_compositePixels;
+        std::uint32_t m_compositeWidth;
+        std::uint32_t m_compositeHeight;
+    };
+
+    struct StreamingTileTexture final
+    {
+        StreamingTileTexture(AZ::Data::Instance<AZ::RPI::StreamingImage> image, std::uint32_t size, std::uint16_t mipLevelCount)
+            : m_image{ std::move(image) }
+            , m_size{ size }
+            , m_mipLevelCount{ mipLevelCount }
+        {
+        }
+
+        AZ::Data::Instance<AZ::RPI::StreamingImage> m_image;
+        std::uint32_t m_size;
+        std::uint16_t m_mipLevelCount;
     };
 
     struct IntrusiveGltfModel
     {
         IntrusiveGltfModel(GltfModel&& model)
             : m_model{ std::move(model) }
+            , m_pointCount{ 0 }
+            , m_pointGeometricError{ 0.0f }
+            , m_compositeId{ 0 }
+            , m_compositeGeneration{ 0 }
+            , m_compositeTextureCoordinates{ 0 }
+            , m_screenCoverage{ 0.0 }
+            , m_selected{ false }
+            , m_withinPointBudget{ true }
         {
         }
 
         GltfModel m_model;
         AZ::StableDynamicArrayHandle<IntrusiveGltfModel> m_self;
+        AZStd::vector<MaterialId> m_pointMaterials;
+        std::uint64_t m_pointCount;
+        float m_pointGeometricError;
+
+        // raster tiles attached to the model by overlay layer, when overlays are composited
+        AZStd::map<std::uint32_t, RasterCompositeInput> m_compositeRasters;
+        std::uint64_t m_compositeId;
+        std::uint64_t m_compositeGeneration;
+        std::uint32_t m_compositeTextureCoordinates;
+
+        // textures whose resident mips follow the size of the tile on screen, in pixels
+        AZStd::vector<StreamingTileTexture> m_streamingTextures;
+        double m_screenCoverage;
+
+        // the model is shown when the tileset renders its tile this frame and, for point clouds, when its points fit in the budget
+        bool m_selected;
+        bool m_withinPointBudget;
+    };
+
+    struct TextureStreamingTarget final
+    {
+        TextureStreamingTarget(AZ::Data::Instance<AZ::RPI::StreamingImage> image)
+            : m_image{ std::move(image) }
+            , m_targetMip{ INVALID_MIP }
+            , m_desiredMip{ INVALID_MIP }
+        {
+        }
+
+        static constexpr std::uint16_t INVALID_MIP = std::numeric_limits<std::uint16_t>::max();
+
+        AZ::Data::Instance<AZ::RPI::StreamingImage> m_image;
+        std::uint16_t m_targetMip;
+        std::uint16_t m_desiredMip;
+    };
+
+    struct RasterCompositeResult final
+    {
+        std::uint64_t m_compositeId;
+        std::uint64_t m_generation;
+        std::uint32_t m_textureCoordinate;
+        AZ::Data::Asset<AZ::RPI::StreamingImageAsset> m_imageAsset;
+    };
+
+    // composites finished by the task processor, waiting to be bound on the main thread. Shared with the tasks, so that a
+    // task which outlives the preparer has somewhere to write to
+    struct RasterCompositeQueue final
+    {
+        AZStd::mutex m_resultsMutex;
+        AZStd::vector<RasterCompositeResult> m_results;
     };
 
     class RenderResourcesPreparer
@@ -55,7 +166,8 @@ namespace Cesium
         , public AZ::TickBus::Handler
     {
     public:
-        RenderResourcesPreparer(AZ::Render::MeshFeatureProcessorInterface* meshFeatureProcessor);
+        RenderResourcesPreparer(
+            AZ::Render::MeshFeatureProcessorInterface* meshFeatureProcessor, const TilesetRenderConfiguration& renderConfiguration);
 
         ~RenderResourcesPreparer() noexcept;
 
@@ -67,6 +179,17 @@ namespace Cesium
 
         void SetVisible(void* renderResources, bool visible);
 
+        void SetViewportSize(const glm::dvec2& viewportSize);
+
+        void UpdateScreenCoverage(
+            const Cesium3DTilesSelection::Tile& tile, const std::vector<Cesium3DTilesSelection::ViewState>& viewStates);
+
+        void UpdateTextureStreaming();
+
+        // hides the rendered point tiles that don't fit in the point budget, starting from the ones that cover the fewest pixels.
+        // Called once a frame after the visibility of the tiles is set
+        void UpdatePointBudget();
+
         bool AddRasterLayer(const Cesium3DTilesSelection::RasterOverlay* rasterOverlay);
 
         void RemoveRasterLayer(const Cesium3DTilesSelection::RasterOverlay* rasterOverlay);
@@ -103,14 +226,53 @@ namespace Cesium
     private:
         AZStd::optional<glm::dvec3> GetRTCFromGltf(const CesiumGltf::Model& model);
 
+        static bool IsBlockCompressionSupported();
+
+        void UpdatePointMaterials(IntrusiveGltfModel& intrusiveModel);
+
+        static void ApplyVisibility(IntrusiveGltfModel& intrusiveModel);
+
+        void ReleaseDecodedImages(Cesium3DTilesSelection::Tile& tile);
+
+        void UploadRasterToTexturePool(const Cesium3DTilesSelection::RasterOverlay& overlay, RasterOverlay& rasterOverlay);
+
+        void MarkRasterCompositeDirty(IntrusiveGltfModel& intrusiveModel);
+
+        void ScheduleRasterComposites();
+
+        void ApplyRasterComposites();
+
+        void SetRasterForModel(
+            IntrusiveGltfModel& intrusiveModel,
+            std::uint32_t layer,
+            const AZ::Data::Instance<AZ::RPI::Image>& image,
+            const AZ::Data::Asset<AZ::RPI::StreamingImageAsset>& imageAsset,
+            std::uint32_t textureCoordinate,
+            const AZ::Vector4& uvTranslateScale,
+            const AZ::Vector4& atlasTranslateScale);
+
+        void UnsetRasterForModel(IntrusiveGltfModel& intrusiveModel, std::uint32_t layer);
+
         static constexpr char CESIUM_RTC_CENTER_EXTRA[] = "RTC_CENTER";
 
         AZ::Render::MeshFeatureProcessorInterface* m_meshFeatureProcessor;
         AZ::StableDynamicArray<IntrusiveGltfModel> m_intrusiveModels;
         glm::dmat4 m_transform;
+        TilesetRenderConfiguration m_renderConfiguration;
+        AZStd::vector<IntrusiveGltfModel*> m_pointBudgetModels;
+        glm::dvec2 m_viewportSize;
+        bool m_compressTextures;
+        SharedTextureCache m_sharedTextureCache;
+        bool m_sharedTexturesReleased;
 
         AZStd::vector<AZ::Data::Instance<AZ::RPI::Material>> m_compileMaterialsQueue;
         AZStd::map<const Cesium3DTilesSelection::RasterOverlay*, std::uint32_t> m_rasterOverlayLayers;
         AZStd::vector<std::uint32_t> m_freeRasterLayers;
+        AZStd::map<const Cesium3DTilesSelection::RasterOverlay*, AZStd::shared_ptr<RasterOverlayTexturePool>> m_rasterTexturePools;
+        AZStd::unordered_map<std::uint64_t, IntrusiveGltfModel*> m_compositeModels;
+        AZStd::unordered_set<std::uint64_t> m_dirtyCompositeModels;
+        AZStd::shared_ptr<RasterCompositeQueue> m_rasterCompositeQueue;
+        std::uint64_t m_nextCompositeId;
+        AZStd::unordered_map<AZ::RPI::StreamingImage*, TextureStreamingTarget> m_textureStreamingTargets;
     };
 } // namespace Cesium
@@ -0,0 +1,29 @@
+#include "Cesium/TilesetUtility/TextureMipSelector.h"
+#include <cmath>
+
+namespace Cesium
+{
+    std::uint16_t TextureMipSelector::GetDesiredMip(std::uint32_t textureSize, std::uint16_t mipLevelCount, double screenCoverage)
+    {
+        if (mipLevelCount <= 1)
+        {
+            return 0;
+        }
+
+        std::uint16_t lastMip = static_cast<std::uint16_t>(mipLevelCount - 1);
+        if (screenCoverage <= 0.0 || !std::isfinite(screenCoverage))
+        {
+            return screenCoverage > 0.0 ? 0 : lastMip;
+        }
+
+        // every mip halves the size, so drop as many mips as the texture is larger than the tile on screen
+        double ratio = static_cast<double>(textureSize) / screenCoverage;
+        if (ratio <= 1.0)
+        {
+            return 0;
+        }
+
+        double mip = std::floor(std::log2(ratio));
+        return mip >= static_cast<double>(lastMip) ? lastMip : static_cast<std::uint16_t>(mip);
+    }
+} // namespace Cesium
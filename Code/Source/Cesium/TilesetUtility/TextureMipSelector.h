@@ -0,0 +1,16 @@
+#pragma once
+
+#include <cstdint>
+
+namespace Cesium
+{
+    // Picks the most detailed mip of a tile texture that is worth keeping resident. The texture is assumed to be stretched over
+    // the whole tile, so a tile that covers N pixels on screen doesn't need more than N texels across.
+    class TextureMipSelector final
+    {
+    public:
+        // screenCoverage is the size of the tile on screen in pixels. Zero or less means the tile is not rendered, and only the
+        // least detailed mip is kept
+        static std::uint16_t GetDesiredMip(std::uint32_t textureSize, std::uint16_t mipLevelCount, double screenCoverage);
+    };
+} // namespace Cesium
@@ -105,7 +105,62 @@ namespace Cesium
                     ->Attribute(AZ::Edit::Attributes::AutoExpand, true)
                     ->DataElement(
                         AZ::Edit::UIHandlers::CheckBox, &TilesetRenderConfiguration::m_generateMissingNormalAsSmooth,
-                        "Generate Missing Normal As Smooth", "");
+                        "Generate Missing Normal As Smooth", "")
+                    ->DataElement(
+                        AZ::Edit::UIHandlers::Default, &TilesetRenderConfiguration::m_pointCloudPointBudget, "Point Cloud Point Budget",
+                        "Maximum number of points the tileset renders in a frame. The tiles covering the fewest pixels are hidden past it")
+                    ->DataElement(
+                        AZ::Edit::UIHandlers::Default, &TilesetRenderConfiguration::m_pointCloudPointSize, "Point Cloud Point Size",
+                        "Point size in pixels when attenuation is disabled")
+                    ->Attribute(AZ::Edit::Attributes::Min, 1.0f)
+                    ->DataElement(
+                        AZ::Edit::UIHandlers::CheckBox, &TilesetRenderConfiguration::m_pointCloudAttenuation, "Point Cloud Attenuation",
+                        "Scale points by the geometric error of their tile")
+                    ->DataElement(
+                        AZ::Edit::UIHandlers::Default, &TilesetRenderConfiguration::m_pointCloudGeometricErrorScale,
+                        "Point Cloud Geometric Error Scale", "")
+                    ->Attribute(AZ::Edit::Attributes::Min, 0.0f)
+                    ->DataElement(
+                        AZ::Edit::UIHandlers::Default, &TilesetRenderConfiguration::m_pointCloudMaximumAttenuation,
+                        "Point Cloud Maximum Attenuation", "Maximum point size in pixels when attenuation is enabled")
+                    ->Attribute(AZ::Edit::Attributes::Min, 1.0f)
+                    ->DataElement(
+                        AZ::Edit::UIHandlers::CheckBox, &TilesetRenderConfiguration::m_optimizeVertexCache, "Optimize Vertex Cache",
+                        "Reorder the triangles and vertices of indexed meshes for GPU cache locality when tiles are loaded")
+                    ->DataElement(
+                        AZ::Edit::UIHandlers::Default, &TilesetRenderConfiguration::m_vertexCacheOptimizationMinimumTriangleCount,
+                        "Vertex Cache Optimization Minimum Triangle Count", "Primitives with fewer triangles are left untouched")
+                    ->DataElement(
+                        AZ::Edit::UIHandlers::ComboBox, &TilesetRenderConfiguration::m_tangentGenerationMode, "Tangent Generation Mode",
+                        "How tangents are generated for primitives that need them but don't have them. The fast modes are approximate")
+                    ->EnumAttribute(TangentGenerationMode::MikkTSpace, "MikkTSpace")
+                    ->EnumAttribute(TangentGenerationMode::FastPerTriangle, "Fast Per Triangle")
+                    ->EnumAttribute(TangentGenerationMode::FastAccumulated, "Fast Accumulated Over Shared Vertices")
+                    ->DataElement(
+                        AZ::Edit::UIHandlers::CheckBox, &TilesetRenderConfiguration::m_compressTextures, "Compress Textures",
+                        "Encode tile and raster overlay textures to BC1/BC3/BC4 when they are loaded. Ignored when the GPU doesn't support them")
+                    ->DataElement(
+                        AZ::Edit::UIHandlers::CheckBox, &TilesetRenderConfiguration::m_generateMipmaps, "Generate Mipmaps",
+                        "Generate the mip chain of tile and raster overlay textures when they are loaded")
+                    ->DataElement(
+                        AZ::Edit::UIHandlers::CheckBox, &TilesetRenderConfiguration::m_shareTextures, "Share Textures",
+                        "Tiles with identical textures share one image instead of creating a copy each")
+                    ->DataElement(
+                        AZ::Edit::UIHandlers::CheckBox, &TilesetRenderConfiguration::m_poolRasterOverlayTiles, "Pool Raster Overlay Tiles",
+                        "Upload 256x256 raster overlay tiles into shared atlas images instead of creating an image per tile")
+                    ->DataElement(
+                        AZ::Edit::UIHandlers::CheckBox, &TilesetRenderConfiguration::m_compositeRasterOverlays, "Composite Raster Overlays",
+                        "Flatten all the raster overlays of a tile into one texture on a worker thread, so that more overlays can be "
+                        "stacked without extra texture samples. Raster overlay tiles keep their pixels in memory while they are loaded")
+                    ->DataElement(
+                        AZ::Edit::UIHandlers::CheckBox, &TilesetRenderConfiguration::m_streamTexturesByScreenCoverage,
+                        "Stream Textures By Screen Coverage",
+                        "Only keep the mips of tile textures that are needed for the size of the tile on screen. Hidden tiles keep their "
+                        "least detailed mips")
+                    ->DataElement(
+                        AZ::Edit::UIHandlers::CheckBox, &TilesetRenderConfiguration::m_releaseDecodedImages, "Release Decoded Images",
+                        "Free the decoded images of a tile once its textures are uploaded. Raster overlays can't be added to the tileset "
+                        "when this is enabled");
             }
         }
     }
@@ -0,0 +1,120 @@
+#include "Cesium/Gltf/BitangentAndTangentGenerator.h"
+#include <AzCore/UnitTest/TestTypes.h>
+#include <AzCore/std/containers/vector.h>
+
+class BitangentAndTangentGeneratorTest : public UnitTest::AllocatorsTestFixture
+{
+public:
+    // MikkTSpace leaves the tangents scaled by how much the uvs stretch, so only their direction and handedness are compared
+    static void ExpectSameTangent(const glm::vec4& fastTangent, const glm::vec4& mikkTangent)
+    {
+        EXPECT_GT(glm::dot(glm::normalize(glm::vec3(fastTangent)), glm::normalize(glm::vec3(mikkTangent))), 0.999f);
+        EXPECT_EQ(fastTangent.w, mikkTangent.w);
+    }
+
+    // the plane is tilted, so that its normal doesn't lie on an axis
+    static glm::vec3 GetPlanePoint(float x, float y)
+    {
+        return glm::vec3(x, 0.6f * y, 0.8f * y);
+    }
+
+    static glm::vec3 GetPlaneNormal()
+    {
+        return glm::vec3(0.0f, -0.8f, 0.6f);
+    }
+};
+
+TEST_F(BitangentAndTangentGeneratorTest, FastTangentsMatchMikkTSpaceOnIndexedMesh)
+{
+    // 3x3 vertices with skewed uvs, so the tangent is the same everywhere and accumulating it per vertex changes nothing
+    AZStd::vector<glm::vec3> positions;
+    AZStd::vector<glm::vec3> normals;
+    AZStd::vector<glm::vec2> uvs;
+    for (std::uint32_t y = 0; y < 3; ++y)
+    {
+        for (std::uint32_t x = 0; x < 3; ++x)
+        {
+            positions.emplace_back(GetPlanePoint(static_cast<float>(x), static_cast<float>(y)));
+            normals.emplace_back(GetPlaneNormal());
+            uvs.emplace_back(0.5f * static_cast<float>(x) + 0.25f * static_cast<float>(y), 0.75f * static_cast<float>(y));
+        }
+    }
+
+    AZStd::vector<std::uint32_t> indices;
+    for (std::uint32_t y = 0; y < 2; ++y)
+    {
+        for (std::uint32_t x = 0; x < 2; ++x)
+        {
+            std::uint32_t v0 = y * 3 + x;
+            indices.insert(indices.end(), { v0, v0 + 1, v0 + 3, v0 + 1, v0 + 4, v0 + 3 });
+        }
+    }
+
+    AZStd::vector<glm::vec4> fastTangents;
+    AZStd::vector<glm::vec3> fastBitangents;
+    ASSERT_TRUE(Cesium::BitangentAndTangentGenerator::GenerateFast(
+        positions,
+        normals,
+        AZStd::span<glm::vec2>(uvs.data(), uvs.size()),
+        AZStd::span<const std::uint32_t>(indices.data(), indices.size()),
+        fastTangents,
+        fastBitangents));
+
+    // MikkTSpace only takes triangle lists without indices
+    AZStd::vector<glm::vec3> unindexedPositions;
+    AZStd::vector<glm::vec3> unindexedNormals;
+    AZStd::vector<glm::vec2> unindexedUvs;
+    for (std::uint32_t index : indices)
+    {
+        unindexedPositions.emplace_back(positions[index]);
+        unindexedNormals.emplace_back(normals[index]);
+        unindexedUvs.emplace_back(uvs[index]);
+    }
+
+    AZStd::vector<glm::vec4> mikkTangents;
+    AZStd::vector<glm::vec3> mikkBitangents;
+    Cesium::BitangentAndTangentGenerator::Generate(
+        unindexedPositions,
+        unindexedNormals,
+        AZStd::span<glm::vec2>(unindexedUvs.data(), unindexedUvs.size()),
+        mikkTangents,
+        mikkBitangents);
+
+    for (std::size_t i = 0; i < indices.size(); ++i)
+    {
+        ExpectSameTangent(fastTangents[indices[i]], mikkTangents[i]);
+    }
+}
+
+TEST_F(BitangentAndTangentGeneratorTest, FastTangentsMatchMikkTSpaceOnUnindexedMesh)
+{
+    // the second triangle has mirrored uvs, so its tangents are left handed
+    AZStd::vector<glm::vec3> positions{ GetPlanePoint(0.0f, 0.0f), GetPlanePoint(1.0f, 0.0f), GetPlanePoint(0.0f, 1.0f),
+                                        GetPlanePoint(3.0f, 0.0f), GetPlanePoint(4.0f, 0.0f), GetPlanePoint(3.0f, 1.0f) };
+    AZStd::vector<glm::vec3> normals(positions.size(), GetPlaneNormal());
+    AZStd::vector<glm::vec2> uvs{ { 0.0f, 0.0f }, { 1.0f, 0.0f }, { 0.0f, 1.0f }, { 1.0f, 0.0f }, { 0.0f, 0.0f }, { 1.0f, 1.0f } };
+
+    AZStd::vector<glm::vec4> fastTangents;
+    AZStd::vector<glm::vec3> fastBitangents;
+    ASSERT_TRUE(Cesium::BitangentAndTangentGenerator::GenerateFast(
+        positions,
+        normals,
+        AZStd::span<glm::vec2>(uvs.data(), uvs.size()),
+        AZStd::span<const std::uint32_t>(),
+        fastTangents,
+        fastBitangents));
+
+    AZStd::vector<glm::vec4> mikkTangents;
+    AZStd::vector<glm::vec3> mikkBitangents;
+    Cesium::BitangentAndTangentGenerator::Generate(
+        positions, normals, AZStd::span<glm::vec2>(uvs.data(), uvs.size()), mikkTangents, mikkBitangents);
+
+    ASSERT_EQ(fastTangents.size(), mikkTangents.size());
+    for (std::size_t i = 0; i < positions.size(); ++i)
+    {
+        ExpectSameTangent(fastTangents[i], mikkTangents[i]);
+    }
+
+    EXPECT_EQ(fastTangents[0].w, 1.0f);
+    EXPECT_EQ(fastTangents[3].w, -1.0f);
+}
@@ -1,8 +1,18 @@
 #include "Cesium/Systems/HttpAssetAccessor.h"
 #include "Cesium/Systems/HttpManager.h"
+#include "LoopbackHttpServer.h"
+#include <AzCore/JSON/document.h>
 #include <AzCore/Memory/PoolAllocator.h>
 #include <AzCore/UnitTest/TestTypes.h>
 #include <CesiumAsync/AsyncSystem.h>
+#include <CesiumAsync/IAssetResponse.h>
+#include <CesiumUtility/Uri.h>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
 
 class HttpAssetAccessorTest : public UnitTest::AllocatorsTestFixture
 {
@@ -12,14 +22,43 @@ public:
         UnitTest::AllocatorsTestFixture::SetUp();
         AZ::AllocatorInstance<AZ::PoolAllocator>::Create();
         AZ::AllocatorInstance<AZ::ThreadPoolAllocator>::Create();
+
+        m_server.AddContent("/ip", R"({ "origin": "127.0.0.1" })", "application/json");
+        ASSERT_TRUE(m_server.Start());
     }
 
     void TearDown() override
     {
+        m_server.Stop();
         AZ::AllocatorInstance<AZ::ThreadPoolAllocator>::Destroy();
         AZ::AllocatorInstance<AZ::PoolAllocator>::Destroy();
         UnitTest::AllocatorsTestFixture::TearDown();
     }
+
+    static void WriteFile(const std::filesystem::path& path, const std::string& content)
+    {
+        std::filesystem::create_directories(path.parent_path());
+        std::ofstream file(path, std::ios::binary);
+        file.write(content.data(), static_cast<std::streamsize>(content.size()));
+    }
+
+    static void CollectContentUris(const rapidjson::Value& tile, std::vector<std::string>& uris)
+    {
+        if (tile.HasMember("content") && tile["content"].HasMember("uri"))
+        {
+            uris.emplace_back(tile["content"]["uri"].GetString());
+        }
+
+        if (tile.HasMember("children"))
+        {
+            for (const auto& child : tile["children"].GetArray())
+            {
+                CollectContentUris(child, uris);
+            }
+        }
+    }
+
+    LoopbackHttpServer m_server;
 };
 
 TEST_F(HttpAssetAccessorTest, TestRequestAsset)
@@ -29,7 +68,7 @@ TEST_F(HttpAssetAccessorTest, TestRequestAsset)
     Cesium::HttpManager httpManager;
 
     Cesium::HttpAssetAccessor accessor(&httpManager);
-    auto completedRequestFuture = accessor.requestAsset(asyncSystem, "https://httpbin.org/ip");
+    auto completedRequestFuture = accessor.requestAsset(asyncSystem, m_server.GetUrl("/ip"));
     auto completedRequest = completedRequestFuture.wait();
 
     ASSERT_NE(completedRequest, nullptr);
@@ -37,6 +76,32 @@ TEST_F(HttpAssetAccessorTest, TestRequestAsset)
     ASSERT_EQ(completedRequest->method(), "GET");
 }
 
+TEST_F(HttpAssetAccessorTest, TestDecodedResponseHeaders)
+{
+    // we don't care about worker thread in this test
+    CesiumAsync::AsyncSystem asyncSystem{ nullptr };
+    LoopbackHttpServerOptions options;
+    options.m_gzip = true;
+    LoopbackHttpServer gzipServer(options);
+    std::string body(64 * 1024, 'g');
+    gzipServer.AddContent("/tile.b3dm", body);
+    ASSERT_TRUE(gzipServer.Start());
+    Cesium::HttpManager httpManager;
+    Cesium::HttpAssetAccessor accessor(&httpManager);
+
+    // the headers describe the decoded body, since that is what caches store next to them
+    auto completedRequest = accessor.requestAsset(asyncSystem, gzipServer.GetUrl("/tile.b3dm")).wait();
+    ASSERT_NE(completedRequest, nullptr);
+    const CesiumAsync::IAssetResponse* response = completedRequest->response();
+    ASSERT_EQ(response->statusCode(), 200);
+    ASSERT_EQ(response->data().size(), body.size());
+    ASSERT_EQ(response->headers().count("Content-Encoding"), 0u);
+    auto contentLength = response->headers().find("Content-Length");
+    ASSERT_NE(contentLength, response->headers().end());
+    ASSERT_EQ(contentLength->second, std::to_string(body.size()));
+    gzipServer.Stop();
+}
+
 TEST_F(HttpAssetAccessorTest, TestPost)
 {
     // we don't care about worker thread in this test
@@ -44,10 +109,129 @@ TEST_F(HttpAssetAccessorTest, TestPost)
     Cesium::HttpManager httpManager;
 
     Cesium::HttpAssetAccessor accessor(&httpManager);
-    auto completedRequestFuture = accessor.post(asyncSystem, "https://httpbin.org/post");
+    auto completedRequestFuture = accessor.post(asyncSystem, m_server.GetUrl("/post"));
     auto completedRequest = completedRequestFuture.wait();
 
     ASSERT_NE(completedRequest, nullptr);
     ASSERT_EQ(completedRequest->response()->statusCode(), 200);
     ASSERT_EQ(completedRequest->method(), "POST");
 }
+
+TEST_F(HttpAssetAccessorTest, TestDuplicateRequestsShareResponse)
+{
+    // we don't care about worker thread in this test
+    CesiumAsync::AsyncSystem asyncSystem{ nullptr };
+    LoopbackHttpServerOptions options;
+    options.m_latency = std::chrono::milliseconds(500);
+    LoopbackHttpServer slowServer(options);
+    slowServer.AddContent("/delay", "{}", "application/json");
+    ASSERT_TRUE(slowServer.Start());
+    Cesium::HttpManager httpManager;
+
+    // the server waits before it responds, so the duplicates are added while the first request is in flight
+    Cesium::HttpAssetAccessor accessor(&httpManager);
+    auto firstRequestFuture = accessor.requestAsset(asyncSystem, slowServer.GetUrl("/delay"));
+    auto duplicateRequestFuture = accessor.requestAsset(asyncSystem, slowServer.GetUrl("/delay"));
+    auto otherHeaderRequestFuture =
+        accessor.requestAsset(asyncSystem, slowServer.GetUrl("/delay"), { { "Accept", "application/json" } });
+
+    auto firstRequest = firstRequestFuture.wait();
+    auto duplicateRequest = duplicateRequestFuture.wait();
+    auto otherHeaderRequest = otherHeaderRequestFuture.wait();
+
+    ASSERT_NE(firstRequest, nullptr);
+    ASSERT_EQ(firstRequest->response()->statusCode(), 200);
+    ASSERT_EQ(firstRequest, duplicateRequest);
+    ASSERT_NE(firstRequest, otherHeaderRequest);
+
+    // requests that are no longer in flight are not reused
+    auto laterRequest = accessor.requestAsset(asyncSystem, slowServer.GetUrl("/delay")).wait();
+    ASSERT_NE(laterRequest, nullptr);
+    ASSERT_NE(firstRequest, laterRequest);
+}
+
+TEST_F(HttpAssetAccessorTest, TestCancelledAccessor)
+{
+    // we don't care about worker thread in this test
+    CesiumAsync::AsyncSystem asyncSystem{ nullptr };
+    Cesium::HttpManager httpManager;
+
+    Cesium::HttpAssetAccessor accessor(&httpManager);
+    Cesium::HttpCancellationToken cancellationToken;
+    auto cancellableAccessor = accessor.CreateCancellableAccessor(cancellationToken);
+    cancellationToken.Cancel();
+
+    auto cancelledRequest = cancellableAccessor->requestAsset(asyncSystem, m_server.GetUrl("/ip")).wait();
+    ASSERT_NE(cancelledRequest, nullptr);
+    ASSERT_EQ(cancelledRequest->response()->statusCode(), 404);
+
+    // the parent accessor isn't affected by the token
+    auto completedRequest = accessor.requestAsset(asyncSystem, m_server.GetUrl("/ip")).wait();
+    ASSERT_EQ(completedRequest->response()->statusCode(), 200);
+}
+
+TEST_F(HttpAssetAccessorTest, TestTilesetFromDirectory)
+{
+    // we don't care about worker thread in this test
+    CesiumAsync::AsyncSystem asyncSystem{ nullptr };
+    std::filesystem::path rootDirectory = std::filesystem::temp_directory_path() /
+        ("CesiumLoopbackTileset" + std::to_string(std::chrono::steady_clock::now().time_since_epoch().count()));
+    WriteFile(
+        rootDirectory / "tileset.json",
+        R"({
+            "asset": { "version": "1.0" },
+            "geometricError": 100,
+            "root": {
+                "boundingVolume": { "sphere": [0, 0, 0, 10] },
+                "geometricError": 10,
+                "refine": "REPLACE",
+                "content": { "uri": "tiles/root.b3dm" },
+                "children": [
+                    { "boundingVolume": { "sphere": [0, 0, 0, 5] }, "geometricError": 0, "content": { "uri": "tiles/child.b3dm" } }
+                ]
+            }
+        })");
+    WriteFile(rootDirectory / "tiles" / "root.b3dm", std::string(64 * 1024, 'r'));
+    WriteFile(rootDirectory / "tiles" / "child.b3dm", std::string(32 * 1024, 'c'));
+
+    LoopbackHttpServer directoryServer;
+    directoryServer.ServeDirectory(rootDirectory.generic_string());
+    ASSERT_TRUE(directoryServer.Start());
+    Cesium::HttpManager httpManager;
+    Cesium::HttpAssetAccessor accessor(&httpManager);
+
+    // the tiles are found the way the tileset finds them, by resolving the content uris against the url of tileset.json
+    std::string tilesetUrl = directoryServer.GetUrl("/tileset.json");
+    auto tilesetRequest = accessor.requestAsset(asyncSystem, tilesetUrl).wait();
+    ASSERT_NE(tilesetRequest, nullptr);
+    ASSERT_EQ(tilesetRequest->response()->statusCode(), 200);
+    ASSERT_EQ(tilesetRequest->response()->contentType(), "application/json");
+
+    auto tilesetData = tilesetRequest->response()->data();
+    rapidjson::Document tileset;
+    tileset.Parse(reinterpret_cast<const char*>(tilesetData.data()), tilesetData.size());
+    ASSERT_FALSE(tileset.HasParseError());
+
+    std::vector<std::string> contentUris;
+    CollectContentUris(tileset["root"], contentUris);
+    ASSERT_EQ(contentUris.size(), 2u);
+    for (const std::string& contentUri : contentUris)
+    {
+        auto tileRequest = accessor.requestAsset(asyncSystem, CesiumUtility::Uri::resolve(tilesetUrl, contentUri)).wait();
+        ASSERT_NE(tileRequest, nullptr);
+        ASSERT_EQ(tileRequest->response()->statusCode(), 200);
+
+        std::ifstream file(rootDirectory / contentUri, std::ios::binary);
+        std::string expected((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+        auto tileData = tileRequest->response()->data();
+        ASSERT_EQ(tileData.size(), expected.size());
+        ASSERT_EQ(std::memcmp(tileData.data(), expected.data(), expected.size()), 0);
+    }
+
+    auto missingRequest = accessor.requestAsset(asyncSystem, directoryServer.GetUrl("/tiles/missing.b3dm")).wait();
+    ASSERT_NE(missingRequest, nullptr);
+    ASSERT_EQ(missingRequest->response()->statusCode(), 404);
+
+    directoryServer.Stop();
+    std::filesystem::remove_all(rootDirectory);
+}
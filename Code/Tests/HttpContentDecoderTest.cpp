@@ -0,0 +1,151 @@
+#include "Cesium/Systems/HttpContentDecoder.h"
+#include "Cesium/Systems/HttpResponseBodyStream.h"
+#include <AzCore/UnitTest/TestTypes.h>
+#include <zlib.h>
+#include <algorithm>
+#include <cstring>
+#include <string>
+
+class HttpContentDecoderTest : public UnitTest::AllocatorsTestFixture
+{
+public:
+    static Cesium::IOContent CreateContent(std::size_t size)
+    {
+        Cesium::IOContent content(size);
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            content[i] = static_cast<std::byte>((i * 7) % 251);
+        }
+
+        return content;
+    }
+
+    static Cesium::IOContent Compress(const Cesium::IOContent& content, int windowBits)
+    {
+        z_stream stream;
+        std::memset(&stream, 0, sizeof(stream));
+        deflateInit2(&stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, windowBits, 8, Z_DEFAULT_STRATEGY);
+
+        Cesium::IOContent compressed(deflateBound(&stream, static_cast<uLong>(content.size())));
+        stream.next_in = const_cast<Bytef*>(reinterpret_cast<const Bytef*>(content.data()));
+        stream.avail_in = static_cast<uInt>(content.size());
+        stream.next_out = reinterpret_cast<Bytef*>(compressed.data());
+        stream.avail_out = static_cast<uInt>(compressed.size());
+        deflate(&stream, Z_FINISH);
+        compressed.resize(stream.total_out);
+        deflateEnd(&stream);
+
+        return compressed;
+    }
+};
+
+TEST_F(HttpContentDecoderTest, GzipIsDecodedChunkByChunk)
+{
+    Cesium::IOContent content = CreateContent(300 * 1024);
+    Cesium::IOContent compressed = Compress(content, MAX_WBITS + 16);
+
+    auto decoder = Cesium::HttpContentDecoder::Create("gzip");
+    ASSERT_NE(decoder, nullptr);
+
+    Cesium::IOContent output;
+    for (std::size_t offset = 0; offset < compressed.size(); offset += 1000)
+    {
+        std::size_t chunkSize = std::min<std::size_t>(1000, compressed.size() - offset);
+        ASSERT_TRUE(decoder->Decode(compressed.data() + offset, chunkSize, output));
+    }
+
+    ASSERT_TRUE(decoder->IsFinished());
+    ASSERT_EQ(output, content);
+}
+
+TEST_F(HttpContentDecoderTest, ReservedOutputIsNotReallocated)
+{
+    Cesium::IOContent content = CreateContent(100 * 1024);
+    Cesium::IOContent compressed = Compress(content, MAX_WBITS);
+
+    auto decoder = Cesium::HttpContentDecoder::Create(" deflate ");
+    ASSERT_NE(decoder, nullptr);
+
+    Cesium::IOContent output;
+    output.reserve(content.size());
+    const std::byte* reserved = output.data();
+    ASSERT_TRUE(decoder->Decode(compressed.data(), compressed.size(), output));
+    ASSERT_TRUE(decoder->IsFinished());
+    ASSERT_EQ(output, content);
+    ASSERT_EQ(output.data(), reserved);
+}
+
+TEST_F(HttpContentDecoderTest, RawDeflateIsDecoded)
+{
+    Cesium::IOContent content = CreateContent(100 * 1024);
+    Cesium::IOContent compressed = Compress(content, -MAX_WBITS);
+
+    // the header is split over two calls, so the format is only detected on the second one
+    auto decoder = Cesium::HttpContentDecoder::Create("deflate");
+    Cesium::IOContent output;
+    ASSERT_TRUE(decoder->Decode(compressed.data(), 1, output));
+    ASSERT_TRUE(decoder->Decode(compressed.data() + 1, compressed.size() - 1, output));
+    ASSERT_TRUE(decoder->IsFinished());
+    ASSERT_EQ(output, content);
+
+    // gzip bodies sent as deflate are still recognized
+    Cesium::IOContent gzipped = Compress(content, MAX_WBITS + 16);
+    ASSERT_TRUE(Cesium::HttpContentDecoder::DecodeContent("deflate", gzipped));
+    ASSERT_EQ(gzipped, content);
+}
+
+TEST_F(HttpContentDecoderTest, InvalidContentIsRejected)
+{
+    Cesium::IOContent content = CreateContent(1024);
+    ASSERT_FALSE(Cesium::HttpContentDecoder::DecodeContent("gzip", content));
+    ASSERT_EQ(content, CreateContent(1024));
+
+    // a body that ends early is not complete
+    Cesium::IOContent truncated = Compress(CreateContent(64 * 1024), MAX_WBITS + 16);
+    truncated.resize(truncated.size() / 2);
+    ASSERT_FALSE(Cesium::HttpContentDecoder::DecodeContent("gzip", truncated));
+}
+
+TEST_F(HttpContentDecoderTest, OnlySupportedEncodingsHaveDecoders)
+{
+    ASSERT_EQ(Cesium::HttpContentDecoder::Create("identity"), nullptr);
+    ASSERT_EQ(Cesium::HttpContentDecoder::Create("compress"), nullptr);
+    ASSERT_NE(Cesium::HttpContentDecoder::Create("x-gzip"), nullptr);
+
+    std::string acceptEncoding = Cesium::HttpContentDecoder::GetAcceptEncoding();
+    ASSERT_NE(acceptEncoding.find("gzip"), std::string::npos);
+
+    Cesium::IOContent content = CreateContent(1024);
+    ASSERT_TRUE(Cesium::HttpContentDecoder::DecodeContent("identity", content));
+    ASSERT_EQ(content, CreateContent(1024));
+}
+
+TEST_F(HttpContentDecoderTest, BodyStreamKeepsDecodedContent)
+{
+    Cesium::IOContent content = CreateContent(200 * 1024);
+    Cesium::IOContent compressed = Compress(content, MAX_WBITS + 16);
+
+    Cesium::HttpResponseBodyStream stream;
+    stream.GetBuffer().SetDecoder(Cesium::HttpContentDecoder::Create("gzip"));
+    stream.GetBuffer().Reserve(compressed.size());
+    stream.write(reinterpret_cast<const char*>(compressed.data()), compressed.size());
+
+    ASSERT_FALSE(stream.GetBuffer().HasDecodingFailed());
+    ASSERT_EQ(stream.GetBuffer().TakeContent(), content);
+}
+
+TEST_F(HttpContentDecoderTest, BodyStreamDetectsTruncatedContent)
+{
+    Cesium::IOContent compressed = Compress(CreateContent(200 * 1024), MAX_WBITS + 16);
+
+    Cesium::HttpResponseBodyStream stream;
+    stream.GetBuffer().SetDecoder(Cesium::HttpContentDecoder::Create("gzip"));
+    ASSERT_TRUE(stream.GetBuffer().IsDecodingFinished());
+
+    stream.write(reinterpret_cast<const char*>(compressed.data()), compressed.size() / 2);
+    ASSERT_FALSE(stream.GetBuffer().HasDecodingFailed());
+    ASSERT_FALSE(stream.GetBuffer().IsDecodingFinished());
+
+    stream.write(reinterpret_cast<const char*>(compressed.data() + compressed.size() / 2), compressed.size() - compressed.size() / 2);
+    ASSERT_TRUE(stream.GetBuffer().IsDecodingFinished());
+}
@@ -1,6 +1,87 @@
+#include "Cesium/Systems/HttpAssetAccessor.h"
 #include "Cesium/Systems/HttpManager.h"
+#include "LoopbackHttpServer.h"
 #include <AzCore/Memory/PoolAllocator.h>
 #include <AzCore/UnitTest/TestTypes.h>
+#include <aws/core/http/HttpClientFactory.h>
+#include <aws/core/http/HttpRequest.h>
+#include <aws/core/http/standard/StandardHttpResponse.h>
+#include <aws/core/utils/stream/ResponseStream.h>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#if defined(HAVE_BENCHMARK)
+#include <benchmark/benchmark.h>
+#endif
+
+namespace
+{
+    // records the requests instead of sending them, so the test decides when each of them completes
+    class RecordingHttpClientBackend final : public Cesium::HttpClientBackend
+    {
+    public:
+        RecordingHttpClientBackend(std::vector<std::string>& sentUrls, std::vector<CompletionCallback>& completions)
+            : m_sentUrls{ sentUrls }
+            , m_completions{ completions }
+        {
+        }
+
+        std::uint32_t GetMaxActiveRequests() const override
+        {
+            return 2;
+        }
+
+        std::uint32_t GetMaxActiveRequestsPerHost() const override
+        {
+            return 1;
+        }
+
+        void Send(const std::shared_ptr<Aws::Http::HttpRequest>& request, CompletionCallback onComplete) override
+        {
+            m_sentUrls.emplace_back(request->GetURIString().c_str());
+            m_completions.emplace_back(std::move(onComplete));
+        }
+
+    private:
+        std::vector<std::string>& m_sentUrls;
+        std::vector<CompletionCallback>& m_completions;
+    };
+
+    // fails every request as soon as it is sent
+    class FailingHttpClientBackend final : public Cesium::HttpClientBackend
+    {
+    public:
+        explicit FailingHttpClientBackend(std::vector<std::string>& sentUrls)
+            : m_sentUrls{ sentUrls }
+        {
+        }
+
+        std::uint32_t GetMaxActiveRequests() const override
+        {
+            return 1;
+        }
+
+        std::uint32_t GetMaxActiveRequestsPerHost() const override
+        {
+            return 1;
+        }
+
+        void Send(const std::shared_ptr<Aws::Http::HttpRequest>& request, CompletionCallback onComplete) override
+        {
+            m_sentUrls.emplace_back(request->GetURIString().c_str());
+            onComplete(nullptr);
+        }
+
+    private:
+        std::vector<std::string>& m_sentUrls;
+    };
+} // namespace
 
 class HttpManagerTest : public UnitTest::AllocatorsTestFixture
 {
@@ -10,14 +91,20 @@ public:
         UnitTest::AllocatorsTestFixture::SetUp();
         AZ::AllocatorInstance<AZ::PoolAllocator>::Create();
         AZ::AllocatorInstance<AZ::ThreadPoolAllocator>::Create();
+
+        m_server.AddContent("/ip", R"({ "origin": "127.0.0.1" })", "application/json");
+        ASSERT_TRUE(m_server.Start());
     }
 
     void TearDown() override
     {
+        m_server.Stop();
         AZ::AllocatorInstance<AZ::ThreadPoolAllocator>::Destroy();
         AZ::AllocatorInstance<AZ::PoolAllocator>::Destroy();
         UnitTest::AllocatorsTestFixture::TearDown();
     }
+
+    LoopbackHttpServer m_server;
 };
 
 TEST_F(HttpManagerTest, AddValidRequest)
@@ -26,7 +113,7 @@ TEST_F(HttpManagerTest, AddValidRequest)
     CesiumAsync::AsyncSystem asyncSystem{ nullptr };
     Cesium::HttpManager httpManager;
 
-    Cesium::HttpRequestParameter parameter("https://httpbin.org/ip", Aws::Http::HttpMethod::HTTP_GET);
+    Cesium::HttpRequestParameter parameter(m_server.GetUrl("/ip").c_str(), Aws::Http::HttpMethod::HTTP_GET);
     auto completedRequestFuture = httpManager.AddRequest(asyncSystem, std::move(parameter));
     auto completedRequest = completedRequestFuture.wait();
 
@@ -52,7 +139,7 @@ TEST_F(HttpManagerTest, GetFileContent)
 {
     // we don't care about io thread in this test
     Cesium::HttpManager httpManager;
-    Cesium::IOContent content = httpManager.GetFileContent(Cesium::IORequestParameter{ "", "https://httpbin.org/ip" });
+    Cesium::IOContent content = httpManager.GetFileContent(Cesium::IORequestParameter{ "", m_server.GetUrl("/ip").c_str() });
     ASSERT_FALSE(content.empty());
 }
 
@@ -62,9 +149,444 @@ TEST_F(HttpManagerTest, GetFileContentAsync)
     CesiumAsync::AsyncSystem asyncSystem{ nullptr };
     Cesium::HttpManager httpManager;
 
-    Cesium::IORequestParameter parameter{ "", "https://httpbin.org/ip" };
+    Cesium::IORequestParameter parameter{ "", m_server.GetUrl("/ip").c_str() };
     auto contentFuture = httpManager.GetFileContentAsync(asyncSystem, parameter);
     auto content = contentFuture.wait();
 
     ASSERT_FALSE(content.empty());
 }
+
+TEST_F(HttpManagerTest, CancelledRequestIsNotSent)
+{
+    // we don't care about worker thread in this test
+    CesiumAsync::AsyncSystem asyncSystem{ nullptr };
+    Cesium::HttpManager httpManager;
+
+    Cesium::HttpCancellationToken cancellationToken;
+    cancellationToken.Cancel();
+
+    Cesium::HttpRequestParameter parameter(m_server.GetUrl("/ip").c_str(), Aws::Http::HttpMethod::HTTP_GET);
+    parameter.m_continueRequest = [cancellationToken]()
+    {
+        return !cancellationToken.IsCancelled();
+    };
+
+    auto completedRequest = httpManager.AddRequest(asyncSystem, std::move(parameter)).wait();
+    ASSERT_NE(completedRequest.m_request, nullptr);
+    ASSERT_EQ(completedRequest.m_response, nullptr);
+}
+
+TEST_F(HttpManagerTest, CancellationTokenIsShared)
+{
+    Cesium::HttpCancellationToken cancellationToken;
+    Cesium::HttpCancellationToken copiedToken = cancellationToken;
+    Cesium::HttpCancellationToken otherToken;
+    ASSERT_FALSE(copiedToken.IsCancelled());
+
+    cancellationToken.Cancel();
+    ASSERT_TRUE(copiedToken.IsCancelled());
+    ASSERT_FALSE(otherToken.IsCancelled());
+}
+
+TEST_F(HttpManagerTest, BackendSendsRequestsByLaneAndHost)
+{
+    // we don't care about worker thread in this test
+    CesiumAsync::AsyncSystem asyncSystem{ nullptr };
+    std::vector<std::string> sentUrls;
+    std::vector<Cesium::HttpClientBackend::CompletionCallback> completions;
+    Cesium::HttpManager httpManager(AZStd::make_unique<RecordingHttpClientBackend>(sentUrls, completions));
+
+    std::vector<CesiumAsync::Future<Cesium::HttpResult>> futures;
+    futures.emplace_back(httpManager.AddRequest(asyncSystem, { "https://a.org/tile1", Aws::Http::HttpMethod::HTTP_GET }));
+    futures.emplace_back(httpManager.AddRequest(asyncSystem, { "https://a.org/tile2", Aws::Http::HttpMethod::HTTP_GET }));
+
+    Cesium::HttpRequestParameter metadata("https://a.org/tileset.json", Aws::Http::HttpMethod::HTTP_GET);
+    metadata.m_priority = Cesium::HttpRequestPriority::Metadata;
+    futures.emplace_back(httpManager.AddRequest(asyncSystem, std::move(metadata)));
+    futures.emplace_back(httpManager.AddRequest(asyncSystem, { "https://b.org/tile1", Aws::Http::HttpMethod::HTTP_GET }));
+
+    // a.org already has a request in flight, so only b.org is sent next to it
+    ASSERT_EQ(sentUrls.size(), 2u);
+    ASSERT_EQ(sentUrls[0], "https://a.org/tile1");
+    ASSERT_EQ(sentUrls[1], "https://b.org/tile1");
+
+    // once a.org is free again, the metadata lane goes before the tile that was added earlier
+    auto completion = std::move(completions[0]);
+    completion(nullptr);
+    ASSERT_EQ(sentUrls.size(), 3u);
+    ASSERT_EQ(sentUrls[2], "https://a.org/tileset.json");
+
+    for (std::size_t i = 1; i < completions.size(); ++i)
+    {
+        completion = std::move(completions[i]);
+        completion(nullptr);
+    }
+
+    ASSERT_EQ(sentUrls.size(), 4u);
+    ASSERT_EQ(sentUrls[3], "https://a.org/tile2");
+}
+
+TEST_F(HttpManagerTest, PendingRequestIsCancelledOnTick)
+{
+    // we don't care about worker thread in this test
+    CesiumAsync::AsyncSystem asyncSystem{ nullptr };
+    std::vector<std::string> sentUrls;
+    std::vector<Cesium::HttpClientBackend::CompletionCallback> completions;
+    Cesium::HttpManager httpManager(AZStd::make_unique<RecordingHttpClientBackend>(sentUrls, completions));
+
+    Cesium::HttpCancellationToken cancellationToken;
+    Cesium::HttpRequestParameter parameter("https://a.org/tile2", Aws::Http::HttpMethod::HTTP_GET);
+    parameter.m_continueRequest = [cancellationToken]()
+    {
+        return !cancellationToken.IsCancelled();
+    };
+
+    auto sentRequestFuture = httpManager.AddRequest(asyncSystem, { "https://a.org/tile1", Aws::Http::HttpMethod::HTTP_GET });
+    auto cancelledRequestFuture = httpManager.AddRequest(asyncSystem, std::move(parameter));
+    ASSERT_EQ(sentUrls.size(), 1u);
+
+    // a.org is still busy, so the cancelled request is only completed by the tick
+    cancellationToken.Cancel();
+    httpManager.Tick();
+    auto cancelledRequest = cancelledRequestFuture.wait();
+    ASSERT_NE(cancelledRequest.m_request, nullptr);
+    ASSERT_EQ(cancelledRequest.m_response, nullptr);
+
+    auto completion = std::move(completions[0]);
+    completion(nullptr);
+    sentRequestFuture.wait();
+    ASSERT_EQ(sentUrls.size(), 1u);
+}
+
+TEST_F(HttpManagerTest, PendingRequestsAreOnlySweptAfterATokenIsCancelled)
+{
+    // we don't care about worker thread in this test
+    CesiumAsync::AsyncSystem asyncSystem{ nullptr };
+    std::vector<std::string> sentUrls;
+    std::vector<Cesium::HttpClientBackend::CompletionCallback> completions;
+    Cesium::HttpManager httpManager(AZStd::make_unique<RecordingHttpClientBackend>(sentUrls, completions));
+    httpManager.Tick();
+
+    std::atomic<bool> continueRequest{ true };
+    std::atomic<std::uint32_t> checkCount{ 0 };
+    Cesium::HttpRequestParameter parameter("https://a.org/tile2", Aws::Http::HttpMethod::HTTP_GET);
+    parameter.m_continueRequest = [&continueRequest, &checkCount]()
+    {
+        ++checkCount;
+        return continueRequest.load();
+    };
+
+    auto sentRequestFuture = httpManager.AddRequest(asyncSystem, { "https://a.org/tile1", Aws::Http::HttpMethod::HTTP_GET });
+    auto pendingRequestFuture = httpManager.AddRequest(asyncSystem, std::move(parameter));
+    ASSERT_EQ(sentUrls.size(), 1u);
+
+    // without a cancelled token, ticks don't look at the pending requests
+    continueRequest = false;
+    httpManager.Tick();
+    httpManager.Tick();
+    ASSERT_EQ(checkCount.load(), 0u);
+
+    Cesium::HttpCancellationToken cancellationToken;
+    cancellationToken.Cancel();
+    httpManager.Tick();
+    ASSERT_EQ(checkCount.load(), 1u);
+    auto cancelledRequest = pendingRequestFuture.wait();
+    ASSERT_EQ(cancelledRequest.m_response, nullptr);
+
+    auto completion = std::move(completions[0]);
+    completion(nullptr);
+    sentRequestFuture.wait();
+    ASSERT_EQ(sentUrls.size(), 1u);
+}
+
+TEST_F(HttpManagerTest, GetFileContentUsesBackend)
+{
+    std::vector<std::string> sentUrls;
+    Cesium::HttpManager httpManager(AZStd::make_unique<FailingHttpClientBackend>(sentUrls));
+
+    Cesium::IOContent content = httpManager.GetFileContent(Cesium::IORequestParameter{ "https://a.org/model/", "buffer.bin" });
+    ASSERT_TRUE(content.empty());
+    ASSERT_EQ(sentUrls.size(), 1u);
+    ASSERT_EQ(sentUrls[0], "https://a.org/model/buffer.bin");
+}
+
+TEST_F(HttpManagerTest, TransientFailureIsRetried)
+{
+    // we don't care about worker thread in this test
+    CesiumAsync::AsyncSystem asyncSystem{ nullptr };
+    std::vector<std::string> sentUrls;
+    std::vector<Cesium::HttpClientBackend::CompletionCallback> completions;
+    Cesium::HttpClientConfiguration configuration;
+    configuration.m_maxRetries = 1;
+    configuration.m_retryBaseDelayMs = 0;
+    Cesium::HttpManager httpManager(AZStd::make_unique<RecordingHttpClientBackend>(sentUrls, completions), configuration);
+
+    Cesium::HttpRequestParameter parameter("https://a.org/tile1", Aws::Http::HttpMethod::HTTP_GET);
+    parameter.m_retryable = true;
+    auto completedRequestFuture = httpManager.AddRequest(asyncSystem, std::move(parameter));
+
+    // the first 503 is retried right away, since there is no backoff in this configuration
+    ASSERT_EQ(sentUrls.size(), 1u);
+    auto unavailableResponse = [](const std::string& url)
+    {
+        auto request = Aws::Http::CreateHttpRequest(
+            Aws::String(url.c_str()), Aws::Http::HttpMethod::HTTP_GET, Aws::Utils::Stream::DefaultResponseStreamFactoryMethod);
+        auto response = std::make_shared<Aws::Http::Standard::StandardHttpResponse>(request);
+        response->SetResponseCode(Aws::Http::HttpResponseCode::SERVICE_UNAVAILABLE);
+        return response;
+    };
+
+    auto completion = std::move(completions[0]);
+    completion(unavailableResponse(sentUrls[0]));
+    ASSERT_EQ(sentUrls.size(), 2u);
+    ASSERT_EQ(sentUrls[1], "https://a.org/tile1");
+
+    // and the second one goes back to the caller once the retries are used up
+    completion = std::move(completions[1]);
+    completion(unavailableResponse(sentUrls[1]));
+    ASSERT_EQ(sentUrls.size(), 2u);
+
+    auto completedRequest = completedRequestFuture.wait();
+    ASSERT_NE(completedRequest.m_response, nullptr);
+    ASSERT_EQ(completedRequest.m_response->GetResponseCode(), Aws::Http::HttpResponseCode::SERVICE_UNAVAILABLE);
+}
+
+TEST_F(HttpManagerTest, DelayedRetryIsSentOnTick)
+{
+    // we don't care about worker thread in this test
+    CesiumAsync::AsyncSystem asyncSystem{ nullptr };
+    std::vector<std::string> sentUrls;
+    std::vector<Cesium::HttpClientBackend::CompletionCallback> completions;
+    Cesium::HttpClientConfiguration configuration;
+    configuration.m_maxRetries = 1;
+    configuration.m_retryMaxDelayMs = 20;
+    Cesium::HttpManager httpManager(AZStd::make_unique<RecordingHttpClientBackend>(sentUrls, completions), configuration);
+
+    Cesium::HttpRequestParameter parameter("https://a.org/tile1", Aws::Http::HttpMethod::HTTP_GET);
+    parameter.m_retryable = true;
+    auto completedRequestFuture = httpManager.AddRequest(asyncSystem, std::move(parameter));
+
+    auto request = Aws::Http::CreateHttpRequest(
+        Aws::String("https://a.org/tile1"), Aws::Http::HttpMethod::HTTP_GET, Aws::Utils::Stream::DefaultResponseStreamFactoryMethod);
+    auto response = std::make_shared<Aws::Http::Standard::StandardHttpResponse>(request);
+    response->SetResponseCode(Aws::Http::HttpResponseCode::TOO_MANY_REQUESTS);
+    response->AddHeader("Retry-After", "1");
+
+    // the retry waits for its backoff, and nothing else finishes meanwhile, so the tick is what sends it
+    auto completion = std::move(completions[0]);
+    completion(response);
+    ASSERT_EQ(sentUrls.size(), 1u);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    httpManager.Tick();
+    ASSERT_EQ(sentUrls.size(), 2u);
+
+    completion = std::move(completions[1]);
+    completion(nullptr);
+    completedRequestFuture.wait();
+}
+
+TEST_F(HttpManagerTest, GzippedContentIsDecoded)
+{
+    LoopbackHttpServerOptions options;
+    options.m_gzip = true;
+    LoopbackHttpServer gzipServer(options);
+    std::string body(16 * 1024, 'a');
+    gzipServer.AddContent("/tileset.json", body, "application/json");
+    ASSERT_TRUE(gzipServer.Start());
+
+    Cesium::HttpManager httpManager;
+    Cesium::IOContent content = httpManager.GetFileContent(Cesium::IORequestParameter{ "", gzipServer.GetUrl("/tileset.json").c_str() });
+    ASSERT_EQ(content.size(), body.size());
+    ASSERT_EQ(std::string(reinterpret_cast<const char*>(content.data()), content.size()), body);
+}
+
+TEST_F(HttpManagerTest, ServerFailureIsRetried)
+{
+    // we don't care about worker thread in this test
+    CesiumAsync::AsyncSystem asyncSystem{ nullptr };
+    LoopbackHttpServerOptions options;
+    options.m_failEveryNthRequest = 2;
+    LoopbackHttpServer failingServer(options);
+    failingServer.AddContent("/tile1", "tile1");
+    failingServer.AddContent("/tile2", "tile2");
+    ASSERT_TRUE(failingServer.Start());
+
+    Cesium::HttpClientConfiguration configuration;
+    configuration.m_maxRetries = 1;
+    configuration.m_retryBaseDelayMs = 0;
+    Cesium::HttpManager httpManager(configuration);
+
+    Cesium::HttpRequestParameter firstParameter(failingServer.GetUrl("/tile1").c_str(), Aws::Http::HttpMethod::HTTP_GET);
+    firstParameter.m_retryable = true;
+    auto firstRequest = httpManager.AddRequest(asyncSystem, std::move(firstParameter)).wait();
+    ASSERT_EQ(firstRequest.m_response->GetResponseCode(), Aws::Http::HttpResponseCode::OK);
+
+    // the second request gets a 503 from the server, and the caller only sees the retry
+    Cesium::HttpRequestParameter secondParameter(failingServer.GetUrl("/tile2").c_str(), Aws::Http::HttpMethod::HTTP_GET);
+    secondParameter.m_retryable = true;
+    auto secondRequest = httpManager.AddRequest(asyncSystem, std::move(secondParameter)).wait();
+    ASSERT_EQ(secondRequest.m_response->GetResponseCode(), Aws::Http::HttpResponseCode::OK);
+    ASSERT_EQ(failingServer.GetRequestCount(), 3u);
+}
+
+#if defined(HAVE_BENCHMARK)
+// serves synthetic tiles from a loopback server, so that the benchmarks measure HttpManager and HttpAssetAccessor rather than the network.
+// The arguments are the number of requests in flight, the tile size in KB and whether the tiles are gzipped
+class HttpManagerBenchmark : public UnitTest::AllocatorsBenchmarkFixture
+{
+public:
+    static constexpr std::size_t TILE_COUNT = 64;
+
+    void SetUp(const benchmark::State& state) override
+    {
+        UnitTest::AllocatorsBenchmarkFixture::SetUp(state);
+        SetUpServer(state);
+    }
+
+    void SetUp(benchmark::State& state) override
+    {
+        UnitTest::AllocatorsBenchmarkFixture::SetUp(state);
+        SetUpServer(state);
+    }
+
+    void TearDown(const benchmark::State& state) override
+    {
+        TearDownServer();
+        UnitTest::AllocatorsBenchmarkFixture::TearDown(state);
+    }
+
+    void TearDown(benchmark::State& state) override
+    {
+        TearDownServer();
+        UnitTest::AllocatorsBenchmarkFixture::TearDown(state);
+    }
+
+    static void ApplyArguments(benchmark::internal::Benchmark* benchmark)
+    {
+        benchmark->ArgNames({ "requests", "kb", "gzip" });
+        for (std::int64_t requestCount : { 1, 4, 16, 64 })
+        {
+            for (std::int64_t tileSizeKB : { 16, 256 })
+            {
+                for (std::int64_t gzip : { 0, 1 })
+                {
+                    benchmark->Args({ requestCount, tileSizeKB, gzip });
+                }
+            }
+        }
+    }
+
+    std::string GetTileUrl(std::size_t tile) const
+    {
+        return m_server->GetUrl("/tiles/" + std::to_string(tile % TILE_COUNT) + ".b3dm");
+    }
+
+    std::size_t GetTileSize() const
+    {
+        return m_tileSize;
+    }
+
+private:
+    void SetUpServer(const benchmark::State& state)
+    {
+        AZ::AllocatorInstance<AZ::PoolAllocator>::Create();
+        AZ::AllocatorInstance<AZ::ThreadPoolAllocator>::Create();
+
+        LoopbackHttpServerOptions options;
+        options.m_gzip = state.range(2) != 0;
+        m_tileSize = static_cast<std::size_t>(state.range(1)) * 1024;
+        m_server = std::make_unique<LoopbackHttpServer>(options);
+
+        // a small alphabet in a pseudo random order compresses about as well as tile content does, unlike a repeated byte
+        std::uint32_t seed = 1;
+        for (std::size_t i = 0; i < TILE_COUNT; ++i)
+        {
+            std::string tile(m_tileSize, '\0');
+            for (char& c : tile)
+            {
+                seed = seed * 1664525u + 1013904223u;
+                c = static_cast<char>('a' + (seed >> 24) % 16);
+            }
+
+            m_server->AddContent("/tiles/" + std::to_string(i) + ".b3dm", tile);
+        }
+
+        m_server->Start();
+    }
+
+    void TearDownServer()
+    {
+        m_server.reset();
+        AZ::AllocatorInstance<AZ::ThreadPoolAllocator>::Destroy();
+        AZ::AllocatorInstance<AZ::PoolAllocator>::Destroy();
+    }
+
+    std::unique_ptr<LoopbackHttpServer> m_server;
+    std::size_t m_tileSize{ 0 };
+};
+
+BENCHMARK_DEFINE_F(HttpManagerBenchmark, AddRequest)(benchmark::State& state)
+{
+    // we don't care about worker thread in this benchmark
+    CesiumAsync::AsyncSystem asyncSystem{ nullptr };
+    Cesium::HttpManager httpManager;
+    std::size_t requestCount = static_cast<std::size_t>(state.range(0));
+    std::size_t nextTile = 0;
+    for ([[maybe_unused]] auto _ : state)
+    {
+        std::vector<CesiumAsync::Future<Cesium::HttpResult>> futures;
+        futures.reserve(requestCount);
+        for (std::size_t i = 0; i < requestCount; ++i)
+        {
+            futures.emplace_back(httpManager.AddRequest(asyncSystem, { GetTileUrl(nextTile++).c_str(), Aws::Http::HttpMethod::HTTP_GET }));
+        }
+
+        for (auto& future : futures)
+        {
+            Cesium::HttpResult result = future.wait();
+            benchmark::DoNotOptimize(result.m_response);
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * requestCount);
+    state.SetBytesProcessed(state.iterations() * requestCount * GetTileSize());
+}
+
+BENCHMARK_DEFINE_F(HttpManagerBenchmark, RequestAsset)(benchmark::State& state)
+{
+    // we don't care about worker thread in this benchmark
+    CesiumAsync::AsyncSystem asyncSystem{ nullptr };
+    Cesium::HttpManager httpManager;
+    Cesium::HttpAssetAccessor accessor(&httpManager);
+    std::size_t requestCount = static_cast<std::size_t>(state.range(0));
+    std::size_t nextTile = 0;
+    for ([[maybe_unused]] auto _ : state)
+    {
+        std::vector<CesiumAsync::Future<std::shared_ptr<CesiumAsync::IAssetRequest>>> futures;
+        futures.reserve(requestCount);
+        for (std::size_t i = 0; i < requestCount; ++i)
+        {
+            futures.emplace_back(accessor.requestAsset(asyncSystem, GetTileUrl(nextTile++)));
+        }
+
+        for (auto& future : futures)
+        {
+            std::shared_ptr<CesiumAsync::IAssetRequest> request = future.wait();
+            benchmark::DoNotOptimize(request);
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * requestCount);
+    state.SetBytesProcessed(state.iterations() * requestCount * GetTileSize());
+}
+
+BENCHMARK_REGISTER_F(HttpManagerBenchmark, AddRequest)
+    ->Apply(HttpManagerBenchmark::ApplyArguments)
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_REGISTER_F(HttpManagerBenchmark, RequestAsset)
+    ->Apply(HttpManagerBenchmark::ApplyArguments)
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+#endif
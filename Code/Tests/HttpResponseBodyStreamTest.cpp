@@ -0,0 +1,60 @@
+#include "Cesium/Systems/HttpResponseBodyStream.h"
+#include <AzCore/UnitTest/TestTypes.h>
+#include <sstream>
+#include <string>
+
+class HttpResponseBodyStreamTest : public UnitTest::AllocatorsTestFixture
+{
+};
+
+TEST_F(HttpResponseBodyStreamTest, ContentIsTakenWithItsExactSize)
+{
+    Cesium::HttpResponseBodyStream stream;
+    stream.GetBuffer().Reserve(1024);
+
+    std::string body(700, 'a');
+    for (std::size_t i = 0; i < body.size(); ++i)
+    {
+        body[i] = static_cast<char>('a' + i % 26);
+    }
+
+    stream.write(body.data(), 300);
+    stream << 'Z';
+    stream.write(body.data() + 300, 400);
+    ASSERT_EQ(static_cast<std::streamoff>(stream.tellp()), 701);
+
+    Cesium::IOContent content = stream.GetBuffer().TakeContent();
+    ASSERT_EQ(content.size(), 701);
+    ASSERT_EQ(static_cast<char>(content[0]), 'a');
+    ASSERT_EQ(static_cast<char>(content[300]), 'Z');
+    ASSERT_EQ(static_cast<char>(content[700]), body[699]);
+    ASSERT_TRUE(stream.GetBuffer().TakeContent().empty());
+}
+
+TEST_F(HttpResponseBodyStreamTest, ContentCanBeReadWhileItIsWritten)
+{
+    Cesium::HttpResponseBodyStream stream;
+    stream.write("0123456789", 10);
+
+    char read[4] = {};
+    stream.read(read, 4);
+    ASSERT_EQ(std::string(read, 4), "0123");
+
+    // growing the content must not invalidate the read position
+    std::string more(4096, 'x');
+    stream.write(more.data(), more.size());
+    stream.read(read, 4);
+    ASSERT_EQ(std::string(read, 4), "4567");
+
+    stream.seekg(0, std::ios_base::end);
+    ASSERT_EQ(static_cast<std::streamoff>(stream.tellg()), 10 + 4096);
+}
+
+TEST_F(HttpResponseBodyStreamTest, OnlyBodyStreamsAreRecognized)
+{
+    Cesium::HttpResponseBodyStream stream;
+    ASSERT_EQ(Cesium::HttpResponseBodyStream::FromStream(stream), &stream);
+
+    std::stringstream otherStream;
+    ASSERT_EQ(Cesium::HttpResponseBodyStream::FromStream(otherStream), nullptr);
+}
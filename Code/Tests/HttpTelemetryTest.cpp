@@ -0,0 +1,78 @@
+#include "Cesium/Systems/HttpTelemetry.h"
+#include <AzCore/UnitTest/TestTypes.h>
+
+class HttpTelemetryTest : public UnitTest::AllocatorsTestFixture
+{
+public:
+    static Cesium::HttpRequestMetrics CreateMetrics(int responseCode, std::chrono::milliseconds totalTime)
+    {
+        Cesium::HttpRequestMetrics metrics;
+        metrics.m_responseCode = responseCode;
+        metrics.m_retried = false;
+        metrics.m_bytesReceived = 100;
+        metrics.m_bytesDecoded = 400;
+        metrics.m_timeToFirstByte = totalTime / 2;
+        metrics.m_totalTime = totalTime;
+        return metrics;
+    }
+};
+
+TEST_F(HttpTelemetryTest, HistogramPercentiles)
+{
+    Cesium::HttpLatencyHistogram histogram;
+    ASSERT_EQ(histogram.GetPercentileMs(0.5), 0u);
+
+    for (int i = 0; i < 90; ++i)
+    {
+        histogram.Record(std::chrono::milliseconds(20));
+    }
+
+    for (int i = 0; i < 10; ++i)
+    {
+        histogram.Record(std::chrono::milliseconds(20000));
+    }
+
+    ASSERT_EQ(histogram.GetCount(), 100u);
+    ASSERT_EQ(histogram.GetPercentileMs(0.5), 25u);
+    ASSERT_EQ(histogram.GetPercentileMs(0.9), 25u);
+    ASSERT_EQ(histogram.GetPercentileMs(0.95), 10000u);
+    ASSERT_EQ(histogram.GetBucketCounts().back(), 10u);
+    ASSERT_DOUBLE_EQ(histogram.GetMeanMs(), 2018.0);
+}
+
+TEST_F(HttpTelemetryTest, StatisticsAreKeptPerHost)
+{
+    Cesium::HttpTelemetry telemetry;
+    telemetry.RecordRequestStarted("b.org", 1);
+    telemetry.RecordRequestStarted("a.org", 1);
+    telemetry.RecordRequestStarted("a.org", 2);
+    telemetry.RecordRequestCompleted("a.org", CreateMetrics(200, std::chrono::milliseconds(40)));
+    telemetry.RecordRequestCompleted("a.org", CreateMetrics(503, std::chrono::milliseconds(40)));
+
+    Cesium::HttpRequestMetrics failedMetrics = CreateMetrics(-1, std::chrono::milliseconds(10));
+    failedMetrics.m_bytesReceived = 0;
+    failedMetrics.m_bytesDecoded = 0;
+    failedMetrics.m_timeToFirstByte.reset();
+    telemetry.RecordRequestCompleted("b.org", failedMetrics);
+
+    auto hosts = telemetry.GetHostStatistics();
+    ASSERT_EQ(hosts.size(), 2u);
+
+    const Cesium::HttpHostStatistics& a = hosts[0];
+    ASSERT_EQ(a.m_host, "a.org");
+    ASSERT_EQ(a.m_requestCount, 2u);
+    ASSERT_EQ(a.m_bytesReceived, 200u);
+    ASSERT_EQ(a.m_bytesDecoded, 800u);
+    ASSERT_EQ(a.m_peakActiveRequestCount, 2u);
+    ASSERT_EQ(a.m_timeToFirstByte.GetCount(), 2u);
+    ASSERT_EQ(a.m_responseCodeCounts.at(200), 1u);
+    ASSERT_EQ(a.m_responseCodeCounts.at(503), 1u);
+
+    // requests without a body have no time to first byte
+    const Cesium::HttpHostStatistics& b = hosts[1];
+    ASSERT_EQ(b.m_host, "b.org");
+    ASSERT_EQ(b.m_requestCount, 1u);
+    ASSERT_EQ(b.m_timeToFirstByte.GetCount(), 0u);
+    ASSERT_EQ(b.m_totalTime.GetCount(), 1u);
+    ASSERT_EQ(b.m_responseCodeCounts.at(-1), 1u);
+}
@@ -0,0 +1,157 @@
+#include "Cesium/Gltf/ImageDecoder.h"
+#include <AzCore/UnitTest/TestTypes.h>
+#include <AzCore/std/smart_ptr/make_shared.h>
+#include <CesiumGltf/ImageCesium.h>
+
+namespace
+{
+    // decodes any data that starts with its tag into a solid image
+    class FakeImageDecoder final : public Cesium::ImageDecoder
+    {
+    public:
+        FakeImageDecoder(std::byte tag, std::int32_t size, std::int32_t channels, bool succeed, AZStd::shared_ptr<int> decodeCount)
+            : m_tag{ tag }
+            , m_size{ size }
+            , m_channels{ channels }
+            , m_succeed{ succeed }
+            , m_decodeCount{ std::move(decodeCount) }
+        {
+        }
+
+        bool CanDecode(gsl::span<const std::byte> data) const override
+        {
+            return !data.empty() && data[0] == m_tag;
+        }
+
+        bool Decode(
+            [[maybe_unused]] gsl::span<const std::byte> data,
+            [[maybe_unused]] const Cesium::ImageDecodeOption& option,
+            CesiumGltf::ImageCesium& image) const override
+        {
+            ++*m_decodeCount;
+            image.width = m_size;
+            image.height = m_size;
+            image.channels = m_channels;
+            image.bytesPerChannel = 1;
+            image.pixelData.assign(static_cast<std::size_t>(m_size) * m_size * m_channels, std::byte{ 200 });
+            return m_succeed;
+        }
+
+    private:
+        std::byte m_tag;
+        std::int32_t m_size;
+        std::int32_t m_channels;
+        bool m_succeed;
+        AZStd::shared_ptr<int> m_decodeCount;
+    };
+} // namespace
+
+class ImageDecoderTest : public UnitTest::AllocatorsTestFixture
+{
+};
+
+TEST_F(ImageDecoderTest, HigherPriorityDecoderIsTriedFirst)
+{
+    auto lowCount = AZStd::make_shared<int>(0);
+    auto highCount = AZStd::make_shared<int>(0);
+    Cesium::ImageDecoderRegistry registry;
+    registry.AddDecoder(AZStd::make_unique<FakeImageDecoder>(std::byte{ 1 }, 4, 4, true, lowCount), 10);
+    registry.AddDecoder(AZStd::make_unique<FakeImageDecoder>(std::byte{ 1 }, 8, 4, true, highCount), 20);
+
+    std::byte data[] = { std::byte{ 1 }, std::byte{ 0 } };
+    CesiumGltf::ImageCesium image;
+    ASSERT_TRUE(registry.Decode(data, Cesium::ImageDecodeOption{}, image));
+    ASSERT_EQ(image.width, 8);
+    ASSERT_EQ(*highCount, 1);
+    ASSERT_EQ(*lowCount, 0);
+}
+
+TEST_F(ImageDecoderTest, FailedDecoderFallsBackToTheNextOne)
+{
+    auto failCount = AZStd::make_shared<int>(0);
+    auto fallbackCount = AZStd::make_shared<int>(0);
+    Cesium::ImageDecoderRegistry registry;
+    registry.AddDecoder(AZStd::make_unique<FakeImageDecoder>(std::byte{ 1 }, 8, 4, false, failCount), 20);
+    registry.AddDecoder(AZStd::make_unique<FakeImageDecoder>(std::byte{ 1 }, 4, 4, true, fallbackCount), 10);
+
+    std::byte data[] = { std::byte{ 1 }, std::byte{ 0 } };
+    CesiumGltf::ImageCesium image;
+    ASSERT_TRUE(registry.Decode(data, Cesium::ImageDecodeOption{}, image));
+    ASSERT_EQ(image.width, 4);
+    ASSERT_EQ(*failCount, 1);
+    ASSERT_EQ(*fallbackCount, 1);
+}
+
+TEST_F(ImageDecoderTest, DecoderOnlyDecodesDataItRecognizes)
+{
+    auto count = AZStd::make_shared<int>(0);
+    Cesium::ImageDecoderRegistry registry;
+    registry.AddDecoder(AZStd::make_unique<FakeImageDecoder>(std::byte{ 1 }, 4, 4, true, count), 10);
+
+    // not an image either, so the stb fallback fails as well
+    std::byte data[] = { std::byte{ 2 }, std::byte{ 0 }, std::byte{ 0 }, std::byte{ 0 } };
+    CesiumGltf::ImageCesium image;
+    ASSERT_FALSE(registry.Decode(data, Cesium::ImageDecodeOption{}, image));
+    ASSERT_EQ(*count, 0);
+}
+
+TEST_F(ImageDecoderTest, RGBImageIsExpandedToRGBA)
+{
+    auto count = AZStd::make_shared<int>(0);
+    Cesium::ImageDecoderRegistry registry;
+    registry.AddDecoder(AZStd::make_unique<FakeImageDecoder>(std::byte{ 1 }, 4, 3, true, count), 10);
+
+    std::byte data[] = { std::byte{ 1 } };
+    CesiumGltf::ImageCesium image;
+    ASSERT_TRUE(registry.Decode(data, Cesium::ImageDecodeOption{}, image));
+    ASSERT_EQ(image.channels, 4);
+    ASSERT_EQ(image.pixelData.size(), 4 * 4 * 4);
+    ASSERT_EQ(image.pixelData[0], std::byte{ 200 });
+    ASSERT_EQ(image.pixelData[3], std::byte{ 255 });
+}
+
+TEST_F(ImageDecoderTest, ImageIsReducedToTargetSize)
+{
+    auto count = AZStd::make_shared<int>(0);
+    Cesium::ImageDecoderRegistry registry;
+    registry.AddDecoder(AZStd::make_unique<FakeImageDecoder>(std::byte{ 1 }, 64, 4, true, count), 10);
+
+    Cesium::ImageDecodeOption option;
+    option.m_targetSize = 12;
+    std::byte data[] = { std::byte{ 1 } };
+    CesiumGltf::ImageCesium image;
+    ASSERT_TRUE(registry.Decode(data, option, image));
+    ASSERT_EQ(image.width, 16);
+    ASSERT_EQ(image.height, 16);
+    ASSERT_EQ(image.pixelData.size(), 16 * 16 * 4);
+    ASSERT_EQ(image.pixelData[0], std::byte{ 200 });
+}
+
+TEST_F(ImageDecoderTest, OtherLayoutsArePassedThrough)
+{
+    auto count = AZStd::make_shared<int>(0);
+    Cesium::ImageDecoderRegistry registry;
+    registry.AddDecoder(AZStd::make_unique<FakeImageDecoder>(std::byte{ 1 }, 64, 1, true, count), 10);
+
+    // single channel images are neither expanded nor reduced, so the image builders get them as the backend decoded them
+    Cesium::ImageDecodeOption option;
+    option.m_targetSize = 12;
+    std::byte data[] = { std::byte{ 1 } };
+    CesiumGltf::ImageCesium image;
+    ASSERT_TRUE(registry.Decode(data, option, image));
+    ASSERT_EQ(image.width, 64);
+    ASSERT_EQ(image.channels, 1);
+    ASSERT_EQ(image.pixelData.size(), 64 * 64);
+}
+
+TEST_F(ImageDecoderTest, ReductionKeepsTheLongerSideAboveTarget)
+{
+    ASSERT_EQ(Cesium::ImageDecoderRegistry::GetReductionCount(1024, 128, 0), 0);
+    ASSERT_EQ(Cesium::ImageDecoderRegistry::GetReductionCount(1024, 128, 256), 2);
+    ASSERT_EQ(Cesium::ImageDecoderRegistry::GetReductionCount(128, 1024, 256), 2);
+    ASSERT_EQ(Cesium::ImageDecoderRegistry::GetReductionCount(1024, 1024, 1000), 0);
+    ASSERT_EQ(Cesium::ImageDecoderRegistry::GetReductionCount(100, 100, 200), 0);
+
+    // the shorter side doesn't go below 1 pixel
+    ASSERT_EQ(Cesium::ImageDecoderRegistry::GetReductionCount(1024, 2, 1), 1);
+}
@@ -0,0 +1,392 @@
+#include "LoopbackHttpServer.h"
+#include <zlib.h>
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+
+LoopbackHttpServer::LoopbackHttpServer(const LoopbackHttpServerOptions& options)
+    : m_options{ options }
+    , m_listenSocket{ AZ_SOCKET_INVALID }
+    , m_port{ 0 }
+    , m_stopping{ false }
+    , m_requestCount{ 0 }
+{
+}
+
+LoopbackHttpServer::~LoopbackHttpServer() noexcept
+{
+    Stop();
+}
+
+void LoopbackHttpServer::AddContent(const std::string& path, std::string body, std::string contentType)
+{
+    m_contents[path] = Content{ std::move(body), std::move(contentType) };
+}
+
+void LoopbackHttpServer::ServeDirectory(const std::string& rootDirectory)
+{
+    m_rootDirectory = rootDirectory;
+}
+
+bool LoopbackHttpServer::Start()
+{
+    AZ::AzSock::Startup();
+    m_listenSocket = AZ::AzSock::Socket();
+    if (!AZ::AzSock::IsAzSocketValid(m_listenSocket))
+    {
+        return false;
+    }
+
+    // port 0 lets the system pick a free port, which is read back once the socket is bound
+    AZ::AzSock::AzSocketAddress address;
+    address.SetAddress("127.0.0.1", 0);
+    if (AZ::AzSock::Bind(m_listenSocket, address) != 0 || AZ::AzSock::Listen(m_listenSocket, 128) != 0 ||
+        AZ::AzSock::GetSockName(m_listenSocket, address) != 0)
+    {
+        AZ::AzSock::CloseSocket(m_listenSocket);
+        m_listenSocket = AZ_SOCKET_INVALID;
+        return false;
+    }
+
+    m_port = address.GetAddrPort();
+    m_stopping = false;
+    m_acceptThread = std::thread(
+        [this]()
+        {
+            AcceptConnections();
+        });
+    return true;
+}
+
+void LoopbackHttpServer::Stop()
+{
+    if (!AZ::AzSock::IsAzSocketValid(m_listenSocket))
+    {
+        return;
+    }
+
+    // the threads poll their sockets, so they notice that the server stops within a poll interval
+    m_stopping = true;
+    m_acceptThread.join();
+
+    std::vector<std::thread> connectionThreads;
+    {
+        std::lock_guard<std::mutex> lock(m_connectionsMutex);
+        connectionThreads.swap(m_connectionThreads);
+    }
+
+    for (auto& connectionThread : connectionThreads)
+    {
+        connectionThread.join();
+    }
+
+    AZ::AzSock::CloseSocket(m_listenSocket);
+    m_listenSocket = AZ_SOCKET_INVALID;
+    AZ::AzSock::Cleanup();
+}
+
+std::string LoopbackHttpServer::GetUrl(const std::string& path) const
+{
+    return "http://127.0.0.1:" + std::to_string(m_port) + path;
+}
+
+std::uint32_t LoopbackHttpServer::GetRequestCount() const
+{
+    return m_requestCount;
+}
+
+void LoopbackHttpServer::AcceptConnections()
+{
+    while (!m_stopping)
+    {
+        if (!WaitForData(m_listenSocket))
+        {
+            continue;
+        }
+
+        AZ::AzSock::AzSocketAddress clientAddress;
+        AZSOCKET connection = AZ::AzSock::Accept(m_listenSocket, clientAddress);
+        if (!AZ::AzSock::IsAzSocketValid(connection))
+        {
+            continue;
+        }
+
+        AZ::AzSock::EnableTCPNoDelay(connection, true);
+        std::lock_guard<std::mutex> lock(m_connectionsMutex);
+        m_connectionThreads.emplace_back(
+            [this, connection]()
+            {
+                ServeConnection(connection);
+            });
+    }
+}
+
+void LoopbackHttpServer::ServeConnection(AZSOCKET connection)
+{
+    std::string received;
+    Request request;
+    while (!m_stopping && ReadRequest(connection, received, request))
+    {
+        if (!SendResponse(connection, request))
+        {
+            break;
+        }
+
+        auto connectionHeader = request.m_headers.find("connection");
+        if (connectionHeader != request.m_headers.end() && connectionHeader->second == "close")
+        {
+            break;
+        }
+    }
+
+    AZ::AzSock::CloseSocket(connection);
+}
+
+bool LoopbackHttpServer::ReadRequest(AZSOCKET connection, std::string& received, Request& request)
+{
+    // requests can arrive in pieces, and the next request of a kept alive connection can follow in the same piece
+    char block[RECEIVE_BLOCK_SIZE];
+    std::size_t headerEnd = std::string::npos;
+    while ((headerEnd = received.find("\r\n\r\n")) == std::string::npos)
+    {
+        if (m_stopping)
+        {
+            return false;
+        }
+
+        if (!WaitForData(connection))
+        {
+            continue;
+        }
+
+        int receivedSize = AZ::AzSock::Recv(connection, block, static_cast<int>(sizeof(block)), 0);
+        if (receivedSize <= 0)
+        {
+            return false;
+        }
+
+        received.append(block, static_cast<std::size_t>(receivedSize));
+    }
+
+    request = Request{};
+    std::istringstream header(received.substr(0, headerEnd));
+    std::string line;
+    std::getline(header, line);
+    std::istringstream requestLine(line);
+    requestLine >> request.m_method >> request.m_path;
+    request.m_path = request.m_path.substr(0, request.m_path.find('?'));
+
+    while (std::getline(header, line))
+    {
+        std::size_t separator = line.find(':');
+        if (separator == std::string::npos)
+        {
+            continue;
+        }
+
+        std::string name = line.substr(0, separator);
+        std::transform(
+            name.begin(),
+            name.end(),
+            name.begin(),
+            [](unsigned char c)
+            {
+                return static_cast<char>(std::tolower(c));
+            });
+
+        std::size_t valueBegin = line.find_first_not_of(" \t", separator + 1);
+        std::size_t valueEnd = line.find_last_not_of(" \t\r");
+        request.m_headers[name] =
+            valueBegin == std::string::npos || valueEnd < valueBegin ? std::string{} : line.substr(valueBegin, valueEnd - valueBegin + 1);
+    }
+
+    std::size_t bodySize = 0;
+    auto contentLength = request.m_headers.find("content-length");
+    if (contentLength != request.m_headers.end())
+    {
+        bodySize = static_cast<std::size_t>(std::strtoull(contentLength->second.c_str(), nullptr, 10));
+    }
+
+    std::size_t bodyBegin = headerEnd + 4;
+    while (received.size() < bodyBegin + bodySize)
+    {
+        if (m_stopping)
+        {
+            return false;
+        }
+
+        if (!WaitForData(connection))
+        {
+            continue;
+        }
+
+        int receivedSize = AZ::AzSock::Recv(connection, block, static_cast<int>(sizeof(block)), 0);
+        if (receivedSize <= 0)
+        {
+            return false;
+        }
+
+        received.append(block, static_cast<std::size_t>(receivedSize));
+    }
+
+    request.m_body = received.substr(bodyBegin, bodySize);
+    received.erase(0, bodyBegin + bodySize);
+    return true;
+}
+
+bool LoopbackHttpServer::SendResponse(AZSOCKET connection, const Request& request)
+{
+    std::uint32_t requestNumber = ++m_requestCount;
+    if (m_options.m_latency.count() > 0)
+    {
+        std::this_thread::sleep_for(m_options.m_latency);
+    }
+
+    int status = 200;
+    Content content;
+    std::string extraHeaders;
+    if (m_options.m_failEveryNthRequest > 0 && requestNumber % m_options.m_failEveryNthRequest == 0)
+    {
+        status = m_options.m_failureStatus;
+        if (m_options.m_retryAfterSeconds > 0)
+        {
+            extraHeaders += "Retry-After: " + std::to_string(m_options.m_retryAfterSeconds) + "\r\n";
+        }
+    }
+    else if (request.m_method == "POST" || request.m_method == "PUT")
+    {
+        // bodies are echoed back, so that tests can check what was sent
+        content.m_body = request.m_body;
+        content.m_contentType = "application/octet-stream";
+    }
+    else if (!FindContent(request.m_path, content))
+    {
+        status = 404;
+    }
+
+    auto acceptEncoding = request.m_headers.find("accept-encoding");
+    if (m_options.m_gzip && !content.m_body.empty() && acceptEncoding != request.m_headers.end() &&
+        acceptEncoding->second.find("gzip") != std::string::npos)
+    {
+        content.m_body = Gzip(content.m_body);
+        extraHeaders += "Content-Encoding: gzip\r\n";
+    }
+
+    std::string header = "HTTP/1.1 " + std::to_string(status) + " " + GetStatusText(status) + "\r\n";
+    header += "Content-Length: " + std::to_string(content.m_body.size()) + "\r\n";
+    if (!content.m_contentType.empty())
+    {
+        header += "Content-Type: " + content.m_contentType + "\r\n";
+    }
+
+    header += extraHeaders;
+    header += "\r\n";
+    if (!Send(connection, header.data(), header.size()))
+    {
+        return false;
+    }
+
+    return request.m_method == "HEAD" || Send(connection, content.m_body.data(), content.m_body.size());
+}
+
+bool LoopbackHttpServer::FindContent(const std::string& path, Content& content) const
+{
+    auto existingContent = m_contents.find(path);
+    if (existingContent != m_contents.end())
+    {
+        content = existingContent->second;
+        return true;
+    }
+
+    // paths that could leave the directory are never served
+    if (m_rootDirectory.empty() || path.find("..") != std::string::npos)
+    {
+        return false;
+    }
+
+    std::ifstream file(m_rootDirectory + path, std::ios::binary);
+    if (!file)
+    {
+        return false;
+    }
+
+    content.m_body.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    bool isJson = path.size() >= 5 && path.compare(path.size() - 5, 5, ".json") == 0;
+    content.m_contentType = isJson ? "application/json" : "application/octet-stream";
+    return true;
+}
+
+bool LoopbackHttpServer::Send(AZSOCKET connection, const char* data, std::size_t size)
+{
+    // bandwidth is limited by sending a block at a time and waiting for as long as the block takes at that rate
+    std::size_t sent = 0;
+    while (sent < size)
+    {
+        if (m_stopping)
+        {
+            return false;
+        }
+
+        std::size_t blockSize = std::min(size - sent, SEND_BLOCK_SIZE);
+        int sentSize = AZ::AzSock::Send(connection, data + sent, static_cast<int>(blockSize), 0);
+        if (sentSize <= 0)
+        {
+            return false;
+        }
+
+        sent += static_cast<std::size_t>(sentSize);
+        if (m_options.m_bytesPerSecond > 0)
+        {
+            std::uint64_t blockTimeUs = static_cast<std::uint64_t>(sentSize) * 1000000 / m_options.m_bytesPerSecond;
+            std::this_thread::sleep_for(std::chrono::microseconds(blockTimeUs));
+        }
+    }
+
+    return true;
+}
+
+bool LoopbackHttpServer::WaitForData(AZSOCKET socket)
+{
+    AZTIMEVAL timeout{ 0, POLL_INTERVAL_US };
+    return AZ::AzSock::IsRecvPending(socket, timeout) > 0;
+}
+
+std::string LoopbackHttpServer::Gzip(const std::string& body)
+{
+    z_stream stream;
+    std::memset(&stream, 0, sizeof(stream));
+    deflateInit2(&stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, MAX_WBITS + 16, 8, Z_DEFAULT_STRATEGY);
+
+    std::string compressed(deflateBound(&stream, static_cast<uLong>(body.size())), '\0');
+    stream.next_in = const_cast<Bytef*>(reinterpret_cast<const Bytef*>(body.data()));
+    stream.avail_in = static_cast<uInt>(body.size());
+    stream.next_out = reinterpret_cast<Bytef*>(compressed.data());
+    stream.avail_out = static_cast<uInt>(compressed.size());
+    deflate(&stream, Z_FINISH);
+    compressed.resize(stream.total_out);
+    deflateEnd(&stream);
+    return compressed;
+}
+
+const char* LoopbackHttpServer::GetStatusText(int status)
+{
+    switch (status)
+    {
+    case 200:
+        return "OK";
+    case 404:
+        return "Not Found";
+    case 429:
+        return "Too Many Requests";
+    case 500:
+        return "Internal Server Error";
+    case 503:
+        return "Service Unavailable";
+    default:
+        return "Unknown";
+    }
+}
@@ -0,0 +1,105 @@
+#pragma once
+
+#include <AzCore/Socket/AzSocket.h>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+struct LoopbackHttpServerOptions final
+{
+    // waited before every response, to stand in for the round trip to a real server
+    std::chrono::milliseconds m_latency{ 0 };
+
+    // per connection. Zero sends as fast as the socket allows
+    std::size_t m_bytesPerSecond{ 0 };
+
+    // bodies are gzipped for requests that accept it
+    bool m_gzip{ false };
+
+    // every nth request fails with the failure status instead of its content. Zero never fails
+    std::uint32_t m_failEveryNthRequest{ 0 };
+
+    int m_failureStatus{ 503 };
+
+    // sent with failures when it is not zero
+    std::uint32_t m_retryAfterSeconds{ 0 };
+};
+
+// HTTP/1.1 server on 127.0.0.1 that serves in-memory content and the files of a local directory, so that http tests run offline and
+// at a known speed. Connections are kept alive, and each of them is served by its own thread
+class LoopbackHttpServer final
+{
+    struct Content
+    {
+        std::string m_body;
+        std::string m_contentType;
+    };
+
+    struct Request
+    {
+        std::string m_method;
+        std::string m_path;
+        std::string m_body;
+        std::unordered_map<std::string, std::string> m_headers;
+    };
+
+public:
+    explicit LoopbackHttpServer(const LoopbackHttpServerOptions& options = LoopbackHttpServerOptions{});
+
+    ~LoopbackHttpServer() noexcept;
+
+    // content has to be added before the server starts
+    void AddContent(const std::string& path, std::string body, std::string contentType = "application/octet-stream");
+
+    // paths that have no content are looked up in this directory
+    void ServeDirectory(const std::string& rootDirectory);
+
+    // listens on a free port. Returns false when the socket can't be set up
+    bool Start();
+
+    void Stop();
+
+    std::string GetUrl(const std::string& path) const;
+
+    std::uint32_t GetRequestCount() const;
+
+private:
+    void AcceptConnections();
+
+    void ServeConnection(AZSOCKET connection);
+
+    bool ReadRequest(AZSOCKET connection, std::string& received, Request& request);
+
+    bool SendResponse(AZSOCKET connection, const Request& request);
+
+    bool FindContent(const std::string& path, Content& content) const;
+
+    bool Send(AZSOCKET connection, const char* data, std::size_t size);
+
+    bool WaitForData(AZSOCKET socket);
+
+    static std::string Gzip(const std::string& body);
+
+    static const char* GetStatusText(int status);
+
+    static constexpr std::size_t RECEIVE_BLOCK_SIZE = 16 * 1024;
+    static constexpr std::size_t SEND_BLOCK_SIZE = 16 * 1024;
+    static constexpr long POLL_INTERVAL_US = 20000;
+
+    LoopbackHttpServerOptions m_options;
+    std::unordered_map<std::string, Content> m_contents;
+    std::string m_rootDirectory;
+    AZSOCKET m_listenSocket;
+    std::uint16_t m_port;
+    std::atomic<bool> m_stopping;
+    std::atomic<std::uint32_t> m_requestCount;
+    std::thread m_acceptThread;
+    std::mutex m_connectionsMutex;
+    std::vector<std::thread> m_connectionThreads;
+};
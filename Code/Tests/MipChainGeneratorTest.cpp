@@ -0,0 +1,141 @@
+#include "Cesium/Gltf/MipChainGenerator.h"
+#include <AzCore/UnitTest/TestTypes.h>
+#include <AzCore/std/containers/vector.h>
+
+#if defined(HAVE_BENCHMARK)
+#include <benchmark/benchmark.h>
+#endif
+
+namespace
+{
+    AZStd::vector<std::byte> CreatePixels(std::size_t pixelCount, std::uint32_t channelCount)
+    {
+        AZStd::vector<std::byte> pixels(pixelCount * channelCount);
+        for (std::size_t i = 0; i < pixels.size(); ++i)
+        {
+            pixels[i] = static_cast<std::byte>((i * 7 + i / 13) & 0xFF);
+        }
+
+        return pixels;
+    }
+} // namespace
+
+class MipChainGeneratorTest : public UnitTest::AllocatorsTestFixture
+{
+};
+
+TEST_F(MipChainGeneratorTest, MipLevelCountGoesDownToOnePixel)
+{
+    ASSERT_EQ(Cesium::MipChainGenerator::GetMipLevelCount(1, 1), 1);
+    ASSERT_EQ(Cesium::MipChainGenerator::GetMipLevelCount(256, 256), 9);
+    ASSERT_EQ(Cesium::MipChainGenerator::GetMipLevelCount(300, 20), 9);
+    ASSERT_EQ(Cesium::MipChainGenerator::GetMipSize(20, 8), 1);
+}
+
+TEST_F(MipChainGeneratorTest, GenerateMipAveragesLinearChannels)
+{
+    AZStd::vector<std::byte> source{ std::byte{ 10 }, std::byte{ 20 }, std::byte{ 30 }, std::byte{ 41 } };
+    AZStd::vector<std::byte> mip(1);
+    Cesium::MipChainGenerator::GenerateMip(source.data(), 2, 2, 1, false, mip.data());
+
+    ASSERT_EQ(static_cast<std::uint8_t>(mip[0]), 25);
+}
+
+TEST_F(MipChainGeneratorTest, GenerateMipAveragesSrgbChannelsInLinearSpace)
+{
+    // black and white checker. The alpha channel is averaged as is
+    AZStd::vector<std::byte> source;
+    for (std::uint8_t value : { 0, 255, 255, 0 })
+    {
+        source.insert(source.end(), { std::byte{ value }, std::byte{ value }, std::byte{ value }, std::byte{ value } });
+    }
+
+    AZStd::vector<std::byte> mip(4);
+    Cesium::MipChainGenerator::GenerateMip(source.data(), 2, 2, 4, true, mip.data());
+
+    ASSERT_NEAR(static_cast<std::uint8_t>(mip[0]), 188, 1);
+    ASSERT_NEAR(static_cast<std::uint8_t>(mip[2]), 188, 1);
+    ASSERT_EQ(static_cast<std::uint8_t>(mip[3]), 128);
+}
+
+TEST_F(MipChainGeneratorTest, GenerateMipOfOnePixelWideImage)
+{
+    AZStd::vector<std::byte> source{ std::byte{ 0 }, std::byte{ 100 }, std::byte{ 200 }, std::byte{ 50 } };
+    AZStd::vector<std::byte> mip(2);
+    Cesium::MipChainGenerator::GenerateMip(source.data(), 1, 4, 1, false, mip.data());
+
+    ASSERT_EQ(static_cast<std::uint8_t>(mip[0]), 50);
+    ASSERT_EQ(static_cast<std::uint8_t>(mip[1]), 125);
+}
+
+TEST_F(MipChainGeneratorTest, VectorizedRowsMatchBoxFilter)
+{
+    // 70 pixels wide leaves a scalar tail after the vectorized part of each row, and 5 rows repeat the last one
+    std::uint32_t width = 70;
+    std::uint32_t height = 5;
+    for (std::uint32_t channelCount : { 1u, 2u, 3u, 4u })
+    {
+        AZStd::vector<std::byte> source = CreatePixels(static_cast<std::size_t>(width) * height, channelCount);
+        std::uint32_t mipWidth = Cesium::MipChainGenerator::GetMipSize(width, 1);
+        std::uint32_t mipHeight = Cesium::MipChainGenerator::GetMipSize(height, 1);
+        AZStd::vector<std::byte> mip(static_cast<std::size_t>(mipWidth) * mipHeight * channelCount);
+        Cesium::MipChainGenerator::GenerateMip(source.data(), width, height, channelCount, false, mip.data());
+
+        for (std::uint32_t y = 0; y < mipHeight; ++y)
+        {
+            for (std::uint32_t x = 0; x < mipWidth; ++x)
+            {
+                for (std::uint32_t c = 0; c < channelCount; ++c)
+                {
+                    auto sourceAt = [&](std::uint32_t sourceX, std::uint32_t sourceY)
+                    {
+                        return static_cast<std::uint32_t>(source[(static_cast<std::size_t>(sourceY) * width + sourceX) * channelCount + c]);
+                    };
+
+                    std::uint32_t y1 = AZStd::min(y * 2 + 1, height - 1);
+                    std::uint32_t sum = sourceAt(x * 2, y * 2) + sourceAt(x * 2 + 1, y * 2) + sourceAt(x * 2, y1) + sourceAt(x * 2 + 1, y1);
+                    std::size_t mipIndex = (static_cast<std::size_t>(y) * mipWidth + x) * channelCount + c;
+                    ASSERT_EQ(static_cast<std::uint32_t>(mip[mipIndex]), (sum + 2) / 4);
+                }
+            }
+        }
+    }
+}
+
+#if defined(HAVE_BENCHMARK)
+class MipChainGeneratorBenchmark : public UnitTest::AllocatorsBenchmarkFixture
+{
+};
+
+BENCHMARK_DEFINE_F(MipChainGeneratorBenchmark, GenerateLinearMip)(benchmark::State& state)
+{
+    std::uint32_t size = static_cast<std::uint32_t>(state.range(0));
+    AZStd::vector<std::byte> source = CreatePixels(static_cast<std::size_t>(size) * size, 4);
+    AZStd::vector<std::byte> mip(source.size() / 4);
+    for ([[maybe_unused]] auto _ : state)
+    {
+        Cesium::MipChainGenerator::GenerateMip(source.data(), size, size, 4, false, mip.data());
+        benchmark::DoNotOptimize(mip.data());
+    }
+
+    state.SetBytesProcessed(state.iterations() * source.size());
+}
+
+BENCHMARK_DEFINE_F(MipChainGeneratorBenchmark, GenerateSrgbMip)(benchmark::State& state)
+{
+    // the color channels go through the lookup tables, so this is the scalar path
+    std::uint32_t size = static_cast<std::uint32_t>(state.range(0));
+    AZStd::vector<std::byte> source = CreatePixels(static_cast<std::size_t>(size) * size, 4);
+    AZStd::vector<std::byte> mip(source.size() / 4);
+    for ([[maybe_unused]] auto _ : state)
+    {
+        Cesium::MipChainGenerator::GenerateMip(source.data(), size, size, 4, true, mip.data());
+        benchmark::DoNotOptimize(mip.data());
+    }
+
+    state.SetBytesProcessed(state.iterations() * source.size());
+}
+
+BENCHMARK_REGISTER_F(MipChainGeneratorBenchmark, GenerateLinearMip)->Arg(2048)->Arg(4096)->Unit(benchmark::kMillisecond);
+BENCHMARK_REGISTER_F(MipChainGeneratorBenchmark, GenerateSrgbMip)->Arg(2048)->Arg(4096)->Unit(benchmark::kMillisecond);
+#endif
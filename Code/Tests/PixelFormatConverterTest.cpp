@@ -0,0 +1,156 @@
+#include "Cesium/Gltf/PixelFormatConverter.h"
+#include <AzCore/UnitTest/TestTypes.h>
+#include <AzCore/std/containers/vector.h>
+
+#if defined(HAVE_BENCHMARK)
+#include <benchmark/benchmark.h>
+#endif
+
+namespace
+{
+    AZStd::vector<std::byte> CreatePixels(std::size_t pixelCount, std::uint32_t channelCount)
+    {
+        AZStd::vector<std::byte> pixels(pixelCount * channelCount);
+        for (std::size_t i = 0; i < pixels.size(); ++i)
+        {
+            pixels[i] = static_cast<std::byte>((i * 7 + i / 13) & 0xFF);
+        }
+
+        return pixels;
+    }
+} // namespace
+
+class PixelFormatConverterTest : public UnitTest::AllocatorsTestFixture
+{
+};
+
+TEST_F(PixelFormatConverterTest, ExpandRGBToRGBAForOddPixelCounts)
+{
+    // cover the vectorized loop and the scalar tail
+    for (std::size_t pixelCount : { 1, 15, 16, 17, 100 })
+    {
+        AZStd::vector<std::byte> rgb = CreatePixels(pixelCount, 3);
+        AZStd::vector<std::byte> rgba(pixelCount * 4);
+        Cesium::PixelFormatConverter::ExpandRGBToRGBA(rgb.data(), pixelCount, rgba.data());
+
+        for (std::size_t i = 0; i < pixelCount; ++i)
+        {
+            ASSERT_EQ(rgba[i * 4], rgb[i * 3]);
+            ASSERT_EQ(rgba[i * 4 + 1], rgb[i * 3 + 1]);
+            ASSERT_EQ(rgba[i * 4 + 2], rgb[i * 3 + 2]);
+            ASSERT_EQ(static_cast<std::uint8_t>(rgba[i * 4 + 3]), 255);
+        }
+    }
+}
+
+TEST_F(PixelFormatConverterTest, ExtractChannelFromRGBAImage)
+{
+    for (std::size_t pixelCount : { 1, 17, 100 })
+    {
+        AZStd::vector<std::byte> rgba = CreatePixels(pixelCount, 4);
+        AZStd::vector<std::byte> channel(pixelCount);
+        for (std::uint32_t c = 0; c < 4; ++c)
+        {
+            Cesium::PixelFormatConverter::ExtractChannel(rgba.data(), pixelCount, 4, c, channel.data());
+            for (std::size_t i = 0; i < pixelCount; ++i)
+            {
+                ASSERT_EQ(channel[i], rgba[i * 4 + c]);
+            }
+        }
+    }
+}
+
+TEST_F(PixelFormatConverterTest, ExtractChannelFromRGBImage)
+{
+    std::size_t pixelCount = 100;
+    AZStd::vector<std::byte> rgb = CreatePixels(pixelCount, 3);
+    AZStd::vector<std::byte> channel(pixelCount);
+    Cesium::PixelFormatConverter::ExtractChannel(rgb.data(), pixelCount, 3, 2, channel.data());
+    for (std::size_t i = 0; i < pixelCount; ++i)
+    {
+        ASSERT_EQ(channel[i], rgb[i * 3 + 2]);
+    }
+}
+
+#if defined(HAVE_BENCHMARK)
+class PixelFormatConverterBenchmark : public UnitTest::AllocatorsBenchmarkFixture
+{
+};
+
+BENCHMARK_DEFINE_F(PixelFormatConverterBenchmark, ExpandRGBToRGBA)(benchmark::State& state)
+{
+    std::size_t pixelCount = static_cast<std::size_t>(state.range(0)) * state.range(0);
+    AZStd::vector<std::byte> rgb = CreatePixels(pixelCount, 3);
+    AZStd::vector<std::byte> rgba(pixelCount * 4);
+    for ([[maybe_unused]] auto _ : state)
+    {
+        Cesium::PixelFormatConverter::ExpandRGBToRGBA(rgb.data(), pixelCount, rgba.data());
+        benchmark::DoNotOptimize(rgba.data());
+    }
+
+    state.SetBytesProcessed(state.iterations() * rgb.size());
+}
+
+BENCHMARK_DEFINE_F(PixelFormatConverterBenchmark, ExpandRGBToRGBAScalar)(benchmark::State& state)
+{
+    // the per pixel loop the material builder used before
+    std::size_t pixelCount = static_cast<std::size_t>(state.range(0)) * state.range(0);
+    AZStd::vector<std::byte> rgb = CreatePixels(pixelCount, 3);
+    AZStd::vector<std::byte> rgba(pixelCount * 4);
+    for ([[maybe_unused]] auto _ : state)
+    {
+        std::size_t j = 0;
+        for (std::size_t i = 0; i < rgb.size(); i += 3)
+        {
+            rgba[j] = rgb[i];
+            rgba[j + 1] = rgb[i + 1];
+            rgba[j + 2] = rgb[i + 2];
+            rgba[j + 3] = static_cast<std::byte>(255);
+            j += 4;
+        }
+
+        benchmark::DoNotOptimize(rgba.data());
+    }
+
+    state.SetBytesProcessed(state.iterations() * rgb.size());
+}
+
+BENCHMARK_DEFINE_F(PixelFormatConverterBenchmark, ExtractChannel)(benchmark::State& state)
+{
+    std::size_t pixelCount = static_cast<std::size_t>(state.range(0)) * state.range(0);
+    AZStd::vector<std::byte> rgba = CreatePixels(pixelCount, 4);
+    AZStd::vector<std::byte> channel(pixelCount);
+    for ([[maybe_unused]] auto _ : state)
+    {
+        Cesium::PixelFormatConverter::ExtractChannel(rgba.data(), pixelCount, 4, 1, channel.data());
+        benchmark::DoNotOptimize(channel.data());
+    }
+
+    state.SetBytesProcessed(state.iterations() * rgba.size());
+}
+
+BENCHMARK_DEFINE_F(PixelFormatConverterBenchmark, ExtractChannelScalar)(benchmark::State& state)
+{
+    std::size_t pixelCount = static_cast<std::size_t>(state.range(0)) * state.range(0);
+    AZStd::vector<std::byte> rgba = CreatePixels(pixelCount, 4);
+    AZStd::vector<std::byte> channel(pixelCount);
+    for ([[maybe_unused]] auto _ : state)
+    {
+        std::size_t j = 0;
+        for (std::size_t i = 0; i < rgba.size(); i += 4)
+        {
+            channel[j] = rgba[i + 1];
+            ++j;
+        }
+
+        benchmark::DoNotOptimize(channel.data());
+    }
+
+    state.SetBytesProcessed(state.iterations() * rgba.size());
+}
+
+BENCHMARK_REGISTER_F(PixelFormatConverterBenchmark, ExpandRGBToRGBA)->Arg(2048)->Arg(4096)->Unit(benchmark::kMillisecond);
+BENCHMARK_REGISTER_F(PixelFormatConverterBenchmark, ExpandRGBToRGBAScalar)->Arg(2048)->Arg(4096)->Unit(benchmark::kMillisecond);
+BENCHMARK_REGISTER_F(PixelFormatConverterBenchmark, ExtractChannel)->Arg(2048)->Arg(4096)->Unit(benchmark::kMillisecond);
+BENCHMARK_REGISTER_F(PixelFormatConverterBenchmark, ExtractChannelScalar)->Arg(2048)->Arg(4096)->Unit(benchmark::kMillisecond);
+#endif
@@ -0,0 +1,63 @@
+#include "Cesium/TilesetUtility/RasterCompositor.h"
+#include <AzCore/UnitTest/TestTypes.h>
+#include <AzCore/std/containers/vector.h>
+#include <AzCore/std/smart_ptr/make_shared.h>
+
+class RasterCompositorTest : public UnitTest::AllocatorsTestFixture
+{
+};
+
+namespace
+{
+    Cesium::RasterCompositeInput CreateInput(std::uint32_t size, std::uint8_t value)
+    {
+        Cesium::RasterCompositeInput input;
+        input.m_pixels = AZStd::make_shared<AZStd::vector<std::byte>>(static_cast<std::size_t>(size) * size * 4, std::byte{ value });
+        input.m_width = size;
+        input.m_height = size;
+        return input;
+    }
+} // namespace
+
+TEST_F(RasterCompositorTest, CompositeSizeFollowsTheMostDetailedInput)
+{
+    Cesium::RasterCompositeInput input = CreateInput(256, 255);
+    input.m_scale = glm::dvec2{ 0.25 };
+    ASSERT_EQ(Cesium::RasterCompositor::GetCompositeSize({ input }), Cesium::RasterCompositor::MIN_COMPOSITE_SIZE);
+
+    input.m_scale = glm::dvec2{ 1.5 };
+    ASSERT_EQ(Cesium::RasterCompositor::GetCompositeSize({ input }), 512);
+
+    input.m_scale = glm::dvec2{ 16.0 };
+    ASSERT_EQ(Cesium::RasterCompositor::GetCompositeSize({ input }), Cesium::RasterCompositor::MAX_COMPOSITE_SIZE);
+}
+
+TEST_F(RasterCompositorTest, LayersAreMultipliedInLinearSpace)
+{
+    // 188 is about 0.5 in linear space, so 2 layers of it come out at about 0.25
+    AZStd::vector<std::byte> composite;
+    Cesium::RasterCompositor::Composite({ CreateInput(4, 188) }, 64, composite);
+    ASSERT_EQ(composite.size(), 64 * 64 * 4);
+    ASSERT_NEAR(static_cast<std::uint8_t>(composite[0]), 188, 1);
+    ASSERT_EQ(static_cast<std::uint8_t>(composite[3]), 255);
+
+    Cesium::RasterCompositor::Composite({ CreateInput(4, 188), CreateInput(4, 188) }, 64, composite);
+    ASSERT_NEAR(static_cast<std::uint8_t>(composite[0]), 137, 2);
+}
+
+TEST_F(RasterCompositorTest, CompositeKeepsTheOrientationOfTheRaster)
+{
+    // top left pixel is red, the rest is white
+    Cesium::RasterCompositeInput input = CreateInput(2, 255);
+    AZStd::vector<std::byte>& pixels = const_cast<AZStd::vector<std::byte>&>(*input.m_pixels);
+    pixels[1] = std::byte{ 0 };
+    pixels[2] = std::byte{ 0 };
+
+    AZStd::vector<std::byte> composite;
+    Cesium::RasterCompositor::Composite({ input }, 64, composite);
+    ASSERT_EQ(static_cast<std::uint8_t>(composite[0]), 255);
+    ASSERT_EQ(static_cast<std::uint8_t>(composite[1]), 0);
+
+    std::size_t bottomRight = (63 * 64 + 63) * 4;
+    ASSERT_EQ(static_cast<std::uint8_t>(composite[bottomRight + 1]), 255);
+}
@@ -0,0 +1,51 @@
+#include "Cesium/TilesetUtility/RasterOverlayTexturePool.h"
+#include <AzCore/UnitTest/TestTypes.h>
+#include <AzCore/std/containers/vector.h>
+
+class RasterOverlayTexturePoolTest : public UnitTest::AllocatorsTestFixture
+{
+};
+
+TEST_F(RasterOverlayTexturePoolTest, OnlyRGBATilesOfSlotSizeArePooled)
+{
+    using Cesium::RasterOverlayTexturePool;
+    ASSERT_TRUE(RasterOverlayTexturePool::CanPool(256, 256, 4));
+    ASSERT_FALSE(RasterOverlayTexturePool::CanPool(256, 256, 3));
+    ASSERT_FALSE(RasterOverlayTexturePool::CanPool(512, 512, 4));
+    ASSERT_FALSE(RasterOverlayTexturePool::CanPool(256, 128, 4));
+}
+
+TEST_F(RasterOverlayTexturePoolTest, SlotPixelsHoldTheMipChainOfTheTile)
+{
+    using Cesium::RasterOverlayTexturePool;
+    std::uint32_t mipLevelCount = RasterOverlayTexturePool::GetMipLevelCount(true);
+    AZStd::vector<std::byte> tile(RasterOverlayTexturePool::SLOT_SIZE * RasterOverlayTexturePool::SLOT_SIZE * 4, std::byte{ 200 });
+    AZStd::vector<std::byte> slotPixels;
+    RasterOverlayTexturePool::PrepareSlotPixels(tile.data(), mipLevelCount, slotPixels);
+
+    // 256, 128, 64, 32 and 16 pixels wide mips of a constant tile stay constant
+    ASSERT_EQ(slotPixels.size(), (256 * 256 + 128 * 128 + 64 * 64 + 32 * 32 + 16 * 16) * 4);
+    for (std::byte pixel : slotPixels)
+    {
+        ASSERT_NEAR(static_cast<std::uint8_t>(pixel), 200, 1);
+    }
+
+    RasterOverlayTexturePool::PrepareSlotPixels(tile.data(), RasterOverlayTexturePool::GetMipLevelCount(false), slotPixels);
+    ASSERT_EQ(slotPixels.size(), tile.size());
+}
+
+TEST_F(RasterOverlayTexturePoolTest, SlotTransformsTileTheAtlas)
+{
+    using Cesium::RasterOverlayTexturePool;
+    RasterOverlayTexturePool pool{ false };
+    AZ::Vector4 first = pool.GetSlotTranslateScale(0);
+    AZ::Vector4 nextRow = pool.GetSlotTranslateScale(RasterOverlayTexturePool::SLOTS_PER_ROW + 1);
+    AZ::Vector4 nextPage = pool.GetSlotTranslateScale(RasterOverlayTexturePool::SLOTS_PER_PAGE);
+
+    ASSERT_FLOAT_EQ(first.GetX(), 0.0f);
+    ASSERT_FLOAT_EQ(first.GetY(), 0.0f);
+    ASSERT_FLOAT_EQ(first.GetZ(), 1.0f / RasterOverlayTexturePool::SLOTS_PER_ROW);
+    ASSERT_FLOAT_EQ(nextRow.GetX(), 1.0f / RasterOverlayTexturePool::SLOTS_PER_ROW);
+    ASSERT_FLOAT_EQ(nextRow.GetY(), 1.0f / RasterOverlayTexturePool::SLOTS_PER_ROW);
+    ASSERT_TRUE(nextPage.IsClose(first));
+}
@@ -0,0 +1,61 @@
+#include "Cesium/Gltf/SharedTextureCache.h"
+#include <AzCore/UnitTest/TestTypes.h>
+#include <AzCore/std/containers/vector.h>
+
+class SharedTextureCacheTest : public UnitTest::AllocatorsTestFixture
+{
+};
+
+TEST_F(SharedTextureCacheTest, IdenticalPixelsHaveTheSameHash)
+{
+    AZStd::vector<std::byte> first(256 * 256 * 4);
+    for (std::size_t i = 0; i < first.size(); ++i)
+    {
+        first[i] = static_cast<std::byte>(i % 251);
+    }
+
+    AZStd::vector<std::byte> second = first;
+    ASSERT_EQ(
+        Cesium::SharedTextureCache::HashPixels(first.data(), first.size()),
+        Cesium::SharedTextureCache::HashPixels(second.data(), second.size()));
+}
+
+TEST_F(SharedTextureCacheTest, ChangingOnePixelChangesTheHash)
+{
+    // 67 bytes cover both the 32 bytes blocks and the tail
+    AZStd::vector<std::byte> pixels(67, std::byte{ 128 });
+    Cesium::SharedTexturePixelHash hash = Cesium::SharedTextureCache::HashPixels(pixels.data(), pixels.size());
+    for (std::size_t i = 0; i < pixels.size(); ++i)
+    {
+        AZStd::vector<std::byte> changed = pixels;
+        changed[i] = std::byte{ 129 };
+
+        // both halves change, since they are hashed independently
+        Cesium::SharedTexturePixelHash changedHash = Cesium::SharedTextureCache::HashPixels(changed.data(), changed.size());
+        ASSERT_NE(changedHash.m_first, hash.m_first);
+        ASSERT_NE(changedHash.m_second, hash.m_second);
+    }
+}
+
+TEST_F(SharedTextureCacheTest, ImageSizeIsPartOfTheHash)
+{
+    AZStd::vector<std::byte> pixels(64);
+    ASSERT_NE(Cesium::SharedTextureCache::HashPixels(pixels.data(), 32), Cesium::SharedTextureCache::HashPixels(pixels.data(), 64));
+}
+
+TEST_F(SharedTextureCacheTest, KeysOfDifferentFormatsAreNotEqual)
+{
+    Cesium::StreamingImageBuilderOption linear;
+    Cesium::StreamingImageBuilderOption srgb;
+    srgb.m_srgb = true;
+
+    Cesium::SharedTexturePixelHash hash{ 1, 2 };
+    Cesium::SharedTextureKey linearKey{ hash, 16, 16, 4, linear };
+    Cesium::SharedTextureKey srgbKey{ hash, 16, 16, 4, srgb };
+    ASSERT_FALSE(linearKey == srgbKey);
+    ASSERT_TRUE(linearKey == Cesium::SharedTextureKey(hash, 16, 16, 4, linear));
+    ASSERT_FALSE(linearKey == Cesium::SharedTextureKey(hash, 16, 16, 1, linear));
+
+    // keys that only differ in the second half of the hash are different images
+    ASSERT_FALSE(linearKey == Cesium::SharedTextureKey(Cesium::SharedTexturePixelHash(1, 3), 16, 16, 4, linear));
+}
@@ -0,0 +1,165 @@
+#include "Cesium/Gltf/TextureBlockCompressor.h"
+#include <AzCore/UnitTest/TestTypes.h>
+#include <AzCore/std/containers/vector.h>
+#include <AzCore/std/algorithm.h>
+#include <cstdlib>
+
+class TextureBlockCompressorTest : public UnitTest::AllocatorsTestFixture
+{
+public:
+    void SetUp() override
+    {
+        UnitTest::AllocatorsTestFixture::SetUp();
+
+        // smooth gradients with a transparent right half
+        m_pixels.resize(IMAGE_SIZE * IMAGE_SIZE * 4);
+        for (std::uint32_t y = 0; y < IMAGE_SIZE; ++y)
+        {
+            for (std::uint32_t x = 0; x < IMAGE_SIZE; ++x)
+            {
+                std::byte* pixel = m_pixels.data() + (y * IMAGE_SIZE + x) * 4;
+                pixel[0] = static_cast<std::byte>(x * 4);
+                pixel[1] = static_cast<std::byte>(y * 4);
+                pixel[2] = static_cast<std::byte>((x + y) * 2);
+                pixel[3] = static_cast<std::byte>(x < IMAGE_SIZE / 2 ? 255 : y * 4);
+            }
+        }
+    }
+
+    void TearDown() override
+    {
+        AZStd::vector<std::byte>().swap(m_pixels);
+        UnitTest::AllocatorsTestFixture::TearDown();
+    }
+
+protected:
+    static void ExpandRGB565(std::uint32_t color, std::int32_t* rgb)
+    {
+        std::uint32_t r = (color >> 11) & 0x1F;
+        std::uint32_t g = (color >> 5) & 0x3F;
+        std::uint32_t b = color & 0x1F;
+        rgb[0] = static_cast<std::int32_t>((r << 3) | (r >> 2));
+        rgb[1] = static_cast<std::int32_t>((g << 2) | (g >> 4));
+        rgb[2] = static_cast<std::int32_t>((b << 3) | (b >> 2));
+    }
+
+    // returns the largest channel error of the decoded BC1 image
+    std::int32_t DecodeBC1MaxError(const AZStd::vector<std::byte>& blocks, std::uint32_t blockStride, std::uint32_t blockOffset) const
+    {
+        std::int32_t maxError = 0;
+        std::uint32_t blockCount = IMAGE_SIZE / 4;
+        for (std::uint32_t blockY = 0; blockY < blockCount; ++blockY)
+        {
+            for (std::uint32_t blockX = 0; blockX < blockCount; ++blockX)
+            {
+                const std::uint8_t* block =
+                    reinterpret_cast<const std::uint8_t*>(blocks.data()) + (blockY * blockCount + blockX) * blockStride + blockOffset;
+                std::uint32_t color0 = block[0] | (block[1] << 8);
+                std::uint32_t color1 = block[2] | (block[3] << 8);
+                std::uint32_t indices = block[4] | (block[5] << 8) | (block[6] << 16) | (static_cast<std::uint32_t>(block[7]) << 24);
+
+                std::int32_t palette[4][3];
+                ExpandRGB565(color0, palette[0]);
+                ExpandRGB565(color1, palette[1]);
+                for (std::size_t c = 0; c < 3; ++c)
+                {
+                    palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+                    palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+                }
+
+                for (std::uint32_t i = 0; i < 16; ++i)
+                {
+                    std::uint32_t x = blockX * 4 + i % 4;
+                    std::uint32_t y = blockY * 4 + i / 4;
+                    const std::int32_t* decoded = palette[(indices >> (2 * i)) & 3];
+                    for (std::size_t c = 0; c < 3; ++c)
+                    {
+                        std::int32_t expected = static_cast<std::int32_t>(m_pixels[(y * IMAGE_SIZE + x) * 4 + c]);
+                        maxError = AZStd::max(maxError, std::abs(decoded[c] - expected));
+                    }
+                }
+            }
+        }
+
+        return maxError;
+    }
+
+    // returns the largest error of the decoded BC4 image against the given channel
+    std::int32_t DecodeBC4MaxError(const AZStd::vector<std::byte>& blocks, std::uint32_t blockStride, std::uint32_t channel) const
+    {
+        std::int32_t maxError = 0;
+        std::uint32_t blockCount = IMAGE_SIZE / 4;
+        for (std::uint32_t blockY = 0; blockY < blockCount; ++blockY)
+        {
+            for (std::uint32_t blockX = 0; blockX < blockCount; ++blockX)
+            {
+                const std::uint8_t* block =
+                    reinterpret_cast<const std::uint8_t*>(blocks.data()) + (blockY * blockCount + blockX) * blockStride;
+                std::int32_t palette[8];
+                palette[0] = block[0];
+                palette[1] = block[1];
+                for (std::int32_t i = 2; i < 8; ++i)
+                {
+                    palette[i] = palette[0] > palette[1] ? ((8 - i) * palette[0] + (i - 1) * palette[1]) / 7 : palette[0];
+                }
+
+                std::uint64_t indices = 0;
+                for (std::uint32_t i = 0; i < 6; ++i)
+                {
+                    indices |= static_cast<std::uint64_t>(block[2 + i]) << (8 * i);
+                }
+
+                for (std::uint32_t i = 0; i < 16; ++i)
+                {
+                    std::uint32_t x = blockX * 4 + i % 4;
+                    std::uint32_t y = blockY * 4 + i / 4;
+                    std::int32_t decoded = palette[(indices >> (3 * i)) & 7];
+                    std::int32_t expected = static_cast<std::int32_t>(m_pixels[(y * IMAGE_SIZE + x) * 4 + channel]);
+                    maxError = AZStd::max(maxError, std::abs(decoded - expected));
+                }
+            }
+        }
+
+        return maxError;
+    }
+
+    static constexpr std::uint32_t IMAGE_SIZE = 64;
+
+    AZStd::vector<std::byte> m_pixels;
+};
+
+TEST_F(TextureBlockCompressorTest, CanCompressOnlyMultipleOfBlockSize)
+{
+    ASSERT_TRUE(Cesium::TextureBlockCompressor::CanCompress(256, 128));
+    ASSERT_FALSE(Cesium::TextureBlockCompressor::CanCompress(250, 128));
+    ASSERT_FALSE(Cesium::TextureBlockCompressor::CanCompress(0, 0));
+}
+
+TEST_F(TextureBlockCompressorTest, CompressBC1ApproximatesColors)
+{
+    AZStd::vector<std::byte> blocks(Cesium::TextureBlockCompressor::GetBC1Size(IMAGE_SIZE, IMAGE_SIZE));
+    Cesium::TextureBlockCompressor::CompressBC1(m_pixels.data(), IMAGE_SIZE, IMAGE_SIZE, 4, blocks.data());
+
+    ASSERT_EQ(blocks.size(), IMAGE_SIZE * IMAGE_SIZE / 2);
+    ASSERT_LE(DecodeBC1MaxError(blocks, 8, 0), 12);
+}
+
+TEST_F(TextureBlockCompressorTest, CompressBC3KeepsAlpha)
+{
+    ASSERT_FALSE(Cesium::TextureBlockCompressor::IsOpaque(m_pixels.data(), IMAGE_SIZE, IMAGE_SIZE));
+
+    AZStd::vector<std::byte> blocks(Cesium::TextureBlockCompressor::GetBC3Size(IMAGE_SIZE, IMAGE_SIZE));
+    Cesium::TextureBlockCompressor::CompressBC3(m_pixels.data(), IMAGE_SIZE, IMAGE_SIZE, blocks.data());
+
+    ASSERT_EQ(blocks.size(), IMAGE_SIZE * IMAGE_SIZE);
+    ASSERT_LE(DecodeBC4MaxError(blocks, 16, 3), 2);
+    ASSERT_LE(DecodeBC1MaxError(blocks, 16, 8), 12);
+}
+
+TEST_F(TextureBlockCompressorTest, CompressBC4ReadsRequestedChannel)
+{
+    AZStd::vector<std::byte> blocks(Cesium::TextureBlockCompressor::GetBC4Size(IMAGE_SIZE, IMAGE_SIZE));
+    Cesium::TextureBlockCompressor::CompressBC4(m_pixels.data(), IMAGE_SIZE, IMAGE_SIZE, 4, 1, blocks.data());
+
+    ASSERT_LE(DecodeBC4MaxError(blocks, 8, 1), 2);
+}
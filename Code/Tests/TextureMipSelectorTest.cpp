@@ -0,0 +1,36 @@
+#include "Cesium/TilesetUtility/TextureMipSelector.h"
+#include <AzCore/UnitTest/TestTypes.h>
+#include <limits>
+
+class TextureMipSelectorTest : public UnitTest::AllocatorsTestFixture
+{
+};
+
+TEST_F(TextureMipSelectorTest, TileLargerThanTextureKeepsTheTopMip)
+{
+    ASSERT_EQ(Cesium::TextureMipSelector::GetDesiredMip(1024, 11, 1024.0), 0);
+    ASSERT_EQ(Cesium::TextureMipSelector::GetDesiredMip(1024, 11, 4000.0), 0);
+    ASSERT_EQ(Cesium::TextureMipSelector::GetDesiredMip(1024, 11, std::numeric_limits<double>::infinity()), 0);
+}
+
+TEST_F(TextureMipSelectorTest, MipFollowsScreenCoverage)
+{
+    ASSERT_EQ(Cesium::TextureMipSelector::GetDesiredMip(1024, 11, 1000.0), 0);
+    ASSERT_EQ(Cesium::TextureMipSelector::GetDesiredMip(1024, 11, 512.0), 1);
+    ASSERT_EQ(Cesium::TextureMipSelector::GetDesiredMip(1024, 11, 300.0), 1);
+    ASSERT_EQ(Cesium::TextureMipSelector::GetDesiredMip(1024, 11, 128.0), 3);
+    ASSERT_EQ(Cesium::TextureMipSelector::GetDesiredMip(4096, 13, 64.0), 6);
+}
+
+TEST_F(TextureMipSelectorTest, MipIsClampedToTheMipChain)
+{
+    ASSERT_EQ(Cesium::TextureMipSelector::GetDesiredMip(1024, 11, 0.01), 10);
+    ASSERT_EQ(Cesium::TextureMipSelector::GetDesiredMip(1024, 4, 16.0), 3);
+    ASSERT_EQ(Cesium::TextureMipSelector::GetDesiredMip(1024, 1, 16.0), 0);
+}
+
+TEST_F(TextureMipSelectorTest, HiddenTileKeepsTheLeastDetailedMip)
+{
+    ASSERT_EQ(Cesium::TextureMipSelector::GetDesiredMip(1024, 11, 0.0), 10);
+    ASSERT_EQ(Cesium::TextureMipSelector::GetDesiredMip(1024, 11, -1.0), 10);
+}
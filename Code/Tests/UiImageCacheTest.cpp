@@ -0,0 +1,61 @@
+#include "Cesium/Systems/UiImageCache.h"
+#include <AzCore/UnitTest/TestTypes.h>
+
+class UiImageCacheTest : public UnitTest::AllocatorsTestFixture
+{
+};
+
+TEST_F(UiImageCacheTest, PendingRequestsWaitForTheFirstLoad)
+{
+    Cesium::UiImageCache cache;
+    int readyCount = 0;
+    auto onReady = [&readyCount](const Cesium::UiImage&)
+    {
+        ++readyCount;
+    };
+
+    ASSERT_TRUE(cache.Request("https://example.com/logo.png", onReady));
+    ASSERT_FALSE(cache.Request("https://example.com/logo.png", onReady));
+    ASSERT_FALSE(cache.Request("https://example.com/logo.png", onReady));
+    ASSERT_TRUE(cache.Request("https://example.com/other.png", onReady));
+    ASSERT_EQ(readyCount, 0);
+
+    cache.Complete("https://example.com/logo.png", Cesium::UiImage{});
+    ASSERT_EQ(readyCount, 3);
+}
+
+TEST_F(UiImageCacheTest, FailedLoadIsNotCached)
+{
+    Cesium::UiImageCache cache;
+    auto onReady = [](const Cesium::UiImage&)
+    {
+    };
+
+    ASSERT_TRUE(cache.Request("https://example.com/logo.png", onReady));
+    cache.Complete("https://example.com/logo.png", Cesium::UiImage{});
+    ASSERT_EQ(cache.GetCachedImageCount(), 0);
+    ASSERT_TRUE(cache.Request("https://example.com/logo.png", onReady));
+}
+
+TEST_F(UiImageCacheTest, CompletingAnUnknownKeyIsIgnored)
+{
+    Cesium::UiImageCache cache;
+    cache.Complete("https://example.com/logo.png", Cesium::UiImage{});
+    ASSERT_EQ(cache.GetCachedImageCount(), 0);
+}
+
+TEST_F(UiImageCacheTest, PendingLoadsAreNeverEvicted)
+{
+    Cesium::UiImageCache cache;
+    auto onReady = [](const Cesium::UiImage&)
+    {
+    };
+
+    for (std::size_t i = 0; i < Cesium::UiImageCache::MAX_CACHED_IMAGES * 2; ++i)
+    {
+        ASSERT_TRUE(cache.Request(AZStd::string::format("https://example.com/%zu.png", i), onReady));
+    }
+
+    ASSERT_EQ(cache.GetCachedImageCount(), Cesium::UiImageCache::MAX_CACHED_IMAGES * 2);
+    ASSERT_FALSE(cache.Request("https://example.com/0.png", onReady));
+}
@@ -0,0 +1,98 @@
+#include "Cesium/Gltf/VertexCacheOptimizer.h"
+#include <AzCore/UnitTest/TestTypes.h>
+#include <AzCore/std/containers/array.h>
+#include <AzCore/std/sort.h>
+
+class VertexCacheOptimizerTest : public UnitTest::AllocatorsTestFixture
+{
+public:
+    void SetUp() override
+    {
+        UnitTest::AllocatorsTestFixture::SetUp();
+
+        // grid triangles are emitted in a scattered order, so that the input has almost no cache reuse
+        for (std::uint32_t i = 0; i < GRID_SIZE * GRID_SIZE; ++i)
+        {
+            std::uint32_t cell = (i * SCATTER_STRIDE) % (GRID_SIZE * GRID_SIZE);
+            std::uint32_t x = cell % GRID_SIZE;
+            std::uint32_t y = cell / GRID_SIZE;
+            std::uint32_t v0 = y * (GRID_SIZE + 1) + x;
+            std::uint32_t v1 = v0 + 1;
+            std::uint32_t v2 = v0 + GRID_SIZE + 1;
+            std::uint32_t v3 = v2 + 1;
+            m_indices.insert(m_indices.end(), { v0, v1, v2, v1, v3, v2 });
+        }
+    }
+
+    void TearDown() override
+    {
+        AZStd::vector<std::uint32_t>().swap(m_indices);
+        UnitTest::AllocatorsTestFixture::TearDown();
+    }
+
+protected:
+    static AZStd::vector<AZStd::array<std::uint32_t, 3>> SortedTriangles(const AZStd::vector<std::uint32_t>& indices)
+    {
+        AZStd::vector<AZStd::array<std::uint32_t, 3>> triangles;
+        for (std::size_t i = 0; i < indices.size(); i += 3)
+        {
+            triangles.push_back({ indices[i], indices[i + 1], indices[i + 2] });
+        }
+
+        AZStd::sort(triangles.begin(), triangles.end());
+        return triangles;
+    }
+
+    static constexpr std::uint32_t GRID_SIZE = 64;
+    static constexpr std::uint32_t GRID_VERTEX_COUNT = (GRID_SIZE + 1) * (GRID_SIZE + 1);
+    static constexpr std::uint32_t SCATTER_STRIDE = 1031;
+
+    AZStd::vector<std::uint32_t> m_indices;
+};
+
+TEST_F(VertexCacheOptimizerTest, OptimizeVertexCacheReducesACMR)
+{
+    Cesium::VertexCacheOptimizer optimizer;
+    float acmrBefore = optimizer.CalculateACMR(m_indices, GRID_VERTEX_COUNT);
+    ASSERT_TRUE(optimizer.OptimizeVertexCache(m_indices, GRID_VERTEX_COUNT));
+    float acmrAfter = optimizer.CalculateACMR(m_indices, GRID_VERTEX_COUNT);
+
+    ASSERT_GT(acmrBefore, 1.5f);
+    ASSERT_LT(acmrAfter, 0.8f);
+}
+
+TEST_F(VertexCacheOptimizerTest, OptimizeVertexCacheKeepsTriangles)
+{
+    auto originalTriangles = SortedTriangles(m_indices);
+
+    Cesium::VertexCacheOptimizer optimizer;
+    ASSERT_TRUE(optimizer.OptimizeVertexCache(m_indices, GRID_VERTEX_COUNT));
+
+    ASSERT_EQ(SortedTriangles(m_indices), originalTriangles);
+}
+
+TEST_F(VertexCacheOptimizerTest, OptimizeVertexCacheRejectsOutOfRangeIndices)
+{
+    m_indices.back() = GRID_VERTEX_COUNT;
+    AZStd::vector<std::uint32_t> originalIndices = m_indices;
+
+    Cesium::VertexCacheOptimizer optimizer;
+    ASSERT_FALSE(optimizer.OptimizeVertexCache(m_indices, GRID_VERTEX_COUNT));
+    ASSERT_EQ(m_indices, originalIndices);
+}
+
+TEST_F(VertexCacheOptimizerTest, OptimizeVertexFetchOrdersVerticesByFirstUse)
+{
+    // vertex 0 is never referenced and vertex 3 is referenced first
+    AZStd::vector<std::uint32_t> indices{ 3, 1, 2, 2, 1, 4 };
+    AZStd::vector<std::uint32_t> remap;
+
+    Cesium::VertexCacheOptimizer optimizer;
+    std::size_t vertexCount = optimizer.OptimizeVertexFetch(indices, 5, remap);
+
+    ASSERT_EQ(vertexCount, 4);
+    ASSERT_EQ(indices, AZStd::vector<std::uint32_t>({ 0, 1, 2, 2, 1, 3 }));
+    ASSERT_EQ(remap[0], Cesium::VertexCacheOptimizer::INVALID_INDEX);
+    ASSERT_EQ(remap[3], 0);
+    ASSERT_EQ(remap[4], 3);
+}
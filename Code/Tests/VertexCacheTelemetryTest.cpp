@@ -0,0 +1,21 @@
+#include "Cesium/Gltf/VertexCacheTelemetry.h"
+#include <AzCore/UnitTest/TestTypes.h>
+
+class VertexCacheTelemetryTest : public UnitTest::AllocatorsTestFixture
+{
+};
+
+TEST_F(VertexCacheTelemetryTest, MeanACMRIsWeightedByTriangles)
+{
+    Cesium::VertexCacheTelemetry telemetry;
+    ASSERT_EQ(telemetry.GetStatistics().GetMeanACMRBefore(), 0.0);
+
+    telemetry.Record(100, 3.0f, 1.0f);
+    telemetry.Record(300, 1.0f, 0.5f);
+
+    Cesium::VertexCacheStatistics statistics = telemetry.GetStatistics();
+    ASSERT_EQ(statistics.m_primitiveCount, 2u);
+    ASSERT_EQ(statistics.m_triangleCount, 400u);
+    ASSERT_NEAR(statistics.GetMeanACMRBefore(), 1.5, 1e-6);
+    ASSERT_NEAR(statistics.GetMeanACMRAfter(), 0.625, 1e-6);
+}
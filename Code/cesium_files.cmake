@@ -28,10 +28,21 @@ set(FILES
     Source/Cesium/Math/LinearInterpolator.h
     Source/Cesium/Math/LinearInterpolator.cpp
 
+    Source/Cesium/Systems/BlockingHttpClientBackend.h
+    Source/Cesium/Systems/BlockingHttpClientBackend.cpp
+    Source/Cesium/Systems/CurlMultiHttpClientBackend.h
+    Source/Cesium/Systems/CurlMultiHttpClientBackend.cpp
     Source/Cesium/Systems/GenericIOManager.h
     Source/Cesium/Systems/GenericIOManager.cpp
+    Source/Cesium/Systems/HttpClientBackend.h
+    Source/Cesium/Systems/HttpContentDecoder.h
+    Source/Cesium/Systems/HttpContentDecoder.cpp
     Source/Cesium/Systems/HttpManager.h
     Source/Cesium/Systems/HttpManager.cpp
+    Source/Cesium/Systems/HttpResponseBodyStream.h
+    Source/Cesium/Systems/HttpResponseBodyStream.cpp
+    Source/Cesium/Systems/HttpTelemetry.h
+    Source/Cesium/Systems/HttpTelemetry.cpp
     Source/Cesium/Systems/LocalFileManager.h
     Source/Cesium/Systems/LocalFileManager.cpp
     Source/Cesium/Systems/LoggerSink.h
@@ -44,17 +55,41 @@ set(FILES
     Source/Cesium/Systems/GenericAssetAccessor.cpp
     Source/Cesium/Systems/CriticalAssetManager.h
     Source/Cesium/Systems/CriticalAssetManager.cpp
+    Source/Cesium/Systems/UiImageCache.h
+    Source/Cesium/Systems/UiImageCache.cpp
     Source/Cesium/Systems/CesiumSystem.h
     Source/Cesium/Systems/CesiumSystem.cpp
 
     Source/Cesium/Gltf/BitangentAndTangentGenerator.h
     Source/Cesium/Gltf/BitangentAndTangentGenerator.cpp
+    Source/Cesium/Gltf/VertexCacheOptimizer.h
+    Source/Cesium/Gltf/VertexCacheOptimizer.cpp
+    Source/Cesium/Gltf/VertexCacheTelemetry.h
+    Source/Cesium/Gltf/VertexCacheTelemetry.cpp
+    Source/Cesium/Gltf/TextureBlockCompressor.h
+    Source/Cesium/Gltf/TextureBlockCompressor.cpp
+    Source/Cesium/Gltf/MipChainGenerator.h
+    Source/Cesium/Gltf/MipChainGenerator.cpp
+    Source/Cesium/Gltf/PixelFormatConverter.h
+    Source/Cesium/Gltf/PixelFormatConverter.cpp
+    Source/Cesium/Gltf/ImageDecoder.h
+    Source/Cesium/Gltf/ImageDecoder.cpp
+    Source/Cesium/Gltf/StreamingImageBuilder.h
+    Source/Cesium/Gltf/StreamingImageBuilder.cpp
+    Source/Cesium/Gltf/SharedTextureCache.h
+    Source/Cesium/Gltf/SharedTextureCache.cpp
     Source/Cesium/Gltf/GltfLoadContext.h
     Source/Cesium/Gltf/GltfLoadContext.cpp
+    Source/Cesium/Gltf/GltfLoadScratchArena.h
+    Source/Cesium/Gltf/GltfLoadScratchArena.cpp
     Source/Cesium/Gltf/GltfModel.h
     Source/Cesium/Gltf/GltfModel.cpp
     Source/Cesium/Gltf/GltfPrimitiveBuilder.h
     Source/Cesium/Gltf/GltfPrimitiveBuilder.cpp
+    Source/Cesium/Gltf/GltfPointPrimitiveBuilder.h
+    Source/Cesium/Gltf/GltfPointPrimitiveBuilder.cpp
+    Source/Cesium/Gltf/GltfPointMaterialBuilder.h
+    Source/Cesium/Gltf/GltfPointMaterialBuilder.cpp
     Source/Cesium/Gltf/GltfMaterialBuilder.h
     Source/Cesium/Gltf/GltfMaterialBuilder.cpp
     Source/Cesium/Gltf/GltfPBRMaterialBuilder.h
@@ -68,6 +103,12 @@ set(FILES
     Source/Cesium/TilesetUtility/GltfRasterMaterialBuilder.cpp
     Source/Cesium/TilesetUtility/RenderResourcesPreparer.h
     Source/Cesium/TilesetUtility/RenderResourcesPreparer.cpp
+    Source/Cesium/TilesetUtility/RasterOverlayTexturePool.h
+    Source/Cesium/TilesetUtility/RasterOverlayTexturePool.cpp
+    Source/Cesium/TilesetUtility/RasterCompositor.h
+    Source/Cesium/TilesetUtility/RasterCompositor.cpp
+    Source/Cesium/TilesetUtility/TextureMipSelector.h
+    Source/Cesium/TilesetUtility/TextureMipSelector.cpp
 
     Source/Cesium/EBus/CesiumSystemComponentBus.h
     Source/Cesium/EBus/CesiumSystemComponentBus.cpp
@@ -1,7 +1,24 @@
 
 set(FILES
     Tests/CesiumTest.cpp
+    Tests/LoopbackHttpServer.h
+    Tests/LoopbackHttpServer.cpp
     Tests/HttpManagerTest.cpp
+    Tests/HttpResponseBodyStreamTest.cpp
+    Tests/HttpContentDecoderTest.cpp
+    Tests/HttpTelemetryTest.cpp
     Tests/HttpAssetAccessorTest.cpp
     Tests/TaskProcessorTest.cpp
+    Tests/VertexCacheOptimizerTest.cpp
+    Tests/VertexCacheTelemetryTest.cpp
+    Tests/BitangentAndTangentGeneratorTest.cpp
+    Tests/TextureBlockCompressorTest.cpp
+    Tests/MipChainGeneratorTest.cpp
+    Tests/PixelFormatConverterTest.cpp
+    Tests/SharedTextureCacheTest.cpp
+    Tests/RasterOverlayTexturePoolTest.cpp
+    Tests/RasterCompositorTest.cpp
+    Tests/TextureMipSelectorTest.cpp
+    Tests/ImageDecoderTest.cpp
+    Tests/UiImageCacheTest.cpp
 )